@@ -104,6 +104,12 @@
  * If the queue is full and the sending thread has a higher priority than the
  * receiving thread the send-behavior is equivalent to synchronous mode.
  *
+ * With the `core_msg_mpsc` module, the message queue is a lock-free
+ * multi-producer single-consumer ring buffer, so interrupts (including
+ * nested ones) can queue messages without disabling interrupts. Messages that
+ * find the queue full are counted in thread_t::msg_overflows, which `ps`
+ * shows.
+ *
  * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
  * #include <inttypes.h>
  * #include <stdio.h>
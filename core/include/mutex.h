@@ -11,6 +11,26 @@
  * @defgroup    core_sync_mutex Mutex
  * @ingroup     core_sync
  * @brief       Mutex for thread synchronization
+ *
+ * If the `core_mutex_priority_inheritance` module is used, a thread that
+ * owns a mutex runs with the priority of the highest priority thread waiting
+ * for it, so threads of medium priority can not delay the release of the
+ * mutex indefinitely (priority inversion). This is transitive: if the owner
+ * itself waits for another mutex, the owner of that one inherits the
+ * priority as well. As @ref rmutex_t and the mutex of a @ref cond_t are
+ * locked through this API, they are covered, too.
+ *
+ * The owner is the thread that locked the mutex, or the thread that was woken
+ * up by mutex_unlock(). Mutexes locked in interrupt context or initialized
+ * with @ref MUTEX_INIT_LOCKED have no owner until they are passed on to a
+ * waiter, so their waiters are not inherited.
+ *
+ * A thread must not exit while it owns a mutex other threads wait for, or
+ * may wait for later: the owner is resolved by its PID, which may be reused
+ * by an unrelated thread. With `DEVELHELP` exiting while others wait
+ * for a mutex of the thread fails an assertion. Otherwise the ownership of
+ * these mutexes is dropped, so their waiters are not inherited anymore.
+ *
  * @{
  *
  * @file
@@ -24,6 +44,7 @@
 
 #include <stddef.h>
 
+#include "kernel_types.h"
 #include "list.h"
 
 #ifdef __cplusplus
@@ -33,25 +54,42 @@
 /**
  * @brief Mutex structure. Must never be modified by the user.
  */
-typedef struct {
+typedef struct mutex {
     /**
      * @brief   The process waiting queue of the mutex. **Must never be changed
      *          by the user.**
      * @internal
      */
     list_node_t queue;
+#if defined(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE) || defined(DOXYGEN)
+    /**
+     * @brief   The thread owning the mutex, KERNEL_PID_UNDEF if unknown
+     * @internal
+     */
+    kernel_pid_t owner;
+    /**
+     * @brief   Next mutex in the list of contended mutexes of the owner
+     * @internal
+     */
+    struct mutex *next_held;
+#endif
 } mutex_t;
 
+#if defined(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE) || defined(DOXYGEN)
 /**
  * @brief Static initializer for mutex_t.
  * @details This initializer is preferable to mutex_init().
  */
-#define MUTEX_INIT { { NULL } }
+#define MUTEX_INIT { { NULL }, KERNEL_PID_UNDEF, NULL }
 
 /**
  * @brief Static initializer for mutex_t with a locked mutex
  */
+#define MUTEX_INIT_LOCKED { { MUTEX_LOCKED }, KERNEL_PID_UNDEF, NULL }
+#else
+#define MUTEX_INIT { { NULL } }
 #define MUTEX_INIT_LOCKED { { MUTEX_LOCKED } }
+#endif
 
 /**
  * @cond INTERNAL
@@ -72,6 +110,10 @@ typedef struct {
 static inline void mutex_init(mutex_t *mutex)
 {
     mutex->queue.next = NULL;
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    mutex->owner = KERNEL_PID_UNDEF;
+    mutex->next_held = NULL;
+#endif
 }
 
 /**
@@ -127,6 +169,29 @@ void mutex_unlock(mutex_t *mutex);
  */
 void mutex_unlock_and_sleep(mutex_t *mutex);
 
+#if defined(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE) || defined(DOXYGEN)
+/**
+ * @brief   Updates the priority of the owner of @p mutex after a waiter was
+ *          removed from its queue by other means than mutex_unlock()
+ * @internal
+ *
+ * @pre     Interrupts are disabled
+ *
+ * @param[in] mutex     Mutex a waiter was removed from
+ */
+void mutex_waiter_removed(mutex_t *mutex);
+
+/**
+ * @brief   Drops the ownership of the mutexes other threads wait for, as the
+ *          running thread exits
+ * @internal
+ *
+ * @pre     Interrupts are disabled
+ * @pre     The running thread owns no mutex other threads wait for
+ */
+void mutex_owner_exit(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -39,6 +39,16 @@
  * happens, threads with the same priority will only switch due to
  * voluntary or implicit context switches.
  *
+ * If the `sched_round_robin` module is used, threads of the same
+ * priority are time sliced instead: while other threads are runnable at
+ * the priority of the running thread, a timer preempts it after its
+ * quantum (@ref SCHED_RR_QUANTUM unless set with `sched_set_quantum()`)
+ * and moves it to the end of its runqueue. A thread preempted by a higher
+ * priority continues its time slice afterwards. The timer is only set when
+ * a time slice starts, not on every context switch, and is stopped once the
+ * thread it runs for is the only runnable one at its priority, so the
+ * scheduler stays tickless.
+ *
  * ## Interrupts:
  *
  * When an interrupt occurs, e.g. because a timer fired or a network
@@ -148,6 +158,18 @@ int sched_run(void);
  */
 void sched_set_status(thread_t *process, thread_status_t status);
 
+/**
+ * @brief       Change the priority of a thread
+ *
+ * A runnable thread is moved to the runqueue of its new priority. This
+ * function does not yield, call sched_switch() if the change may make
+ * another thread preempt the running one.
+ *
+ * @param[in]   thread      thread to change the priority of
+ * @param[in]   priority    new priority
+ */
+void sched_change_priority(thread_t *thread, uint8_t priority);
+
 /**
  * @brief       Yield if approriate.
  *
@@ -204,6 +226,24 @@ extern clist_node_t sched_runqueues[SCHED_PRIO_LEVELS];
 NORETURN void sched_task_exit(void);
 
 #ifdef MODULE_SCHEDSTATISTICS
+/**
+ * @brief   Number of buckets of the wake-up latency histogram
+ */
+#ifndef SCHEDSTATISTICS_LATENCY_BUCKETS
+#define SCHEDSTATISTICS_LATENCY_BUCKETS     (8U)
+#endif
+
+/**
+ * @brief   Upper bound of the first wake-up latency bucket as power of two
+ *          in microseconds
+ *
+ * Bucket 0 counts latencies below 2^SCHEDSTATISTICS_LATENCY_SHIFT us, every
+ * following bucket doubles the bound, the last one is open-ended.
+ */
+#ifndef SCHEDSTATISTICS_LATENCY_SHIFT
+#define SCHEDSTATISTICS_LATENCY_SHIFT       (4U)
+#endif
+
 /**
  *  Scheduler statistics
  */
@@ -212,8 +252,39 @@ typedef struct {
                                   scheduled to run */
     unsigned int schedules;  /**< How often the thread was scheduled to run */
     uint64_t runtime_ticks;  /**< The total runtime of this thread in ticks */
+    unsigned int voluntary;  /**< How often the thread blocked or exited */
+    unsigned int involuntary;   /**< How often the thread was preempted or
+                                     yielded while still runnable */
+    uint32_t readystart;     /**< Time stamp of the last time this thread was
+                                  put on its runqueue */
+    uint32_t latency_max;    /**< Longest wake-up latency in ticks */
+    uint16_t latency[SCHEDSTATISTICS_LATENCY_BUCKETS]; /**< Wake-up latency
+                                                            histogram */
+    uintptr_t sp_min;        /**< Lowest saved stack pointer seen when the
+                                  thread was switched in, 0 if none yet */
+    uint8_t waking;          /**< 1 while readystart is pending evaluation */
 } schedstat_t;
 
+/**
+ * @brief   Snapshot of the statistics of one thread
+ */
+typedef struct {
+    uint64_t runtime_us;        /**< Total runtime in microseconds, including
+                                     the ongoing time slice */
+    unsigned int schedules;     /**< How often the thread was scheduled */
+    unsigned int voluntary;     /**< How often the thread blocked or exited */
+    unsigned int involuntary;   /**< How often the thread was preempted or
+                                     yielded while still runnable */
+    uint32_t latency_max_us;    /**< Longest wake-up latency in microseconds */
+    uint16_t latency[SCHEDSTATISTICS_LATENCY_BUCKETS]; /**< Wake-up latency
+                                                            histogram */
+    unsigned int stack_peak;    /**< Deepest stack usage in bytes seen at a
+                                     context switch, 0 if unknown */
+    uint64_t irq_off_us;        /**< Total time in microseconds the thread
+                                     ran with interrupts disabled, 0 without
+                                     @ref sys_irq_stats */
+} schedstat_snapshot_t;
+
 /**
  *  Thread statistics table
  */
@@ -224,8 +295,44 @@ extern schedstat_t sched_pidlist[KERNEL_PID_LAST + 1];
  *          caller thread
  */
 void init_schedstatistics(void);
+
+/**
+ * @brief   Takes a consistent snapshot of the statistics of a thread
+ *
+ * The stack peak is derived from the saved stack pointer of the thread
+ * whenever it is switched in, so it is a cheap lower bound of what
+ * @ref thread_measure_stack_free reports. It is only available with
+ * `DEVELHELP`, where the stack bounds of a thread are known.
+ *
+ * @param[in]  pid          the thread
+ * @param[out] snapshot     the statistics of @p pid
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p pid is not a running thread
+ */
+int sched_statistics_snapshot(kernel_pid_t pid, schedstat_snapshot_t *snapshot);
 #endif /* MODULE_SCHEDSTATISTICS */
 
+#if defined(MODULE_SCHED_ROUND_ROBIN) || defined(DOXYGEN)
+/**
+ * @brief   Default time slice in microseconds of threads sharing a priority
+ */
+#ifndef SCHED_RR_QUANTUM
+#define SCHED_RR_QUANTUM        (10000U)
+#endif
+
+/**
+ * @brief   Sets the time slice of a thread
+ *
+ * The new quantum applies from the next time the thread is scheduled.
+ *
+ * @param[in] pid       the thread
+ * @param[in] quantum   time slice in microseconds, 0 for
+ *                      @ref SCHED_RR_QUANTUM
+ */
+void sched_set_quantum(kernel_pid_t pid, uint32_t quantum);
+#endif /* MODULE_SCHED_ROUND_ROBIN */
+
 #ifdef MODULE_SCHED_CB
 /**
  *  @brief  Register a callback that will be called on every scheduler run
@@ -235,6 +342,19 @@ void init_schedstatistics(void);
 void sched_register_cb(void (*callback)(kernel_pid_t, kernel_pid_t));
 #endif /* MODULE_SCHED_CB */
 
+#ifdef MODULE_SCHED_EXIT_CB
+/**
+ *  @brief  Register a callback that will be called when a thread exits
+ *
+ *  The callback is called with interrupts disabled, before the thread is
+ *  stopped.
+ *
+ *  @param[in] callback The callback function, gets the PID of the exiting
+ *                      thread
+ */
+void sched_register_exit_cb(void (*callback)(kernel_pid_t));
+#endif /* MODULE_SCHED_EXIT_CB */
+
 #ifdef __cplusplus
 }
 #endif
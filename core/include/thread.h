@@ -133,6 +133,8 @@
  extern "C" {
 #endif
 
+struct mutex;
+
 /**
  * @brief Prototype for a thread entry function
  */
@@ -168,6 +170,10 @@ struct _thread {
     msg_t *msg_array;               /**< memory holding messages sent
                                          to this thread's message queue */
 #endif
+#if defined(MODULE_CORE_MSG_MPSC) || defined(DOXYGEN)
+    unsigned msg_overflows;         /**< number of messages that found
+                                         the message queue full         */
+#endif
 #if defined(DEVELHELP) || defined(SCHED_TEST_STACK) \
     || defined(MODULE_MPU_STACK_GUARD) || defined(DOXYGEN)
     char *stack_start;              /**< thread's stack start address   */
@@ -176,6 +182,17 @@ struct _thread {
     const char *name;               /**< thread's name                  */
     int stack_size;                 /**< thread's stack size            */
 #endif
+#if defined(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE) || defined(DOXYGEN)
+    uint8_t base_priority;          /**< priority without inheritance   */
+    struct mutex *mutex_blocked;    /**< mutex the thread waits for, valid
+                                         while STATUS_MUTEX_BLOCKED     */
+    struct mutex *mutex_held;       /**< mutexes owned by the thread that
+                                         others wait for                */
+#endif
+#if defined(MODULE_SCHED_ROUND_ROBIN) || defined(DOXYGEN)
+    uint32_t quantum;               /**< time slice in microseconds, 0 for
+                                         the default                    */
+#endif
 #ifdef HAVE_THREAD_ARCH_T
     thread_arch_t arch;             /**< architecture dependent part    */
 #endif
@@ -39,20 +39,104 @@
 static int _msg_receive(msg_t *m, int block);
 static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block, unsigned state);
 
-static int queue_msg(thread_t *target, const msg_t *m)
+#ifdef MODULE_CORE_MSG_MPSC
+/*
+ * The message queue is a lock-free multi-producer single-consumer ring:
+ * producers reserve a slot by advancing msg_queue.write_count with a
+ * compare-and-swap and publish the message by writing its sender_pid last.
+ * Free slots have a sender_pid of KERNEL_PID_UNDEF, which is never the
+ * sender of a message. The owner of the queue is the only consumer.
+ */
+static int _queue_put(thread_t *target, const msg_t *m)
+{
+    cib_t *queue = &target->msg_queue;
+    unsigned write = __atomic_load_n(&queue->write_count, __ATOMIC_RELAXED);
+
+    if (target->msg_array == NULL) {
+        return 0;
+    }
+
+    do {
+        unsigned read = __atomic_load_n(&queue->read_count, __ATOMIC_ACQUIRE);
+
+        if ((write - read) > queue->mask) {
+            __atomic_fetch_add(&target->msg_overflows, 1, __ATOMIC_RELAXED);
+            return 0;
+        }
+    } while (!__atomic_compare_exchange_n(&queue->write_count, &write,
+                                          write + 1, true, __ATOMIC_ACQ_REL,
+                                          __ATOMIC_RELAXED));
+
+    msg_t *dest = &target->msg_array[write & queue->mask];
+    dest->type = m->type;
+    dest->content = m->content;
+    __atomic_store_n(&dest->sender_pid, m->sender_pid, __ATOMIC_RELEASE);
+    return 1;
+}
+
+static int _queue_get(thread_t *me, msg_t *m)
+{
+    cib_t *queue = &me->msg_queue;
+    unsigned read = queue->read_count;
+    msg_t *src = &me->msg_array[read & queue->mask];
+    kernel_pid_t sender_pid = __atomic_load_n(&src->sender_pid,
+                                              __ATOMIC_ACQUIRE);
+
+    /* empty, or the producer of the next slot was interrupted */
+    if (sender_pid == KERNEL_PID_UNDEF) {
+        return 0;
+    }
+
+    m->sender_pid = sender_pid;
+    m->type = src->type;
+    m->content = src->content;
+    src->sender_pid = KERNEL_PID_UNDEF;
+    __atomic_store_n(&queue->read_count, read + 1, __ATOMIC_RELEASE);
+    return 1;
+}
+#else
+static int _queue_put(thread_t *target, const msg_t *m)
 {
     int n = cib_put(&(target->msg_queue));
     if (n < 0) {
-        DEBUG("queue_msg(): message queue is full (or there is none)\n");
         return 0;
     }
 
-    DEBUG("queue_msg(): queuing message\n");
     msg_t *dest = &target->msg_array[n];
     *dest = *m;
+    return 1;
+}
+
+static int _queue_get(thread_t *me, msg_t *m)
+{
+    int n = cib_get(&(me->msg_queue));
+    if (n < 0) {
+        return 0;
+    }
+
+    *m = me->msg_array[n];
+    return 1;
+}
+#endif
+
+static int queue_msg(thread_t *target, const msg_t *m)
+{
+    if (!_queue_put(target, m)) {
+        DEBUG("queue_msg(): message queue is full (or there is none)\n");
+        return 0;
+    }
+
+    DEBUG("queue_msg(): queuing message\n");
 #if MODULE_CORE_THREAD_FLAGS
+#ifdef MODULE_CORE_MSG_MPSC
+    /* the queue is lock-free, waking the thread is not */
+    unsigned state = irq_disable();
+#endif
     target->flags |= THREAD_FLAG_MSG_WAITING;
     thread_flags_wake(target);
+#ifdef MODULE_CORE_MSG_MPSC
+    irq_restore(state);
+#endif
 #endif
     return 1;
 }
@@ -198,6 +282,11 @@ int msg_send_int(msg_t *m, kernel_pid_t target_pid)
     }
 
     m->sender_pid = KERNEL_PID_ISR;
+#ifdef MODULE_CORE_MSG_MPSC
+    /* with nested interrupts, only handing the message to a waiting
+     * receiver needs protection, queueing is lock-free */
+    unsigned state = irq_disable();
+#endif
     if (target->status == STATUS_RECEIVE_BLOCKED) {
         DEBUG("msg_send_int: Direct msg copy from %" PRIkernel_pid " to %"
               PRIkernel_pid ".\n", thread_getpid(), target_pid);
@@ -209,9 +298,15 @@ int msg_send_int(msg_t *m, kernel_pid_t target_pid)
         sched_set_status(target, STATUS_PENDING);
 
         sched_context_switch_request = 1;
+#ifdef MODULE_CORE_MSG_MPSC
+        irq_restore(state);
+#endif
         return 1;
     }
     else {
+#ifdef MODULE_CORE_MSG_MPSC
+        irq_restore(state);
+#endif
         DEBUG("msg_send_int: Receiver not waiting.\n");
         return (queue_msg(target, m));
     }
@@ -294,22 +389,21 @@ static int _msg_receive(msg_t *m, int block)
 
     thread_t *me = (thread_t*) sched_threads[sched_active_pid];
 
-    int queue_index = -1;
+    int queued = 0;
 
     if (thread_has_msg_queue(me)) {
-        queue_index = cib_get(&(me->msg_queue));
+        queued = _queue_get(me, m);
     }
 
     /* no message, fail */
-    if ((!block) && ((!me->msg_waiters.next) && (queue_index == -1))) {
+    if ((!block) && ((!me->msg_waiters.next) && !queued)) {
         irq_restore(state);
         return -1;
     }
 
-    if (queue_index >= 0) {
+    if (queued) {
         DEBUG("_msg_receive: %" PRIkernel_pid ": _msg_receive(): We've got a queued message.\n",
               sched_active_thread->pid);
-        *m = me->msg_array[queue_index];
     }
     else {
         me->wait_data = (void *) m;
@@ -321,7 +415,7 @@ static int _msg_receive(msg_t *m, int block)
         DEBUG("_msg_receive: %" PRIkernel_pid ": _msg_receive(): No thread in waiting list.\n",
               sched_active_thread->pid);
 
-        if (queue_index < 0) {
+        if (!queued) {
             DEBUG("_msg_receive(): %" PRIkernel_pid ": No msg in queue. Going blocked.\n",
                   sched_active_thread->pid);
             sched_set_status(me, STATUS_RECEIVE_BLOCKED);
@@ -344,16 +438,17 @@ static int _msg_receive(msg_t *m, int block)
 
         thread_t *sender = container_of((clist_node_t*)next, thread_t, rq_entry);
 
-        if (queue_index >= 0) {
+        /* copy msg */
+        msg_t *sender_msg = (msg_t*) sender->wait_data;
+        if (queued) {
             /* We've already got a message from the queue. As there is a
              * waiter, take it's message into the just freed queue space.
              */
-            m = &(me->msg_array[cib_put(&(me->msg_queue))]);
+            _queue_put(me, sender_msg);
+        }
+        else {
+            *m = *sender_msg;
         }
-
-        /* copy msg */
-        msg_t *sender_msg = (msg_t*) sender->wait_data;
-        *m = *sender_msg;
 
         /* remove sender from queue */
         uint16_t sender_prio = THREAD_PRIORITY_IDLE;
@@ -394,6 +489,12 @@ void msg_init_queue(msg_t *array, int num)
     thread_t *me = (thread_t*) sched_active_thread;
     me->msg_array = array;
     cib_init(&(me->msg_queue), num);
+#ifdef MODULE_CORE_MSG_MPSC
+    me->msg_overflows = 0;
+    for (int i = 0; i < num; i++) {
+        array[i].sender_pid = KERNEL_PID_UNDEF;
+    }
+#endif
 }
 
 void msg_queue_print(void)
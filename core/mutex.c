@@ -23,6 +23,7 @@
 #include <stdio.h>
 #include <inttypes.h>
 
+#include "assert.h"
 #include "mutex.h"
 #include "thread.h"
 #include "sched.h"
@@ -32,6 +33,127 @@
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+static inline int _has_waiters(const mutex_t *mutex)
+{
+    return mutex->queue.next && (mutex->queue.next != MUTEX_LOCKED);
+}
+
+static inline thread_t *_owner(const mutex_t *mutex)
+{
+    /* sched_threads[KERNEL_PID_UNDEF] is always NULL */
+    return (thread_t *)sched_threads[mutex->owner];
+}
+
+static void _held_add(thread_t *owner, mutex_t *mutex)
+{
+    mutex->next_held = owner->mutex_held;
+    owner->mutex_held = mutex;
+}
+
+static void _held_remove(thread_t *owner, mutex_t *mutex)
+{
+    mutex_t **pos = &owner->mutex_held;
+
+    while (*pos) {
+        if (*pos == mutex) {
+            *pos = mutex->next_held;
+            break;
+        }
+        pos = &(*pos)->next_held;
+    }
+    mutex->next_held = NULL;
+}
+
+static uint8_t _effective_priority(const thread_t *thread)
+{
+    uint8_t priority = thread->base_priority;
+
+    /* the queues are sorted, so their heads are the relevant waiters */
+    for (mutex_t *mutex = thread->mutex_held; mutex; mutex = mutex->next_held) {
+        thread_t *waiter = container_of((clist_node_t *)mutex->queue.next,
+                                        thread_t, rq_entry);
+        if (waiter->priority < priority) {
+            priority = waiter->priority;
+        }
+    }
+    return priority;
+}
+
+/**
+ * @brief   Applies the inherited priority to @p thread and along the chain of
+ *          mutex owners it waits for
+ */
+static void _update_priority(thread_t *thread)
+{
+    while (thread) {
+        uint8_t priority = _effective_priority(thread);
+
+        if (priority == thread->priority) {
+            return;
+        }
+        sched_change_priority(thread, priority);
+        if (thread->status != STATUS_MUTEX_BLOCKED) {
+            return;
+        }
+
+        /* keep the queue of the mutex the thread waits for sorted and pass
+         * the change on to its owner */
+        mutex_t *mutex = thread->mutex_blocked;
+        list_remove(&mutex->queue, (list_node_t *)&thread->rq_entry);
+        thread_add_to_list(&mutex->queue, thread);
+        thread = _owner(mutex);
+    }
+}
+
+static void _set_owner(mutex_t *mutex, thread_t *thread)
+{
+    mutex->owner = thread->pid;
+    if (_has_waiters(mutex)) {
+        _held_add(thread, mutex);
+        _update_priority(thread);
+    }
+}
+
+static thread_t *_clear_owner(mutex_t *mutex)
+{
+    thread_t *owner = _owner(mutex);
+
+    if (owner && _has_waiters(mutex)) {
+        _held_remove(owner, mutex);
+    }
+    mutex->owner = KERNEL_PID_UNDEF;
+    return owner;
+}
+
+void mutex_waiter_removed(mutex_t *mutex)
+{
+    thread_t *owner = _owner(mutex);
+
+    if (owner) {
+        if (!_has_waiters(mutex)) {
+            _held_remove(owner, mutex);
+        }
+        _update_priority(owner);
+    }
+}
+
+void mutex_owner_exit(void)
+{
+    thread_t *me = (thread_t *)sched_active_thread;
+
+    /* the waiters would wait forever */
+    assert(me->mutex_held == NULL);
+    while (me->mutex_held) {
+        mutex_t *mutex = me->mutex_held;
+
+        me->mutex_held = mutex->next_held;
+        mutex->next_held = NULL;
+        mutex->owner = KERNEL_PID_UNDEF;
+    }
+}
+#endif
+
 int _mutex_lock(mutex_t *mutex, int blocking)
 {
     unsigned irqstate = irq_disable();
@@ -41,6 +163,9 @@ int _mutex_lock(mutex_t *mutex, int blocking)
     if (mutex->queue.next == NULL) {
         /* mutex is unlocked. */
         mutex->queue.next = MUTEX_LOCKED;
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+        mutex->owner = irq_is_in() ? KERNEL_PID_UNDEF : sched_active_pid;
+#endif
         DEBUG("PID[%" PRIkernel_pid "]: mutex_wait early out.\n",
               sched_active_pid);
         irq_restore(irqstate);
@@ -58,6 +183,17 @@ int _mutex_lock(mutex_t *mutex, int blocking)
         else {
             thread_add_to_list(&mutex->queue, me);
         }
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+        me->mutex_blocked = mutex;
+        thread_t *owner = _owner(mutex);
+        if (owner) {
+            if (mutex->queue.next->next == NULL) {
+                /* first waiter */
+                _held_add(owner, mutex);
+            }
+            _update_priority(owner);
+        }
+#endif
         irq_restore(irqstate);
         thread_yield_higher();
         /* We were woken up by scheduler. Waker removed us from queue.
@@ -83,6 +219,10 @@ void mutex_unlock(mutex_t *mutex)
         return;
     }
 
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    thread_t *owner = _clear_owner(mutex);
+#endif
+
     if (mutex->queue.next == MUTEX_LOCKED) {
         mutex->queue.next = NULL;
         /* the mutex was locked and no thread was waiting for it */
@@ -102,6 +242,12 @@ void mutex_unlock(mutex_t *mutex)
         mutex->queue.next = MUTEX_LOCKED;
     }
 
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    _set_owner(mutex, process);
+    /* drop what the previous owner inherited through this mutex */
+    _update_priority(owner);
+#endif
+
     uint16_t process_priority = process->priority;
     irq_restore(irqstate);
     sched_switch(process_priority);
@@ -114,6 +260,9 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
     unsigned irqstate = irq_disable();
 
     if (mutex->queue.next) {
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+        thread_t *owner = _clear_owner(mutex);
+#endif
         if (mutex->queue.next == MUTEX_LOCKED) {
             mutex->queue.next = NULL;
         }
@@ -126,7 +275,13 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
             if (!mutex->queue.next) {
                 mutex->queue.next = MUTEX_LOCKED;
             }
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+            _set_owner(mutex, process);
+#endif
         }
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+        _update_priority(owner);
+#endif
     }
 
     DEBUG("PID[%" PRIkernel_pid "]: going to sleep.\n", sched_active_pid);
@@ -19,7 +19,9 @@
  * @}
  */
 
+#include <errno.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "sched.h"
 #include "clist.h"
@@ -33,10 +35,18 @@
 #include "mpu.h"
 #endif
 
-#ifdef MODULE_SCHEDSTATISTICS
+#if defined(MODULE_SCHEDSTATISTICS) || defined(MODULE_SCHED_ROUND_ROBIN)
 #include "xtimer.h"
 #endif
 
+#if defined(MODULE_SCHEDSTATISTICS) && defined(MODULE_IRQ_STATS)
+#include "irq_stats.h"
+#endif
+
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+#include "mutex.h"
+#endif
+
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
@@ -77,8 +87,58 @@ const uint8_t _tcb_name_offset = offsetof(thread_t, name);
 #ifdef MODULE_SCHED_CB
 static void (*sched_cb) (kernel_pid_t active_thread, kernel_pid_t next_thread) = NULL;
 #endif
+#ifdef MODULE_SCHED_EXIT_CB
+static void (*sched_exit_cb) (kernel_pid_t exiting_thread) = NULL;
+#endif
 #ifdef MODULE_SCHEDSTATISTICS
 schedstat_t sched_pidlist[KERNEL_PID_LAST + 1];
+
+/* threads are created before the timer is initialized, so no time stamps
+ * are taken until init_schedstatistics() ran */
+static uint8_t _schedstat_running;
+#endif
+
+#ifdef MODULE_SCHED_ROUND_ROBIN
+static void _rr_expired(void *arg);
+
+static xtimer_t _rr_timer = { .callback = _rr_expired };
+static uint8_t _rr_armed;
+/* thread the pending time slice was started for, only compared, never
+ * dereferenced */
+static const thread_t *_rr_thread;
+
+static inline int _rr_contended(uint8_t priority)
+{
+    clist_node_t *last = sched_runqueues[priority].next;
+
+    return last && (last->next != last);
+}
+
+static void _rr_arm(const thread_t *thread)
+{
+    uint32_t quantum = thread->quantum ? thread->quantum : SCHED_RR_QUANTUM;
+
+    _rr_armed = 1;
+    _rr_thread = thread;
+    xtimer_set(&_rr_timer, quantum);
+}
+
+static void _rr_expired(void *arg)
+{
+    (void)arg;
+    thread_t *active_thread = (thread_t *)sched_active_thread;
+
+    _rr_armed = 0;
+    if (active_thread && (active_thread->status == STATUS_RUNNING) &&
+        _rr_contended(active_thread->priority)) {
+        DEBUG("sched: quantum of thread %" PRIkernel_pid " expired\n",
+              active_thread->pid);
+        /* the running thread is the head of its runqueue, move it to the
+         * tail and let the ISR epilogue switch to the next one */
+        clist_lpoprpush(&sched_runqueues[active_thread->priority]);
+        sched_context_switch_request = 1;
+    }
+}
 #endif
 
 int __attribute__((used)) sched_run(void)
@@ -123,6 +183,21 @@ int __attribute__((used)) sched_run(void)
     }
 #endif
 
+#ifdef MODULE_SCHED_ROUND_ROBIN
+    /* start a new time slice if other threads wait at the same priority,
+     * a thread returning from preemption continues its pending one */
+    if (_rr_contended(next_thread->priority)) {
+        if (!_rr_armed || (_rr_thread != next_thread)) {
+            _rr_arm(next_thread);
+        }
+    }
+    else if (_rr_armed && (_rr_thread == next_thread)) {
+        /* the thread is alone at its priority now */
+        _rr_armed = 0;
+        xtimer_remove(&_rr_timer);
+    }
+#endif
+
     next_thread->status = STATUS_RUNNING;
     sched_active_pid = next_thread->pid;
     sched_active_thread = (volatile thread_t *) next_thread;
@@ -150,6 +225,26 @@ void sched_set_status(thread_t *process, thread_status_t status)
                   process->pid, process->priority);
             clist_rpush(&sched_runqueues[process->priority], &(process->rq_entry));
             runqueue_bitcache |= 1 << process->priority;
+
+#ifdef MODULE_SCHEDSTATISTICS
+            if (_schedstat_running) {
+                schedstat_t *stat = &sched_pidlist[process->pid];
+                stat->readystart = xtimer_now().ticks32;
+                stat->waking = 1;
+            }
+#endif
+
+#ifdef MODULE_SCHED_ROUND_ROBIN
+            thread_t *active_thread = (thread_t *)sched_active_thread;
+
+            /* the running thread now shares its priority, so its time
+             * slice starts */
+            if (!_rr_armed && active_thread &&
+                (active_thread->status == STATUS_RUNNING) &&
+                (active_thread->priority == process->priority)) {
+                _rr_arm(active_thread);
+            }
+#endif
         }
     }
     else {
@@ -167,6 +262,38 @@ void sched_set_status(thread_t *process, thread_status_t status)
     process->status = status;
 }
 
+void sched_change_priority(thread_t *thread, uint8_t priority)
+{
+    unsigned irqstate = irq_disable();
+    uint8_t old_priority = thread->priority;
+
+    if (old_priority == priority) {
+        irq_restore(irqstate);
+        return;
+    }
+
+    DEBUG("sched_change_priority: thread %" PRIkernel_pid ": %" PRIu8
+          " -> %" PRIu8 "\n", thread->pid, old_priority, priority);
+
+    if (thread->status >= STATUS_ON_RUNQUEUE) {
+        clist_remove(&sched_runqueues[old_priority], &thread->rq_entry);
+        if (!sched_runqueues[old_priority].next) {
+            runqueue_bitcache &= ~(1 << old_priority);
+        }
+        /* the running thread stays the head of its runqueue */
+        if (thread == sched_active_thread) {
+            clist_lpush(&sched_runqueues[priority], &thread->rq_entry);
+        }
+        else {
+            clist_rpush(&sched_runqueues[priority], &thread->rq_entry);
+        }
+        runqueue_bitcache |= 1 << priority;
+    }
+    thread->priority = priority;
+
+    irq_restore(irqstate);
+}
+
 void sched_switch(uint16_t other_prio)
 {
     thread_t *active_thread = (thread_t *) sched_active_thread;
@@ -200,6 +327,16 @@ NORETURN void sched_task_exit(void)
     sched_threads[sched_active_pid] = NULL;
     sched_num_threads--;
 
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    mutex_owner_exit();
+#endif
+
+#ifdef MODULE_SCHED_EXIT_CB
+    if (sched_exit_cb) {
+        sched_exit_cb(sched_active_pid);
+    }
+#endif
+
     sched_set_status((thread_t *)sched_active_thread, STATUS_STOPPED);
 
     sched_active_thread = NULL;
@@ -213,7 +350,46 @@ void sched_register_cb(void (*callback)(kernel_pid_t, kernel_pid_t))
 }
 #endif
 
+#ifdef MODULE_SCHED_EXIT_CB
+void sched_register_exit_cb(void (*callback)(kernel_pid_t))
+{
+    sched_exit_cb = callback;
+}
+#endif
+
+#ifdef MODULE_SCHED_ROUND_ROBIN
+void sched_set_quantum(kernel_pid_t pid, uint32_t quantum)
+{
+    unsigned state = irq_disable();
+    thread_t *thread = (thread_t *)sched_threads[pid];
+
+    if (thread) {
+        thread->quantum = quantum;
+    }
+    irq_restore(state);
+}
+#endif
+
 #ifdef MODULE_SCHEDSTATISTICS
+static void _statistics_latency(schedstat_t *stat, uint32_t now)
+{
+    uint32_t latency = now - stat->readystart;
+    uint32_t bound = _xtimer_usec_from_ticks(latency) >>
+                     SCHEDSTATISTICS_LATENCY_SHIFT;
+    unsigned bucket = bound ? bitarithm_msb(bound) + 1 : 0;
+
+    if (bucket >= SCHEDSTATISTICS_LATENCY_BUCKETS) {
+        bucket = SCHEDSTATISTICS_LATENCY_BUCKETS - 1;
+    }
+    if (stat->latency[bucket] < UINT16_MAX) {
+        stat->latency[bucket]++;
+    }
+    if (latency > stat->latency_max) {
+        stat->latency_max = latency;
+    }
+    stat->waking = 0;
+}
+
 void sched_statistics_cb(kernel_pid_t active_thread, kernel_pid_t next_thread)
 {
     uint32_t now = xtimer_now().ticks32;
@@ -223,10 +399,30 @@ void sched_statistics_cb(kernel_pid_t active_thread, kernel_pid_t next_thread)
     schedstat_t *active_stat = &sched_pidlist[active_thread];
     active_stat->runtime_ticks += now - active_stat->laststart;
 
+    /* sched_run() already moved a still runnable thread to pending, any
+     * other state means it blocked or exited on its own */
+    thread_t *active = (thread_t *)sched_threads[active_thread];
+    if (active && (active->status == STATUS_PENDING)) {
+        active_stat->involuntary++;
+    }
+    else {
+        active_stat->voluntary++;
+    }
+
     /* Update next_thread stats */
     schedstat_t *next_stat = &sched_pidlist[next_thread];
     next_stat->laststart = now;
     next_stat->schedules++;
+    if (next_stat->waking) {
+        _statistics_latency(next_stat, now);
+    }
+
+    /* the context of the next thread is saved on its stack, so its stack
+     * pointer marks how deep it went when it was switched out */
+    uintptr_t sp = (uintptr_t)sched_threads[next_thread]->sp;
+    if (!next_stat->sp_min || (sp < next_stat->sp_min)) {
+        next_stat->sp_min = sp;
+    }
 }
 
 void init_schedstatistics(void)
@@ -236,6 +432,51 @@ void init_schedstatistics(void)
     schedstat_t *active_stat = &sched_pidlist[sched_active_pid];
     active_stat->laststart = xtimer_now().ticks32;
     active_stat->schedules = 1;
+    _schedstat_running = 1;
     sched_register_cb(sched_statistics_cb);
 }
+
+int sched_statistics_snapshot(kernel_pid_t pid, schedstat_snapshot_t *snapshot)
+{
+    if (!pid_is_valid(pid)) {
+        return -EINVAL;
+    }
+
+    unsigned state = irq_disable();
+    thread_t *thread = (thread_t *)sched_threads[pid];
+
+    if (!thread) {
+        irq_restore(state);
+        return -EINVAL;
+    }
+
+    schedstat_t stat = sched_pidlist[pid];
+    if (pid == sched_active_pid) {
+        stat.runtime_ticks += xtimer_now().ticks32 - stat.laststart;
+    }
+#ifdef DEVELHELP
+    uintptr_t stack_end = (uintptr_t)thread->stack_start + thread->stack_size;
+#endif
+    irq_restore(state);
+
+    snapshot->runtime_us = _xtimer_usec_from_ticks64(stat.runtime_ticks);
+    snapshot->schedules = stat.schedules;
+    snapshot->voluntary = stat.voluntary;
+    snapshot->involuntary = stat.involuntary;
+    snapshot->latency_max_us = _xtimer_usec_from_ticks(stat.latency_max);
+    memcpy(snapshot->latency, stat.latency, sizeof(snapshot->latency));
+    snapshot->stack_peak = 0;
+#ifdef DEVELHELP
+    if (stat.sp_min && (stat.sp_min < stack_end)) {
+        snapshot->stack_peak = stack_end - stat.sp_min;
+    }
+#endif
+#ifdef MODULE_IRQ_STATS
+    snapshot->irq_off_us = irq_stats_thread_us(pid);
+#else
+    snapshot->irq_off_us = 0;
+#endif
+
+    return 0;
+}
 #endif
@@ -20,6 +20,7 @@
 
 #include <errno.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "assert.h"
 #include "thread.h"
@@ -226,14 +227,32 @@ kernel_pid_t thread_create(char *stack, int stacksize, uint8_t priority, int fla
     thread->priority = priority;
     thread->status = STATUS_STOPPED;
 
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    thread->base_priority = priority;
+    thread->mutex_blocked = NULL;
+    thread->mutex_held = NULL;
+#endif
+
     thread->rq_entry.next = NULL;
 
+#ifdef MODULE_SCHED_ROUND_ROBIN
+    thread->quantum = 0;
+#endif
+
 #ifdef MODULE_CORE_MSG
     thread->wait_data = NULL;
     thread->msg_waiters.next = NULL;
     cib_init(&(thread->msg_queue), 0);
     thread->msg_array = NULL;
 #endif
+#ifdef MODULE_CORE_MSG_MPSC
+    thread->msg_overflows = 0;
+#endif
+
+#ifdef MODULE_SCHEDSTATISTICS
+    /* a recycled pid starts with fresh statistics */
+    memset(&sched_pidlist[pid], 0, sizeof(schedstat_t));
+#endif
 
     sched_num_threads++;
 
@@ -22,6 +22,41 @@
 #include "irq.h"
 #include "cpu.h"
 
+/* the cycle counter is only available on ARMv7-M and up */
+#if defined(MODULE_IRQ_STATS) && defined(DWT_CTRL_CYCCNTENA_Msk)
+#include "irq_stats.h"
+#include "periph_conf.h"
+
+#define IRQ_STATS_HOOKS     (1)
+
+uint32_t irq_stats_now(void)
+{
+    if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    return DWT->CYCCNT;
+}
+
+uint32_t irq_stats_ticks_per_us(void)
+{
+    return CLOCK_CORECLOCK / 1000000U;
+}
+#elif defined(MODULE_IRQ_STATS)
+#include "irq_stats.h"
+
+uint32_t irq_stats_now(void)
+{
+    return 0;
+}
+
+uint32_t irq_stats_ticks_per_us(void)
+{
+    return 1;
+}
+#endif
+
 /**
  * @brief Disable all maskable interrupts
  */
@@ -29,6 +64,11 @@ unsigned int irq_disable(void)
 {
     uint32_t mask = __get_PRIMASK();
     __disable_irq();
+#ifdef IRQ_STATS_HOOKS
+    if (!mask) {
+        irq_stats_begin(__builtin_return_address(0));
+    }
+#endif
     return mask;
 }
 
@@ -37,6 +77,11 @@ unsigned int irq_disable(void)
  */
 __attribute__((used)) unsigned int irq_enable(void)
 {
+#ifdef IRQ_STATS_HOOKS
+    if (__get_PRIMASK()) {
+        irq_stats_end();
+    }
+#endif
     __enable_irq();
     return __get_PRIMASK();
 }
@@ -46,6 +91,11 @@ __attribute__((used)) unsigned int irq_enable(void)
  */
 void irq_restore(unsigned int state)
 {
+#ifdef IRQ_STATS_HOOKS
+    if (!state && __get_PRIMASK()) {
+        irq_stats_end();
+    }
+#endif
     __set_PRIMASK(state);
 }
 
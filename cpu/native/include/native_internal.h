@@ -79,6 +79,7 @@ void _native_init_syscalls(void);
  * external functions regularly wrapped in native for direct use
  */
 extern ssize_t (*real_read)(int fd, void *buf, size_t count);
+extern ssize_t (*real_readv)(int fd, const struct iovec *iov, int iovcnt);
 extern ssize_t (*real_write)(int fd, const void *buf, size_t count);
 extern size_t (*real_fread)(void *ptr, size_t size, size_t nmemb, FILE *stream);
 extern void (*real_clearerr)(FILE *stream);
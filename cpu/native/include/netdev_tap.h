@@ -44,6 +44,9 @@ typedef struct netdev_tap {
     int tap_fd;                         /**< host file descriptor for the TAP */
     uint8_t addr[ETHERNET_ADDR_LEN];    /**< The MAC address of the TAP */
     uint8_t promiscous;                 /**< Flag for promiscous mode */
+    uint8_t csum_verified;              /**< Flag to pass received packets up
+                                             as having valid upper layer
+                                             checksums */
 } netdev_tap_t;
 
 /**
@@ -40,6 +40,11 @@
 
 #include "native_internal.h"
 
+#ifdef MODULE_IRQ_STATS
+#include <time.h>
+#include "irq_stats.h"
+#endif
+
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
@@ -146,6 +151,27 @@ void native_print_signals(void)
 /**
  * block signals
  */
+#ifdef MODULE_IRQ_STATS
+uint32_t irq_stats_now(void)
+{
+    struct timespec ts;
+
+    if (real_clock_gettime == NULL) {
+        /* interrupts are toggled before the syscalls got resolved */
+        return 0;
+    }
+    real_clock_gettime(CLOCK_MONOTONIC, &ts);
+    /* nanoseconds, wraps every 4.29 s, which is plenty for section
+     * durations */
+    return (uint32_t)ts.tv_sec * 1000000000U + ts.tv_nsec;
+}
+
+uint32_t irq_stats_ticks_per_us(void)
+{
+    return 1000U;
+}
+#endif
+
 unsigned irq_disable(void)
 {
     unsigned int prev_state;
@@ -164,6 +190,12 @@ unsigned irq_disable(void)
     prev_state = native_interrupts_enabled;
     native_interrupts_enabled = 0;
 
+#ifdef MODULE_IRQ_STATS
+    if (prev_state) {
+        irq_stats_begin(__builtin_return_address(0));
+    }
+#endif
+
     DEBUG("irq_disable(): return\n");
     _native_syscall_leave();
 
@@ -193,6 +225,11 @@ unsigned irq_enable(void)
      */
 
     prev_state = native_interrupts_enabled;
+#ifdef MODULE_IRQ_STATS
+    if (!prev_state) {
+        irq_stats_end();
+    }
+#endif
     native_interrupts_enabled = 1;
 
     if (sigprocmask(SIG_SETMASK, &_native_sig_set, NULL) == -1) {
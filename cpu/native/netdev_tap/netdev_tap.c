@@ -68,6 +68,7 @@
 static int _init(netdev_t *netdev);
 static int _send(netdev_t *netdev, const iolist_t *iolist);
 static int _recv(netdev_t *netdev, void *buf, size_t n, void *info);
+static int _recv_iolist(netdev_t *netdev, const iolist_t *iolist, void *info);
 
 static inline void _get_mac_addr(netdev_t *netdev, uint8_t *dst)
 {
@@ -124,6 +125,12 @@ static int _get(netdev_t *dev, netopt_t opt, void *value, size_t max_len)
             *((bool*)value) = (bool)_get_promiscous(dev);
             res = sizeof(bool);
             break;
+        case NETOPT_RX_CSUM_VERIFIED:
+            assert(max_len >= sizeof(netopt_enable_t));
+            *((netopt_enable_t *)value) = (((netdev_tap_t *)dev)->csum_verified) ?
+                                          NETOPT_ENABLE : NETOPT_DISABLE;
+            res = sizeof(netopt_enable_t);
+            break;
         default:
             res = netdev_eth_get(dev, opt, value, max_len);
             break;
@@ -147,6 +154,13 @@ static int _set(netdev_t *dev, netopt_t opt, const void *value, size_t value_len
             _set_promiscous(dev, ((const bool *)value)[0]);
             res = sizeof(netopt_enable_t);
             break;
+        case NETOPT_RX_CSUM_VERIFIED:
+            /* the host's stack calculated the checksums itself and there is
+             * no medium in between to corrupt the frames */
+            ((netdev_tap_t *)dev)->csum_verified =
+                (*((const netopt_enable_t *)value) == NETOPT_ENABLE);
+            res = sizeof(netopt_enable_t);
+            break;
         default:
             res = netdev_eth_set(dev, opt, value, value_len);
             break;
@@ -158,6 +172,7 @@ static int _set(netdev_t *dev, netopt_t opt, const void *value, size_t value_len
 static const netdev_driver_t netdev_driver_tap = {
     .send = _send,
     .recv = _recv,
+    .recv_iolist = _recv_iolist,
     .init = _init,
     .isr = _isr,
     .get = _get,
@@ -234,18 +249,59 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
         return ETHERNET_FRAME_LEN;
     }
 
-    int nread = real_read(dev->tap_fd, buf, len);
+    iolist_t iolist = {
+        .iol_base = buf,
+        .iol_len = len,
+    };
+
+    return _recv_iolist(netdev, &iolist, info);
+}
+
+static int _recv_iolist(netdev_t *netdev, const iolist_t *iolist, void *info)
+{
+    netdev_tap_t *dev = (netdev_tap_t*)netdev;
+    /* one more byte than requested tells a truncated frame, the kernel drops
+     * the rest of it */
+    struct iovec iov[iolist_count(iolist) + 1];
+    uint8_t excess;
+    unsigned n;
+    (void)info;
+
+    size_t size = iolist_to_iovec(iolist, iov, &n);
+    iov[n].iov_base = &excess;
+    iov[n].iov_len = sizeof(excess);
+
+    int nread = real_readv(dev->tap_fd, iov, n + 1);
     DEBUG("netdev_tap: read %d bytes\n", nread);
 
+    if ((nread > 0) && ((size_t)nread > size)) {
+        DEBUG("netdev_tap: frame larger than %u bytes => Dropped\n",
+              (unsigned)size);
+        _continue_reading(dev);
+
+        return -ENOBUFS;
+    }
     if (nread > 0) {
-        ethernet_hdr_t *hdr = (ethernet_hdr_t *)buf;
-        if (!(dev->promiscous) && !_is_addr_multicast(hdr->dst) &&
-            !_is_addr_broadcast(hdr->dst) &&
-            (memcmp(hdr->dst, dev->addr, ETHERNET_ADDR_LEN) != 0)) {
+        uint8_t dst[ETHERNET_ADDR_LEN];
+        size_t got = 0;
+
+        /* the destination address may be split over several buffers */
+        for (const iolist_t *iol = iolist; iol && (got < sizeof(dst));
+             iol = iol->iol_next) {
+            size_t part = sizeof(dst) - got;
+
+            if (part > iol->iol_len) {
+                part = iol->iol_len;
+            }
+            memcpy(&dst[got], iol->iol_base, part);
+            got += part;
+        }
+        if (!(dev->promiscous) && !_is_addr_multicast(dst) &&
+            !_is_addr_broadcast(dst) &&
+            (memcmp(dst, dev->addr, ETHERNET_ADDR_LEN) != 0)) {
             DEBUG("netdev_tap: received for %02x:%02x:%02x:%02x:%02x:%02x\n"
                   "That's not me => Dropped\n",
-                  hdr->dst[0], hdr->dst[1], hdr->dst[2],
-                  hdr->dst[3], hdr->dst[4], hdr->dst[5]);
+                  dst[0], dst[1], dst[2], dst[3], dst[4], dst[5]);
 
             native_async_read_continue(dev->tap_fd);
 
@@ -333,6 +389,7 @@ static int _init(netdev_t *netdev)
 #endif
     /* initialize device descriptor */
     dev->promiscous = 0;
+    dev->csum_verified = 0;
     /* implicitly create the tap interface */
     if ((dev->tap_fd = real_open(clonedev, O_RDWR | O_NONBLOCK)) == -1) {
         err(EXIT_FAILURE, "open(%s)", clonedev);
@@ -49,6 +49,7 @@
 #include "debug.h"
 
 ssize_t (*real_read)(int fd, void *buf, size_t count);
+ssize_t (*real_readv)(int fd, const struct iovec *iov, int iovcnt);
 ssize_t (*real_write)(int fd, const void *buf, size_t count);
 size_t (*real_fread)(void *ptr, size_t size, size_t nmemb, FILE *stream);
 void (*real_clearerr)(FILE *stream);
@@ -440,6 +441,7 @@ int _gettimeofday(struct timeval *tp, void *restrict tzp)
 void _native_init_syscalls(void)
 {
     *(void **)(&real_read) = dlsym(RTLD_NEXT, "read");
+    *(void **)(&real_readv) = dlsym(RTLD_NEXT, "readv");
     *(void **)(&real_write) = dlsym(RTLD_NEXT, "write");
     *(void **)(&real_malloc) = dlsym(RTLD_NEXT, "malloc");
     *(void **)(&real_calloc) = dlsym(RTLD_NEXT, "calloc");
@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_native
+ * @{
+ *
+ * @file
+ * @brief       Host thread backend of the thread pool
+ *
+ * RIOT runs all its threads on a single host thread. Jobs of a host backed
+ * pool run on additional host threads instead, which never execute RIOT
+ * code: they take jobs from the pool queue under a host mutex and report
+ * finished jobs back with a signal, whose handler then releases the RIOT
+ * threads waiting for them.
+ *
+ * RIOT code only takes the host mutex with interrupts disabled, so no RIOT
+ * context switch can happen while it is held.
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ * @}
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+
+#include "irq.h"
+#include "native_internal.h"
+#include "tpool.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/**
+ * @brief   Signal the host threads report finished jobs with
+ */
+#ifndef TPOOL_HOST_SIGNAL
+#define TPOOL_HOST_SIGNAL   (SIGUSR2)
+#endif
+
+static pthread_mutex_t _lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t _avail = PTHREAD_COND_INITIALIZER;
+static pthread_t _riot;
+static tpool_t *_pool;
+static clist_node_t _finished;
+
+void tpool_host_submit(tpool_t *pool, tpool_job_t *job);
+int tpool_host_cancel(tpool_t *pool, tpool_job_t *job);
+
+static void *_host_worker(void *arg)
+{
+    tpool_t *pool = arg;
+
+    while (1) {
+        clist_node_t *node;
+
+        pthread_mutex_lock(&_lock);
+        while ((node = clist_lpop(&pool->queue)) == NULL) {
+            pthread_cond_wait(&_avail, &_lock);
+        }
+        tpool_job_t *job = container_of(node, tpool_job_t, node);
+        job->state = TPOOL_JOB_RUNNING;
+        pthread_mutex_unlock(&_lock);
+
+        job->fn(job->arg);
+
+        pthread_mutex_lock(&_lock);
+        clist_rpush(&_finished, &job->node);
+        pthread_mutex_unlock(&_lock);
+
+        pthread_kill(_riot, TPOOL_HOST_SIGNAL);
+    }
+
+    return NULL;
+}
+
+static void _finished_isr(void)
+{
+    clist_node_t *node;
+
+    pthread_mutex_lock(&_lock);
+    while ((node = clist_lpop(&_finished)) != NULL) {
+        tpool_job_t *job = container_of(node, tpool_job_t, node);
+        DEBUG("tpool_pthread: job %p finished\n", (void *)job);
+        /* in interrupt context, so no thread sees the job done before it
+         * left _finished and got released */
+        mutex_unlock(&job->done);
+        job->state = TPOOL_JOB_DONE;
+    }
+    pthread_mutex_unlock(&_lock);
+}
+
+int tpool_start_host(tpool_t *pool, unsigned n)
+{
+    if (_pool && (_pool != pool)) {
+        return -EALREADY;
+    }
+
+    unsigned state = irq_disable();
+    sigset_t all, old;
+    unsigned started = 0;
+
+    if (!_pool) {
+        _pool = pool;
+        _riot = pthread_self();
+        pool->host = true;
+        register_interrupt(TPOOL_HOST_SIGNAL, _finished_isr);
+    }
+
+    /* host workers inherit the signal mask, RIOT's signals must only ever
+     * be delivered to the host thread running RIOT */
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &old);
+    for (unsigned i = 0; i < n; i++) {
+        pthread_t thread;
+
+        if (pthread_create(&thread, NULL, _host_worker, pool) != 0) {
+            break;
+        }
+        pthread_detach(thread);
+        started++;
+    }
+    pthread_sigmask(SIG_SETMASK, &old, NULL);
+
+    irq_restore(state);
+
+    return started;
+}
+
+void tpool_host_submit(tpool_t *pool, tpool_job_t *job)
+{
+    unsigned state = irq_disable();
+
+    pthread_mutex_lock(&_lock);
+    clist_rpush(&pool->queue, &job->node);
+    pthread_cond_signal(&_avail);
+    pthread_mutex_unlock(&_lock);
+
+    irq_restore(state);
+}
+
+int tpool_host_cancel(tpool_t *pool, tpool_job_t *job)
+{
+    int res = -EBUSY;
+    unsigned state = irq_disable();
+
+    pthread_mutex_lock(&_lock);
+    if (job->state == TPOOL_JOB_QUEUED) {
+        clist_remove(&pool->queue, &job->node);
+        job->state = TPOOL_JOB_CANCELLED;
+        res = 0;
+    }
+    pthread_mutex_unlock(&_lock);
+
+    if (res == 0) {
+        mutex_unlock(&job->done);
+    }
+    irq_restore(state);
+
+    return res;
+}
@@ -44,6 +44,7 @@
 
 static int _send(netdev_t *netdev, const iolist_t *iolist);
 static int _recv(netdev_t *netdev, void *buf, size_t len, void *info);
+static int _recv_iolist(netdev_t *netdev, const iolist_t *iolist, void *info);
 static int _init(netdev_t *netdev);
 static void _isr(netdev_t *netdev);
 static int _get(netdev_t *netdev, netopt_t opt, void *val, size_t max_len);
@@ -52,6 +53,7 @@ static int _set(netdev_t *netdev, netopt_t opt, const void *val, size_t len);
 const netdev_driver_t at86rf2xx_driver = {
     .send = _send,
     .recv = _recv,
+    .recv_iolist = _recv_iolist,
     .init = _init,
     .isr = _isr,
     .get = _get,
@@ -129,9 +131,11 @@ static int _send(netdev_t *netdev, const iolist_t *iolist)
     return (int)len;
 }
 
-static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
+/* reads the frame into iolist, just returns its size or drops it (if
+ * len > 0) if iolist is NULL */
+static int _recv_frame(at86rf2xx_t *dev, const iolist_t *iolist, size_t len,
+                       void *info)
 {
-    at86rf2xx_t *dev = (at86rf2xx_t *)netdev;
     uint8_t phr;
     size_t pkt_len;
 
@@ -148,8 +152,8 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
     /* ignore MSB (refer p.80) and substract length of FCS field */
     pkt_len = (phr & 0x7f) - 2;
 
-    /* return length when buf == NULL */
-    if (buf == NULL) {
+    /* return length when iolist == NULL */
+    if (iolist == NULL) {
         /* release SPI bus */
         at86rf2xx_fb_stop(dev);
 
@@ -171,8 +175,16 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
         at86rf2xx_set_state(dev, dev->idle_state);
         return -ENOBUFS;
     }
-    /* copy payload */
-    at86rf2xx_fb_read(dev, (uint8_t *)buf, pkt_len);
+    /* copy payload, consecutive reads continue in the frame buffer */
+    size_t left = pkt_len;
+    for (const iolist_t *iol = iolist; left > 0; iol = iol->iol_next) {
+        size_t part = (iol->iol_len < left) ? iol->iol_len : left;
+
+        if (part > 0) {
+            at86rf2xx_fb_read(dev, iol->iol_base, part);
+            left -= part;
+        }
+    }
 
     /* Ignore FCS but advance fb read - we must give a temporary buffer here,
      * as we are not allowed to issue SPI transfers without any buffer */
@@ -224,6 +236,23 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
     return pkt_len;
 }
 
+static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
+{
+    iolist_t iolist = {
+        .iol_base = buf,
+        .iol_len = len,
+    };
+
+    return _recv_frame((at86rf2xx_t *)netdev, (buf != NULL) ? &iolist : NULL,
+                       len, info);
+}
+
+static int _recv_iolist(netdev_t *netdev, const iolist_t *iolist, void *info)
+{
+    return _recv_frame((at86rf2xx_t *)netdev, iolist, iolist_size(iolist),
+                       info);
+}
+
 static int _set_state(at86rf2xx_t *dev, netopt_state_t state)
 {
     switch (state) {
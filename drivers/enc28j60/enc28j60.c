@@ -316,14 +316,14 @@ static int nd_send(netdev_t *netdev, const iolist_t *iolist)
 #define NEXT_TO_ERXRDPT(n) ((n == BUF_RX_START || n - 1 > BUF_RX_END) ? BUF_RX_END : n - 1)
 #define ERXRDPT_TO_NEXT(e) ((e >= BUF_RX_END) ? BUF_RX_START : e + 1)
 
-static int nd_recv(netdev_t *netdev, void *buf, size_t max_len, void *info)
+/* reads the frame into iolist, just returns its size or drops it (if
+ * max_len != 0) if iolist is NULL */
+static int _recv(enc28j60_t *dev, const iolist_t *iolist, size_t max_len)
 {
-    enc28j60_t *dev = (enc28j60_t *)netdev;
     uint8_t head[6];
     uint16_t size;
     uint16_t next;
 
-    (void)info;
     mutex_lock(&dev->lock);
 
     /* set read pointer to RX read address */
@@ -335,13 +335,23 @@ static int nd_recv(netdev_t *netdev, void *buf, size_t max_len, void *info)
     next = (uint16_t)((head[1] << 8) | head[0]);
     size = (uint16_t)((head[3] << 8) | head[2]) - 4;  /* discard CRC */
 
-    DEBUG("[enc28j60] recv: size=%i next=%i buf=%p len=%d\n",
-          (int)size, (int)next, buf, max_len);
+    DEBUG("[enc28j60] recv: size=%i next=%i iolist=%p len=%d\n",
+          (int)size, (int)next, (void *)iolist, max_len);
 
-    if (buf != NULL) {
-        /* read packet content into the supplied buffer */
+    if (iolist != NULL) {
+        /* read packet content into the supplied buffers, the read pointer
+         * advances with every transfer */
         if (size <= max_len) {
-            cmd_rbm(dev, (uint8_t *)buf, size);
+            size_t left = size;
+
+            for (const iolist_t *iol = iolist; left > 0; iol = iol->iol_next) {
+                size_t part = (iol->iol_len < left) ? iol->iol_len : left;
+
+                if (part > 0) {
+                    cmd_rbm(dev, iol->iol_base, part);
+                    left -= part;
+                }
+            }
         } else {
             DEBUG("[enc28j60] recv: unable to get packet - buffer too small\n");
             size = 0;
@@ -361,6 +371,23 @@ static int nd_recv(netdev_t *netdev, void *buf, size_t max_len, void *info)
     return (int)size;
 }
 
+static int nd_recv(netdev_t *netdev, void *buf, size_t max_len, void *info)
+{
+    iolist_t iolist = {
+        .iol_base = buf,
+        .iol_len = max_len,
+    };
+
+    (void)info;
+    return _recv((enc28j60_t *)netdev, (buf != NULL) ? &iolist : NULL, max_len);
+}
+
+static int nd_recv_iolist(netdev_t *netdev, const iolist_t *iolist, void *info)
+{
+    (void)info;
+    return _recv((enc28j60_t *)netdev, iolist, iolist_size(iolist));
+}
+
 static int nd_init(netdev_t *netdev)
 {
     enc28j60_t *dev = (enc28j60_t *)netdev;
@@ -536,6 +563,7 @@ static int nd_set(netdev_t *netdev, netopt_t opt, const void *value, size_t valu
 static const netdev_driver_t netdev_driver_enc28j60 = {
     .send = nd_send,
     .recv = nd_recv,
+    .recv_iolist = nd_recv_iolist,
     .init = nd_init,
     .isr = nd_isr,
     .get = nd_get,
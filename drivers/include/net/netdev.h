@@ -427,6 +427,34 @@ typedef struct netdev_driver {
      */
     int (*set)(netdev_t *dev, netopt_t opt,
                const void *value, size_t value_len);
+
+    /**
+     * @brief   Get a received frame scattered over several buffers
+     *
+     * @pre `(dev != NULL) && (iolist != NULL)`
+     *
+     * Optional, NULL if not supported by the driver. Behaves like
+     * @ref netdev_driver_t::recv "recv()" with a buffer given, but fills the
+     * elements of @p iolist one after another. This allows e.g. to read the
+     * link layer header into a buffer of its own and the payload directly
+     * into the buffer it is handed upwards in, without moving it afterwards.
+     * Use @ref netdev_driver_t::recv "recv()" to get the size of the frame
+     * or to drop it.
+     *
+     * If the received frame is larger than all elements of @p iolist
+     * together, it is dropped and `-ENOBUFS` is returned.
+     *
+     * @param[in]   dev     network device descriptor. Must not be NULL.
+     * @param[out]  iolist  buffers to write into. Elements may have
+     *                      iolist_t::iol_len == 0.
+     * @param[out]  info    status information for the received packet. Might
+     *                      be of different type for different netdev devices.
+     *                      May be NULL if not needed or applicable.
+     *
+     * @return `-ENOBUFS` if the supplied buffers are too small
+     * @return number of bytes read
+     */
+    int (*recv_iolist)(netdev_t *dev, const iolist_t *iolist, void *info);
 } netdev_driver_t;
 
 /**
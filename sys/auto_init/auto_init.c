@@ -96,6 +96,10 @@
 #include "sched.h"
 #endif
 
+#ifdef MODULE_SOFTIRQ
+#include "softirq.h"
+#endif
+
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
@@ -112,6 +116,10 @@ void auto_init(void)
 #ifdef MODULE_SCHEDSTATISTICS
     init_schedstatistics();
 #endif
+#ifdef MODULE_SOFTIRQ
+    DEBUG("Auto init softirq module.\n");
+    softirq_init();
+#endif
 #ifdef MODULE_MCI
     DEBUG("Auto init mci module.\n");
     mci_initialize();
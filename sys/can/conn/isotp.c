@@ -177,7 +177,7 @@ int conn_can_isotp_send(conn_can_isotp_t *conn, const void *buf, size_t size, in
         return isotp_send(&conn->isotp, buf, size, flags);
     }
     else {
-        xtimer_t timer;
+        xtimer_t timer = { 0 };
         timer.callback = _tx_conf_timeout;
         timer.arg = conn;
         xtimer_set(&timer, CONN_CAN_ISOTP_TIMEOUT_TX_CONF);
@@ -254,7 +254,7 @@ int conn_can_isotp_recv(conn_can_isotp_t *conn, void *buf, size_t size, uint32_t
     }
 #endif
 
-    xtimer_t timer;
+    xtimer_t timer = { 0 };
     if (timeout != 0) {
         timer.callback = _rx_timeout;
         timer.arg = conn;
@@ -391,7 +391,7 @@ int conn_can_isotp_select(conn_can_isotp_slave_t **conn, conn_can_isotp_t *maste
 
     int ret;
 
-    xtimer_t timer;
+    xtimer_t timer = { 0 };
     if (timeout != 0) {
         timer.callback = _rx_timeout;
         timer.arg = master;
@@ -96,21 +96,50 @@ event_t *event_get(event_queue_t *queue)
     return result;
 }
 
+static event_t *_pop_multi(event_queue_t *queues, size_t n_queues,
+                           size_t *index)
+{
+    event_t *result = NULL;
+    unsigned state = irq_disable();
+
+    for (size_t i = 0; i < n_queues; i++) {
+        result = (event_t *)clist_lpop(&queues[i].event_list);
+        if (result) {
+            *index = i;
+            break;
+        }
+    }
+    irq_restore(state);
+
+    if (result) {
+        result->list_node.next = NULL;
+    }
+    return result;
+}
+
+event_t *event_get_multi(event_queue_t *queues, size_t n_queues)
+{
+    assert(queues && n_queues);
+    size_t index;
+
+    return _pop_multi(queues, n_queues, &index);
+}
+
 event_t *event_wait(event_queue_t *queue)
 {
-    assert(queue);
+    return event_wait_multi(queue, 1);
+}
+
+event_t *event_wait_multi(event_queue_t *queues, size_t n_queues)
+{
+    assert(queues && n_queues);
     event_t *result;
+    size_t index;
 
-    do {
-        unsigned state = irq_disable();
-        result = (event_t *)clist_lpop(&queue->event_list);
-        irq_restore(state);
-        if (result == NULL) {
-            thread_flags_wait_any(THREAD_FLAG_EVENT);
-        }
-    } while (result == NULL);
+    while ((result = _pop_multi(queues, n_queues, &index)) == NULL) {
+        thread_flags_wait_any(THREAD_FLAG_EVENT);
+    }
 
-    result->list_node.next = NULL;
     return result;
 }
 
@@ -119,12 +148,13 @@ event_t *event_wait_timeout(event_queue_t *queue, uint32_t timeout)
 {
     assert(queue);
     event_t *result;
-    xtimer_t timer;
+    xtimer_t timer = { 0 };
     thread_flags_t flags = 0;
+    size_t index;
 
     xtimer_set_timeout_flag(&timer, timeout);
     do {
-        result = event_get(queue);
+        result = _pop_multi(queue, 1, &index);
         if (result == NULL) {
             flags = thread_flags_wait_any(THREAD_FLAG_EVENT | THREAD_FLAG_TIMEOUT);
         }
@@ -138,6 +168,46 @@ event_t *event_wait_timeout(event_queue_t *queue, uint32_t timeout)
 }
 #endif
 
+event_select_source_t event_select(const event_select_t *sel,
+                                   event_select_res_t *res)
+{
+    assert(sel && res);
+    assert(!(sel->flags & (THREAD_FLAG_EVENT | THREAD_FLAG_MSG_WAITING)));
+
+    thread_flags_t mask = THREAD_FLAG_EVENT | sel->flags;
+    thread_flags_t pending = 0;
+
+#ifdef MODULE_CORE_MSG
+    if (sel->msg) {
+        mask |= THREAD_FLAG_MSG_WAITING;
+    }
+#endif
+
+    while (1) {
+        /* every source is polled before going to sleep, so a flag consumed
+         * by the wait below never hides a pending event or message */
+        res->event = _pop_multi(sel->queues, sel->n_queues, &res->queue);
+        if (res->event) {
+            if (pending) {
+                /* hand the flags back for the next call */
+                thread_flags_set((thread_t *)sched_active_thread, pending);
+            }
+            return EVENT_SELECT_EVENT;
+        }
+        pending |= thread_flags_clear(sel->flags);
+        if (pending) {
+            res->flags = pending;
+            return EVENT_SELECT_FLAGS;
+        }
+#ifdef MODULE_CORE_MSG
+        if (sel->msg && (msg_try_receive(sel->msg) == 1)) {
+            return EVENT_SELECT_MSG;
+        }
+#endif
+        pending = thread_flags_wait_any(mask) & sel->flags;
+    }
+}
+
 void event_loop(event_queue_t *queue)
 {
     event_t *event;
@@ -146,3 +216,12 @@ void event_loop(event_queue_t *queue)
         event->handler(event);
     }
 }
+
+void event_loop_multi(event_queue_t *queues, size_t n_queues)
+{
+    event_t *event;
+
+    while ((event = event_wait_multi(queues, n_queues))) {
+        event->handler(event);
+    }
+}
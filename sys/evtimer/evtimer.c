@@ -91,21 +91,50 @@ static void _del_event_from_list(evtimer_t *evtimer, evtimer_event_t *event)
     }
 }
 
-static void _set_timer(xtimer_t *timer, uint32_t offset_ms)
+static inline uint32_t _slack(const evtimer_t *evtimer)
 {
-    uint64_t offset_us = (uint64_t)offset_ms * US_PER_MS;
+#ifdef MODULE_XTIMER_SLACK
+    return evtimer->slack;
+#else
+    (void)evtimer;
+    return 0;
+#endif
+}
+
+/* time in milliseconds after the head of the list the timer is set to, i.e.
+ * offset of the latest event that is due within the slack of the head */
+static uint32_t _span(const evtimer_t *evtimer)
+{
+    uint32_t slack = _slack(evtimer);
+    uint32_t span = 0;
+
+    if (!slack) {
+        return 0;
+    }
+    for (evtimer_event_t *event = evtimer->events->next;
+         event && (event->offset <= (slack - span)); event = event->next) {
+        span += event->offset;
+    }
+    return span;
+}
+
+static void _set_timer(evtimer_t *evtimer)
+{
+    uint32_t span = _span(evtimer);
+    uint64_t offset_us = ((uint64_t)evtimer->events->offset + span) * US_PER_MS;
+    uint64_t slack_us = (uint64_t)(_slack(evtimer) - span) * US_PER_MS;
 
     DEBUG("evtimer: now=%" PRIu32 " us setting xtimer to %" PRIu32 ":%" PRIu32 " us\n",
           xtimer_now_usec(), (uint32_t)(offset_us >> 32), (uint32_t)(offset_us));
 
-    xtimer_set64(timer, offset_us);
+    xtimer_set64_slack(&evtimer->timer, offset_us,
+                       (slack_us > UINT32_MAX) ? UINT32_MAX : slack_us);
 }
 
 static void _update_timer(evtimer_t *evtimer)
 {
     if (evtimer->events) {
-        evtimer_event_t *event = evtimer->events;
-        _set_timer(&evtimer->timer, event->offset);
+        _set_timer(evtimer);
     }
     else {
         xtimer_remove(&evtimer->timer);
@@ -132,7 +161,11 @@ static void _update_head_offset(evtimer_t *evtimer)
 {
     if (evtimer->events) {
         evtimer_event_t *event = evtimer->events;
-        event->offset = _get_offset(&evtimer->timer);
+        uint32_t offset = _get_offset(&evtimer->timer);
+        uint32_t span = _span(evtimer);
+
+        /* the timer is set to the last event handled together with the head */
+        event->offset = (offset > span) ? (offset - span) : 0;
         DEBUG("evtimer: _update_head_offset(): new head offset %" PRIu32 "\n", event->offset);
     }
 }
@@ -145,8 +178,9 @@ void evtimer_add(evtimer_t *evtimer, evtimer_event_t *event)
 
     _update_head_offset(evtimer);
     _add_event_to_list(evtimer, event);
-    if (evtimer->events == event) {
-        _set_timer(&evtimer->timer, event->offset);
+    /* with slack, a new event may be handled together with the head */
+    if ((evtimer->events == event) || _slack(evtimer)) {
+        _set_timer(evtimer);
     }
     irq_restore(state);
     if (sched_context_switch_request) {
@@ -166,15 +200,21 @@ void evtimer_del(evtimer_t *evtimer, evtimer_event_t *event)
     irq_restore(state);
 }
 
-static evtimer_event_t *_get_next(evtimer_t *evtimer)
+static evtimer_event_t *_get_next(evtimer_t *evtimer, uint32_t *span)
 {
     evtimer_event_t *event = evtimer->events;
 
-    if (event && (event->offset == 0)) {
+    if (event && (event->offset <= *span)) {
+        *span -= event->offset;
         evtimer->events = event->next;
         return event;
     }
     else {
+        if (event) {
+            /* time elapsed since the handled events were due */
+            event->offset -= *span;
+            *span = 0;
+        }
         return NULL;
     }
 }
@@ -188,10 +228,11 @@ static void _evtimer_handler(void *arg)
     /* this function gets called directly by xtimer if the set xtimer expired.
      * Thus the offset of the first event is down to zero. */
     evtimer_event_t *event = evtimer->events;
+    uint32_t span = _span(evtimer);
     event->offset = 0;
 
-    /* iterate the event list */
-    while ((event = _get_next(evtimer))) {
+    /* iterate the event list, including the events due within the slack */
+    while ((event = _get_next(evtimer, &span))) {
         evtimer->callback(event);
     }
 
@@ -204,7 +245,22 @@ void evtimer_init(evtimer_t *evtimer, evtimer_callback_t handler)
     evtimer->timer.callback = _evtimer_handler;
     evtimer->timer.arg = (void *)evtimer;
     evtimer->events = NULL;
+#ifdef MODULE_XTIMER_SLACK
+    evtimer->slack = 0;
+#endif
+}
+
+#ifdef MODULE_XTIMER_SLACK
+void evtimer_set_slack(evtimer_t *evtimer, uint32_t slack)
+{
+    unsigned state = irq_disable();
+
+    _update_head_offset(evtimer);
+    evtimer->slack = slack;
+    _update_timer(evtimer);
+    irq_restore(state);
 }
+#endif
 
 void evtimer_print(const evtimer_t *evtimer)
 {
@@ -96,9 +96,11 @@
 #ifndef EVENT_H
 #define EVENT_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include "irq.h"
+#include "msg.h"
 #include "thread_flags.h"
 #include "clist.h"
 
@@ -231,6 +233,97 @@ event_t *event_get(event_queue_t *queue);
  */
 event_t *event_wait(event_queue_t *queue);
 
+/**
+ * @brief   Get next event from the first non-empty of several event queues,
+ *          non-blocking
+ *
+ * The queues are polled in array order, so a lower index means a higher
+ * priority.
+ *
+ * @param[in]   queues      array of event queues to get an event from
+ * @param[in]   n_queues    number of elements in @p queues
+ *
+ * @returns     pointer to next event
+ * @returns     NULL if no event available
+ */
+event_t *event_get_multi(event_queue_t *queues, size_t n_queues);
+
+/**
+ * @brief   Get next event from several event queues, blocking
+ *
+ * Same as event_wait(), but waits on all of @p queues at once. If several
+ * queues hold events, the one with the lowest index in @p queues wins.
+ *
+ * @pre     All queues are bound to the calling thread
+ *
+ * @param[in]   queues      array of event queues to get an event from
+ * @param[in]   n_queues    number of elements in @p queues
+ *
+ * @returns     pointer to next event
+ */
+event_t *event_wait_multi(event_queue_t *queues, size_t n_queues);
+
+/**
+ * @brief   Sources event_select() can return from
+ */
+typedef enum {
+    EVENT_SELECT_EVENT,         /**< an event was taken from a queue */
+    EVENT_SELECT_FLAGS,         /**< some of the requested thread flags were
+                                     set */
+    EVENT_SELECT_MSG,           /**< a message was received */
+} event_select_source_t;
+
+/**
+ * @brief   Set of sources a thread waits on with event_select()
+ */
+typedef struct {
+    event_queue_t *queues;      /**< event queues by descending priority */
+    size_t n_queues;            /**< number of elements in event_select_t::queues */
+    thread_flags_t flags;       /**< thread flags to wait for, must neither
+                                     contain @ref THREAD_FLAG_EVENT nor
+                                     @ref THREAD_FLAG_MSG_WAITING */
+    msg_t *msg;                 /**< buffer for a received message, NULL to
+                                     leave the message queue alone */
+} event_select_t;
+
+/**
+ * @brief   Result of event_select()
+ */
+typedef struct {
+    event_t *event;             /**< event taken from a queue */
+    size_t queue;               /**< index of the queue event_select_res_t::event
+                                     was taken from */
+    thread_flags_t flags;       /**< requested thread flags that were set */
+} event_select_res_t;
+
+/**
+ * @brief   Wait on several event queues, thread flags and the message queue
+ *          of the calling thread at once
+ *
+ * This allows a single thread to serve all sources that otherwise need a
+ * thread each, e.g. a network stack module receiving messages from its
+ * neighbours and events from a timer.
+ *
+ * Sources are served in a fixed order: the event queues in array order
+ * first, then the requested thread flags, then messages. Exactly one source
+ * is served per call, so a high priority source that keeps firing starves
+ * the ones behind it.
+ *
+ * Taking a message requires the `core_msg` module. Senders do not need
+ * the calling thread to have a message queue, as a send-blocked sender also
+ * signals @ref THREAD_FLAG_MSG_WAITING.
+ *
+ * @pre     All queues in @p sel are bound to the calling thread
+ *
+ * @param[in]   sel     sources to wait on
+ * @param[out]  res     the event or flags taken, unchanged for messages
+ *                      (which are stored in event_select_t::msg)
+ *
+ * @returns     the source @p res or event_select_t::msg was filled from
+ */
+event_select_source_t event_select(const event_select_t *sel,
+                                   event_select_res_t *res);
+
 #if defined(MODULE_XTIMER) || defined(DOXYGEN)
 /**
  * @brief   Get next event from event queue, blocking until timeout expires
@@ -262,6 +355,17 @@ event_t *event_wait_timeout(event_queue_t *queue, uint32_t timeout);
  */
 void event_loop(event_queue_t *queue);
 
+/**
+ * @brief   Simple event loop serving several event queues
+ *
+ * Like event_loop(), but handles the events of all @p queues, giving
+ * precedence to queues with a lower index.
+ *
+ * @param[in]   queues      array of event queues to process
+ * @param[in]   n_queues    number of elements in @p queues
+ */
+void event_loop_multi(event_queue_t *queues, size_t n_queues);
+
 #ifdef __cplusplus
 }
 #endif
@@ -72,6 +72,10 @@ typedef struct {
     evtimer_callback_t callback;    /**< Handler function for this evtimer's
                                          event type */
     evtimer_event_t *events;        /**< Event queue */
+#if defined(MODULE_XTIMER_SLACK) || defined(DOXYGEN)
+    uint32_t slack;                 /**< time in milliseconds events may be
+                                         handled late */
+#endif
 } evtimer_t;
 
 /**
@@ -98,6 +102,24 @@ void evtimer_add(evtimer_t *evtimer, evtimer_event_t *event);
  */
 void evtimer_del(evtimer_t *evtimer, evtimer_event_t *event);
 
+#if defined(MODULE_XTIMER_SLACK) || defined(DOXYGEN)
+/**
+ * @brief   Allows the events of an event timer to be handled late
+ *
+ * Events that are due within @p slack milliseconds of the next event are
+ * handled together with it, and the underlying timer may be coalesced with
+ * other timers of the system (see @ref sys_xtimer "xtimer_slack").
+ * No event is ever handled early.
+ *
+ * @note    Only available with the `xtimer_slack` module. The slack of an
+ *          event timer is 0 after evtimer_init().
+ *
+ * @param[in] evtimer   An event timer
+ * @param[in] slack     time in milliseconds events may be handled late
+ */
+void evtimer_set_slack(evtimer_t *evtimer, uint32_t slack);
+#endif
+
 /**
  * @brief   Print overview of current state of an event timer
  *
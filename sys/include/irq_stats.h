@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_irq_stats Interrupt-disabled section statistics
+ * @ingroup     sys
+ * @brief       Measures how long interrupts stay disabled
+ *
+ * With this module the CPU's irq_disable(), irq_enable() and irq_restore()
+ * report every section that runs with interrupts disabled. For each call
+ * site of irq_disable() the number and the longest duration of its sections
+ * are recorded, and for each thread the total time it spent with interrupts
+ * disabled outside of ISRs. This bounds the interrupt latency a system can
+ * guarantee and points at the code that needs to be shortened.
+ *
+ * Sections are timed with a free-running 32 bit counter of the CPU: the CPU
+ * cycle counter on Cortex-M3 and up, and the host's monotonic clock in
+ * nanoseconds on native. Durations are taken modulo 2^32 ticks, so a section
+ * longer than one wrap of the counter (about 4.29 s on native, 2^32 CPU
+ * cycles on Cortex-M) is recorded too short. Cortex-M0 and M0+ have no cycle
+ * counter, the module builds there but records nothing. Other CPUs don't
+ * provide the `cpu_irq_stats` feature this module requires.
+ *
+ * A section that spans a context switch is accounted to the call site that
+ * opened it.
+ *
+ * @{
+ * @file
+ * @brief       Interrupt-disabled section statistics API
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ */
+
+#ifndef IRQ_STATS_H
+#define IRQ_STATS_H
+
+#include <stdint.h>
+
+#include "kernel_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of call sites to track
+ *
+ * Sections of call sites not fitting into the table are accounted to a
+ * catch-all entry with irq_stats_site_t::site set to NULL.
+ */
+#ifndef IRQ_STATS_SITES
+#define IRQ_STATS_SITES     (16U)
+#endif
+
+/**
+ * @brief   Statistics of one call site
+ */
+typedef struct {
+    const void *site;       /**< return address of the irq_disable() call */
+    uint32_t count;         /**< number of sections started at this site */
+    uint32_t max;           /**< longest section in ticks */
+} irq_stats_site_t;
+
+/**
+ * @brief   Called by the CPU once interrupts got disabled
+ *
+ * @param[in] site  return address of the irq_disable() call
+ */
+void irq_stats_begin(const void *site);
+
+/**
+ * @brief   Called by the CPU right before interrupts get enabled again
+ */
+void irq_stats_end(void);
+
+/**
+ * @brief   Current value of the free-running section timer, provided by the
+ *          CPU
+ *
+ * The value wraps around at 2^32 ticks.
+ *
+ * @return  time stamp in ticks
+ */
+uint32_t irq_stats_now(void);
+
+/**
+ * @brief   Rate of the section timer, provided by the CPU
+ *
+ * @return  ticks per microsecond
+ */
+uint32_t irq_stats_ticks_per_us(void);
+
+/**
+ * @brief   Copies the call site table
+ *
+ * Entries are returned in the order the call sites were first seen.
+ *
+ * @param[out] sites    buffer for the entries
+ * @param[in]  n        number of entries @p sites can hold
+ *
+ * @return  number of entries copied
+ */
+unsigned irq_stats_get(irq_stats_site_t *sites, unsigned n);
+
+/**
+ * @brief   Total time a thread spent with interrupts disabled
+ *
+ * @param[in] pid   the thread
+ *
+ * @return  time in microseconds
+ */
+uint64_t irq_stats_thread_us(kernel_pid_t pid);
+
+/**
+ * @brief   Clears all statistics
+ */
+void irq_stats_reset(void);
+
+/**
+ * @brief   Prints the call site table, longest sections first
+ */
+void irq_stats_print(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IRQ_STATS_H */
+/** @} */
@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_msg_buf Messages with attached buffers
+ * @ingroup     sys
+ * @brief       Zero-copy transfer of buffers between threads
+ *
+ * A @ref msg_t only carries a pointer sized payload. To pass larger data
+ * without copying, this module attaches a buffer from a static pool to a
+ * message and transfers the ownership of the buffer along with the message,
+ * using the regular @ref core_msg "msg" and @ref core_mbox "mbox" functions.
+ *
+ * A buffer is owned by one thread at a time. Only the owner may access or
+ * free it. The sender loses the ownership when the message was delivered,
+ * the receiver gets it with msg_buf_claim(). Buffers sent to a thread
+ * directly belong to the receiving thread from the moment they are sent, so
+ * buffers still in the message queue of a thread count as its own.
+ *
+ * When a thread exits, all buffers it owns are returned to their pool.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static MSG_BUF_POOL_STORAGE(_storage, 256, 4);
+ * static msg_buf_pool_t _pool;
+ *
+ * msg_buf_pool_init(&_pool, _storage, 256, 4);
+ *
+ * // sender
+ * msg_buf_t *buf = msg_buf_alloc(&_pool);
+ * buf->len = fill(msg_buf_data(buf), msg_buf_size(buf));
+ * msg_buf_send(&msg, buf, receiver_pid);
+ *
+ * // receiver
+ * msg_receive(&msg);
+ * msg_buf_t *buf = msg_buf_claim(&msg);
+ * consume(msg_buf_data(buf), buf->len);
+ * msg_buf_free(buf);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @{
+ *
+ * @file
+ * @brief       Messages with attached buffers definitions
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ */
+
+#ifndef MSG_BUF_H
+#define MSG_BUF_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "mbox.h"
+#include "memarray.h"
+#include "msg.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Pool of equally sized message buffers
+ */
+typedef struct msg_buf_pool {
+    memarray_t mem;                 /**< free list of the buffers */
+    void *storage;                  /**< memory of the buffers */
+    struct msg_buf_pool *next;      /**< next pool, for releasing the buffers
+                                         of an exiting thread */
+} msg_buf_pool_t;
+
+/**
+ * @brief   Header of a message buffer, the data follows directly
+ */
+typedef struct {
+    msg_buf_pool_t *pool;           /**< pool the buffer belongs to */
+    kernel_pid_t owner;             /**< thread owning the buffer */
+    uint16_t len;                   /**< number of bytes used, not
+                                         interpreted by this module */
+} msg_buf_t;
+
+/**
+ * @brief   Size in bytes of a buffer of @p size data bytes, including its
+ *          header
+ */
+#define MSG_BUF_ELEM_SIZE(size)     (sizeof(msg_buf_t) + \
+                                     (((size) + sizeof(void *) - 1) & \
+                                      ~(sizeof(void *) - 1)))
+
+/**
+ * @brief   Defines memory for a pool of @p num buffers of @p size bytes
+ */
+#define MSG_BUF_POOL_STORAGE(name, size, num) \
+    uintptr_t name[(MSG_BUF_ELEM_SIZE(size) * (num)) / sizeof(uintptr_t)]
+
+/**
+ * @brief   Initializes a buffer pool
+ *
+ * @pre     @p storage was defined with @ref MSG_BUF_POOL_STORAGE for the same
+ *          @p size and @p num
+ * @pre     @p size <= UINT16_MAX
+ *
+ * @param[out] pool     pool to initialize
+ * @param[in]  storage  memory of the buffers
+ * @param[in]  size     data bytes of a buffer
+ * @param[in]  num      number of buffers
+ */
+void msg_buf_pool_init(msg_buf_pool_t *pool, void *storage, size_t size,
+                       size_t num);
+
+/**
+ * @brief   Allocates a buffer, owned by the calling thread
+ *
+ * @param[in] pool      pool to allocate from
+ *
+ * @return  the buffer, with msg_buf_t::len set to 0
+ * @return  NULL, if the pool is exhausted
+ */
+msg_buf_t *msg_buf_alloc(msg_buf_pool_t *pool);
+
+/**
+ * @brief   Returns a buffer to its pool
+ *
+ * @param[in] buf       buffer owned by the calling thread
+ */
+void msg_buf_free(msg_buf_t *buf);
+
+/**
+ * @brief   Returns the data of a buffer
+ */
+static inline uint8_t *msg_buf_data(msg_buf_t *buf)
+{
+    return (uint8_t *)(buf + 1);
+}
+
+/**
+ * @brief   Returns the number of data bytes a buffer can hold
+ */
+static inline size_t msg_buf_size(const msg_buf_t *buf)
+{
+    return buf->pool->mem.size - sizeof(msg_buf_t);
+}
+
+/**
+ * @brief   Sends a buffer to a thread, blocking
+ *
+ * Works like msg_send(), msg_t::content of @p m is set to @p buf. On
+ * success, @p buf belongs to @p target_pid.
+ *
+ * @param[in] m             message to send
+ * @param[in] buf           buffer owned by the calling thread
+ * @param[in] target_pid    receiving thread
+ *
+ * @return  the return value of msg_send(), @p buf is still owned by the
+ *          caller unless it is 1
+ */
+int msg_buf_send(msg_t *m, msg_buf_t *buf, kernel_pid_t target_pid);
+
+/**
+ * @brief   Sends a buffer to a thread, non-blocking
+ *
+ * Works like msg_try_send(), see msg_buf_send().
+ *
+ * @param[in] m             message to send
+ * @param[in] buf           buffer owned by the calling thread
+ * @param[in] target_pid    receiving thread
+ *
+ * @return  the return value of msg_try_send(), @p buf is still owned by the
+ *          caller unless it is 1
+ */
+int msg_buf_try_send(msg_t *m, msg_buf_t *buf, kernel_pid_t target_pid);
+
+#if defined(MODULE_CORE_MBOX) || defined(DOXYGEN)
+/**
+ * @brief   Puts a buffer into a mailbox, blocking
+ *
+ * @note    Only available with the `core_mbox` module
+ * While in the mailbox, the buffer is owned by no thread.
+ *
+ * @param[in] mbox          mailbox to put the message into
+ * @param[in] m             message to put
+ * @param[in] buf           buffer owned by the calling thread
+ */
+void msg_buf_mbox_put(mbox_t *mbox, msg_t *m, msg_buf_t *buf);
+
+/**
+ * @brief   Puts a buffer into a mailbox, non-blocking
+ *
+ * @note    Only available with the `core_mbox` module
+ * @param[in] mbox          mailbox to put the message into
+ * @param[in] m             message to put
+ * @param[in] buf           buffer owned by the calling thread
+ *
+ * @return  1 if the message was put, 0 if the mailbox is full and @p buf
+ *          is still owned by the caller
+ */
+int msg_buf_mbox_try_put(mbox_t *mbox, msg_t *m, msg_buf_t *buf);
+#endif
+
+/**
+ * @brief   Takes the ownership of a buffer received with a message
+ *
+ * @param[in] m     message received from msg_buf_send() or from a mailbox
+ *                  filled with msg_buf_mbox_put()
+ *
+ * @return  the buffer attached to @p m
+ */
+msg_buf_t *msg_buf_claim(msg_t *m);
+
+/**
+ * @brief   Returns all buffers owned by a thread to their pools
+ *
+ * Registered with sched_register_exit_cb() when the first pool is
+ * initialized, so the scheduler calls it when a thread exits.
+ *
+ * @param[in] pid   the thread
+ */
+void msg_buf_release_all(kernel_pid_t pid);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MSG_BUF_H */
+/** @} */
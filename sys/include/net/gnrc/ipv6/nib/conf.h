@@ -209,6 +209,39 @@ extern "C" {
 #ifndef GNRC_IPV6_NIB_CONF_MULTIHOP_DAD
 #define GNRC_IPV6_NIB_CONF_MULTIHOP_DAD (0)
 #endif
+
+/**
+ * @brief   Index off-link entries in a prefix trie
+ *
+ * Finding the forwarding table entry for a destination then takes at most
+ * as many steps as the longest prefix has bits instead of a scan of all
+ * @ref GNRC_IPV6_NIB_OFFL_NUMOF off-link entries, at the cost of 2 nodes of
+ * 3 pointers each per off-link entry. Worth it with many routes, as on a
+ * border router.
+ */
+#ifndef GNRC_IPV6_NIB_CONF_FT_TRIE
+#if GNRC_IPV6_NIB_CONF_6LBR
+#define GNRC_IPV6_NIB_CONF_FT_TRIE      (1)
+#else
+#define GNRC_IPV6_NIB_CONF_FT_TRIE      (0)
+#endif
+#endif
+
+/**
+ * @brief   Index the on-link entries by their IPv6 address in a hash table
+ *
+ * Looking up a neighbor then only compares the entries in one of
+ * @ref GNRC_IPV6_NIB_NC_HASH_BUCKETS buckets instead of scanning all
+ * @ref GNRC_IPV6_NIB_NUMOF on-link entries, at the cost of one pointer per
+ * on-link entry. Worth it with many neighbors, as on a border router.
+ */
+#ifndef GNRC_IPV6_NIB_CONF_NC_HASH
+#if GNRC_IPV6_NIB_CONF_6LBR
+#define GNRC_IPV6_NIB_CONF_NC_HASH      (1)
+#else
+#define GNRC_IPV6_NIB_CONF_NC_HASH      (0)
+#endif
+#endif
 /** @} */
 
 /**
@@ -266,6 +299,19 @@ extern "C" {
 #define GNRC_IPV6_NIB_OFFL_NUMOF            (8)
 #endif
 
+#if GNRC_IPV6_NIB_CONF_NC_HASH || defined(DOXYGEN)
+/**
+ * @brief   Number of hash buckets for the on-link entries in NIB
+ *
+ * @note    Only available if @ref GNRC_IPV6_NIB_CONF_NC_HASH != 0.
+ *
+ * @attention   Must be a power of two.
+ */
+#ifndef GNRC_IPV6_NIB_NC_HASH_BUCKETS
+#define GNRC_IPV6_NIB_NC_HASH_BUCKETS       (16)
+#endif
+#endif
+
 #if GNRC_IPV6_NIB_CONF_MULTIHOP_P6C || defined(DOXYGEN)
 /**
  * @brief   Number of authoritative border router entries in NIB
@@ -153,6 +153,15 @@ typedef struct {
     uint8_t l2addr_len;     /**< Length of gnrc_ipv6_nib_nc_t::l2addr in bytes */
 } gnrc_ipv6_nib_nc_t;
 
+/**
+ * @brief   Statistics of the neighbor cache
+ */
+typedef struct {
+    uint32_t hits;      /**< lookups that found an entry */
+    uint32_t misses;    /**< lookups that found no entry */
+    uint32_t evictions; /**< entries removed to make room for new ones */
+} gnrc_ipv6_nib_nc_stats_t;
+
 /**
  * @brief   Gets neighbor unreachability state from entry
  *
@@ -306,6 +315,20 @@ bool gnrc_ipv6_nib_nc_iter(unsigned iface, void **state,
  */
 void gnrc_ipv6_nib_nc_print(gnrc_ipv6_nib_nc_t *nce);
 
+/**
+ * @brief   Gets the statistics of the neighbor cache
+ *
+ * @pre `stats != NULL`
+ *
+ * @param[out] stats    The statistics since start-up.
+ */
+void gnrc_ipv6_nib_nc_get_stats(gnrc_ipv6_nib_nc_stats_t *stats);
+
+/**
+ * @brief   Prints the statistics of the neighbor cache
+ */
+void gnrc_ipv6_nib_nc_print_stats(void);
+
 #ifdef __cplusplus
 }
 #endif
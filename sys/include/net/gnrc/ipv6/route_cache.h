@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_ipv6_route_cache IPv6 route cache
+ * @ingroup     net_gnrc_ipv6
+ * @brief       Caches the next hop for destinations of unicast packets
+ *
+ * Resolving the next hop of a unicast packet takes a forwarding table
+ * lookup, a neighbor cache lookup and the selection of the interface within
+ * the @ref net_gnrc_ipv6_nib "NIB". With this module, @ref net_gnrc_ipv6
+ * remembers the result for the destinations of recently sent or forwarded
+ * packets, so packets of steady flows skip the NIB entirely.
+ *
+ * Only results for neighbors that are known to be reachable (or are not
+ * subject to neighbor unreachability detection) are cached, so neighbor
+ * unreachability detection is not starved of the packets it needs to notice
+ * a neighbor becoming unreachable. The NIB invalidates the whole cache
+ * whenever it changes.
+ *
+ * To use it, add the module `gnrc_ipv6_route_cache`.
+ *
+ * @{
+ *
+ * @file
+ * @brief   IPv6 route cache definitions
+ *
+ * @author  RIOT developers <devel@riot-os.org>
+ */
+#ifndef NET_GNRC_IPV6_ROUTE_CACHE_H
+#define NET_GNRC_IPV6_ROUTE_CACHE_H
+
+#include <stdint.h>
+
+#include "net/gnrc/ipv6/nib/nc.h"
+#include "net/gnrc/netif.h"
+#include "net/ipv6/addr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup    net_gnrc_ipv6_route_cache_conf GNRC IPv6 route cache compile configurations
+ * @ingroup     net_gnrc_ipv6_route_cache
+ * @ingroup     config
+ * @{
+ */
+/**
+ * @brief   Number of destinations in the route cache
+ *
+ * @attention   Must be a power of two.
+ */
+#ifndef GNRC_IPV6_ROUTE_CACHE_SIZE
+#define GNRC_IPV6_ROUTE_CACHE_SIZE  (8U)
+#endif
+/** @} */
+
+/**
+ * @brief   Statistics of the route cache
+ */
+typedef struct {
+    uint32_t hits;          /**< lookups answered by the cache */
+    uint32_t misses;        /**< lookups that had to ask the NIB */
+    uint32_t forwarded;     /**< forwarded packets */
+    /**
+     * @brief   Sum of the times in microseconds from the reception of the
+     *          forwarded packets until they were handed to the outgoing
+     *          interface
+     */
+    uint64_t forward_time;
+} gnrc_ipv6_route_cache_stats_t;
+
+/**
+ * @brief   Gets the next hop of a destination from the cache
+ *
+ * @note    Only to be called by the IPv6 thread.
+ *
+ * @param[in] dst   A unicast destination address.
+ * @param[in] netif The interface the packet is meant to be sent over. May
+ *                  be NULL for any interface.
+ *
+ * @return  The neighbor cache entry view of the next hop to @p dst, as
+ *          returned by gnrc_ipv6_nib_get_next_hop_l2addr().
+ * @return  NULL, if @p dst is not in the cache. In that case
+ *          gnrc_ipv6_route_cache_add() may be called with the result of the
+ *          NIB.
+ */
+const gnrc_ipv6_nib_nc_t *gnrc_ipv6_route_cache_get(const ipv6_addr_t *dst,
+                                                    const gnrc_netif_t *netif);
+
+/**
+ * @brief   Adds the next hop to a destination to the cache
+ *
+ * The entry is only added, if the NIB did not change since the last call of
+ * gnrc_ipv6_route_cache_get(), which must have been a miss for @p dst and
+ * @p netif.
+ *
+ * @note    Only to be called by the IPv6 thread.
+ *
+ * @param[in] dst   A unicast destination address.
+ * @param[in] netif The interface the packet is meant to be sent over. May
+ *                  be NULL for any interface.
+ * @param[in] nce   The next hop to @p dst, as returned by
+ *                  gnrc_ipv6_nib_get_next_hop_l2addr().
+ */
+void gnrc_ipv6_route_cache_add(const ipv6_addr_t *dst,
+                               const gnrc_netif_t *netif,
+                               const gnrc_ipv6_nib_nc_t *nce);
+
+/**
+ * @brief   Invalidates all entries of the cache
+ *
+ * Called by the NIB on any change that may change the next hop of a
+ * destination. May be called from any thread.
+ */
+void gnrc_ipv6_route_cache_invalidate(void);
+
+/**
+ * @brief   Accounts a forwarded packet
+ *
+ * @param[in] time  Time in microseconds from the reception of the packet
+ *                  until it was handed to the outgoing interface.
+ */
+void gnrc_ipv6_route_cache_forwarded(uint32_t time);
+
+/**
+ * @brief   Gets the statistics of the route cache
+ *
+ * @pre `stats != NULL`
+ *
+ * @param[out] stats    The statistics since start-up.
+ */
+void gnrc_ipv6_route_cache_get_stats(gnrc_ipv6_route_cache_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_IPV6_ROUTE_CACHE_H */
+/** @} */
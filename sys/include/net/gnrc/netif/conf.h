@@ -137,6 +137,16 @@ extern "C" {
 #define GNRC_NETIF_DEFAULT_HL      (64U)   /**< default hop limit */
 #endif
 
+/**
+ * @brief   Maximum number of interrupts served and frames passed up at once
+ *          per wake-up of a network interface thread
+ *
+ * @note    Only applicable with @ref net_gnrc_netif_rx_batch.
+ */
+#ifndef GNRC_NETIF_RX_BATCH_SIZE
+#define GNRC_NETIF_RX_BATCH_SIZE    (8U)
+#endif
+
 /**
  * @brief   Minimum wait time in microseconds after a send operation
  *
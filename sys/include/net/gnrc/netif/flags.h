@@ -122,6 +122,20 @@ enum {
  * @brief   Network interface is configured in raw mode
  */
 #define GNRC_NETIF_FLAGS_RAWMODE                   (0x00010000U)
+
+/**
+ * @brief   Device verifies the upper layer checksums of received packets
+ *
+ * @see @ref NETOPT_RX_CSUM_VERIFIED
+ */
+#define GNRC_NETIF_FLAGS_RX_CSUM_VERIFIED          (0x00020000U)
+
+/**
+ * @brief   Device calculates the upper layer checksums of sent packets
+ *
+ * @see @ref NETOPT_TX_CSUM_OFFLOAD
+ */
+#define GNRC_NETIF_FLAGS_TX_CSUM_OFFLOAD           (0x00040000U)
 /** @} */
 
 #ifdef __cplusplus
@@ -74,6 +74,16 @@ extern "C" {
  */
 #define GNRC_NETIF_HDR_FLAGS_MULTICAST  (0x40)
 
+/**
+ * @brief   Upper layer checksum was verified
+ *
+ * @details This flag signals that the device the packet was received with
+ *          already verified the UDP, TCP, or ICMPv6 checksum of the packet
+ *          (see @ref NETOPT_RX_CSUM_VERIFIED), so the upper layer does not
+ *          need to verify it again. It is only set on reception.
+ */
+#define GNRC_NETIF_HDR_FLAGS_CSUM_VERIFIED  (0x20)
+
 /**
  * @brief   More data will follow
  *
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_netif_rx_batch Batched reception
+ * @ingroup     net_gnrc_netif
+ * @brief       Drains several frames from the device per wake-up of the
+ *              interface thread
+ *
+ * To activate, use `USEMODULE += gnrc_netif_rx_batch` in your applications
+ * Makefile.
+ *
+ * Without this module every interrupt of a device results in one message to
+ * the interface's thread and every received frame is passed up as soon as it
+ * was read from the device. Under load this costs a context switch per frame
+ * and an interrupt arriving while the message queue of the thread is full is
+ * lost.
+ *
+ * With this module interrupts arriving while one is still pending are
+ * coalesced, so at most one message is queued per interface. When woken up,
+ * the interface's thread keeps serving the device as long as it signals new
+ * interrupts, up to @ref GNRC_NETIF_RX_BATCH_SIZE times, and collects the
+ * frames received meanwhile. Only then the collected packets are passed up
+ * in the order they were received. If the device still has more to do the
+ * thread queues a message to itself, so messages queued meanwhile, e.g. of
+ * packets to send, are not starved.
+ *
+ * Link-layers replacing the event callback of the device (e.g.
+ * @ref net_gnrc_lwmac) are not affected by this module.
+ *
+ * @{
+ *
+ * @file
+ * @brief   Definitions for batched reception
+ *
+ * @author  RIOT developers <devel@riot-os.org>
+ */
+#ifndef NET_GNRC_NETIF_RX_BATCH_H
+#define NET_GNRC_NETIF_RX_BATCH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "net/gnrc/pkt.h"
+#include "net/gnrc/netif/conf.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   State of the batched reception of an interface
+ */
+typedef struct {
+    /**
+     * @brief   Packets received but not passed up yet
+     */
+    gnrc_pktsnip_t *pkts[GNRC_NETIF_RX_BATCH_SIZE];
+    uint8_t len;                /**< number of packets in gnrc_netif_rx_batch_t::pkts */
+    volatile bool irq_pending;  /**< the device signaled an unserved interrupt */
+    volatile bool polling;      /**< the interface's thread serves the device */
+} gnrc_netif_rx_batch_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_NETIF_RX_BATCH_H */
+/** @} */
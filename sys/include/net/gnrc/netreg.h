@@ -10,6 +10,18 @@
  * @defgroup    net_gnrc_netreg  Network protocol registry
  * @ingroup     net_gnrc
  * @brief       Registry to receive messages of a specified protocol type by GNRC.
+ *
+ * Entries are kept in a list per protocol type, entries with the same
+ * demultiplexing context next to each other. Looking up an entry thus scans
+ * the list of its type, while the further entries for a context are found
+ * without scanning.
+ *
+ * With `USEMODULE += gnrc_netreg_hash` the entries of every type are spread
+ * over @ref GNRC_NETREG_HASH_BUCKETS lists by a hash of their
+ * demultiplexing context, so lookups only scan the entries that collide
+ * with the looked up context. This pays off with many registrations, e.g.
+ * a lot of UDP sockets, at the cost of
+ * `(GNRC_NETREG_HASH_BUCKETS - 1) * GNRC_NETTYPE_NUMOF` pointers of RAM.
  * @{
  *
  * @file
@@ -72,6 +84,15 @@ typedef enum {
 } gnrc_netreg_type_t;
 #endif
 
+/**
+ * @brief   Number of lists per protocol type with `gnrc_netreg_hash`
+ *
+ * @note    Must be a power of 2 and at most 256.
+ */
+#ifndef GNRC_NETREG_HASH_BUCKETS
+#define GNRC_NETREG_HASH_BUCKETS    (16U)
+#endif
+
 /**
  * @brief   Demux context value to get all packets of a certain type.
  *
@@ -353,6 +374,9 @@ int gnrc_netreg_num(gnrc_nettype_t type, uint32_t demux_ctx);
  *          gnrc_netreg_entry_t::type and gnrc_netreg_entry_t::demux_ctx as the
  *          given entry.
  *
+ * Entries with the same gnrc_netreg_entry_t::demux_ctx are returned from the
+ * last registered to the first registered one.
+ *
  * @param[in] entry     A registry entry retrieved by gnrc_netreg_lookup() or
  *                      gnrc_netreg_getnext(). Must not be NULL.
  *
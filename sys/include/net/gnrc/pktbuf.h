@@ -58,6 +58,50 @@ extern "C" {
 #define GNRC_PKTBUF_SIZE    (6144)
 #endif  /* GNRC_PKTBUF_SIZE */
 
+#if defined(MODULE_GNRC_PKTBUF_SLAB) || defined(DOXYGEN)
+/**
+ * @name    Configuration of the `gnrc_pktbuf_slab` backend
+ *
+ * The `gnrc_pktbuf_slab` backend manages the @ref GNRC_PKTBUF_SIZE bytes of
+ * the packet buffer as a buddy system of @ref GNRC_PKTBUF_SLAB_UNIT sized
+ * units, trimming every block to the units actually requested. Allocations
+ * of up to @ref GNRC_PKTBUF_SLAB_MAX bytes, i.e. packet snips and most
+ * headers, are instead served from per size class slabs of
+ * @ref GNRC_PKTBUF_SLAB_PAGE bytes each, which keeps them from fragmenting
+ * the space for payloads. Both allocation and release take a bounded number
+ * of steps independent of the state of the packet buffer.
+ * @{
+ */
+/**
+ * @brief   Allocation granularity in bytes
+ *
+ * Must be a power of two and at least twice the size of a pointer.
+ */
+#ifndef GNRC_PKTBUF_SLAB_UNIT
+#define GNRC_PKTBUF_SLAB_UNIT   (16U)
+#endif
+
+/**
+ * @brief   Size of a slab in bytes
+ *
+ * Must be a power of two multiple of @ref GNRC_PKTBUF_SLAB_UNIT.
+ */
+#ifndef GNRC_PKTBUF_SLAB_PAGE
+#define GNRC_PKTBUF_SLAB_PAGE   (256U)
+#endif
+
+/**
+ * @brief   Largest allocation in bytes served from slabs
+ *
+ * Must be a multiple of @ref GNRC_PKTBUF_SLAB_UNIT, each multiple up to this
+ * value is a size class.
+ */
+#ifndef GNRC_PKTBUF_SLAB_MAX
+#define GNRC_PKTBUF_SLAB_MAX    (64U)
+#endif
+/** @} */
+#endif /* MODULE_GNRC_PKTBUF_SLAB */
+
 /**
  * @brief   Initializes packet buffer module.
  */
@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_pktbuf_cache   Per-thread packet buffer caches
+ * @ingroup     net_gnrc_pktbuf
+ * @brief       Caches of recently freed packet buffer chunks per thread
+ *
+ * With `gnrc_pktbuf_cache` the packet buffer backend keeps chunks released
+ * by a thread in a small cache (a *magazine*) of that thread instead of
+ * returning them to the packet buffer right away. Allocations of the same
+ * size by that thread are served from the magazine without taking the lock
+ * of the packet buffer. A thread whose magazine runs full hands it to a
+ * depot shared by all threads and a thread whose magazine has no fitting
+ * chunk exchanges it for one from the depot, so chunks move between
+ * threads allocating and releasing packets a magazine at a time. Only when
+ * the depot is full as well a whole magazine is returned to the packet
+ * buffer. When an allocation finds neither a cached chunk nor enough space
+ * in the packet buffer, all caches are returned to the packet buffer and the
+ * allocation is tried once more.
+ *
+ * Magazines are assigned to the first @ref GNRC_PKTBUF_CACHE_NUMOF threads
+ * using the packet buffer, the magazine of a thread that exited is taken
+ * over by the next thread needing one. All other threads use the packet
+ * buffer directly.
+ *
+ * Chunks are only handed out for allocations of exactly the size they were
+ * freed with, rounded as the backend does, so the backend can free them as
+ * if they never were cached. Chunks in caches count as used space of the
+ * packet buffer.
+ *
+ * The functions of this module are meant to be used by packet buffer
+ * backends only. Currently only `gnrc_pktbuf_static` makes use of it.
+ *
+ * @{
+ *
+ * @file
+ * @brief   Per-thread packet buffer cache definitions
+ *
+ * @author  RIOT developers <devel@riot-os.org>
+ */
+#ifndef NET_GNRC_PKTBUF_CACHE_H
+#define NET_GNRC_PKTBUF_CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "mutex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of threads with a cache
+ */
+#ifndef GNRC_PKTBUF_CACHE_NUMOF
+#define GNRC_PKTBUF_CACHE_NUMOF     (4U)
+#endif
+
+/**
+ * @brief   Number of chunks a magazine holds
+ */
+#ifndef GNRC_PKTBUF_CACHE_SIZE
+#define GNRC_PKTBUF_CACHE_SIZE      (8U)
+#endif
+
+/**
+ * @brief   Number of magazines the depot holds
+ */
+#ifndef GNRC_PKTBUF_CACHE_DEPOT
+#define GNRC_PKTBUF_CACHE_DEPOT     (2U)
+#endif
+
+/**
+ * @brief   Function of the backend returning a chunk to the packet buffer
+ *
+ * @param[in] chunk A chunk of the packet buffer.
+ * @param[in] size  Size of @p chunk.
+ */
+typedef void (*gnrc_pktbuf_cache_free_t)(void *chunk, size_t size);
+
+/**
+ * @brief   Empties all caches without returning their chunks
+ *
+ * To be called when the backend (re-)initializes the packet buffer.
+ */
+void gnrc_pktbuf_cache_init(void);
+
+/**
+ * @brief   Takes a chunk from the cache of the calling thread
+ *
+ * Does not need the lock of the packet buffer.
+ *
+ * @param[in] size  Size of the chunk as rounded by the backend.
+ *
+ * @return  A chunk of @p size bytes.
+ * @return  NULL, if the cache of the calling thread holds no such chunk or
+ *          the calling thread has no cache.
+ */
+void *gnrc_pktbuf_cache_get(size_t size);
+
+/**
+ * @brief   Puts a chunk into the cache of the calling thread
+ *
+ * Does not need the lock of the packet buffer.
+ *
+ * @param[in] chunk A chunk no longer used.
+ * @param[in] size  Size of @p chunk as rounded by the backend.
+ *
+ * @return  true, if @p chunk was cached.
+ * @return  false, if the cache of the calling thread is full or the calling
+ *          thread has no cache. Hand @p chunk to gnrc_pktbuf_cache_flush()
+ *          then.
+ */
+bool gnrc_pktbuf_cache_put(void *chunk, size_t size);
+
+/**
+ * @brief   Exchanges the magazine of the calling thread for one of the depot
+ *          holding a chunk of the requested size and takes that chunk
+ *
+ * Assigns a cache to the calling thread if it has none.
+ *
+ * @pre The lock of the packet buffer is held.
+ *
+ * @param[in] size      Size of the chunk as rounded by the backend.
+ * @param[in] free_cb   Returns chunks of a cache taken over to the packet
+ *                      buffer.
+ *
+ * @return  A chunk of @p size bytes.
+ * @return  NULL, if no cached chunk of @p size bytes is available. Allocate
+ *          from the packet buffer then.
+ */
+void *gnrc_pktbuf_cache_refill(size_t size, gnrc_pktbuf_cache_free_t free_cb);
+
+/**
+ * @brief   Moves the full magazine of the calling thread to the depot and
+ *          puts a chunk into the then empty one
+ *
+ * If the depot is full, the magazine put there first is returned to the
+ * packet buffer. If the calling thread has no cache and none can be assigned
+ * to it, @p chunk itself is returned to the packet buffer.
+ *
+ * @pre The lock of the packet buffer is held.
+ *
+ * @param[in] chunk     A chunk no longer used.
+ * @param[in] size      Size of @p chunk as rounded by the backend.
+ * @param[in] free_cb   Returns chunks to the packet buffer.
+ */
+void gnrc_pktbuf_cache_flush(void *chunk, size_t size,
+                             gnrc_pktbuf_cache_free_t free_cb);
+
+/**
+ * @brief   Returns the chunks of the caches of all threads and of the depot
+ *          to the packet buffer
+ *
+ * For the backend to call before it gives up on an allocation, as the
+ * chunks of a size nobody allocates stay in the caches otherwise.
+ *
+ * @pre The lock of the packet buffer is held.
+ *
+ * @param[in] free_cb   Returns chunks to the packet buffer.
+ *
+ * @return  Number of chunks returned to the packet buffer.
+ */
+unsigned gnrc_pktbuf_cache_drain(gnrc_pktbuf_cache_free_t free_cb);
+
+/**
+ * @brief   Takes the lock of the packet buffer and records how long that took
+ *
+ * @param[in] lock  The lock of the packet buffer.
+ */
+void gnrc_pktbuf_cache_lock(mutex_t *lock);
+
+/**
+ * @brief   Prints the hit rate of the caches and the time spent waiting for
+ *          the lock of the packet buffer
+ */
+void gnrc_pktbuf_cache_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_PKTBUF_CACHE_H */
+/** @} */
@@ -88,15 +88,51 @@ extern "C" {
  *          [gnrc_sixlowpan_frag](@ref net_gnrc_sixlowpan_frag) module
  *
  * When set to a non-zero value this will cause the reassembly buffer to
- * override the oldest entry no matter what. When set to zero only the oldest
- * entry that is older than @ref GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US will be
- * overwritten (they will still timeout normally if reassembly buffer is not
- * full).
+ * override an entry no matter what: an entry of the source with the most
+ * entries, preferably one that did not receive more than one fragment yet,
+ * else the least complete and least recently used one. So a flooding source
+ * does not push out the nearly complete datagrams of others. When set to zero
+ * only the oldest entry that is older than
+ * @ref GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US will be overwritten (they will
+ * still timeout normally if reassembly buffer is not full).
  */
 #ifndef GNRC_SIXLOWPAN_FRAG_RBUF_AGGRESSIVE_OVERRIDE
 #define GNRC_SIXLOWPAN_FRAG_RBUF_AGGRESSIVE_OVERRIDE    (1)
 #endif
 
+/**
+ * @brief   Maximum number of reassembly buffer entries for datagrams of the
+ *          same link-layer source
+ *
+ * @note    Only applicable with
+ *          [gnrc_sixlowpan_frag](@ref net_gnrc_sixlowpan_frag) module
+ *
+ * A new datagram of a source that reached this number replaces an entry of
+ * that source (or is dropped, if
+ * @ref GNRC_SIXLOWPAN_FRAG_RBUF_AGGRESSIVE_OVERRIDE is zero), so a single
+ * neighbor can not occupy the whole reassembly buffer. Defaults to all but
+ * one entry.
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_RBUF_SRC_QUOTA
+#if GNRC_SIXLOWPAN_FRAG_RBUF_SIZE > 1
+#define GNRC_SIXLOWPAN_FRAG_RBUF_SRC_QUOTA  (GNRC_SIXLOWPAN_FRAG_RBUF_SIZE - 1)
+#else
+#define GNRC_SIXLOWPAN_FRAG_RBUF_SRC_QUOTA  (1U)
+#endif
+#endif
+
+/**
+ * @brief   Number of hash buckets to look up reassembly buffer entries
+ *
+ * @note    Only applicable with
+ *          [gnrc_sixlowpan_frag](@ref net_gnrc_sixlowpan_frag) module
+ *
+ * @attention   Must be a power of two.
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_RBUF_BUCKETS
+#define GNRC_SIXLOWPAN_FRAG_RBUF_BUCKETS    (4U)
+#endif
+
 /**
  * @brief   Registration lifetime in minutes for the address registration option
  *
@@ -146,6 +182,67 @@ extern "C" {
 #define GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT_US  (GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US)
 #endif  /* GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT_US */
 
+/**
+ * @brief   Maximum number of recoverable fragments in flight per datagram
+ *
+ * @see     [RFC 8931, section 6](https://tools.ietf.org/html/rfc8931#section-6)
+ *
+ * @note    Only applicable with
+ *          [gnrc_sixlowpan_frag_sfr](@ref net_gnrc_sixlowpan_frag_sfr) module.
+ *
+ * @attention   Must not be greater than 32.
+ */
+#ifndef GNRC_SIXLOWPAN_SFR_WIN_SIZE
+#define GNRC_SIXLOWPAN_SFR_WIN_SIZE         (16U)
+#endif
+
+/**
+ * @brief   Gap in microseconds between two recoverable fragments of a burst
+ *
+ * Gives a forwarding node on the path time to pass a fragment on before the
+ * next one arrives. With 0 the fragments of a burst are sent back-to-back.
+ *
+ * @note    Only applicable with
+ *          [gnrc_sixlowpan_frag_sfr](@ref net_gnrc_sixlowpan_frag_sfr) module.
+ */
+#ifndef GNRC_SIXLOWPAN_SFR_INTER_FRAME_GAP_US
+#define GNRC_SIXLOWPAN_SFR_INTER_FRAME_GAP_US   (100U)
+#endif
+
+/**
+ * @brief   Time in microseconds to wait for a fragment acknowledgment
+ *
+ * @note    Only applicable with
+ *          [gnrc_sixlowpan_frag_sfr](@ref net_gnrc_sixlowpan_frag_sfr) module.
+ */
+#ifndef GNRC_SIXLOWPAN_SFR_ARQ_TIMEOUT_US
+#define GNRC_SIXLOWPAN_SFR_ARQ_TIMEOUT_US   (700U * US_PER_MS)
+#endif
+
+/**
+ * @brief   Number of fragment acknowledgments to request again before the
+ *          sender gives up on a datagram
+ *
+ * @note    Only applicable with
+ *          [gnrc_sixlowpan_frag_sfr](@ref net_gnrc_sixlowpan_frag_sfr) module.
+ */
+#ifndef GNRC_SIXLOWPAN_SFR_FRAG_RETRIES
+#define GNRC_SIXLOWPAN_SFR_FRAG_RETRIES     (2U)
+#endif
+
+/**
+ * @brief   Number of datagrams that can be received with recoverable
+ *          fragments at the same time
+ *
+ * Entries time out after @ref GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US.
+ *
+ * @note    Only applicable with
+ *          [gnrc_sixlowpan_frag_sfr](@ref net_gnrc_sixlowpan_frag_sfr) module.
+ */
+#ifndef GNRC_SIXLOWPAN_SFR_RBUF_SIZE
+#define GNRC_SIXLOWPAN_SFR_RBUF_SIZE        (GNRC_SIXLOWPAN_FRAG_RBUF_SIZE)
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -56,11 +56,28 @@ extern "C" {
  * @brief   Message type for triggering garbage collection reassembly buffer
  */
 #define GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF     (0x0226)
+
+/**
+ * @brief   Message type for sending the next recoverable fragment of a
+ *          burst
+ *
+ * @note    Only used with the `gnrc_sixlowpan_frag_sfr` module
+ */
+#define GNRC_SIXLOWPAN_MSG_FRAG_SFR_SND     (0x0227)
+
+/**
+ * @brief   Message type for a timed out fragment acknowledgment
+ *
+ * @note    Only used with the `gnrc_sixlowpan_frag_sfr` module
+ */
+#define GNRC_SIXLOWPAN_MSG_FRAG_SFR_ARQ_TO  (0x0228)
 /** @} */
 
 /**
  * @brief   Fragment intervals to identify limits of fragments and duplicates.
  *
+ * The intervals of a reassembly buffer entry are sorted by their start.
+ *
  * @note    Fragments MUST NOT overlap and overlapping fragments are to be
  *          discarded
  *
@@ -146,13 +163,38 @@ typedef struct {
  */
 typedef struct {
     unsigned rbuf_full;     /**< counts the number of events where the
-                             *   reassembly buffer is full */
+                             *   reassembly buffer is full (or the source of
+                             *   a new datagram reached its quota) */
+    unsigned rbuf_timeout;  /**< counts the number of reassembly buffer
+                             *   entries removed because they timed out */
+    unsigned rbuf_evict_full;   /**< counts the number of reassembly buffer
+                                 *   entries removed for a new datagram,
+                                 *   because the buffer was full */
+    unsigned rbuf_evict_quota;  /**< counts the number of reassembly buffer
+                                 *   entries removed for a new datagram of the
+                                 *   same source, because the source reached
+                                 *   @ref GNRC_SIXLOWPAN_FRAG_RBUF_SRC_QUOTA */
+    unsigned rbuf_invalid;  /**< counts the number of reassembly buffer
+                             *   entries removed because a fragment overlapped
+                             *   another one or exceeded the datagram size */
     unsigned frag_full;     /**< counts the number of events that there where
                              *   no @ref gnrc_sixlowpan_msg_frag_t available */
 #if defined(MODULE_GNRC_SIXLOWPAN_FRAG_VRB) || DOXYGEN
     unsigned vrb_full;      /**< counts the number of events where the virtual
                              *   reassembly buffer is full */
 #endif
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) || DOXYGEN
+    unsigned sfr_sent;      /**< counts the number of recoverable fragments
+                             *   sent */
+    unsigned sfr_resent;    /**< counts the number of recoverable fragments
+                             *   sent again */
+    unsigned sfr_acks_sent; /**< counts the number of fragment
+                             *   acknowledgments sent */
+    unsigned sfr_acks_recv; /**< counts the number of fragment
+                             *   acknowledgments received */
+    unsigned sfr_aborted;   /**< counts the number of datagrams the sender
+                             *   gave up on */
+#endif
 } gnrc_sixlowpan_frag_stats_t;
 
 /**
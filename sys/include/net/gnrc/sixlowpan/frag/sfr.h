@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_sixlowpan_frag_sfr Selective fragment recovery
+ * @ingroup     net_gnrc_sixlowpan_frag
+ * @brief       6LoWPAN selective fragment recovery
+ *
+ * Instead of sending all fragments of a datagram blindly, the sender
+ * transmits them in paced bursts of at most @ref GNRC_SIXLOWPAN_SFR_WIN_SIZE
+ * fragments. The last fragment of a burst requests an acknowledgment, whose
+ * bitmap tells the sender which fragments the receiver has. Only the missing
+ * fragments are sent again, so the loss of a single frame does not cost the
+ * whole datagram.
+ *
+ * Datagrams with a unicast link-layer destination that fit into 32 fragments
+ * are sent with recoverable fragments, all others with the fragments of
+ * [RFC 4944](@ref net_gnrc_sixlowpan_frag). The latter are also used while
+ * all @ref GNRC_SIXLOWPAN_MSG_FRAG_SIZE senders of recoverable fragments are
+ * busy. Hence, all nodes of a link need to use this module.
+ *
+ * @see     [RFC 8931](https://tools.ietf.org/html/rfc8931)
+ * @{
+ *
+ * @file
+ * @brief   Selective fragment recovery definitions
+ *
+ * @author  RIOT developers <devel@riot-os.org>
+ */
+#ifndef NET_GNRC_SIXLOWPAN_FRAG_SFR_H
+#define NET_GNRC_SIXLOWPAN_FRAG_SFR_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "net/gnrc/netif.h"
+#include "net/gnrc/pkt.h"
+#include "net/gnrc/sixlowpan/config.h"
+#include "net/gnrc/sixlowpan/frag.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Checks if a datagram can be sent with recoverable fragments
+ *
+ * @param[in] pkt       A datagram with a @ref gnrc_netif_hdr_t as first snip.
+ *                      Must not be NULL.
+ * @param[in] netif     The interface to send @p pkt over. Must not be NULL.
+ *
+ * @return  true, if @p pkt has a unicast destination, fits into
+ *          32 fragments and a sender entry is available.
+ * @return  false, otherwise.
+ */
+bool gnrc_sixlowpan_frag_sfr_applicable(gnrc_pktsnip_t *pkt,
+                                        gnrc_netif_t *netif);
+
+/**
+ * @brief   Sends a datagram with recoverable fragments
+ *
+ * @pre `gnrc_sixlowpan_frag_sfr_applicable(pkt, netif)`
+ *
+ * @param[in] pkt       A datagram with a @ref gnrc_netif_hdr_t as first snip.
+ *                      Must not be NULL. Released when the receiver
+ *                      acknowledged all fragments or the sender gave up.
+ * @param[in] ctx       Context for the packet. May be NULL.
+ * @param[in] page      Current 6Lo dispatch parsing page.
+ */
+void gnrc_sixlowpan_frag_sfr_send(gnrc_pktsnip_t *pkt, void *ctx,
+                                  unsigned page);
+
+/**
+ * @brief   Handles a packet containing a recoverable fragment or a fragment
+ *          acknowledgment
+ *
+ * @param[in] pkt       The packet to handle
+ * @param[in] ctx       Context for the packet. May be NULL.
+ * @param[in] page      Current 6Lo dispatch parsing page.
+ */
+void gnrc_sixlowpan_frag_sfr_recv(gnrc_pktsnip_t *pkt, void *ctx,
+                                  unsigned page);
+
+/**
+ * @brief   Handles the timer events of the sender
+ *
+ * @see GNRC_SIXLOWPAN_MSG_FRAG_SFR_SND
+ * @see GNRC_SIXLOWPAN_MSG_FRAG_SFR_ARQ_TO
+ *
+ * @param[in] msg       The message of the event.
+ */
+void gnrc_sixlowpan_frag_sfr_handle_msg(msg_t *msg);
+
+/**
+ * @brief   Garbage collects timed out datagrams of the receiver
+ */
+void gnrc_sixlowpan_frag_sfr_gc(void);
+
+#if defined(TEST_SUITES) || defined(DOXYGEN)
+/**
+ * @brief   Resets the sender and the receiver state
+ *
+ * @note    Only available with `TEST_SUITES`.
+ */
+void gnrc_sixlowpan_frag_sfr_reset(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_SIXLOWPAN_FRAG_SFR_H */
+/** @} */
@@ -114,6 +114,79 @@ int gnrc_tcp_open_active(gnrc_tcp_tcb_t *tcb,  uint8_t address_family,
 int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
                           const char *local_addr, uint16_t local_port);
 
+/**
+ * @brief Listens for incomming connections with a pool of TCBs.
+ *
+ * All TCBs in @p tcbs wait for connection requests to @p local_port. The
+ * connections are established without blocking a thread, established
+ * connections are taken from the queue with gnrc_tcp_accept(). Connection
+ * requests, that arrive while all TCBs are in use, are dropped, so the peer
+ * retries later.
+ *
+ * A TCB of the queue allocates a receive buffer with each connection request,
+ * so "GNRC_TCP_RCV_BUFFERS" limits the number of concurrent connections.
+ *
+ * @pre @p queue must not be NULL and must not be listening.
+ * @pre @p tcbs must not be NULL and must not be in use.
+ * @pre @p tcbs_len must not be 0.
+ * @pre @p local_port must not be 0.
+ *
+ * @param[out]    queue            Listening queue to initialize.
+ * @param[in,out] tcbs             Pool of TCBs, they are initialized by this function.
+ * @param[in]     tcbs_len         Number of TCBs in @p tcbs.
+ * @param[in]     address_family   Address family of @p local_addr.
+ * @param[in]     local_addr       If not NULL the connections are bound to @p local_addr.
+ *                                 If NULL connection requests to all local ip
+ *                                 addresses are valid.
+ * @param[in]     local_port       Port number to listen on.
+ *
+ * @returns   Zero on success.
+ *            -EAFNOSUPPORT if @p address_family is not supported.
+ *            -EINVAL if @p local_addr is invalid.
+ */
+int gnrc_tcp_listen(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t *tcbs, size_t tcbs_len,
+                    uint8_t address_family, const char *local_addr, uint16_t local_port);
+
+/**
+ * @brief Takes an established connection from a listening queue.
+ *
+ * The accepted TCB is used with the other functions of this API like a TCB
+ * opened with gnrc_tcp_open_passive(). After gnrc_tcp_close() or
+ * gnrc_tcp_abort() it returns to the queue and listens again.
+ *
+ * @pre gnrc_tcp_listen() must have been successfully called on @p queue.
+ * @pre @p queue must not be NULL.
+ * @pre @p tcb must not be NULL.
+ *
+ * @param[in,out] queue                 Listening queue.
+ * @param[out]    tcb                   The TCB of the accepted connection.
+ * @param[in]     timeout_duration_us   If zero the function returns immediately.
+ *                                      If not zero the function blocks until a
+ *                                      connection was established or
+ *                                      @p timeout_duration_us microseconds passed.
+ *
+ * @returns   Zero on success.
+ *            -EINVAL if @p queue is not listening.
+ *            -EAGAIN if @p timeout_duration_us is zero and no connection is established.
+ *            -ETIMEDOUT if @p timeout_duration_us expired.
+ */
+int gnrc_tcp_accept(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t **tcb,
+                    const uint32_t timeout_duration_us);
+
+/**
+ * @brief Stops listening.
+ *
+ * All connections of the queue, that were not accepted, are aborted.
+ * Accepted connections stay open, they are no longer returned to the queue.
+ *
+ * @pre @p queue must not be NULL.
+ *
+ * @note Blocks while gnrc_tcp_accept() waits on @p queue.
+ *
+ * @param[in,out] queue   Listening queue.
+ */
+void gnrc_tcp_stop_listen(gnrc_tcp_tcb_queue_t *queue);
+
 /**
  * @brief Transmit data to connected peer.
  *
@@ -122,6 +195,10 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
  * @pre @p data must not be NULL.
  *
  * @note Blocks until up to @p len bytes were transmitted or an error occured.
+ *       Without the module `gnrc_tcp_sliding_window`, transmitted means
+ *       acknowledged by the peer. With it, transmitted bytes may still be in
+ *       flight, they are retransmitted as needed until the connection is
+ *       closed.
  *
  * @param[in,out] tcb                        TCB holding the connection information.
  * @param[in]     data                       Pointer to the data that should be transmitted.
@@ -135,6 +212,7 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
  *            -ECONNRESET if connection was resetted by the peer.
  *            -ECONNABORTED if the connection was aborted.
  *            -ETIMEDOUT if @p user_timeout_duration_us expired.
+ *            -ENOMEM if no packet could be allocated.
  */
 ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                       const uint32_t user_timeout_duration_us);
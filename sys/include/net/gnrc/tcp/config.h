@@ -79,6 +79,57 @@ extern "C" {
 #define GNRC_TCP_RCV_BUF_SIZE (GNRC_TCP_DEFAULT_WINDOW)
 #endif
 
+/**
+ * @brief Number of buckets of the table used to find the TCB of a received
+ *        segment
+ *
+ * @attention   Must be a power of two.
+ */
+#ifndef GNRC_TCP_TCB_TABLE_SIZE
+#define GNRC_TCP_TCB_TABLE_SIZE (8U)
+#endif
+
+/**
+ * @brief Number of SYN+ACK retransmissions, after which a connection request
+ *        to a listening queue is dropped
+ */
+#ifndef GNRC_TCP_SYN_ACK_RETRIES
+#define GNRC_TCP_SYN_ACK_RETRIES (5U)
+#endif
+
+/**
+ * @brief Maximum number of unacknowledged segments in flight
+ *
+ * Without the module `gnrc_tcp_sliding_window` only one segment is in flight
+ * at a time, so every segment must be acknowledged before the next is sent.
+ */
+#ifndef GNRC_TCP_RETRANSMIT_QUEUE_SIZE
+#ifdef MODULE_GNRC_TCP_SLIDING_WINDOW
+#define GNRC_TCP_RETRANSMIT_QUEUE_SIZE (8U)
+#else
+#define GNRC_TCP_RETRANSMIT_QUEUE_SIZE (1U)
+#endif
+#endif
+
+/**
+ * @brief Number of duplicate ACKs that trigger a fast retransmit (see RFC 5681)
+ */
+#ifndef GNRC_TCP_DUPACK_THRESHOLD
+#define GNRC_TCP_DUPACK_THRESHOLD (3U)
+#endif
+
+/**
+ * @brief Number of ranges of out-of-order data a connection keeps in its
+ *        receive buffer
+ *
+ * Only used with the module `gnrc_tcp_sack`. Each range is reported to the
+ * peer as one block of the SACK option, so at most four are possible. A
+ * segment that would start another range is dropped.
+ */
+#ifndef GNRC_TCP_SACK_BLOCKS
+#define GNRC_TCP_SACK_BLOCKS (4U)
+#endif
+
 /**
  * @brief Lower bound for RTO = 1 sec (see RFC 6298)
  */
@@ -20,6 +20,7 @@
 #ifndef NET_GNRC_TCP_TCB_H
 #define NET_GNRC_TCP_TCB_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include "kernel_types.h"
 #include "ringbuffer.h"
@@ -43,6 +44,19 @@ extern "C" {
  */
 #define GNRC_TCP_TCB_MBOX_SIZE (8U)
 
+/**
+ * @brief Range of sequence numbers, as reported by a block of the SACK option.
+ */
+typedef struct {
+    uint32_t left;         /**< First sequence number of the range */
+    uint32_t right;        /**< Sequence number following the range */
+} gnrc_tcp_sack_block_t;
+
+/**
+ * @brief Listening queue of GNRC TCP, forward declaration.
+ */
+struct _gnrc_tcp_tcb_queue;
+
 /**
  * @brief Transmission control block of GNRC TCP.
  */
@@ -68,22 +82,60 @@ typedef struct _transmission_control_block {
     uint32_t irs;          /**< Initial received sequence number */
     uint16_t mss;          /**< The peers MSS */
     uint32_t rtt_start;    /**< Timer value for rtt estimation */
+    uint32_t rtt_seq;      /**< Sequence number that ends the timed segment */
     int32_t rtt_var;       /**< Round trip time variance */
     int32_t srtt;          /**< Smoothed round trip time */
     int32_t rto;           /**< Retransmission timeout duration */
     uint8_t retries;       /**< Number of retransmissions */
     xtimer_t tim_tout;     /**< Timer struct for timeouts */
     msg_t msg_tout;        /**< Message, sent on timeouts */
-    gnrc_pktsnip_t *pkt_retransmit;   /**< Pointer to packet in "retransmit queue" */
+#ifdef MODULE_GNRC_TCP_SLIDING_WINDOW
+    uint32_t cwnd;         /**< Congestion window */
+    uint32_t ssthresh;     /**< Slow start threshold */
+    uint32_t recover;      /**< Highest sequence number sent, when loss recovery began */
+    uint8_t dupacks;       /**< Number of duplicate ACKs received in a row */
+    uint8_t in_recovery;   /**< Loss recovery state */
+#endif
+    /**
+     * @brief Unacknowledged packets, ordered by sequence number. One more than
+     *        @ref GNRC_TCP_RETRANSMIT_QUEUE_SIZE, so a FIN still fits if the
+     *        queue is filled with data.
+     */
+    gnrc_pktsnip_t *rtx_queue[GNRC_TCP_RETRANSMIT_QUEUE_SIZE + 1];
+    uint8_t rtx_len;       /**< Number of packets in rtx_queue */
+#ifdef MODULE_GNRC_TCP_SACK
+    uint16_t rtx_sacked;   /**< Bitmask of packets in rtx_queue the peer acknowledged selectively */
+    uint16_t rtx_resent;   /**< Bitmask of packets in rtx_queue retransmitted in loss recovery */
+    uint32_t rtx_avoided;  /**< Number of packets acknowledged selectively, so never retransmitted */
+    gnrc_tcp_sack_block_t ooo[GNRC_TCP_SACK_BLOCKS];  /**< Out-of-order data in rcv_buf,
+                                                           most recently changed first */
+    uint8_t ooo_len;       /**< Number of ranges in ooo */
+    uint16_t ooo_bytes;    /**< Number of bytes currently held out of order */
+#endif
     msg_t mbox_raw[GNRC_TCP_TCB_MBOX_SIZE];   /**< Msg queue for mbox */
     mbox_t mbox;             /**< TCB mbox for synchronization */
     uint8_t *rcv_buf_raw;    /**< Pointer to the receive buffer */
     ringbuffer_t rcv_buf;    /**< Receive buffer data structure */
     mutex_t fsm_lock;        /**< Mutex for FSM access synchronization */
     mutex_t function_lock;   /**< Mutex for function call synchronization */
+    struct _gnrc_tcp_tcb_queue *queue;          /**< Listening queue, NULL if none */
     struct _transmission_control_block *next;   /**< Pointer next TCB */
 } gnrc_tcp_tcb_t;
 
+/**
+ * @brief Listening queue of GNRC TCP: A pool of TCBs accepting connections on
+ *        the same port.
+ */
+typedef struct _gnrc_tcp_tcb_queue {
+    gnrc_tcp_tcb_t *tcbs;    /**< Pool of TCBs */
+    size_t tcbs_len;         /**< Number of TCBs in tcbs */
+    uint16_t local_port;     /**< Port number listened on */
+    msg_t mbox_raw[GNRC_TCP_TCB_MBOX_SIZE];   /**< Msg queue for mbox */
+    mbox_t mbox;             /**< Mbox to wait for established connections */
+    mutex_t lock;            /**< Mutex for accept call synchronization */
+    struct _gnrc_tcp_tcb_queue *next;   /**< Pointer to next listening queue */
+} gnrc_tcp_tcb_queue_t;
+
 #ifdef __cplusplus
 }
 #endif
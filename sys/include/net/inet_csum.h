@@ -73,6 +73,56 @@ static inline uint16_t inet_csum(uint16_t sum, const uint8_t *buf, uint16_t len)
     return inet_csum_slice(sum, buf, len, 0);
 }
 
+/**
+ * @brief   Updates an Internet Checksum after a 16-bit word in its domain
+ *          changed
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc1624#section-3">
+ *          RFC 1624, section 3
+ *      </a>
+ *
+ * @details Saves recalculating the checksum over the whole domain, when only
+ *          a field of a header changes. The words may be given in either byte
+ *          order, as long as @p csum is given in the same.
+ *
+ * @param[in] csum      The normalized checksum (i. e. its 1's complement was
+ *                      taken, as carried in a header) of the old domain.
+ * @param[in] old_word  The word before the change.
+ * @param[in] new_word  The word after the change.
+ *
+ * @return  The normalized checksum of the changed domain.
+ */
+static inline uint16_t inet_csum_update(uint16_t csum, uint16_t old_word,
+                                        uint16_t new_word)
+{
+    /* HC' = ~(~HC + ~m + m') (eqn. 3), which unlike HC' = HC - ~m - m'
+     * (eqn. 4) needs no special case for a 1's complement -0 */
+    uint32_t sum = (uint16_t)~csum + (uint16_t)~old_word + new_word;
+
+    sum = (sum & 0xffff) + (sum >> 16);
+    sum = (sum & 0xffff) + (sum >> 16);
+    return ~sum;
+}
+
+/**
+ * @brief   Updates an Internet Checksum after a range of bytes in its domain
+ *          changed
+ *
+ * @see inet_csum_update()
+ *
+ * @pre The range starts at an even offset into the checksum domain.
+ *
+ * @param[in] csum      The normalized checksum (i. e. its 1's complement was
+ *                      taken, as carried in a header) of the old domain.
+ * @param[in] old_buf   The bytes before the change.
+ * @param[in] new_buf   The bytes after the change.
+ * @param[in] len       Length of @p old_buf and @p new_buf in byte.
+ *
+ * @return  The normalized checksum of the changed domain.
+ */
+uint16_t inet_csum_update_buf(uint16_t csum, const uint8_t *old_buf,
+                              const uint8_t *new_buf, uint16_t len);
+
 #ifdef __cplusplus
 }
 #endif
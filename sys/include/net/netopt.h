@@ -662,6 +662,25 @@ typedef enum {
      */
     NETOPT_RX_SYMBOL_TIMEOUT,
 
+    /**
+     * @brief   (@ref netopt_enable_t) device verifies the UDP, TCP and
+     *          ICMPv6 checksums of received packets
+     *
+     * When enabled, the device only passes packets up that have a valid
+     * checksum, so the network stack does not need to verify it again.
+     */
+    NETOPT_RX_CSUM_VERIFIED,
+
+    /**
+     * @brief   (@ref netopt_enable_t) device calculates the UDP, TCP and
+     *          ICMPv6 checksums of packets to send
+     *
+     * When enabled, the network stack leaves the checksum field of those
+     * packets as is and the device fills in the checksum over the
+     * pseudo-header and the upper layer packet when sending it.
+     */
+    NETOPT_TX_CSUM_OFFLOAD,
+
     /* add more options if needed */
 
     /**
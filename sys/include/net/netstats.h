@@ -51,6 +51,8 @@ typedef struct {
     uint32_t tx_bytes;          /**< sent bytes */
     uint32_t rx_count;          /**< received (data) packets */
     uint32_t rx_bytes;          /**< received bytes */
+    uint32_t rx_copied;         /**< received packets moved in memory after
+                                     reception, e.g. to split off a header */
 } netstats_t;
 
 #ifdef __cplusplus
@@ -141,6 +141,140 @@ static inline bool sixlowpan_frag_is(sixlowpan_frag_t *hdr)
 }
 /** @} */
 
+/**
+ * @name    6LoWPAN selective fragment recovery header definitions
+ * @see     <a href="https://tools.ietf.org/html/rfc8931#section-5">
+ *              RFC 8931, section 5
+ *          </a>
+ * @{
+ */
+#define SIXLOWPAN_SFR_DISP_MASK     (0xfe)      /**< mask for SFR dispatches */
+#define SIXLOWPAN_SFR_RFRAG_DISP    (0xe8)      /**< dispatch for recoverable
+                                                 *   fragments (RFRAG) */
+#define SIXLOWPAN_SFR_ACK_DISP      (0xea)      /**< dispatch for fragment
+                                                 *   acknowledgments (RFRAG-ACK) */
+#define SIXLOWPAN_SFR_ECN           (0x01)      /**< explicit congestion
+                                                 *   notification flag */
+#define SIXLOWPAN_SFR_ACK_REQ       (0x8000U)   /**< acknowledgment request
+                                                 *   flag in
+                                                 *   sixlowpan_sfr_rfrag_t::ar_seq_fs */
+#define SIXLOWPAN_SFR_SEQ_MASK      (0x7c00U)   /**< mask for the sequence
+                                                 *   number in
+                                                 *   sixlowpan_sfr_rfrag_t::ar_seq_fs */
+#define SIXLOWPAN_SFR_SEQ_POS       (10U)       /**< position of the sequence
+                                                 *   number in
+                                                 *   sixlowpan_sfr_rfrag_t::ar_seq_fs */
+#define SIXLOWPAN_SFR_SEQ_MAX       (0x1fU)     /**< maximum sequence number */
+#define SIXLOWPAN_SFR_FRAG_SIZE_MASK (0x03ffU)  /**< mask for the fragment
+                                                 *   size in
+                                                 *   sixlowpan_sfr_rfrag_t::ar_seq_fs */
+#define SIXLOWPAN_SFR_ACK_BITMAP_FULL   (0xffffffffUL)  /**< bitmap to
+                                                         *   acknowledge a
+                                                         *   complete datagram */
+
+/**
+ * @brief   Recoverable fragment (RFRAG) header
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc8931#section-5.1">
+ *          RFC 8931, section 5.1
+ *      </a>
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t disp_ecn;               /**< dispatch and ECN flag */
+    uint8_t tag;                    /**< datagram tag */
+    /**
+     * @brief   Acknowledgment request flag, sequence number and fragment size
+     */
+    network_uint16_t ar_seq_fs;
+    /**
+     * @brief   Offset of the fragment in the compressed datagram, datagram
+     *          size for the fragment with sequence number 0
+     */
+    network_uint16_t offset;
+} sixlowpan_sfr_rfrag_t;
+
+/**
+ * @brief   Fragment acknowledgment (RFRAG-ACK) header
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc8931#section-5.2">
+ *          RFC 8931, section 5.2
+ *      </a>
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t disp_ecn;               /**< dispatch and ECN flag */
+    uint8_t tag;                    /**< datagram tag */
+    /**
+     * @brief   Acknowledgment bitmap, the most significant bit acknowledges
+     *          the fragment with sequence number 0
+     */
+    network_uint32_t bitmap;
+} sixlowpan_sfr_ack_t;
+
+/**
+ * @brief   Checks if a given header is a recoverable fragment header.
+ *
+ * @param[in] data  Data of a datagram. Must not be NULL.
+ *
+ * @return  true, if @p data starts with an RFRAG header.
+ * @return  false, if @p data does not start with an RFRAG header.
+ */
+static inline bool sixlowpan_sfr_rfrag_is(const uint8_t *data)
+{
+    return ((data[0] & SIXLOWPAN_SFR_DISP_MASK) == SIXLOWPAN_SFR_RFRAG_DISP);
+}
+
+/**
+ * @brief   Checks if a given header is a fragment acknowledgment header.
+ *
+ * @param[in] data  Data of a datagram. Must not be NULL.
+ *
+ * @return  true, if @p data starts with an RFRAG-ACK header.
+ * @return  false, if @p data does not start with an RFRAG-ACK header.
+ */
+static inline bool sixlowpan_sfr_ack_is(const uint8_t *data)
+{
+    return ((data[0] & SIXLOWPAN_SFR_DISP_MASK) == SIXLOWPAN_SFR_ACK_DISP);
+}
+
+/**
+ * @brief   Gets the sequence number of a recoverable fragment.
+ *
+ * @param[in] hdr   An RFRAG header.
+ *
+ * @return  The sequence number of the fragment.
+ */
+static inline unsigned sixlowpan_sfr_rfrag_get_seq(const sixlowpan_sfr_rfrag_t *hdr)
+{
+    return (byteorder_ntohs(hdr->ar_seq_fs) & SIXLOWPAN_SFR_SEQ_MASK) >>
+           SIXLOWPAN_SFR_SEQ_POS;
+}
+
+/**
+ * @brief   Gets the fragment size of a recoverable fragment.
+ *
+ * @param[in] hdr   An RFRAG header.
+ *
+ * @return  The number of bytes of the compressed datagram in the fragment.
+ */
+static inline unsigned sixlowpan_sfr_rfrag_get_frag_size(const sixlowpan_sfr_rfrag_t *hdr)
+{
+    return byteorder_ntohs(hdr->ar_seq_fs) & SIXLOWPAN_SFR_FRAG_SIZE_MASK;
+}
+
+/**
+ * @brief   Checks if a recoverable fragment requests an acknowledgment.
+ *
+ * @param[in] hdr   An RFRAG header.
+ *
+ * @return  true, if the fragment requests an acknowledgment.
+ * @return  false, if the fragment does not request an acknowledgment.
+ */
+static inline bool sixlowpan_sfr_rfrag_ack_req(const sixlowpan_sfr_rfrag_t *hdr)
+{
+    return (byteorder_ntohs(hdr->ar_seq_fs) & SIXLOWPAN_SFR_ACK_REQ);
+}
+/** @} */
+
 /**
  * @name    6LoWPAN IPHC dispatch definitions
  * @{
@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_softirq Deferred interrupt work
+ * @ingroup     sys
+ * @brief       Bottom-half queue served by a single high priority thread
+ *
+ * ISRs should only acknowledge their interrupt source and leave the actual
+ * work to thread context, so interrupts are not kept waiting behind long
+ * handlers. This module provides a shared worker thread for that work.
+ *
+ * An ISR raises a @ref softirq_t, which is queued unless already pending.
+ * The worker calls the handler of each raised softirq with a budget, the
+ * number of work units (e.g. frames or buffers) the handler may process in
+ * one go. A handler that has work left over returns a non-zero value and is
+ * queued again behind all other pending softirqs, so one busy source cannot
+ * monopolize the worker.
+ *
+ * A run of the worker calls at most @ref SOFTIRQ_RUN_ITEMS handlers. If that
+ * many were called, the worker pauses for @ref SOFTIRQ_RUN_GAP_US before the
+ * next run, leaving the remaining softirqs queued. So sustained interrupt
+ * load takes a bounded share of the CPU and cannot starve the threads.
+ *
+ * Unlike @ref sys_irq_handler, which serializes drivers that need blocking
+ * bus access, handlers run here must not block.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static int _rx_handler(softirq_t *sirq, unsigned budget)
+ * {
+ *     foo_t *dev = sirq->arg;
+ *
+ *     while (budget-- && foo_rx_pending(dev)) {
+ *         foo_rx_one(dev);
+ *     }
+ *     return foo_rx_pending(dev);
+ * }
+ *
+ * static softirq_t _rx = SOFTIRQ_INIT(_rx_handler, &foo_dev);
+ *
+ * static void _isr(void *arg)
+ * {
+ *     foo_irq_ack(arg);
+ *     softirq_raise(&_rx);
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @{
+ * @file
+ * @brief       Deferred interrupt work API
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ */
+
+#ifndef SOFTIRQ_H
+#define SOFTIRQ_H
+
+#include "event.h"
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Priority of the worker thread
+ */
+#ifndef SOFTIRQ_PRIO
+#define SOFTIRQ_PRIO            (0)
+#endif
+
+/**
+ * @brief   Stack size of the worker thread
+ */
+#ifndef SOFTIRQ_STACKSIZE
+#define SOFTIRQ_STACKSIZE       (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Work units a handler may process per invocation
+ */
+#ifndef SOFTIRQ_BUDGET
+#define SOFTIRQ_BUDGET          (8U)
+#endif
+
+/**
+ * @brief   Handler calls per run of the worker
+ */
+#ifndef SOFTIRQ_RUN_ITEMS
+#define SOFTIRQ_RUN_ITEMS       (16U)
+#endif
+
+/**
+ * @brief   Pause in microseconds after a run that called
+ *          @ref SOFTIRQ_RUN_ITEMS handlers
+ */
+#ifndef SOFTIRQ_RUN_GAP_US
+#define SOFTIRQ_RUN_GAP_US      (1000U)
+#endif
+
+/**
+ * @brief   softirq forward declaration
+ */
+typedef struct softirq softirq_t;
+
+/**
+ * @brief   softirq handler
+ *
+ * @param[in] sirq      the softirq that was raised
+ * @param[in] budget    number of work units the handler may process
+ *
+ * @return  0 if all work is done
+ * @return  non-zero to be called again after the other pending softirqs
+ */
+typedef int (*softirq_handler_t)(softirq_t *sirq, unsigned budget);
+
+/**
+ * @brief   softirq structure
+ */
+struct softirq {
+    event_t super;              /**< event structure the worker queues */
+    softirq_handler_t handler;  /**< work handler */
+    void *arg;                  /**< handler argument */
+};
+
+/**
+ * @brief   softirq static initializer
+ *
+ * @param[in] _handler  work handler
+ * @param[in] _arg      handler argument
+ */
+#define SOFTIRQ_INIT(_handler, _arg) \
+    { .handler = _handler, .arg = _arg }
+
+/**
+ * @brief   Starts the worker thread
+ *
+ * Called by auto_init.
+ */
+void softirq_init(void);
+
+/**
+ * @brief   Queues a softirq for the worker
+ *
+ * Can be called from ISRs. Raising an already pending softirq has no effect.
+ *
+ * @param[in] sirq  the softirq to raise
+ */
+void softirq_raise(softirq_t *sirq);
+
+/**
+ * @brief   Removes a pending softirq from the queue
+ *
+ * @param[in] sirq  the softirq to cancel
+ */
+void softirq_cancel(softirq_t *sirq);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SOFTIRQ_H */
+/** @} */
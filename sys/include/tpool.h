@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_tpool Thread pool
+ * @ingroup     sys
+ * @brief       Work queue served by a pool of worker threads
+ *
+ * A thread pool runs jobs submitted by any thread on a set of worker
+ * threads. Jobs are caller-allocated and double as their own future: the
+ * submitter (or any other thread) can wait for a job to finish with
+ * tpool_wait(), poll it with tpool_done() or withdraw it with tpool_cancel()
+ * as long as no worker picked it up yet.
+ *
+ * All workers of a pool share one FIFO queue. RIOT schedules one thread at
+ * a time on a single core, so there is nothing to gain from per-worker
+ * queues and work stealing; several workers only help jobs that block.
+ *
+ * On native, the `tpool_pthread` module additionally lets a pool run its
+ * jobs on host threads instead (see tpool_start_host()), so CPU bound jobs
+ * of a simulation spread across the host's cores. Such jobs run outside of
+ * RIOT and must not call into RIOT or the C library functions RIOT wraps
+ * (e.g. `malloc()` or `printf()`), they may only compute on their argument.
+ *
+ * @{
+ * @file
+ * @brief       Thread pool API
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ */
+
+#ifndef TPOOL_H
+#define TPOOL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "clist.h"
+#include "cond.h"
+#include "mutex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Job function
+ *
+ * @param[in] arg   argument given to tpool_submit()
+ */
+typedef void (*tpool_fn_t)(void *arg);
+
+/**
+ * @brief   States of a job
+ */
+typedef enum {
+    TPOOL_JOB_IDLE = 0,         /**< not submitted yet */
+    TPOOL_JOB_QUEUED,           /**< waiting for a worker */
+    TPOOL_JOB_RUNNING,          /**< picked up by a worker */
+    TPOOL_JOB_DONE,             /**< finished */
+    TPOOL_JOB_CANCELLED,        /**< withdrawn before it ran */
+} tpool_job_state_t;
+
+/**
+ * @brief   Thread pool
+ */
+typedef struct {
+    clist_node_t queue;         /**< jobs waiting for a worker */
+    mutex_t lock;               /**< protects tpool_t::queue */
+    cond_t avail;               /**< signalled when a job got queued */
+#if defined(MODULE_TPOOL_PTHREAD) || defined(DOXYGEN)
+    bool host;                  /**< jobs run on host threads */
+#endif
+} tpool_t;
+
+/**
+ * @brief   Job, to be allocated by the submitter
+ */
+typedef struct {
+    clist_node_t node;          /**< pool queue entry */
+    tpool_t *pool;              /**< pool the job was submitted to */
+    tpool_fn_t fn;              /**< job function */
+    void *arg;                  /**< argument of tpool_job_t::fn */
+    mutex_t done;               /**< locked until the job finished */
+    volatile uint8_t state;     /**< @ref tpool_job_state_t */
+} tpool_job_t;
+
+/**
+ * @brief   Initializes a thread pool without any workers
+ *
+ * @param[out] pool     pool to initialize
+ */
+void tpool_init(tpool_t *pool);
+
+/**
+ * @brief   Starts worker threads for a pool
+ *
+ * @param[in] pool      pool to serve
+ * @param[in] stacks    stacks of all workers, one after the other
+ * @param[in] stacksize size of each worker's stack
+ * @param[in] n         number of workers to start
+ * @param[in] priority  priority of the workers
+ *
+ * @return  number of workers started
+ */
+unsigned tpool_start(tpool_t *pool, char *stacks, size_t stacksize,
+                     unsigned n, uint8_t priority);
+
+#if defined(MODULE_TPOOL_PTHREAD) || defined(DOXYGEN)
+/**
+ * @brief   Lets host threads serve a pool (native only)
+ *
+ * Only one pool can be served by host threads, and it must not get RIOT
+ * workers with tpool_start().
+ *
+ * @param[in] pool      pool to serve
+ * @param[in] n         number of host threads to start
+ *
+ * @return  number of host threads started
+ * @return  -EALREADY if another pool is served by host threads
+ */
+int tpool_start_host(tpool_t *pool, unsigned n);
+#endif
+
+/**
+ * @brief   Queues a job
+ *
+ * Can be called from thread context only.
+ *
+ * @pre     @p job is not queued or running
+ *
+ * @param[in] pool      pool to run the job in
+ * @param[out] job      job to queue
+ * @param[in] fn        job function
+ * @param[in] arg       argument of @p fn
+ */
+void tpool_submit(tpool_t *pool, tpool_job_t *job, tpool_fn_t fn, void *arg);
+
+/**
+ * @brief   Withdraws a job that did not start yet
+ *
+ * Threads waiting for the job are released.
+ *
+ * @param[in] pool      pool the job was submitted to
+ * @param[in] job       job to cancel
+ *
+ * @return  0 on success
+ * @return  -EBUSY if the job already started or finished
+ */
+int tpool_cancel(tpool_t *pool, tpool_job_t *job);
+
+/**
+ * @brief   Blocks until a job finished or got cancelled
+ *
+ * @param[in] job       job to wait for
+ *
+ * @return  @ref TPOOL_JOB_DONE or @ref TPOOL_JOB_CANCELLED
+ */
+tpool_job_state_t tpool_wait(tpool_job_t *job);
+
+/**
+ * @brief   Checks without blocking whether a job finished
+ *
+ * @param[in] job       job to check
+ *
+ * @return  true if the job finished or got cancelled
+ */
+static inline bool tpool_done(const tpool_job_t *job)
+{
+    return job->state >= TPOOL_JOB_DONE;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TPOOL_H */
+/** @} */
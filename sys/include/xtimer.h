@@ -20,6 +20,18 @@
  * number of active timers.  The reason for this is that multiplexing is
  * realized by next-first singly linked lists.
  *
+ * If the `xtimer_wheel` module is used, timers that expire later than
+ * @ref XTIMER_WHEEL_GRANULARITY ticks in the future are kept in a
+ * hierarchical timing wheel instead.  Insertion and removal of those timers
+ * has O(1) complexity, only timers that are about to expire are moved into
+ * the sorted lists described above.
+ *
+ * If the `xtimer_slack` module is used, timers can be given a slack: the time
+ * they may expire late.  Timers whose windows of (target, target + slack)
+ * overlap are fired by a single interrupt at the latest target that lies
+ * within all of their windows, so a sleeping CPU is woken up less often.
+ * Timers set without slack keep firing at their exact target.
+ *
  * @{
  * @file
  * @brief   xtimer interface definitions
@@ -66,6 +78,10 @@ typedef void (*xtimer_callback_t)(void*);
 
 /**
  * @brief xtimer timer structure
+ *
+ * A timer must be initialized with 0 before its first use, e.g. by defining
+ * it static or with an initializer. xtimer keeps track of whether it is set
+ * from then on.
  */
 typedef struct xtimer {
     struct xtimer *next;         /**< reference to next timer in timer lists */
@@ -74,8 +90,26 @@ typedef struct xtimer {
     xtimer_callback_t callback;  /**< callback function to call when timer
                                      expires */
     void *arg;                   /**< argument to pass to callback function */
+#if defined(MODULE_XTIMER_WHEEL) || defined(DOXYGEN)
+    struct xtimer **pprev;       /**< back reference to the pointer pointing
+                                      to this timer while it is stored in
+                                      the timing wheel, NULL otherwise */
+#endif
+#if defined(MODULE_XTIMER_SLACK) || defined(DOXYGEN)
+    uint32_t slack;              /**< ticks the timer may expire late */
+#endif
 } xtimer_t;
 
+/**
+ * @brief   Statistics on timer coalescing
+ *
+ * `fired - wakeups` is the number of interrupts saved by coalescing.
+ */
+typedef struct {
+    uint32_t wakeups;       /**< number of timer interrupts that fired timers */
+    uint32_t fired;         /**< number of timers fired by those interrupts */
+} xtimer_slack_stats_t;
+
 /**
  * @brief get the current system time as 32bit time stamp value
  *
@@ -207,6 +241,22 @@ static inline void xtimer_spin(xtimer_ticks32_t ticks);
  */
 static inline void xtimer_periodic_wakeup(xtimer_ticks32_t *last_wakeup, uint32_t period);
 
+/**
+ * @brief Like xtimer_periodic_wakeup(), but the wakeup may be delayed by up
+ * to @p slack microseconds to share an interrupt with other timers
+ *
+ * @p last_wakeup is advanced by exactly @p period, so the slack does not
+ * accumulate over several periods.
+ *
+ * @note    @p slack is ignored unless the `xtimer_slack` module is used
+ *
+ * @param[in] last_wakeup   base time stamp for the wakeup
+ * @param[in] period        time in microseconds that will be added to last_wakeup
+ * @param[in] slack         time in microseconds the wakeup may be late
+ */
+static inline void xtimer_periodic_wakeup_slack(xtimer_ticks32_t *last_wakeup,
+                                                uint32_t period, uint32_t slack);
+
 /**
  * @brief Set a timer that sends a message
  *
@@ -312,6 +362,36 @@ static inline void xtimer_set(xtimer_t *timer, uint32_t offset);
  */
 static inline void xtimer_set64(xtimer_t *timer, uint64_t offset_us);
 
+/**
+ * @brief Set a timer that may expire up to @p slack microseconds late
+ *
+ * Works like xtimer_set(), but allows the callback to be delayed so that
+ * it can be executed by the same interrupt as other timers.
+ *
+ * @note    @p slack is ignored unless the `xtimer_slack` module is used
+ *
+ * @param[in] timer     the timer structure to use
+ * @param[in] offset    time in microseconds from now specifying that timer's
+ *                      callback's execution time
+ * @param[in] slack     time in microseconds the callback may be late
+ */
+static inline void xtimer_set_slack(xtimer_t *timer, uint32_t offset,
+                                    uint32_t slack);
+
+/**
+ * @brief Set a timer that may expire up to @p slack_us microseconds late,
+ * 64bit version
+ *
+ * @note    @p slack_us is ignored unless the `xtimer_slack` module is used
+ *
+ * @param[in] timer       the timer structure to use
+ * @param[in] offset_us   time in microseconds from now specifying that
+ *                        timer's callback's execution time
+ * @param[in] slack_us    time in microseconds the callback may be late
+ */
+static inline void xtimer_set64_slack(xtimer_t *timer, uint64_t offset_us,
+                                      uint32_t slack_us);
+
 /**
  * @brief remove a timer
  *
@@ -469,6 +549,15 @@ int xtimer_mutex_lock_timeout(mutex_t *mutex, uint64_t us);
  */
 void xtimer_set_timeout_flag(xtimer_t *t, uint32_t timeout);
 
+#if defined(MODULE_XTIMER_SLACK) || defined(DOXYGEN)
+/**
+ * @brief   Get the timer coalescing statistics
+ *
+ * @param[out]  stats   statistics since boot
+ */
+void xtimer_slack_get_stats(xtimer_slack_stats_t *stats);
+#endif
+
 /**
  * @brief xtimer backoff value
  *
@@ -539,6 +628,35 @@ void xtimer_set_timeout_flag(xtimer_t *t, uint32_t timeout);
 #define XTIMER_PERIODIC_RELATIVE (512)
 #endif
 
+#ifndef XTIMER_WHEEL_GRANULARITY_SHIFT
+/**
+ * @brief   log2 of the width of a slot in the lowest level of the timing
+ *          wheel, in hardware ticks
+ *
+ * Only used with the `xtimer_wheel` module. Timers expiring sooner than
+ * @ref XTIMER_WHEEL_GRANULARITY are inserted into the sorted lists directly.
+ */
+#define XTIMER_WHEEL_GRANULARITY_SHIFT  (10U)
+#endif
+
+/**
+ * @brief   Width of a slot in the lowest level of the timing wheel, in
+ *          hardware ticks
+ */
+#define XTIMER_WHEEL_GRANULARITY    (1LU << XTIMER_WHEEL_GRANULARITY_SHIFT)
+
+#ifndef XTIMER_WHEEL_LEVELS
+/**
+ * @brief   Number of levels of the timing wheel
+ *
+ * Only used with the `xtimer_wheel` module. Each level has 32 slots, so the
+ * wheel covers `XTIMER_WHEEL_GRANULARITY * 32^XTIMER_WHEEL_LEVELS` ticks.
+ * Timers expiring later than that are kept in an unsorted overflow list that
+ * is only revisited when the top level wraps around.
+ */
+#define XTIMER_WHEEL_LEVELS         (4U)
+#endif
+
 /*
  * Default xtimer configuration
  */
@@ -84,6 +84,13 @@ int _xtimer_set_absolute(xtimer_t *timer, uint32_t target);
 void _xtimer_set(xtimer_t *timer, uint32_t offset);
 void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset);
 void _xtimer_periodic_wakeup(uint32_t *last_wakeup, uint32_t period);
+void _xtimer_periodic_wakeup_slack(uint32_t *last_wakeup, uint32_t period,
+                                   uint32_t slack);
+#ifdef MODULE_XTIMER_SLACK
+int _xtimer_set_absolute_slack(xtimer_t *timer, uint32_t target, uint32_t slack);
+void _xtimer_set64_slack(xtimer_t *timer, uint32_t offset, uint32_t long_offset,
+                         uint32_t slack);
+#endif
 void _xtimer_set_msg(xtimer_t *timer, uint32_t offset, msg_t *msg, kernel_pid_t target_pid);
 void _xtimer_set_msg64(xtimer_t *timer, uint64_t offset, msg_t *msg, kernel_pid_t target_pid);
 void _xtimer_set_wakeup(xtimer_t *timer, uint32_t offset, kernel_pid_t pid);
@@ -210,6 +217,14 @@ static inline void xtimer_periodic_wakeup(xtimer_ticks32_t *last_wakeup, uint32_
     _xtimer_periodic_wakeup(&last_wakeup->ticks32, _xtimer_ticks_from_usec(period));
 }
 
+static inline void xtimer_periodic_wakeup_slack(xtimer_ticks32_t *last_wakeup,
+                                                uint32_t period, uint32_t slack)
+{
+    _xtimer_periodic_wakeup_slack(&last_wakeup->ticks32,
+                                  _xtimer_ticks_from_usec(period),
+                                  _xtimer_ticks_from_usec(slack));
+}
+
 static inline void xtimer_set_msg(xtimer_t *timer, uint32_t offset, msg_t *msg, kernel_pid_t target_pid)
 {
     _xtimer_set_msg(timer, _xtimer_ticks_from_usec(offset), msg, target_pid);
@@ -241,6 +256,31 @@ static inline void xtimer_set64(xtimer_t *timer, uint64_t period_us)
     _xtimer_set64(timer, ticks, ticks >> 32);
 }
 
+static inline void xtimer_set_slack(xtimer_t *timer, uint32_t offset,
+                                    uint32_t slack)
+{
+#ifdef MODULE_XTIMER_SLACK
+    _xtimer_set64_slack(timer, _xtimer_ticks_from_usec(offset), 0,
+                        _xtimer_ticks_from_usec(slack));
+#else
+    (void)slack;
+    xtimer_set(timer, offset);
+#endif
+}
+
+static inline void xtimer_set64_slack(xtimer_t *timer, uint64_t offset_us,
+                                      uint32_t slack_us)
+{
+#ifdef MODULE_XTIMER_SLACK
+    uint64_t ticks = _xtimer_ticks_from_usec64(offset_us);
+    _xtimer_set64_slack(timer, ticks, ticks >> 32,
+                        _xtimer_ticks_from_usec(slack_us));
+#else
+    (void)slack_us;
+    xtimer_set64(timer, offset_us);
+#endif
+}
+
 static inline int xtimer_msg_receive_timeout(msg_t *msg, uint32_t timeout)
 {
     return _xtimer_msg_receive_timeout(msg, _xtimer_ticks_from_usec(timeout));
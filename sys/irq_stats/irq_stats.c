@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_irq_stats
+ * @{
+ *
+ * @file
+ * @brief       Interrupt-disabled section statistics implementation
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "irq.h"
+#include "irq_stats.h"
+#include "sched.h"
+
+/* the last entry catches all sites not fitting into the table */
+static irq_stats_site_t _sites[IRQ_STATS_SITES + 1];
+static uint64_t _thread_ticks[KERNEL_PID_LAST + 1];
+
+/* the currently open section, only touched with interrupts disabled */
+static const void *_site;
+static uint32_t _start;
+static kernel_pid_t _pid = KERNEL_PID_UNDEF;
+static uint8_t _open;
+
+static irq_stats_site_t *_lookup(const void *site)
+{
+    for (unsigned i = 0; i < IRQ_STATS_SITES; i++) {
+        if (_sites[i].site == site) {
+            return &_sites[i];
+        }
+        if (_sites[i].site == NULL) {
+            _sites[i].site = site;
+            return &_sites[i];
+        }
+    }
+    return &_sites[IRQ_STATS_SITES];
+}
+
+void irq_stats_begin(const void *site)
+{
+    _site = site;
+    _pid = irq_is_in() ? KERNEL_PID_UNDEF : sched_active_pid;
+    _open = 1;
+    /* last, so the bookkeeping above is not part of the section */
+    _start = irq_stats_now();
+}
+
+void irq_stats_end(void)
+{
+    uint32_t duration = irq_stats_now() - _start;
+
+    if (!_open) {
+        return;
+    }
+    _open = 0;
+
+    irq_stats_site_t *entry = _lookup(_site);
+    entry->count++;
+    if (duration > entry->max) {
+        entry->max = duration;
+    }
+    if (_pid != KERNEL_PID_UNDEF) {
+        _thread_ticks[_pid] += duration;
+    }
+}
+
+unsigned irq_stats_get(irq_stats_site_t *sites, unsigned n)
+{
+    unsigned count = 0;
+    unsigned state = irq_disable();
+
+    for (unsigned i = 0; (i <= IRQ_STATS_SITES) && (count < n); i++) {
+        if (_sites[i].count) {
+            sites[count++] = _sites[i];
+        }
+    }
+    irq_restore(state);
+
+    return count;
+}
+
+uint64_t irq_stats_thread_us(kernel_pid_t pid)
+{
+    if (!pid_is_valid(pid)) {
+        return 0;
+    }
+
+    unsigned state = irq_disable();
+    uint64_t ticks = _thread_ticks[pid];
+    irq_restore(state);
+
+    return ticks / irq_stats_ticks_per_us();
+}
+
+void irq_stats_reset(void)
+{
+    unsigned state = irq_disable();
+
+    memset(_sites, 0, sizeof(_sites));
+    memset(_thread_ticks, 0, sizeof(_thread_ticks));
+    irq_restore(state);
+}
+
+void irq_stats_print(void)
+{
+    irq_stats_site_t sites[IRQ_STATS_SITES + 1];
+    unsigned n = irq_stats_get(sites, IRQ_STATS_SITES + 1);
+    uint32_t tpu = irq_stats_ticks_per_us();
+
+    /* insertion sort by longest section, the table is small */
+    for (unsigned i = 1; i < n; i++) {
+        irq_stats_site_t tmp = sites[i];
+        unsigned j = i;
+        for (; (j > 0) && (sites[j - 1].max < tmp.max); j--) {
+            sites[j] = sites[j - 1];
+        }
+        sites[j] = tmp;
+    }
+
+    printf("%-10s | %10s | %10s\n", "site", "count", "max (us)");
+    for (unsigned i = 0; i < n; i++) {
+        if (sites[i].site) {
+            printf("%10p", sites[i].site);
+        }
+        else {
+            printf("%-10s", "other");
+        }
+        printf(" | %10" PRIu32 " | %6" PRIu32 ".%03" PRIu32 "\n",
+               sites[i].count, sites[i].max / tpu,
+               ((sites[i].max % tpu) * 1000) / tpu);
+    }
+}
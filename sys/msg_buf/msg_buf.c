@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_msg_buf
+ * @{
+ *
+ * @file
+ * @brief       Messages with attached buffers implementation
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ *
+ * @}
+ */
+
+#include <assert.h>
+
+#include "irq.h"
+#include "sched.h"
+#include "thread.h"
+
+#include "msg_buf.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/* owner of free buffers */
+#define OWNER_FREE      (KERNEL_PID_UNDEF)
+/* owner of buffers in a mailbox or allocated in interrupt context */
+#define OWNER_NONE      (KERNEL_PID_LAST + 1)
+
+static msg_buf_pool_t *_pools;
+
+static inline kernel_pid_t _me(void)
+{
+    return irq_is_in() ? OWNER_NONE : sched_active_pid;
+}
+
+void msg_buf_pool_init(msg_buf_pool_t *pool, void *storage, size_t size,
+                       size_t num)
+{
+    assert(size <= UINT16_MAX);
+
+    size = MSG_BUF_ELEM_SIZE(size);
+    memarray_init(&pool->mem, storage, size, num);
+    pool->storage = storage;
+    /* memarray only links the free buffers through their first word, the
+     * owner field stays intact */
+    for (size_t i = 0; i < num; i++) {
+        msg_buf_t *buf = (msg_buf_t *)((uint8_t *)storage + (i * size));
+        buf->owner = OWNER_FREE;
+    }
+
+    unsigned state = irq_disable();
+    if (_pools == NULL) {
+        sched_register_exit_cb(msg_buf_release_all);
+    }
+    pool->next = _pools;
+    _pools = pool;
+    irq_restore(state);
+}
+
+msg_buf_t *msg_buf_alloc(msg_buf_pool_t *pool)
+{
+    unsigned state = irq_disable();
+    msg_buf_t *buf = memarray_alloc(&pool->mem);
+
+    if (buf) {
+        buf->pool = pool;
+        buf->owner = _me();
+        buf->len = 0;
+    }
+    irq_restore(state);
+    DEBUG("msg_buf: allocated %p\n", (void *)buf);
+    return buf;
+}
+
+static void _free(msg_buf_t *buf)
+{
+    buf->owner = OWNER_FREE;
+    memarray_free(&buf->pool->mem, buf);
+}
+
+void msg_buf_free(msg_buf_t *buf)
+{
+    unsigned state = irq_disable();
+
+    assert(buf->owner != OWNER_FREE);
+    DEBUG("msg_buf: freeing %p\n", (void *)buf);
+    _free(buf);
+    irq_restore(state);
+}
+
+int msg_buf_send(msg_t *m, msg_buf_t *buf, kernel_pid_t target_pid)
+{
+    kernel_pid_t me = _me();
+    int res;
+
+    assert(buf->owner == me);
+    m->content.ptr = buf;
+    /* the receiver may run and release the buffer before msg_send()
+     * returns, so hand it over beforehand */
+    buf->owner = target_pid;
+    res = msg_send(m, target_pid);
+    if (res != 1) {
+        buf->owner = me;
+    }
+    return res;
+}
+
+int msg_buf_try_send(msg_t *m, msg_buf_t *buf, kernel_pid_t target_pid)
+{
+    kernel_pid_t me = _me();
+    int res;
+
+    assert(buf->owner == me);
+    m->content.ptr = buf;
+    buf->owner = target_pid;
+    res = msg_try_send(m, target_pid);
+    if (res != 1) {
+        buf->owner = me;
+    }
+    return res;
+}
+
+#ifdef MODULE_CORE_MBOX
+void msg_buf_mbox_put(mbox_t *mbox, msg_t *m, msg_buf_t *buf)
+{
+    assert(buf->owner == _me());
+    m->content.ptr = buf;
+    buf->owner = OWNER_NONE;
+    mbox_put(mbox, m);
+}
+
+int msg_buf_mbox_try_put(mbox_t *mbox, msg_t *m, msg_buf_t *buf)
+{
+    kernel_pid_t me = _me();
+
+    assert(buf->owner == me);
+    m->content.ptr = buf;
+    buf->owner = OWNER_NONE;
+    if (!mbox_try_put(mbox, m)) {
+        buf->owner = me;
+        return 0;
+    }
+    return 1;
+}
+
+#endif
+
+msg_buf_t *msg_buf_claim(msg_t *m)
+{
+    msg_buf_t *buf = m->content.ptr;
+
+    assert(buf->owner != OWNER_FREE);
+    buf->owner = _me();
+    return buf;
+}
+
+void msg_buf_release_all(kernel_pid_t pid)
+{
+    unsigned state = irq_disable();
+
+    for (msg_buf_pool_t *pool = _pools; pool; pool = pool->next) {
+        uint8_t *elem = pool->storage;
+
+        for (size_t i = 0; i < pool->mem.num; i++, elem += pool->mem.size) {
+            msg_buf_t *buf = (msg_buf_t *)elem;
+
+            if (buf->owner == pid) {
+                DEBUG("msg_buf: releasing %p of exiting thread %"
+                      PRIkernel_pid "\n", (void *)buf, pid);
+                _free(buf);
+            }
+        }
+    }
+    irq_restore(state);
+}
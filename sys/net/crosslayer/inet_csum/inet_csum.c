@@ -14,12 +14,47 @@
 
 #include <inttypes.h>
 #include <stdio.h>
+#include <string.h>
+
+#include "byteorder.h"
 #include "od.h"
 #include "net/inet_csum.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+/* Sums up the even number of bytes len in buf as 16-bit words in network byte
+ * order. The one's complement sum is independent of byte order (see RFC 1071,
+ * section 2 (B)), so the words are summed up in host byte order 32 bits at a
+ * time and only the folded result is swapped. */
+static uint16_t _sum_words(const uint8_t *buf, size_t len)
+{
+    uint64_t acc = 0;
+    uint32_t word;
+    uint16_t half;
+
+    for (; len >= 16; buf += 16, len -= 16) {
+        uint32_t words[4];
+
+        /* compiles to plain loads where unaligned access is supported */
+        memcpy(words, buf, sizeof(words));
+        acc += (uint64_t)words[0] + words[1] + words[2] + words[3];
+    }
+    for (; len >= sizeof(word); buf += sizeof(word), len -= sizeof(word)) {
+        memcpy(&word, buf, sizeof(word));
+        acc += word;
+    }
+    if (len) {
+        memcpy(&half, buf, sizeof(half));
+        acc += half;
+    }
+    acc = (acc & 0xffffffff) + (acc >> 32);
+    acc = (acc & 0xffffffff) + (acc >> 32);
+    word = (acc & 0xffff) + (acc >> 16);
+    word = (word & 0xffff) + (word >> 16);
+    return ntohs(word);
+}
+
 uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t accum_len)
 {
     uint32_t csum = sum;
@@ -44,10 +79,8 @@ uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t
         accum_len++;
     }
 
-    for (unsigned i = 0; i < (len >> 1); buf += 2, i++) {
-        csum += (uint16_t)(*buf << 8) + *(buf + 1); /* group bytes by 16-byte words */
-                                                    /* and add them */
-    }
+    csum += _sum_words(buf, len & ~1);  /* group bytes by 16-byte words */
+    buf += len & ~1;                    /* and add them */
 
     if ((accum_len + len) & 1)          /* if accumulated length is odd */
         csum += (uint16_t)(*buf << 8);  /* add last byte as top half of 16-byte word */
@@ -62,4 +95,11 @@ uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t
     return csum;
 }
 
+uint16_t inet_csum_update_buf(uint16_t csum, const uint8_t *old_buf,
+                              const uint8_t *new_buf, uint16_t len)
+{
+    return inet_csum_update(csum, inet_csum(0, old_buf, len),
+                            inet_csum(0, new_buf, len));
+}
+
 /** @} */
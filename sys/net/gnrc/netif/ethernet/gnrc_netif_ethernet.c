@@ -165,9 +165,25 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
     gnrc_pktsnip_t *pkt = NULL;
 
     if (bytes_expected > 0) {
-        pkt = gnrc_pktbuf_add(NULL, NULL,
-                              bytes_expected,
-                              GNRC_NETTYPE_UNDEF);
+        gnrc_pktsnip_t *eth_hdr = NULL;
+        ethernet_hdr_t hdr_buf;
+        ethernet_hdr_t *hdr = &hdr_buf;
+        /* skip the copy gnrc_pktbuf_mark() may need to split off the header */
+        bool scatter = (dev->driver->recv_iolist != NULL) &&
+                       (bytes_expected > (int)sizeof(ethernet_hdr_t));
+        int nread;
+
+        if (scatter) {
+            /* read the header aside and the payload to where it stays */
+            pkt = gnrc_pktbuf_add(NULL, NULL,
+                                  bytes_expected - sizeof(ethernet_hdr_t),
+                                  GNRC_NETTYPE_UNDEF);
+        }
+        else {
+            pkt = gnrc_pktbuf_add(NULL, NULL,
+                                  bytes_expected,
+                                  GNRC_NETTYPE_UNDEF);
+        }
 
         if (!pkt) {
             DEBUG("gnrc_netif_ethernet: cannot allocate pktsnip.\n");
@@ -178,10 +194,29 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
             goto out;
         }
 
-        int nread = dev->driver->recv(dev, pkt->data, bytes_expected, NULL);
-        if (nread <= 0) {
-            DEBUG("gnrc_netif_ethernet: read error.\n");
-            goto safe_out;
+        if (scatter) {
+            iolist_t payload = {
+                .iol_base = pkt->data,
+                .iol_len = pkt->size,
+            };
+            iolist_t iolist = {
+                .iol_next = &payload,
+                .iol_base = &hdr_buf,
+                .iol_len = sizeof(hdr_buf),
+            };
+
+            nread = dev->driver->recv_iolist(dev, &iolist, NULL);
+            if (nread < (int)sizeof(ethernet_hdr_t)) {
+                DEBUG("gnrc_netif_ethernet: read error.\n");
+                goto safe_out;
+            }
+        }
+        else {
+            nread = dev->driver->recv(dev, pkt->data, bytes_expected, NULL);
+            if (nread <= 0) {
+                DEBUG("gnrc_netif_ethernet: read error.\n");
+                goto safe_out;
+            }
         }
 #ifdef MODULE_NETSTATS_L2
         netif->stats.rx_count++;
@@ -193,18 +228,29 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
              * so free the unused space.*/
 
             DEBUG("gnrc_netif_ethernet: reallocating.\n");
-            gnrc_pktbuf_realloc_data(pkt, nread);
+            gnrc_pktbuf_realloc_data(pkt, scatter ? nread - sizeof(ethernet_hdr_t)
+                                                  : (size_t)nread);
         }
 
-        /* mark ethernet header */
-        gnrc_pktsnip_t *eth_hdr = gnrc_pktbuf_mark(pkt, sizeof(ethernet_hdr_t), GNRC_NETTYPE_UNDEF);
-        if (!eth_hdr) {
-            DEBUG("gnrc_netif_ethernet: no space left in packet buffer\n");
-            goto safe_out;
+        if (!scatter) {
+#ifdef MODULE_NETSTATS_L2
+            void *frame = pkt->data;
+#endif
+            /* mark ethernet header */
+            eth_hdr = gnrc_pktbuf_mark(pkt, sizeof(ethernet_hdr_t), GNRC_NETTYPE_UNDEF);
+            if (!eth_hdr) {
+                DEBUG("gnrc_netif_ethernet: no space left in packet buffer\n");
+                goto safe_out;
+            }
+#ifdef MODULE_NETSTATS_L2
+            if (eth_hdr->data != frame) {
+                /* packet buffer had to move the frame to split it */
+                netif->stats.rx_copied++;
+            }
+#endif
+            hdr = (ethernet_hdr_t *)eth_hdr->data;
         }
 
-        ethernet_hdr_t *hdr = (ethernet_hdr_t *)eth_hdr->data;
-
 #ifdef MODULE_L2FILTER
         if (!l2filter_pass(dev->filter, hdr->src, ETHERNET_ADDR_LEN)) {
             DEBUG("gnrc_netif_ethernet: incoming packet filtered by l2filter\n");
@@ -223,7 +269,6 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
 
         if (netif_hdr == NULL) {
             DEBUG("gnrc_netif_ethernet: no space left in packet buffer\n");
-            pkt = eth_hdr;
             goto safe_out;
         }
 
@@ -237,10 +282,13 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
               hdr->src[0], hdr->src[1], hdr->src[2], hdr->src[3], hdr->src[4],
               hdr->src[5], nread);
 #if defined(MODULE_OD) && ENABLE_DEBUG
-        od_hex_dump(hdr, nread, OD_WIDTH_DEFAULT);
+        od_hex_dump(hdr, sizeof(ethernet_hdr_t), OD_WIDTH_DEFAULT);
+        od_hex_dump(pkt->data, pkt->size, OD_WIDTH_DEFAULT);
 #endif
 
-        gnrc_pktbuf_remove_snip(pkt, eth_hdr);
+        if (eth_hdr != NULL) {
+            gnrc_pktbuf_remove_snip(pkt, eth_hdr);
+        }
         LL_APPEND(pkt, netif_hdr);
     }
 
@@ -29,6 +29,7 @@
 #include "net/netstats.h"
 #endif
 #include "fmt.h"
+#include "irq.h"
 #include "log.h"
 #include "sched.h"
 #include "xtimer.h"
@@ -43,8 +44,12 @@ static gnrc_netif_t _netifs[GNRC_NETIF_NUMOF];
 
 static void _update_l2addr_from_dev(gnrc_netif_t *netif);
 static void _configure_netdev(netdev_t *dev);
+static void _update_csum_offload_from_dev(gnrc_netif_t *netif);
 static void *_gnrc_netif_thread(void *args);
 static void _event_cb(netdev_t *dev, netdev_event_t event);
+#ifdef MODULE_GNRC_NETIF_RX_BATCH
+static void _poll(gnrc_netif_t *netif);
+#endif
 
 gnrc_netif_t *gnrc_netif_create(char *stack, int stacksize, char priority,
                                 const char *name, netdev_t *netdev,
@@ -357,6 +362,10 @@ int gnrc_netif_set_from_netdev(gnrc_netif_t *netif,
                         _configure_netdev(netif->dev);
                     }
                     break;
+                case NETOPT_RX_CSUM_VERIFIED:
+                case NETOPT_TX_CSUM_OFFLOAD:
+                    _update_csum_offload_from_dev(netif);
+                    break;
                 default:
                     break;
             }
@@ -1132,6 +1141,26 @@ static void _update_l2addr_from_dev(gnrc_netif_t *netif)
     }
 }
 
+static bool _dev_enabled(netdev_t *dev, netopt_t opt)
+{
+    netopt_enable_t enable = NETOPT_DISABLE;
+
+    return (dev->driver->get(dev, opt, &enable, sizeof(enable)) > 0) &&
+           (enable == NETOPT_ENABLE);
+}
+
+static void _update_csum_offload_from_dev(gnrc_netif_t *netif)
+{
+    netif->flags &= ~(GNRC_NETIF_FLAGS_RX_CSUM_VERIFIED |
+                      GNRC_NETIF_FLAGS_TX_CSUM_OFFLOAD);
+    if (_dev_enabled(netif->dev, NETOPT_RX_CSUM_VERIFIED)) {
+        netif->flags |= GNRC_NETIF_FLAGS_RX_CSUM_VERIFIED;
+    }
+    if (_dev_enabled(netif->dev, NETOPT_TX_CSUM_OFFLOAD)) {
+        netif->flags |= GNRC_NETIF_FLAGS_TX_CSUM_OFFLOAD;
+    }
+}
+
 static void _init_from_device(gnrc_netif_t *netif)
 {
     int res;
@@ -1144,6 +1173,7 @@ static void _init_from_device(gnrc_netif_t *netif)
     netif->device_type = (uint8_t)tmp;
     gnrc_netif_ipv6_init_mtu(netif);
     _update_l2addr_from_dev(netif);
+    _update_csum_offload_from_dev(netif);
 }
 
 static void _configure_netdev(netdev_t *dev)
@@ -1326,7 +1356,11 @@ static void *_gnrc_netif_thread(void *args)
         switch (msg.type) {
             case NETDEV_MSG_TYPE_EVENT:
                 DEBUG("gnrc_netif: GNRC_NETDEV_MSG_TYPE_EVENT received\n");
+#ifdef MODULE_GNRC_NETIF_RX_BATCH
+                _poll(netif);
+#else
                 dev->driver->isr(dev);
+#endif
                 break;
             case GNRC_NETAPI_MSG_TYPE_SND:
                 DEBUG("gnrc_netif: GNRC_NETDEV_MSG_TYPE_SND received\n");
@@ -1395,6 +1429,18 @@ static void *_gnrc_netif_thread(void *args)
     return NULL;
 }
 
+static void _mark_csum_verified(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *netif_snip = gnrc_pktsnip_search_type(pkt,
+                                                          GNRC_NETTYPE_NETIF);
+
+    if (netif_snip != NULL) {
+        gnrc_netif_hdr_t *netif_hdr = netif_snip->data;
+
+        netif_hdr->flags |= GNRC_NETIF_HDR_FLAGS_CSUM_VERIFIED;
+    }
+}
+
 static void _pass_on_packet(gnrc_pktsnip_t *pkt)
 {
     /* throw away packet if no one is interested */
@@ -1405,6 +1451,53 @@ static void _pass_on_packet(gnrc_pktsnip_t *pkt)
     }
 }
 
+#ifdef MODULE_GNRC_NETIF_RX_BATCH
+static void _flush_rx_batch(gnrc_netif_t *netif)
+{
+    gnrc_netif_rx_batch_t *batch = &netif->rx_batch;
+
+    DEBUG("gnrc_netif: passing on %u received packets\n", batch->len);
+    for (unsigned i = 0; i < batch->len; i++) {
+        _pass_on_packet(batch->pkts[i]);
+    }
+    batch->len = 0;
+}
+
+static void _poll(gnrc_netif_t *netif)
+{
+    gnrc_netif_rx_batch_t *batch = &netif->rx_batch;
+    netdev_t *dev = netif->dev;
+    unsigned budget = GNRC_NETIF_RX_BATCH_SIZE;
+    unsigned state;
+    bool pending;
+
+    batch->polling = true;
+    do {
+        state = irq_disable();
+        batch->irq_pending = false;
+        irq_restore(state);
+        dev->driver->isr(dev);
+    } while (batch->irq_pending && (--budget > 0));
+    state = irq_disable();
+    batch->polling = false;
+    pending = batch->irq_pending;
+    irq_restore(state);
+    _flush_rx_batch(netif);
+    if (pending) {
+        /* budget exhausted: serve the rest after the messages queued
+         * meanwhile */
+        msg_t msg = { .type = NETDEV_MSG_TYPE_EVENT,
+                      .content = { .ptr = netif } };
+
+        DEBUG("gnrc_netif: RX budget exhausted, rescheduling\n");
+        if (msg_send_to_self(&msg) <= 0) {
+            batch->irq_pending = false;
+            puts("gnrc_netif: possibly lost interrupt.");
+        }
+    }
+}
+#endif  /* MODULE_GNRC_NETIF_RX_BATCH */
+
 static void _event_cb(netdev_t *dev, netdev_event_t event)
 {
     gnrc_netif_t *netif = (gnrc_netif_t *) dev->context;
@@ -1413,7 +1506,19 @@ static void _event_cb(netdev_t *dev, netdev_event_t event)
         msg_t msg = { .type = NETDEV_MSG_TYPE_EVENT,
                       .content = { .ptr = netif } };
 
+#ifdef MODULE_GNRC_NETIF_RX_BATCH
+        bool coalesce = netif->rx_batch.irq_pending || netif->rx_batch.polling;
+
+        netif->rx_batch.irq_pending = true;
+        if (coalesce) {
+            /* the interface's thread already was or will be woken up */
+            return;
+        }
+#endif
         if (msg_send(&msg, netif->pid) <= 0) {
+#ifdef MODULE_GNRC_NETIF_RX_BATCH
+            netif->rx_batch.irq_pending = false;
+#endif
             puts("gnrc_netif: possibly lost interrupt.");
         }
     }
@@ -1424,6 +1529,20 @@ static void _event_cb(netdev_t *dev, netdev_event_t event)
             case NETDEV_EVENT_RX_COMPLETE:
                 pkt = netif->ops->recv(netif);
                 if (pkt) {
+                    if (netif->flags & GNRC_NETIF_FLAGS_RX_CSUM_VERIFIED) {
+                        _mark_csum_verified(pkt);
+                    }
+#ifdef MODULE_GNRC_NETIF_RX_BATCH
+                    /* frames not received via _poll() are passed on
+                     * right away */
+                    if (netif->rx_batch.polling) {
+                        if (netif->rx_batch.len >= GNRC_NETIF_RX_BATCH_SIZE) {
+                            _flush_rx_batch(netif);
+                        }
+                        netif->rx_batch.pkts[netif->rx_batch.len++] = pkt;
+                        break;
+                    }
+#endif
                     _pass_on_packet(pkt);
                 }
                 break;
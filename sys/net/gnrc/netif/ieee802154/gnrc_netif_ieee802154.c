@@ -151,6 +151,9 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
                 return NULL;
             }
             nread -= mhr_len;
+#ifdef MODULE_NETSTATS_L2
+            void *frame = pkt->data;
+#endif
             /* mark IEEE 802.15.4 header */
             ieee802154_hdr = gnrc_pktbuf_mark(pkt, mhr_len, GNRC_NETTYPE_UNDEF);
             if (ieee802154_hdr == NULL) {
@@ -158,6 +161,12 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
                 gnrc_pktbuf_release(pkt);
                 return NULL;
             }
+#ifdef MODULE_NETSTATS_L2
+            if (ieee802154_hdr->data != frame) {
+                /* packet buffer had to move the frame to split it */
+                netif->stats.rx_copied++;
+            }
+#endif
             netif_hdr = _make_netif_hdr(ieee802154_hdr->data);
             if (netif_hdr == NULL) {
                 DEBUG("_recv_ieee802154: no space left in packet buffer\n");
@@ -28,13 +28,40 @@
 
 #define _INVALID_TYPE(type) (((type) < GNRC_NETTYPE_UNDEF) || ((type) >= GNRC_NETTYPE_NUMOF))
 
-/* The registry as lookup table by gnrc_nettype_t */
-static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF];
+#ifdef MODULE_GNRC_NETREG_HASH
+#if (GNRC_NETREG_HASH_BUCKETS & (GNRC_NETREG_HASH_BUCKETS - 1)) || \
+    (GNRC_NETREG_HASH_BUCKETS > 256)
+#error "GNRC_NETREG_HASH_BUCKETS must be a power of 2 and at most 256"
+#endif
+#define _BUCKETS            (GNRC_NETREG_HASH_BUCKETS)
+#else
+#define _BUCKETS            (1U)
+#endif
+
+/* The registry as lookup table by gnrc_nettype_t and hash of the demux
+ * context. Entries with the same demux context are kept next to each other
+ * within a list, the last registered first. */
+static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF][_BUCKETS];
+
+static inline gnrc_netreg_entry_t **_head(gnrc_nettype_t type,
+                                          uint32_t demux_ctx)
+{
+#ifdef MODULE_GNRC_NETREG_HASH
+    /* fold GNRC_NETREG_DEMUX_CTX_ALL in and spread consecutive ports
+     * (Fibonacci hashing) */
+    uint32_t hash = (demux_ctx ^ (demux_ctx >> 16)) * 2654435769U;
+
+    return &netreg[type][(hash >> 24) & (_BUCKETS - 1)];
+#else
+    (void)demux_ctx;
+    return &netreg[type][0];
+#endif
+}
 
 void gnrc_netreg_init(void)
 {
     /* set all pointers in registry to NULL */
-    memset(netreg, 0, GNRC_NETTYPE_NUMOF * sizeof(gnrc_netreg_entry_t *));
+    memset(netreg, 0, sizeof(netreg));
 }
 
 int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
@@ -59,7 +86,14 @@ int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return -EINVAL;
     }
 
-    LL_PREPEND(netreg[type], entry);
+    gnrc_netreg_entry_t **pos = _head(type, entry->demux_ctx);
+
+    /* insert in front of the entries with the same demux context, if any */
+    while ((*pos != NULL) && ((*pos)->demux_ctx != entry->demux_ctx)) {
+        pos = &(*pos)->next;
+    }
+    entry->next = *pos;
+    *pos = entry;
 
     return 0;
 }
@@ -70,54 +104,40 @@ void gnrc_netreg_unregister(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return;
     }
 
-    LL_DELETE(netreg[type], entry);
+    LL_DELETE(*_head(type, entry->demux_ctx), entry);
 }
 
-/**
- * @brief   Searches the next entry in the registry that matches given
- *          parameters, start lookup from beginning or given entry.
- *
- * @param[in] from      A registry entry to lookup from or NULL to start fresh
- * @param[in] type      Type of the protocol.
- * @param[in] demux_ctx The demultiplexing context for the registered thread.
- *                      See gnrc_netreg_entry_t::demux_ctx.
- *
- * @return  The first entry fitting the given parameters on success
- * @return  NULL if no entry can be found.
- */
-static gnrc_netreg_entry_t *_netreg_lookup(gnrc_netreg_entry_t *from,
-                                           gnrc_nettype_t type,
-                                           uint32_t demux_ctx)
+gnrc_netreg_entry_t *gnrc_netreg_lookup(gnrc_nettype_t type, uint32_t demux_ctx)
 {
     gnrc_netreg_entry_t *res = NULL;
 
-    if (from || !_INVALID_TYPE(type)) {
-        gnrc_netreg_entry_t *head = (from) ? from->next : netreg[type];
-        LL_SEARCH_SCALAR(head, res, demux_ctx, demux_ctx);
+    if (!_INVALID_TYPE(type)) {
+        LL_SEARCH_SCALAR(*_head(type, demux_ctx), res, demux_ctx, demux_ctx);
     }
 
     return res;
 }
 
-gnrc_netreg_entry_t *gnrc_netreg_lookup(gnrc_nettype_t type, uint32_t demux_ctx)
-{
-    return _netreg_lookup(NULL, type, demux_ctx);
-}
-
 int gnrc_netreg_num(gnrc_nettype_t type, uint32_t demux_ctx)
 {
     int num = 0;
-    gnrc_netreg_entry_t *entry = NULL;
+    gnrc_netreg_entry_t *entry = gnrc_netreg_lookup(type, demux_ctx);
 
-    while((entry = _netreg_lookup(entry, type, demux_ctx)) != NULL) {
+    while (entry != NULL) {
         num++;
+        entry = gnrc_netreg_getnext(entry);
     }
     return num;
 }
 
 gnrc_netreg_entry_t *gnrc_netreg_getnext(gnrc_netreg_entry_t *entry)
 {
-    return (entry ? _netreg_lookup(entry, 0, entry->demux_ctx) : NULL);
+    /* entries with the same demux context are next to each other */
+    if ((entry == NULL) || (entry->next == NULL) ||
+        (entry->next->demux_ctx != entry->demux_ctx)) {
+        return NULL;
+    }
+    return entry->next;
 }
 
 int gnrc_netreg_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr)
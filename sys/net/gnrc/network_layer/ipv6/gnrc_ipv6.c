@@ -31,6 +31,10 @@
 #include "net/gnrc/netif/internal.h"
 #include "net/gnrc/ipv6/whitelist.h"
 #include "net/gnrc/ipv6/blacklist.h"
+#include "net/gnrc/ipv6/route_cache.h"
+#ifdef MODULE_GNRC_IPV6_ROUTE_CACHE
+#include "xtimer.h"
+#endif
 
 #include "net/gnrc/ipv6.h"
 
@@ -265,7 +269,7 @@ static void _send_to_iface(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
     }
 }
 
-static gnrc_pktsnip_t *_create_netif_hdr(uint8_t *dst_l2addr,
+static gnrc_pktsnip_t *_create_netif_hdr(const uint8_t *dst_l2addr,
                                          unsigned dst_l2addr_len,
                                          gnrc_pktsnip_t *pkt,
                                          uint8_t flags)
@@ -299,12 +303,42 @@ static bool _is_ipv6_hdr(gnrc_pktsnip_t *hdr)
 #endif
 }
 
-static int _fill_ipv6_hdr(gnrc_netif_t *netif, gnrc_pktsnip_t *ipv6)
+static int _calc_upper_csum(gnrc_pktsnip_t *ipv6)
 {
     int res;
-    ipv6_hdr_t *hdr = ipv6->data;
     gnrc_pktsnip_t *payload, *prev;
 
+    DEBUG("ipv6: write protect up to payload to calculate checksum\n");
+    payload = ipv6;
+    prev = ipv6;
+    while (_is_ipv6_hdr(payload) && (payload->next != NULL)) {
+        /* IPv6 header itself was already write-protected in caller function,
+         * just write protect extension headers and payload header */
+        if ((payload = gnrc_pktbuf_start_write(payload->next)) == NULL) {
+            DEBUG("ipv6: unable to get write access to IPv6 extension or payload header\n");
+            /* packet duplicated to this point will be released by caller,
+             * original packet by other subscriber */
+            return -ENOMEM;
+        }
+        prev->next = payload;
+        prev = payload;
+    }
+    DEBUG("ipv6: calculate checksum for upper header.\n");
+    if ((res = gnrc_netreg_calc_csum(payload, ipv6)) < 0) {
+        if (res != -ENOENT) {   /* if there is no checksum we are okay */
+            DEBUG("ipv6: checksum calculation failed.\n");
+            /* packet will be released by caller */
+            return res;
+        }
+    }
+
+    return 0;
+}
+
+static int _fill_ipv6_hdr(gnrc_netif_t *netif, gnrc_pktsnip_t *ipv6)
+{
+    ipv6_hdr_t *hdr = ipv6->data;
+
     hdr->len = byteorder_htons(gnrc_pkt_len(ipv6->next));
     DEBUG("ipv6: set payload length to %u (network byteorder %04" PRIx16 ")\n",
           (unsigned)byteorder_ntohs(hdr->len), hdr->len.u16);
@@ -383,31 +417,11 @@ static int _fill_ipv6_hdr(gnrc_netif_t *netif, gnrc_pktsnip_t *ipv6)
         }
     }
 
-    DEBUG("ipv6: write protect up to payload to calculate checksum\n");
-    payload = ipv6;
-    prev = ipv6;
-    while (_is_ipv6_hdr(payload) && (payload->next != NULL)) {
-        /* IPv6 header itself was already write-protected in caller function,
-         * just write protect extension headers and payload header */
-        if ((payload = gnrc_pktbuf_start_write(payload->next)) == NULL) {
-            DEBUG("ipv6: unable to get write access to IPv6 extension or payload header\n");
-            /* packet duplicated to this point will be released by caller,
-             * original packet by other subscriber */
-            return -ENOMEM;
-        }
-        prev->next = payload;
-        prev = payload;
-    }
-    DEBUG("ipv6: calculate checksum for upper header.\n");
-    if ((res = gnrc_netreg_calc_csum(payload, ipv6)) < 0) {
-        if (res != -ENOENT) {   /* if there is no checksum we are okay */
-            DEBUG("ipv6: checksum calculation failed.\n");
-            /* packet will be released by caller */
-            return res;
-        }
+    if ((netif != NULL) && (netif->flags & GNRC_NETIF_FLAGS_TX_CSUM_OFFLOAD)) {
+        DEBUG("ipv6: checksum for upper header is calculated by device\n");
+        return 0;
     }
-
-    return 0;
+    return _calc_upper_csum(ipv6);
 }
 
 static bool _safe_fill_ipv6_hdr(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt,
@@ -422,26 +436,58 @@ static bool _safe_fill_ipv6_hdr(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt,
 }
 
 /* functions for sending */
+static const gnrc_ipv6_nib_nc_t *_get_next_hop(const ipv6_addr_t *dst,
+                                               gnrc_netif_t *netif,
+                                               gnrc_pktsnip_t *pkt,
+                                               gnrc_ipv6_nib_nc_t *nce)
+{
+#ifdef MODULE_GNRC_IPV6_ROUTE_CACHE
+    const gnrc_ipv6_nib_nc_t *cached = gnrc_ipv6_route_cache_get(dst, netif);
+
+    if (cached != NULL) {
+        DEBUG("ipv6: next hop to %s from route cache\n",
+              ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
+        return cached;
+    }
+#endif
+    if (gnrc_ipv6_nib_get_next_hop_l2addr(dst, netif, pkt, nce) < 0) {
+        return NULL;
+    }
+#ifdef MODULE_GNRC_IPV6_ROUTE_CACHE
+    /* neighbor unreachability detection only sees the packets of cache
+     * misses, so only cache neighbors it does not need to watch */
+    switch (gnrc_ipv6_nib_nc_get_nud_state(nce)) {
+        case GNRC_IPV6_NIB_NC_INFO_NUD_STATE_UNMANAGED:
+        case GNRC_IPV6_NIB_NC_INFO_NUD_STATE_REACHABLE:
+            gnrc_ipv6_route_cache_add(dst, netif, nce);
+            break;
+        default:
+            break;
+    }
+#endif
+    return nce;
+}
+
 static void _send_unicast(gnrc_pktsnip_t *pkt, bool prep_hdr,
                           gnrc_netif_t *netif, ipv6_hdr_t *ipv6_hdr,
                           uint8_t netif_hdr_flags)
 {
     gnrc_ipv6_nib_nc_t nce;
+    const gnrc_ipv6_nib_nc_t *next_hop;
 
     DEBUG("ipv6: send unicast\n");
-    if (gnrc_ipv6_nib_get_next_hop_l2addr(&ipv6_hdr->dst, netif, pkt,
-                                          &nce) < 0) {
+    if ((next_hop = _get_next_hop(&ipv6_hdr->dst, netif, pkt, &nce)) == NULL) {
         /* packet is released by NIB */
         DEBUG("ipv6: no link-layer address or interface for next hop to %s",
               ipv6_addr_to_str(addr_str, &ipv6_hdr->dst, sizeof(addr_str)));
         return;
     }
-    netif = gnrc_netif_get_by_pid(gnrc_ipv6_nib_nc_get_iface(&nce));
+    netif = gnrc_netif_get_by_pid(gnrc_ipv6_nib_nc_get_iface(next_hop));
     assert(netif != NULL);
     if (_safe_fill_ipv6_hdr(netif, pkt, prep_hdr)) {
         DEBUG("ipv6: add interface header to packet\n");
-        if ((pkt = _create_netif_hdr(nce.l2addr, nce.l2addr_len, pkt,
-                                     netif_hdr_flags)) == NULL) {
+        if ((pkt = _create_netif_hdr(next_hop->l2addr, next_hop->l2addr_len,
+                                     pkt, netif_hdr_flags)) == NULL) {
             return;
         }
         DEBUG("ipv6: send unicast over interface %" PRIkernel_pid "\n",
@@ -543,6 +589,11 @@ static void _send_to_self(gnrc_pktsnip_t *pkt, bool prep_hdr,
                           gnrc_netif_t *netif)
 {
     if (!_safe_fill_ipv6_hdr(netif, pkt, prep_hdr) ||
+        /* the device of netif will not see the packet to calculate the
+         * checksum */
+        (prep_hdr && (netif != NULL) &&
+         (netif->flags & GNRC_NETIF_FLAGS_TX_CSUM_OFFLOAD) &&
+         (_calc_upper_csum(pkt) < 0)) ||
         /* no netif header so we just merge the whole packet. */
         (gnrc_pktbuf_merge(pkt) != 0)) {
         DEBUG("ipv6: error looping packet to sender.\n");
@@ -651,6 +702,9 @@ static inline bool _pkt_not_for_me(gnrc_netif_t **netif, ipv6_hdr_t *hdr)
 
 static void _receive(gnrc_pktsnip_t *pkt)
 {
+#if defined(MODULE_GNRC_IPV6_ROUTE_CACHE) && defined(MODULE_GNRC_IPV6_ROUTER)
+    uint32_t rcv_time = xtimer_now_usec();
+#endif
     gnrc_netif_t *netif = NULL;
     gnrc_pktsnip_t *ipv6, *netif_hdr;
     ipv6_hdr_t *hdr;
@@ -797,6 +851,9 @@ static void _receive(gnrc_pktsnip_t *pkt)
             pkt = gnrc_pktbuf_reverse_snips(pkt);
             if (pkt != NULL) {
                 _send(pkt, false);
+#ifdef MODULE_GNRC_IPV6_ROUTE_CACHE
+                gnrc_ipv6_route_cache_forwarded(xtimer_now_usec() - rcv_time);
+#endif
             }
             else {
                 DEBUG("ipv6: unable to reverse pkt from receive order to send "
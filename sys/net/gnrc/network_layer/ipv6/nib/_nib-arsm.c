@@ -86,6 +86,29 @@ void _snd_uc_ns(_nib_onl_entry_t *nbr, bool reset)
 #endif  /* GNRC_IPV6_NIB_CONF_ARSM */
 }
 
+#if GNRC_IPV6_NIB_CONF_ARSM
+/**
+ * @brief   Sets the link-layer address of a neighbor cache entry
+ *
+ * @param[in,out] nce       A neighbor cache entry.
+ * @param[in] l2addr        The new link-layer address. May be NULL if
+ *                          @p l2addr_len is 0.
+ * @param[in] l2addr_len    Length of @p l2addr.
+ */
+static void _set_l2addr(_nib_onl_entry_t *nce, const void *l2addr,
+                        unsigned l2addr_len)
+{
+    if ((nce->l2addr_len != l2addr_len) ||
+        ((l2addr_len > 0) && (memcmp(nce->l2addr, l2addr, l2addr_len) != 0))) {
+        if (l2addr_len > 0) {
+            memcpy(nce->l2addr, l2addr, l2addr_len);
+        }
+        nce->l2addr_len = l2addr_len;
+        _nib_changed();
+    }
+}
+#endif  /* GNRC_IPV6_NIB_CONF_ARSM */
+
 void _handle_sl2ao(gnrc_netif_t *netif, const ipv6_hdr_t *ipv6,
                    const icmpv6_hdr_t *icmpv6, const ndp_opt_t *sl2ao)
 {
@@ -154,8 +177,7 @@ void _handle_sl2ao(gnrc_netif_t *netif, const ipv6_hdr_t *ipv6,
         /* a 6LR MUST NOT modify an existing NCE based on an SL2AO in an RS
          * see https://tools.ietf.org/html/rfc6775#section-6.3 */
         if (!_rtr_sol_on_6lr(netif, icmpv6)) {
-            nce->l2addr_len = l2addr_len;
-            memcpy(nce->l2addr, sl2ao + 1, l2addr_len);
+            _set_l2addr(nce, sl2ao + 1, l2addr_len);
         }
 #endif  /* GNRC_IPV6_NIB_CONF_ARSM */
     }
@@ -347,11 +369,10 @@ void _handle_adv_l2(gnrc_netif_t *netif, _nib_onl_entry_t *nce,
         bool nce_was_incomplete =
             (_get_nud_state(nce) == GNRC_IPV6_NIB_NC_INFO_NUD_STATE_INCOMPLETE);
         if (tl2ao != NULL) {
-            nce->l2addr_len = l2addr_len;
-            memcpy(nce->l2addr, tl2ao + 1, l2addr_len);
+            _set_l2addr(nce, tl2ao + 1, l2addr_len);
         }
         else {
-            nce->l2addr_len = 0;
+            _set_l2addr(nce, NULL, 0);
         }
         if (_sflag_set((ndp_nbr_adv_t *)icmpv6)) {
             _set_reachable(netif, nce);
@@ -430,6 +451,17 @@ void _set_reachable(gnrc_netif_t *netif, _nib_onl_entry_t *nce)
 void _set_nud_state(gnrc_netif_t *netif, _nib_onl_entry_t *nce,
                     uint16_t state)
 {
+    switch (_get_nud_state(nce)) {
+        case GNRC_IPV6_NIB_NC_INFO_NUD_STATE_REACHABLE:
+        case GNRC_IPV6_NIB_NC_INFO_NUD_STATE_UNMANAGED:
+            /* only neighbors in these states are resolved from caches */
+            if (state != _get_nud_state(nce)) {
+                _nib_changed();
+            }
+            break;
+        default:
+            break;
+    }
     nce->info &= ~GNRC_IPV6_NIB_NC_INFO_NUD_STATE_MASK;
     nce->info |= state;
 
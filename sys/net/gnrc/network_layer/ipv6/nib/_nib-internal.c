@@ -27,6 +27,7 @@
 
 #include "_nib-internal.h"
 #include "_nib-router.h"
+#include "_nib-trie.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -43,10 +44,25 @@ static _nib_dr_entry_t _def_routers[GNRC_IPV6_NIB_DEFAULT_ROUTER_NUMOF];
 static _nib_abr_entry_t _abrs[GNRC_IPV6_NIB_ABR_NUMOF];
 #endif  /* GNRC_IPV6_NIB_CONF_MULTIHOP_P6C */
 
+#if GNRC_IPV6_NIB_CONF_NC_HASH
+#if (GNRC_IPV6_NIB_NC_HASH_BUCKETS & (GNRC_IPV6_NIB_NC_HASH_BUCKETS - 1)) || \
+    (GNRC_IPV6_NIB_NC_HASH_BUCKETS > 256)
+#error "GNRC_IPV6_NIB_NC_HASH_BUCKETS must be a power of 2 and at most 256"
+#endif
+/* chains of on-link entries by hash of their address, sorted by position in
+ * _nodes. The last chain holds the entries with the unspecified address, i.e.
+ * also all unused ones, so the others only hold neighbors */
+static _nib_onl_entry_t *_buckets[GNRC_IPV6_NIB_NC_HASH_BUCKETS + 1];
+#endif  /* GNRC_IPV6_NIB_CONF_NC_HASH */
+
+/* clock for _nib_onl_entry_t::last_used, ticks on every use of an entry */
+static uint32_t _lru_clock;
+
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 
 mutex_t _nib_mutex = MUTEX_INIT;
 evtimer_msg_t _nib_evtimer;
+gnrc_ipv6_nib_nc_stats_t _nib_nc_stats;
 
 static void _override_node(const ipv6_addr_t *addr, unsigned iface,
                            _nib_onl_entry_t *node);
@@ -60,10 +76,21 @@ void _nib_init(void)
     memset(_nodes, 0, sizeof(_nodes));
     memset(_def_routers, 0, sizeof(_def_routers));
     memset(_dsts, 0, sizeof(_dsts));
+    memset(&_nib_nc_stats, 0, sizeof(_nib_nc_stats));
+    _lru_clock = 0;
 #if GNRC_IPV6_NIB_CONF_MULTIHOP_P6C
     memset(_abrs, 0, sizeof(_abrs));
 #endif  /* GNRC_IPV6_NIB_CONF_MULTIHOP_P6C */
 #endif  /* TEST_SUITES */
+#if GNRC_IPV6_NIB_CONF_FT_TRIE
+    _nib_trie_init();
+#endif  /* GNRC_IPV6_NIB_CONF_FT_TRIE */
+#if GNRC_IPV6_NIB_CONF_NC_HASH
+    memset(_buckets, 0, sizeof(_buckets));
+    for (unsigned i = 0; i < GNRC_IPV6_NIB_NUMOF; i++) {
+        _nib_onl_hash(&_nodes[i]);
+    }
+#endif  /* GNRC_IPV6_NIB_CONF_NC_HASH */
     evtimer_init_msg(&_nib_evtimer);
     /* TODO: load ABR information from persistent memory */
 }
@@ -75,6 +102,89 @@ static inline bool _addr_equals(const ipv6_addr_t *addr,
            (ipv6_addr_equal(addr, &node->ipv6));
 }
 
+static inline void _touch(_nib_onl_entry_t *node)
+{
+    node->last_used = ++_lru_clock;
+}
+
+#if GNRC_IPV6_NIB_CONF_NC_HASH
+static inline _nib_onl_entry_t **_bucket(const ipv6_addr_t *addr)
+{
+    if (ipv6_addr_is_unspecified(addr)) {
+        return &_buckets[GNRC_IPV6_NIB_NC_HASH_BUCKETS];
+    }
+    /* the interface identifier varies most between neighbors, but prefixes
+     * may differ as well */
+    uint32_t hash = addr->u32[0].u32 ^ addr->u32[1].u32 ^
+                    addr->u32[2].u32 ^ addr->u32[3].u32;
+
+    hash = (hash ^ (hash >> 16)) * 2654435769U;
+    return &_buckets[(hash >> 24) & (GNRC_IPV6_NIB_NC_HASH_BUCKETS - 1)];
+}
+
+void _nib_onl_hash(_nib_onl_entry_t *node)
+{
+    _nib_onl_entry_t **ptr = _bucket(&node->ipv6);
+
+    /* keep the order of _nodes, so lookups find the same entry as a scan */
+    while ((*ptr != NULL) && (*ptr < node)) {
+        ptr = &(*ptr)->hnext;
+    }
+    node->hnext = *ptr;
+    *ptr = node;
+}
+
+void _nib_onl_unhash(_nib_onl_entry_t *node)
+{
+    for (_nib_onl_entry_t **ptr = _bucket(&node->ipv6); *ptr != NULL;
+         ptr = &(*ptr)->hnext) {
+        if (*ptr == node) {
+            *ptr = node->hnext;
+            node->hnext = NULL;
+            return;
+        }
+    }
+}
+
+/* the first entry _nib_onl_alloc() would treat as an exact match for an
+ * address */
+static _nib_onl_entry_t *_hash_exact_match(const ipv6_addr_t *addr,
+                                           unsigned iface)
+{
+    _nib_onl_entry_t *node = NULL;
+
+    for (_nib_onl_entry_t *tmp = *_bucket(addr); tmp != NULL;
+         tmp = tmp->hnext) {
+        if ((_nib_onl_get_if(tmp) == iface) &&
+            ipv6_addr_equal(addr, &tmp->ipv6)) {
+            node = tmp;
+            break;
+        }
+    }
+    /* entries without an address match as well */
+    for (_nib_onl_entry_t *tmp = _buckets[GNRC_IPV6_NIB_NC_HASH_BUCKETS];
+         (tmp != NULL) && ((node == NULL) || (tmp < node));
+         tmp = tmp->hnext) {
+        if (_nib_onl_get_if(tmp) == iface) {
+            node = tmp;
+            break;
+        }
+    }
+    return node;
+}
+#endif  /* GNRC_IPV6_NIB_CONF_NC_HASH */
+
+static inline void _set_addr(_nib_onl_entry_t *node, const ipv6_addr_t *addr)
+{
+#if GNRC_IPV6_NIB_CONF_NC_HASH
+    _nib_onl_unhash(node);
+#endif  /* GNRC_IPV6_NIB_CONF_NC_HASH */
+    memcpy(&node->ipv6, addr, sizeof(node->ipv6));
+#if GNRC_IPV6_NIB_CONF_NC_HASH
+    _nib_onl_hash(node);
+#endif  /* GNRC_IPV6_NIB_CONF_NC_HASH */
+}
+
 _nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface)
 {
     _nib_onl_entry_t *node = NULL;
@@ -82,6 +192,13 @@ _nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface)
     DEBUG("nib: Allocating on-link node entry (addr = %s, iface = %u)\n",
           (addr == NULL) ? "NULL" : ipv6_addr_to_str(addr_str, addr,
                                                      sizeof(addr_str)), iface);
+#if GNRC_IPV6_NIB_CONF_NC_HASH
+    if ((addr != NULL) && ((node = _hash_exact_match(addr, iface)) != NULL)) {
+        DEBUG("  %p is an exact match\n", (void *)node);
+        _override_node(addr, iface, node);
+        return node;
+    }
+#endif  /* GNRC_IPV6_NIB_CONF_NC_HASH */
     for (unsigned i = 0; i < GNRC_IPV6_NIB_NUMOF; i++) {
         _nib_onl_entry_t *tmp = &_nodes[i];
 
@@ -118,46 +235,41 @@ static inline _nib_onl_entry_t *_cache_out_onl_entry(const ipv6_addr_t *addr,
                                                      unsigned iface,
                                                      uint16_t cstate)
 {
-    /* Use clist as FIFO for caching */
-    _nib_onl_entry_t *first = (_nib_onl_entry_t *)clist_lpop(&_next_removable);
-    _nib_onl_entry_t *tmp = first, *res = NULL;
+    clist_node_t *ptr = _next_removable.next;
+    _nib_onl_entry_t *res = NULL;
 
     DEBUG("nib: Searching for replaceable entries (addr = %s, iface = %u)\n",
           ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)), iface);
-    if (tmp == NULL) {
+    if (ptr == NULL) {
         return NULL;
     }
+    /* find least recently used entry that is garbage collectible at the
+     * moment */
     do {
-        if (_is_gc(tmp)) {
-            DEBUG("nib: Removing neighbor cache entry (addr = %s, "
-                  "iface = %u) ",
-                  ipv6_addr_to_str(addr_str, &tmp->ipv6,
-                                   sizeof(addr_str)),
-                  _nib_onl_get_if(tmp));
-            DEBUG("for (addr = %s, iface = %u)\n",
-                  ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)),
-                  iface);
-            /* call _nib_nc_remove to remove timers from _evtimer */
-            _nib_nc_remove(tmp);
+        _nib_onl_entry_t *tmp = (_nib_onl_entry_t *)(ptr = ptr->next);
+
+        if (_is_gc(tmp) &&
+            ((res == NULL) || ((int32_t)(tmp->last_used - res->last_used) < 0))) {
             res = tmp;
-            _override_node(addr, iface, res);
-            /* cstate masked in _nib_nc_add() already */
-            res->info |= cstate;
-            res->mode = _NC;
-        }
-        /* requeue if not garbage collectible at the moment or queueing
-         * newly created NCE or in case entry becomes garbage collectible
-         * again */
-        clist_rpush(&_next_removable, (clist_node_t *)tmp);
-        if (res == NULL) {
-            /* no new entry created yet, get next entry in FIFO */
-            tmp = (_nib_onl_entry_t *)clist_lpop(&_next_removable);
-        }
-    } while ((tmp != first) && (res == NULL));
+        }
+    } while (ptr != _next_removable.next);
     if (res == NULL) {
-        /* we did not find any removable entry => requeue current one */
-        clist_rpush(&_next_removable, (clist_node_t *)tmp);
+        return NULL;
     }
+    DEBUG("nib: Removing neighbor cache entry (addr = %s, iface = %u) ",
+          ipv6_addr_to_str(addr_str, &res->ipv6, sizeof(addr_str)),
+          _nib_onl_get_if(res));
+    DEBUG("for (addr = %s, iface = %u)\n",
+          ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)), iface);
+    /* call _nib_nc_remove to remove timers from _evtimer */
+    _nib_nc_remove(res);
+    _nib_nc_stats.evictions++;
+    _override_node(addr, iface, res);
+    /* cstate masked in _nib_nc_add() already */
+    res->info |= cstate;
+    res->mode = _NC;
+    /* queue newly created NCE */
+    clist_rpush(&_next_removable, (clist_node_t *)res);
     return res;
 }
 
@@ -180,6 +292,7 @@ _nib_onl_entry_t *_nib_nc_add(const ipv6_addr_t *addr, unsigned iface,
         /* masked above already */
         node->info |= cstate;
         node->mode |= _NC;
+        _nib_changed();
     }
     if (node->next == NULL) {
         DEBUG("nib: queueing (addr = %s, iface = %u) for potential removal\n",
@@ -209,8 +322,13 @@ _nib_onl_entry_t *_nib_onl_get(const ipv6_addr_t *addr, unsigned iface)
     assert(addr != NULL);
     DEBUG("nib: Getting on-link node entry (addr = %s, iface = %u)\n",
           ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)), iface);
+#if GNRC_IPV6_NIB_CONF_NC_HASH
+    for (_nib_onl_entry_t *node = *_bucket(addr); node != NULL;
+         node = node->hnext) {
+#else   /* GNRC_IPV6_NIB_CONF_NC_HASH */
     for (unsigned i = 0; i < GNRC_IPV6_NIB_NUMOF; i++) {
         _nib_onl_entry_t *node = &_nodes[i];
+#endif  /* GNRC_IPV6_NIB_CONF_NC_HASH */
 
         if ((node->mode != _EMPTY) &&
             /* either requested or current interface undefined or
@@ -219,10 +337,13 @@ _nib_onl_entry_t *_nib_onl_get(const ipv6_addr_t *addr, unsigned iface)
              (_nib_onl_get_if(node) == iface)) &&
             ipv6_addr_equal(&node->ipv6, addr)) {
             DEBUG("  Found %p\n", (void *)node);
+            _nib_nc_stats.hits++;
+            _touch(node);
             return node;
         }
     }
     DEBUG("  No suitable entry found\n");
+    _nib_nc_stats.misses++;
     return NULL;
 }
 
@@ -280,6 +401,7 @@ void _nib_nc_remove(_nib_onl_entry_t *node)
     /* remove from cache-out procedure */
     clist_remove(&_next_removable, (clist_node_t *)node);
     _nib_onl_clear(node);
+    _nib_changed();
 }
 
 #if GNRC_IPV6_NIB_CONF_6LN || !GNRC_IPV6_NIB_CONF_ARSM
@@ -359,6 +481,7 @@ _nib_dr_entry_t *_nib_drl_add(const ipv6_addr_t *router_addr, unsigned iface)
         }
         _override_node(router_addr, iface, def_router->next_hop);
         def_router->next_hop->mode |= _DRL;
+        _nib_changed();
     }
     return def_router;
 }
@@ -373,6 +496,7 @@ void _nib_drl_remove(_nib_dr_entry_t *nib_dr)
     if (nib_dr == _prime_def_router) {
         _prime_def_router = NULL;
     }
+    _nib_changed();
 }
 
 _nib_dr_entry_t *_nib_drl_iter(const _nib_dr_entry_t *last)
@@ -407,6 +531,15 @@ _nib_dr_entry_t *_nib_drl_get(const ipv6_addr_t *router_addr, unsigned iface)
     return NULL;
 }
 
+static inline _nib_dr_entry_t *_select_dr(_nib_dr_entry_t *dr)
+{
+    if (dr != _prime_def_router) {
+        _prime_def_router = dr;
+        _nib_changed();
+    }
+    return dr;
+}
+
 _nib_dr_entry_t *_nib_drl_get_dr(void)
 {
     _nib_dr_entry_t *ptr = NULL;
@@ -429,18 +562,14 @@ _nib_dr_entry_t *_nib_drl_get_dr(void)
             if ((_prime_def_router == NULL) || (next == NULL)) {
                 /* wrap around to first (potentially unreachable) route
                  * to trigger NUD for it */
-                _prime_def_router = _nib_drl_iter(NULL);
+                return _select_dr(_nib_drl_iter(NULL));
             }
             /* there is another default router, choose it regardless of
              * reachability to potentially trigger NUD for it */
-            else if (next != NULL) {
-                _prime_def_router = next;
-            }
-            return _prime_def_router;
+            return _select_dr(next);
         }
     } while (_node_unreachable(ptr->next_hop));
-    _prime_def_router = ptr;
-    return _prime_def_router;
+    return _select_dr(ptr);
 }
 
 void _nib_drl_ft_get(const _nib_dr_entry_t *drl, gnrc_ipv6_nib_ft_t *fte)
@@ -455,6 +584,29 @@ void _nib_drl_ft_get(const _nib_dr_entry_t *drl, gnrc_ipv6_nib_ft_t *fte)
     fte->iface = _nib_onl_get_if(drl->next_hop);
 }
 
+static inline bool _offl_same_next_hop(const _nib_offl_entry_t *dst,
+                                       const ipv6_addr_t *next_hop,
+                                       unsigned iface)
+{
+    const _nib_onl_entry_t *node = dst->next_hop;
+
+    return (node != NULL) &&                        /* there is a next hop that */
+           (_nib_onl_get_if(node) == iface) &&      /* has a matching interface and */
+           _addr_equals(next_hop, node);            /* equal address to next_hop */
+}
+
+static inline _nib_offl_entry_t *_offl_reuse(_nib_offl_entry_t *dst,
+                                             const ipv6_addr_t *next_hop)
+{
+    /* exact match (or next hop address was previously unset) */
+    DEBUG("  %p is an exact match\n", (void *)dst);
+    if (next_hop != NULL) {
+        _set_addr(dst->next_hop, next_hop);
+    }
+    dst->next_hop->mode |= _DST;
+    return dst;
+}
+
 _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
                                    const ipv6_addr_t *pfx, unsigned pfx_len)
 {
@@ -469,27 +621,33 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
           iface);
     DEBUG("pfx = %s/%u)\n", ipv6_addr_to_str(addr_str, pfx,
                                              sizeof(addr_str)), pfx_len);
+#if GNRC_IPV6_NIB_CONF_FT_TRIE
+    for (_nib_offl_entry_t *tmp = _nib_trie_get(pfx, pfx_len); tmp != NULL;
+         tmp = tmp->trie_next) {
+        if (_offl_same_next_hop(tmp, next_hop, iface)) {
+            return _offl_reuse(tmp, next_hop);
+        }
+    }
+    for (unsigned i = 0; i < GNRC_IPV6_NIB_OFFL_NUMOF; i++) {
+        if (_dsts[i].next_hop == NULL) {
+            dst = &_dsts[i];
+            break;
+        }
+    }
+#else   /* GNRC_IPV6_NIB_CONF_FT_TRIE */
     for (unsigned i = 0; i < GNRC_IPV6_NIB_OFFL_NUMOF; i++) {
         _nib_offl_entry_t *tmp = &_dsts[i];
-        _nib_onl_entry_t *tmp_node = tmp->next_hop;
 
         if ((tmp->pfx_len == pfx_len) &&                /* prefix length matches and */
-            (tmp_node != NULL) &&                       /* there is a next hop that */
-            (_nib_onl_get_if(tmp_node) == iface) &&     /* has a matching interface and */
-            _addr_equals(next_hop, tmp_node) &&         /* equal address to next_hop, also */
+            _offl_same_next_hop(tmp, next_hop, iface) &&
             (ipv6_addr_match_prefix(&tmp->pfx, pfx) >= pfx_len)) {  /* the prefix matches */
-            /* exact match (or next hop address was previously unset) */
-            DEBUG("  %p is an exact match\n", (void *)tmp);
-            if (next_hop != NULL) {
-                memcpy(&tmp_node->ipv6, next_hop, sizeof(tmp_node->ipv6));
-            }
-            tmp->next_hop->mode |= _DST;
-            return tmp;
+            return _offl_reuse(tmp, next_hop);
         }
-        if ((dst == NULL) && (tmp_node == NULL)) {
+        if ((dst == NULL) && (tmp->next_hop == NULL)) {
             dst = tmp;
         }
     }
+#endif  /* GNRC_IPV6_NIB_CONF_FT_TRIE */
     if (dst != NULL) {
         DEBUG("  using %p\n", (void *)dst);
         dst->next_hop = _nib_onl_alloc(next_hop, iface);
@@ -502,6 +660,9 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
         dst->next_hop->mode |= _DST;
         ipv6_addr_init_prefix(&dst->pfx, pfx, pfx_len);
         dst->pfx_len = pfx_len;
+#if GNRC_IPV6_NIB_CONF_FT_TRIE
+        _nib_trie_add(dst);
+#endif  /* GNRC_IPV6_NIB_CONF_FT_TRIE */
     }
     return dst;
 }
@@ -533,7 +694,11 @@ void _nib_offl_clear(_nib_offl_entry_t *dst)
             dst->next_hop->mode &= ~(_DST);
             _nib_onl_clear(dst->next_hop);
         }
+#if GNRC_IPV6_NIB_CONF_FT_TRIE
+        _nib_trie_remove(dst);
+#endif  /* GNRC_IPV6_NIB_CONF_FT_TRIE */
         memset(dst, 0, sizeof(_nib_offl_entry_t));
+        _nib_changed();
     }
 }
 
@@ -558,6 +723,11 @@ bool _nib_offl_is_entry(const _nib_offl_entry_t *entry)
 
 static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
 {
+#if GNRC_IPV6_NIB_CONF_FT_TRIE
+    DEBUG("nib: get match for destination %s from NIB trie\n",
+          ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
+    return _nib_trie_match(dst);
+#else   /* GNRC_IPV6_NIB_CONF_FT_TRIE */
     _nib_offl_entry_t *res = NULL;
     uint8_t best_match = 0;
 
@@ -583,6 +753,7 @@ static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
         }
     }
     return res;
+#endif  /* GNRC_IPV6_NIB_CONF_FT_TRIE */
 }
 
 void _nib_ft_get(const _nib_offl_entry_t *dst, gnrc_ipv6_nib_ft_t *fte)
@@ -810,9 +981,10 @@ static void _override_node(const ipv6_addr_t *addr, unsigned iface,
 {
     _nib_onl_clear(node);
     if (addr != NULL) {
-        memcpy(&node->ipv6, addr, sizeof(node->ipv6));
+        _set_addr(node, addr);
     }
     _nib_onl_set_if(node, iface);
+    _touch(node);
 }
 
 static inline bool _node_unreachable(_nib_onl_entry_t *node)
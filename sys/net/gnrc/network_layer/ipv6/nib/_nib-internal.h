@@ -36,6 +36,7 @@
 #include "net/gnrc/ipv6/nib/ft.h"
 #include "net/gnrc/ipv6/nib/nc.h"
 #include "net/gnrc/ipv6/nib/conf.h"
+#include "net/gnrc/ipv6/route_cache.h"
 #include "net/gnrc/pktqueue.h"
 #include "net/gnrc/sixlowpan/ctx.h"
 #include "net/ndp.h"
@@ -91,6 +92,21 @@ extern "C" {
  */
 typedef struct _nib_onl_entry {
     struct _nib_onl_entry *next;        /**< next removable entry */
+#if GNRC_IPV6_NIB_CONF_NC_HASH || defined(DOXYGEN)
+    /**
+     * @brief   next entry in the same hash bucket
+     *
+     * @note    Only available if @ref GNRC_IPV6_NIB_CONF_NC_HASH != 0.
+     */
+    struct _nib_onl_entry *hnext;
+#endif
+    /**
+     * @brief   time stamp of the last lookup or creation of the entry
+     *
+     * Counted in NIB operations, not in time, to find the least recently used
+     * entry on cache-out.
+     */
+    uint32_t last_used;
 #if GNRC_IPV6_NIB_CONF_QUEUE_PKT || defined(DOXYGEN)
     /**
      * @brief   queue for packets currently in address resolution
@@ -194,7 +210,7 @@ typedef struct {
 /**
  * @brief   Off-link NIB entry
  */
-typedef struct {
+typedef struct _nib_offl_entry {
     _nib_onl_entry_t *next_hop; /**< next hop to destination */
     ipv6_addr_t pfx;            /**< prefix to the destination */
     /**
@@ -216,6 +232,14 @@ typedef struct {
                                      valid (UINT32_MAX means forever) */
     uint32_t pref_until;        /**< timestamp (in ms) until which the prefix
                                      preferred (UINT32_MAX means forever) */
+#if GNRC_IPV6_NIB_CONF_FT_TRIE || defined(DOXYGEN)
+    /**
+     * @brief   Next off-link entry with the same prefix
+     *
+     * @note    Only available if @ref GNRC_IPV6_NIB_CONF_FT_TRIE != 0
+     */
+    struct _nib_offl_entry *trie_next;
+#endif
 } _nib_offl_entry_t;
 
 /**
@@ -251,6 +275,11 @@ extern mutex_t _nib_mutex;
  */
 extern evtimer_msg_t _nib_evtimer;
 
+/**
+ * @brief   Statistics of the neighbor cache
+ */
+extern gnrc_ipv6_nib_nc_stats_t _nib_nc_stats;
+
 /**
  * @brief   Primary default router.
  *
@@ -291,6 +320,23 @@ static inline void _nib_onl_set_if(_nib_onl_entry_t *node, unsigned iface)
     node->info |= ((iface << _NIB_IF_POS) & _NIB_IF_MASK);
 }
 
+/**
+ * @brief   Invalidates results of the NIB cached elsewhere
+ *
+ * To be called with the NIB locked by functions that change the next hop
+ * or the link-layer address a destination resolves to: adding or removing
+ * neighbors, routers, routes and prefixes, and a neighbor changing its
+ * link-layer address or leaving a reachable state. Refreshing lifetimes or
+ * confirming reachability does not change anything cached, so the cache
+ * survives the traffic of an active network.
+ */
+static inline void _nib_changed(void)
+{
+#ifdef MODULE_GNRC_IPV6_ROUTE_CACHE
+    gnrc_ipv6_route_cache_invalidate();
+#endif
+}
+
 /**
  * @brief   Creates or gets an existing on-link entry by address
  *
@@ -304,6 +350,27 @@ static inline void _nib_onl_set_if(_nib_onl_entry_t *node, unsigned iface)
  */
 _nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface);
 
+#if GNRC_IPV6_NIB_CONF_NC_HASH || defined(DOXYGEN)
+/**
+ * @brief   Adds an on-link entry to the hash table under its current address
+ *
+ * @note    Only available if @ref GNRC_IPV6_NIB_CONF_NC_HASH != 0.
+ *
+ * @param[in] node  An entry not in the hash table.
+ */
+void _nib_onl_hash(_nib_onl_entry_t *node);
+
+/**
+ * @brief   Removes an on-link entry from the hash table
+ *
+ * @note    Only available if @ref GNRC_IPV6_NIB_CONF_NC_HASH != 0.
+ *
+ * @param[in] node  An entry in the hash table. Its _nib_onl_entry_t::ipv6
+ *                  must not have changed since it was added.
+ */
+void _nib_onl_unhash(_nib_onl_entry_t *node);
+#endif
+
 /**
  * @brief   Clears out a NIB entry (on-link version)
  *
@@ -315,7 +382,14 @@ _nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface);
 static inline bool _nib_onl_clear(_nib_onl_entry_t *node)
 {
     if (node->mode == _EMPTY) {
+#if GNRC_IPV6_NIB_CONF_NC_HASH
+        _nib_onl_unhash(node);
+#endif
         memset(node, 0, sizeof(_nib_onl_entry_t));
+#if GNRC_IPV6_NIB_CONF_NC_HASH
+        /* unused entries are hashed with the unspecified address */
+        _nib_onl_hash(node);
+#endif
         return true;
     }
     return false;
@@ -562,8 +636,9 @@ static inline _nib_offl_entry_t *_nib_offl_add(const ipv6_addr_t *next_hop,
 {
     _nib_offl_entry_t *nib_offl = _nib_offl_alloc(next_hop, iface, pfx, pfx_len);
 
-    if (nib_offl != NULL) {
+    if ((nib_offl != NULL) && ((nib_offl->mode & mode) != mode)) {
         nib_offl->mode |= mode;
+        _nib_changed();
     }
     return nib_offl;
 }
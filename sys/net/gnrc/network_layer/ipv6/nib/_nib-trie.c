@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @author  RIOT developers <devel@riot-os.org>
+ */
+
+#include <string.h>
+
+#include "assert.h"
+
+#include "_nib-trie.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#if GNRC_IPV6_NIB_CONF_FT_TRIE
+
+#define _NODES_NUMOF    (2 * GNRC_IPV6_NIB_OFFL_NUMOF)
+
+typedef struct _node {
+    /**
+     * @brief   Sub-tries, their prefixes continue with a 0 and a 1 bit
+     *          respectively (next free node for free nodes)
+     */
+    struct _node *child[2];
+    _nib_offl_entry_t *entries; /**< entries with the prefix of the node */
+    uint8_t len;                /**< length in bits of the prefix */
+} _node_t;
+
+static _node_t _nodes[_NODES_NUMOF];
+static _node_t *_free;
+static _node_t *_root;
+
+static inline unsigned _bit(const ipv6_addr_t *addr, unsigned idx)
+{
+    return (addr->u8[idx >> 3] >> (7 - (idx & 0x7))) & 0x1;
+}
+
+/* nodes without entries have two children, so following them leads to a
+ * node with entries sharing the prefix of node */
+static const ipv6_addr_t *_key(const _node_t *node)
+{
+    while (node->entries == NULL) {
+        node = node->child[0];
+    }
+    return &node->entries->pfx;
+}
+
+static _node_t *_node_alloc(unsigned len, _nib_offl_entry_t *entries)
+{
+    _node_t *node = _free;
+
+    /* there are more nodes than a trie of GNRC_IPV6_NIB_OFFL_NUMOF prefixes
+     * may have */
+    assert(node != NULL);
+    _free = node->child[0];
+    node->child[0] = NULL;
+    node->child[1] = NULL;
+    node->entries = entries;
+    node->len = len;
+    return node;
+}
+
+static void _node_free(_node_t *node)
+{
+    node->entries = NULL;
+    node->child[1] = NULL;
+    node->child[0] = _free;
+    _free = node;
+}
+
+/* searches the position of the node with exactly the prefix pfx / pfx_len,
+ * parent is set to the position of its parent */
+static _node_t **_find(const ipv6_addr_t *pfx, unsigned pfx_len,
+                       _node_t ***parent)
+{
+    _node_t **pos = &_root;
+
+    *parent = NULL;
+    while ((*pos != NULL) && ((*pos)->len < pfx_len)) {
+        *parent = pos;
+        pos = &(*pos)->child[_bit(pfx, (*pos)->len)];
+    }
+    if ((*pos == NULL) || ((*pos)->len != pfx_len) ||
+        (ipv6_addr_match_prefix(_key(*pos), pfx) < pfx_len)) {
+        return NULL;
+    }
+    return pos;
+}
+
+void _nib_trie_init(void)
+{
+    memset(_nodes, 0, sizeof(_nodes));
+    _free = NULL;
+    for (unsigned i = 0; i < _NODES_NUMOF; i++) {
+        _node_free(&_nodes[i]);
+    }
+    _root = NULL;
+}
+
+void _nib_trie_add(_nib_offl_entry_t *entry)
+{
+    const unsigned len = entry->pfx_len;
+    _node_t **pos = &_root;
+
+    assert((len > 0) && (len <= IPV6_ADDR_BIT_LEN));
+    entry->trie_next = NULL;
+    while (*pos != NULL) {
+        _node_t *node = *pos;
+        unsigned common = ipv6_addr_match_prefix(_key(node), &entry->pfx);
+
+        if (common > node->len) {
+            common = node->len;
+        }
+        if (common > len) {
+            common = len;
+        }
+        if (common < node->len) {
+            /* prefix of entry ends or deviates within the prefix of node */
+            _node_t *new;
+
+            if (common == len) {
+                new = _node_alloc(len, entry);
+            }
+            else {
+                new = _node_alloc(common, NULL);
+                new->child[_bit(&entry->pfx, common)] = _node_alloc(len, entry);
+            }
+            new->child[_bit(_key(node), common)] = node;
+            *pos = new;
+            return;
+        }
+        if (node->len == len) {
+            /* keep entries in the order of the off-link entries */
+            _nib_offl_entry_t **ptr = &node->entries;
+
+            while ((*ptr != NULL) && (*ptr < entry)) {
+                ptr = &(*ptr)->trie_next;
+            }
+            entry->trie_next = *ptr;
+            *ptr = entry;
+            return;
+        }
+        pos = &node->child[_bit(&entry->pfx, node->len)];
+    }
+    *pos = _node_alloc(len, entry);
+}
+
+void _nib_trie_remove(_nib_offl_entry_t *entry)
+{
+    _node_t **parent;
+    _node_t **pos = _find(&entry->pfx, entry->pfx_len, &parent);
+    _nib_offl_entry_t **ptr;
+    _node_t *node;
+
+    if (pos == NULL) {
+        return;
+    }
+    node = *pos;
+    for (ptr = &node->entries; *ptr != NULL; ptr = &(*ptr)->trie_next) {
+        if (*ptr == entry) {
+            *ptr = entry->trie_next;
+            entry->trie_next = NULL;
+            break;
+        }
+    }
+    if (node->entries != NULL) {
+        return;
+    }
+    if ((node->child[0] != NULL) && (node->child[1] != NULL)) {
+        /* still needed to branch */
+        return;
+    }
+    *pos = (node->child[0] != NULL) ? node->child[0] : node->child[1];
+    _node_free(node);
+    if ((*pos == NULL) && (parent != NULL) && ((*parent)->entries == NULL)) {
+        /* parent only branched to node, replace it by its other child */
+        node = *parent;
+        *parent = (node->child[0] != NULL) ? node->child[0] : node->child[1];
+        _node_free(node);
+    }
+}
+
+_nib_offl_entry_t *_nib_trie_get(const ipv6_addr_t *pfx, unsigned pfx_len)
+{
+    _node_t **parent;
+    _node_t **pos = _find(pfx, pfx_len, &parent);
+
+    return (pos != NULL) ? (*pos)->entries : NULL;
+}
+
+_nib_offl_entry_t *_nib_trie_match(const ipv6_addr_t *dst)
+{
+    _nib_offl_entry_t *res = NULL;
+    const _node_t *node = _root;
+
+    while (node != NULL) {
+        if (node->entries != NULL) {
+            if (ipv6_addr_match_prefix(&node->entries->pfx, dst) < node->len) {
+                /* no longer prefix below can match either */
+                break;
+            }
+            for (_nib_offl_entry_t *entry = node->entries; entry != NULL;
+                 entry = entry->trie_next) {
+                if (entry->mode != _EMPTY) {
+                    res = entry;
+                    break;
+                }
+            }
+        }
+        if (node->len >= IPV6_ADDR_BIT_LEN) {
+            break;
+        }
+        node = node->child[_bit(dst, node->len)];
+    }
+    return res;
+}
+#else   /* GNRC_IPV6_NIB_CONF_FT_TRIE */
+typedef int dont_be_pedantic;
+#endif  /* GNRC_IPV6_NIB_CONF_FT_TRIE */
+
+/** @} */
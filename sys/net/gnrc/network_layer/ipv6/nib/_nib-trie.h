@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_gnrc_ipv6_nib
+ * @internal
+ * @{
+ *
+ * @file
+ * @brief   Definitions related to the prefix trie indexing the off-link
+ *          entries of the NIB
+ * @see     @ref GNRC_IPV6_NIB_CONF_FT_TRIE
+ *
+ * The trie is a path-compressed binary trie (PATRICIA trie) over the
+ * prefixes of the off-link entries. Every node stands for a prefix and
+ * holds the off-link entries with exactly that prefix, chained by
+ * _nib_offl_entry_t::trie_next in the order of the off-link entries.
+ * Nodes holding no entries only exist where the prefixes below them branch,
+ * so at most `2 * GNRC_IPV6_NIB_OFFL_NUMOF - 1` nodes are ever needed and
+ * both looking up and adding a prefix visit at most as many nodes as the
+ * prefix is long.
+ *
+ * @author  RIOT developers <devel@riot-os.org>
+ */
+#ifndef PRIV_NIB_TRIE_H
+#define PRIV_NIB_TRIE_H
+
+#include "net/gnrc/ipv6/nib/conf.h"
+#include "net/ipv6/addr.h"
+
+#include "_nib-internal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if GNRC_IPV6_NIB_CONF_FT_TRIE || defined(DOXYGEN)
+/**
+ * @brief   Empties the trie
+ */
+void _nib_trie_init(void);
+
+/**
+ * @brief   Adds an off-link entry to the trie
+ *
+ * @pre `(entry != NULL) && (entry->pfx_len > 0)`
+ * @pre @p entry is not in the trie.
+ *
+ * @param[in] entry An off-link entry with _nib_offl_entry_t::pfx and
+ *                  _nib_offl_entry_t::pfx_len set.
+ */
+void _nib_trie_add(_nib_offl_entry_t *entry);
+
+/**
+ * @brief   Removes an off-link entry from the trie
+ *
+ * @param[in] entry An off-link entry in the trie. Its
+ *                  _nib_offl_entry_t::pfx and _nib_offl_entry_t::pfx_len
+ *                  must not have changed since it was added.
+ */
+void _nib_trie_remove(_nib_offl_entry_t *entry);
+
+/**
+ * @brief   Gets the off-link entries with exactly the given prefix
+ *
+ * @param[in] pfx       A prefix.
+ * @param[in] pfx_len   The length of @p pfx in bits.
+ *
+ * @return  The first off-link entry with prefix @p pfx / @p pfx_len, the
+ *          others follow via _nib_offl_entry_t::trie_next.
+ * @return  NULL, if there is no such entry.
+ */
+_nib_offl_entry_t *_nib_trie_get(const ipv6_addr_t *pfx, unsigned pfx_len);
+
+/**
+ * @brief   Gets the off-link entry with the longest prefix matching a
+ *          destination
+ *
+ * Entries without a [mode](@ref net_gnrc_ipv6_nib_mode) are skipped. Of
+ * several entries with the same prefix the first one is returned.
+ *
+ * @param[in] dst   A destination address.
+ *
+ * @return  The off-link entry with the longest prefix matching @p dst.
+ * @return  NULL, if no prefix matches @p dst.
+ */
+_nib_offl_entry_t *_nib_trie_match(const ipv6_addr_t *dst);
+#endif  /* GNRC_IPV6_NIB_CONF_FT_TRIE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PRIV_NIB_TRIE_H */
+/** @} */
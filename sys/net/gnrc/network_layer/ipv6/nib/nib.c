@@ -94,6 +94,7 @@ void gnrc_ipv6_nib_init(void)
         evtimer_del((evtimer_t *)(&_nib_evtimer), ptr);
     }
     _nib_init();
+    _nib_changed();
     mutex_unlock(&_nib_mutex);
 }
 
@@ -1493,8 +1494,10 @@ static uint32_t _handle_pio(gnrc_netif_t *netif, const icmpv6_hdr_t *icmpv6,
                 _nib_abr_add_pfx(abr, pfx);
             }
 #endif  /* GNRC_IPV6_NIB_CONF_MULTIHOP_P6C */
-            if (pio->flags & NDP_OPT_PI_FLAGS_L) {
+            if ((pio->flags & NDP_OPT_PI_FLAGS_L) &&
+                !(pfx->flags & _PFX_ON_LINK)) {
                 pfx->flags |= _PFX_ON_LINK;
+                _nib_changed();
             }
             if (pio->flags & NDP_OPT_PI_FLAGS_A) {
                 pfx->flags |= _PFX_SLAAC;
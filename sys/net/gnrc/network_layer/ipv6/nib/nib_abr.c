@@ -53,6 +53,7 @@ void gnrc_ipv6_nib_abr_del(const ipv6_addr_t *addr)
 {
     mutex_lock(&_nib_mutex);
     _nib_abr_remove(addr);
+    _nib_changed();
     mutex_unlock(&_nib_mutex);
 }
 #endif  /* GNRC_IPV6_NIB_CONF_6LBR */
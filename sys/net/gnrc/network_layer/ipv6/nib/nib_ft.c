@@ -44,6 +44,7 @@ int gnrc_ipv6_nib_ft_add(const ipv6_addr_t *dst, unsigned dst_len,
         return -EINVAL;
     }
     mutex_lock(&_nib_mutex);
+    _nib_changed();
     if (is_default_route) {
         _nib_dr_entry_t *ptr;
 
@@ -85,6 +86,7 @@ int gnrc_ipv6_nib_ft_add(const ipv6_addr_t *dst, unsigned dst_len,
 void gnrc_ipv6_nib_ft_del(const ipv6_addr_t *dst, unsigned dst_len)
 {
     mutex_lock(&_nib_mutex);
+    _nib_changed();
     if ((dst == NULL) || (dst_len == 0) || ipv6_addr_is_unspecified(dst)) {
         _nib_dr_entry_t *entry = _nib_drl_get_dr();
 
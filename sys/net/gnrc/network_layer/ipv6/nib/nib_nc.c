@@ -14,6 +14,7 @@
  */
 
 #include <errno.h>
+#include <inttypes.h>
 #include <stdbool.h>
 #include <stdio.h>
 
@@ -33,6 +34,7 @@ int gnrc_ipv6_nib_nc_set(const ipv6_addr_t *ipv6, unsigned iface,
     assert(l2addr_len <= GNRC_IPV6_NIB_L2ADDR_MAX_LEN);
     assert((iface > KERNEL_PID_UNDEF) && (iface <= KERNEL_PID_LAST));
     mutex_lock(&_nib_mutex);
+    _nib_changed();
     node = _nib_nc_add(ipv6, iface, GNRC_IPV6_NIB_NC_INFO_NUD_STATE_UNMANAGED);
     if (node == NULL) {
         mutex_unlock(&_nib_mutex);
@@ -105,6 +107,14 @@ bool gnrc_ipv6_nib_nc_iter(unsigned iface, void **state,
     return (*state != NULL);
 }
 
+void gnrc_ipv6_nib_nc_get_stats(gnrc_ipv6_nib_nc_stats_t *stats)
+{
+    assert(stats != NULL);
+    mutex_lock(&_nib_mutex);
+    *stats = _nib_nc_stats;
+    mutex_unlock(&_nib_mutex);
+}
+
 #if GNRC_IPV6_NIB_CONF_ARSM
 static const char *_nud_str[] = {
     [GNRC_IPV6_NIB_NC_INFO_NUD_STATE_UNMANAGED]     = "-",
@@ -152,4 +162,13 @@ void gnrc_ipv6_nib_nc_print(gnrc_ipv6_nib_nc_t *entry)
     puts("");
 }
 
+void gnrc_ipv6_nib_nc_print_stats(void)
+{
+    gnrc_ipv6_nib_nc_stats_t stats;
+
+    gnrc_ipv6_nib_nc_get_stats(&stats);
+    printf("hits: %" PRIu32 ", misses: %" PRIu32 ", evictions: %" PRIu32 "\n",
+           stats.hits, stats.misses, stats.evictions);
+}
+
 /** @} */
@@ -43,6 +43,7 @@ int gnrc_ipv6_nib_pl_set(unsigned iface,
         return -EINVAL;
     }
     mutex_lock(&_nib_mutex);
+    _nib_changed();
     dst = _nib_pl_add(iface, pfx, pfx_len, valid_ltime,
                       pref_ltime);
     if (dst == NULL) {
@@ -93,6 +94,7 @@ void gnrc_ipv6_nib_pl_del(unsigned iface,
 
     assert(pfx != NULL);
     mutex_lock(&_nib_mutex);
+    _nib_changed();
     while ((dst = _nib_offl_iter(dst)) != NULL) {
         assert(dst->next_hop != NULL);
         if ((pfx_len == dst->pfx_len) &&
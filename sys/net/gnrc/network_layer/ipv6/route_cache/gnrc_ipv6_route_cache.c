@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @author  RIOT developers <devel@riot-os.org>
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "irq.h"
+
+#include "net/gnrc/ipv6/route_cache.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#if (GNRC_IPV6_ROUTE_CACHE_SIZE & (GNRC_IPV6_ROUTE_CACHE_SIZE - 1)) || \
+    (GNRC_IPV6_ROUTE_CACHE_SIZE > 256)
+#error "GNRC_IPV6_ROUTE_CACHE_SIZE must be a power of 2 and at most 256"
+#endif
+
+typedef struct {
+    ipv6_addr_t dst;            /**< destination */
+    gnrc_ipv6_nib_nc_t nce;     /**< next hop to dst */
+    /**
+     * @brief   interface requested for dst (KERNEL_PID_UNDEF for any)
+     */
+    kernel_pid_t iface;
+    /**
+     * @brief   value of _version when the entry was resolved, the entry is
+     *          invalid once they differ
+     */
+    uint32_t version;
+} _entry_t;
+
+static _entry_t _cache[GNRC_IPV6_ROUTE_CACHE_SIZE];
+/* starts with 1 so unused entries are invalid */
+static volatile uint32_t _version = 1;
+static uint32_t _miss_version;
+static gnrc_ipv6_route_cache_stats_t _stats;
+
+static inline _entry_t *_entry(const ipv6_addr_t *dst)
+{
+    uint32_t hash = dst->u32[0].u32 ^ dst->u32[1].u32 ^
+                    dst->u32[2].u32 ^ dst->u32[3].u32;
+
+    hash = (hash ^ (hash >> 16)) * 2654435769U;
+    return &_cache[(hash >> 24) & (GNRC_IPV6_ROUTE_CACHE_SIZE - 1)];
+}
+
+static inline kernel_pid_t _iface(const gnrc_netif_t *netif)
+{
+    return (netif == NULL) ? KERNEL_PID_UNDEF : netif->pid;
+}
+
+const gnrc_ipv6_nib_nc_t *gnrc_ipv6_route_cache_get(const ipv6_addr_t *dst,
+                                                    const gnrc_netif_t *netif)
+{
+    _entry_t *entry = _entry(dst);
+    uint32_t version = _version;
+
+    if ((entry->version == version) && (entry->iface == _iface(netif)) &&
+        ipv6_addr_equal(&entry->dst, dst)) {
+        _stats.hits++;
+        return &entry->nce;
+    }
+    _stats.misses++;
+    /* changes of the NIB while it resolves dst invalidate the result */
+    _miss_version = version;
+    return NULL;
+}
+
+void gnrc_ipv6_route_cache_add(const ipv6_addr_t *dst,
+                               const gnrc_netif_t *netif,
+                               const gnrc_ipv6_nib_nc_t *nce)
+{
+    _entry_t *entry = _entry(dst);
+
+    memcpy(&entry->dst, dst, sizeof(entry->dst));
+    memcpy(&entry->nce, nce, sizeof(entry->nce));
+    entry->iface = _iface(netif);
+    entry->version = _miss_version;
+}
+
+void gnrc_ipv6_route_cache_invalidate(void)
+{
+    /* concurrent invalidations may lose an increment, but the version
+     * changes nonetheless */
+    _version++;
+    DEBUG("ipv6 route cache: invalidated\n");
+}
+
+void gnrc_ipv6_route_cache_forwarded(uint32_t time)
+{
+    _stats.forwarded++;
+    _stats.forward_time += time;
+}
+
+void gnrc_ipv6_route_cache_get_stats(gnrc_ipv6_route_cache_stats_t *stats)
+{
+    assert(stats != NULL);
+    unsigned state = irq_disable();
+
+    *stats = _stats;
+    irq_restore(state);
+}
+
+/** @} */
@@ -21,13 +21,15 @@
 #include "net/gnrc.h"
 #include "net/gnrc/sixlowpan.h"
 #include "net/gnrc/sixlowpan/frag.h"
+#ifdef  MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+#include "net/gnrc/sixlowpan/frag/sfr.h"
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_SFR */
 #ifdef  MODULE_GNRC_SIXLOWPAN_FRAG_VRB
 #include "net/gnrc/sixlowpan/frag/vrb.h"
 #endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
 #include "net/sixlowpan.h"
 #include "thread.h"
 #include "xtimer.h"
-#include "utlist.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -45,10 +47,25 @@
 #define RBUF_INT_SIZE (DIV_CEIL(IPV6_MIN_MTU, GNRC_SIXLOWPAN_FRAG_SIZE) * RBUF_SIZE)
 #endif
 
+#define RBUF_BUCKETS    (GNRC_SIXLOWPAN_FRAG_RBUF_BUCKETS)
+
+#if (RBUF_BUCKETS & (RBUF_BUCKETS - 1)) != 0
+#error "GNRC_SIXLOWPAN_FRAG_RBUF_BUCKETS must be a power of two"
+#endif
+
+#if RBUF_SIZE > UINT8_MAX
+#error "GNRC_SIXLOWPAN_FRAG_RBUF_SIZE must not exceed UINT8_MAX"
+#endif
+
 static gnrc_sixlowpan_rbuf_int_t rbuf_int[RBUF_INT_SIZE];
 
 static gnrc_sixlowpan_rbuf_t rbuf[RBUF_SIZE];
 
+/* Hash buckets of rbuf entries, chained by _rbuf_next. Both store the index of
+ * an entry in rbuf plus one, so 0 marks the end of a chain */
+static uint8_t _rbuf_bucket[RBUF_BUCKETS];
+static uint8_t _rbuf_next[RBUF_SIZE];
+
 static char l2addr_str[3 * IEEE802154_LONG_ADDRESS_LEN];
 
 static xtimer_t _gc_timer;
@@ -95,12 +112,15 @@ static int _check_fragments(gnrc_sixlowpan_rbuf_base_t *entry,
                             size_t frag_size, size_t offset)
 {
     gnrc_sixlowpan_rbuf_int_t *ptr = entry->ints;
+    uint16_t end = (uint16_t)(offset + frag_size - 1);
 
     /* If the fragment overlaps another fragment and differs in either the size
      * or the offset of the overlapped fragment, discards the datagram
-     * https://tools.ietf.org/html/rfc4944#section-5.3 */
-    while (ptr != NULL) {
-        if (_rbuf_int_overlap_partially(ptr, offset, offset + frag_size - 1)) {
+     * https://tools.ietf.org/html/rfc4944#section-5.3
+     * Intervals are sorted by their start, so no interval after one starting
+     * behind the fragment can overlap it */
+    while ((ptr != NULL) && (ptr->start <= end)) {
+        if (_rbuf_int_overlap_partially(ptr, offset, end)) {
 
             /* "A fresh reassembly may be commenced with the most recently
              * received link fragment"
@@ -167,6 +187,9 @@ static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
         gnrc_pktbuf_release(entry->pkt);
         gnrc_pktbuf_release(pkt);
         rbuf_rm(entry);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+        _stats.rbuf_invalid++;
+#endif
         return RBUF_ADD_ERROR;
     }
 
@@ -175,6 +198,9 @@ static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
             DEBUG("6lo rfrag: overlapping intervals, discarding datagram\n");
             gnrc_pktbuf_release(entry->pkt);
             rbuf_rm(entry);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+            _stats.rbuf_invalid++;
+#endif
             return RBUF_ADD_REPEAT;
         case RBUF_ADD_DUPLICATE:
             gnrc_pktbuf_release(pkt);
@@ -233,8 +259,49 @@ static gnrc_sixlowpan_rbuf_int_t *_rbuf_int_get_free(void)
     return NULL;
 }
 
+static unsigned _rbuf_hash(const uint8_t *src, size_t src_len,
+                           const uint8_t *dst, size_t dst_len,
+                           size_t size, uint16_t tag)
+{
+    uint32_t hash = ((uint32_t)tag << 16) | (uint16_t)size;
+
+    for (unsigned i = 0; i < src_len; i++) {
+        hash = (hash * 33) ^ src[i];
+    }
+    for (unsigned i = 0; i < dst_len; i++) {
+        hash = (hash * 33) ^ dst[i];
+    }
+    hash ^= hash >> 16;
+    hash ^= hash >> 8;
+    return hash & (RBUF_BUCKETS - 1);
+}
+
+static inline unsigned _rbuf_entry_hash(const gnrc_sixlowpan_rbuf_t *entry)
+{
+    return _rbuf_hash(entry->super.src, entry->super.src_len,
+                      entry->super.dst, entry->super.dst_len,
+                      entry->super.datagram_size, entry->super.tag);
+}
+
+static void _rbuf_unlink(gnrc_sixlowpan_rbuf_t *entry)
+{
+    uint8_t idx = (uint8_t)(entry - rbuf) + 1;
+    uint8_t *ptr = &_rbuf_bucket[_rbuf_entry_hash(entry)];
+
+    /* entry might not be in the table, e.g. when its allocation failed */
+    while (*ptr != 0) {
+        if (*ptr == idx) {
+            *ptr = _rbuf_next[idx - 1];
+            _rbuf_next[idx - 1] = 0;
+            return;
+        }
+        ptr = &_rbuf_next[*ptr - 1];
+    }
+}
+
 void rbuf_rm(gnrc_sixlowpan_rbuf_t *entry)
 {
+    _rbuf_unlink(entry);
     gnrc_sixlowpan_frag_rbuf_base_rm(&entry->super);
     entry->pkt = NULL;
 }
@@ -242,7 +309,7 @@ void rbuf_rm(gnrc_sixlowpan_rbuf_t *entry)
 static bool _rbuf_update_ints(gnrc_sixlowpan_rbuf_base_t *entry,
                               uint16_t offset, size_t frag_size)
 {
-    gnrc_sixlowpan_rbuf_int_t *new;
+    gnrc_sixlowpan_rbuf_int_t *new, **ptr = &entry->ints;
     uint16_t end = (uint16_t)(offset + frag_size - 1);
 
     new = _rbuf_int_get_free();
@@ -264,7 +331,12 @@ static bool _rbuf_update_ints(gnrc_sixlowpan_rbuf_base_t *entry,
                                                   l2addr_str),
           entry->datagram_size, entry->tag);
 
-    LL_PREPEND(entry->ints, new);
+    /* keep intervals sorted by their start */
+    while ((*ptr != NULL) && ((*ptr)->start < offset)) {
+        ptr = &(*ptr)->next;
+    }
+    new->next = *ptr;
+    *ptr = new;
 
     return true;
 }
@@ -290,11 +362,17 @@ void rbuf_gc(void)
 
             gnrc_pktbuf_release(rbuf[i].pkt);
             rbuf_rm(&(rbuf[i]));
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+            _stats.rbuf_timeout++;
+#endif
         }
     }
 #ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
     gnrc_sixlowpan_frag_vrb_gc();
 #endif
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    gnrc_sixlowpan_frag_sfr_gc();
+#endif
 }
 
 static inline void _set_rbuf_timeout(void)
@@ -302,38 +380,104 @@ static inline void _set_rbuf_timeout(void)
     xtimer_set_msg(&_gc_timer, RBUF_TIMEOUT, &_gc_timer_msg, sched_active_pid);
 }
 
+/* checks whether entry a should rather be evicted than entry b: entries that
+ * did not receive more than one fragment yet go first, then entries holding a
+ * smaller share of their datagram, then the least recently used */
+static bool _rbuf_evict_before(const gnrc_sixlowpan_rbuf_t *a,
+                               const gnrc_sixlowpan_rbuf_t *b)
+{
+    bool a_single = (a->super.ints == NULL) || (a->super.ints->next == NULL);
+    bool b_single = (b->super.ints == NULL) || (b->super.ints->next == NULL);
+
+    if (a_single != b_single) {
+        return a_single;
+    }
+    if (!a_single) {
+        uint32_t a_share = (uint32_t)a->super.current_size *
+                           b->super.datagram_size;
+        uint32_t b_share = (uint32_t)b->super.current_size *
+                           a->super.datagram_size;
+
+        if (a_share != b_share) {
+            return (a_share < b_share);
+        }
+    }
+    /* note that xtimer_now will overflow in ~1.2 hours */
+    return (a->super.arrival != b->super.arrival) &&
+           ((b->super.arrival - a->super.arrival) < UINT32_MAX / 2);
+}
+
+static unsigned _rbuf_src_entries(const uint8_t *src, size_t src_len)
+{
+    unsigned entries = 0;
+
+    for (unsigned int i = 0; i < RBUF_SIZE; i++) {
+        if (!rbuf_entry_empty(&rbuf[i]) && (rbuf[i].super.src_len == src_len) &&
+            (memcmp(rbuf[i].super.src, src, src_len) == 0)) {
+            entries++;
+        }
+    }
+    return entries;
+}
+
+static gnrc_sixlowpan_rbuf_t *_rbuf_evict(gnrc_sixlowpan_rbuf_t *entry)
+{
+    DEBUG("6lo rfrag: remove entry (%s, ",
+          gnrc_netif_addr_to_str(entry->super.src, entry->super.src_len,
+                                 l2addr_str));
+    DEBUG("%s, %u, %u) for new datagram\n",
+          gnrc_netif_addr_to_str(entry->super.dst, entry->super.dst_len,
+                                 l2addr_str),
+          (unsigned)entry->super.datagram_size, entry->super.tag);
+    gnrc_pktbuf_release(entry->pkt);
+    rbuf_rm(entry);
+    return entry;
+}
+
 static gnrc_sixlowpan_rbuf_t *_rbuf_get(const void *src, size_t src_len,
                                         const void *dst, size_t dst_len,
                                         size_t size, uint16_t tag,
                                         unsigned page)
 {
     gnrc_sixlowpan_rbuf_t *res = NULL, *oldest = NULL;
+    gnrc_sixlowpan_rbuf_t *victim = NULL, *src_victim = NULL;
     uint32_t now_usec = xtimer_now_usec();
-
-    for (unsigned int i = 0; i < RBUF_SIZE; i++) {
-        /* check first if entry already available */
-        if ((rbuf[i].pkt != NULL) && (rbuf[i].super.datagram_size == size) &&
-            (rbuf[i].super.tag == tag) && (rbuf[i].super.src_len == src_len) &&
-            (rbuf[i].super.dst_len == dst_len) &&
-            (memcmp(rbuf[i].super.src, src, src_len) == 0) &&
-            (memcmp(rbuf[i].super.dst, dst, dst_len) == 0)) {
-            DEBUG("6lo rfrag: entry %p (%s, ", (void *)(&rbuf[i]),
-                  gnrc_netif_addr_to_str(rbuf[i].super.src,
-                                         rbuf[i].super.src_len,
+    unsigned hash = _rbuf_hash(src, src_len, dst, dst_len, size, tag);
+    unsigned src_entries = 0, victim_entries = 0;
+
+    /* check first if entry already available */
+    for (uint8_t i = _rbuf_bucket[hash]; i != 0; i = _rbuf_next[i - 1]) {
+        gnrc_sixlowpan_rbuf_t *entry = &rbuf[i - 1];
+
+        if ((entry->super.datagram_size == size) &&
+            (entry->super.tag == tag) && (entry->super.src_len == src_len) &&
+            (entry->super.dst_len == dst_len) &&
+            (memcmp(entry->super.src, src, src_len) == 0) &&
+            (memcmp(entry->super.dst, dst, dst_len) == 0)) {
+            DEBUG("6lo rfrag: entry %p (%s, ", (void *)entry,
+                  gnrc_netif_addr_to_str(entry->super.src,
+                                         entry->super.src_len,
                                          l2addr_str));
             DEBUG("%s, %u, %u) found\n",
-                  gnrc_netif_addr_to_str(rbuf[i].super.dst,
-                                         rbuf[i].super.dst_len,
+                  gnrc_netif_addr_to_str(entry->super.dst,
+                                         entry->super.dst_len,
                                          l2addr_str),
-                  (unsigned)rbuf[i].super.datagram_size, rbuf[i].super.tag);
-            rbuf[i].super.arrival = now_usec;
+                  (unsigned)entry->super.datagram_size, entry->super.tag);
+            entry->super.arrival = now_usec;
             _set_rbuf_timeout();
-            return &(rbuf[i]);
+            return entry;
         }
+    }
+
+    for (unsigned int i = 0; i < RBUF_SIZE; i++) {
+        unsigned entries;
 
         /* if there is a free spot: remember it */
-        if ((res == NULL) && rbuf_entry_empty(&rbuf[i])) {
-            res = &(rbuf[i]);
+        if (rbuf_entry_empty(&rbuf[i])) {
+            if (res == NULL) {
+                res = &(rbuf[i]);
+            }
+            continue;
         }
 
         /* remember oldest slot */
@@ -342,32 +486,61 @@ static gnrc_sixlowpan_rbuf_t *_rbuf_get(const void *src, size_t src_len,
             (oldest->super.arrival - rbuf[i].super.arrival < UINT32_MAX / 2)) {
             oldest = &(rbuf[i]);
         }
+        /* remember slot to evict: of the source with the most entries, so
+         * a flooding source can not push out the datagrams of others */
+        entries = _rbuf_src_entries(rbuf[i].super.src, rbuf[i].super.src_len);
+        if ((victim == NULL) || (entries > victim_entries) ||
+            ((entries == victim_entries) &&
+             _rbuf_evict_before(&rbuf[i], victim))) {
+            victim = &(rbuf[i]);
+            victim_entries = entries;
+        }
+        /* remember slot to evict of the datagram's source */
+        if ((rbuf[i].super.src_len == src_len) &&
+            (memcmp(rbuf[i].super.src, src, src_len) == 0)) {
+            src_entries++;
+            if ((src_victim == NULL) ||
+                _rbuf_evict_before(&rbuf[i], src_victim)) {
+                src_victim = &(rbuf[i]);
+            }
+        }
     }
 
-    /* entry not in buffer and no empty spot found */
-    if (res == NULL) {
-        assert(oldest != NULL);
-        /* if oldest is not empty, res must not be NULL (because otherwise
-         * oldest could have been picked as res) */
-        assert(!rbuf_entry_empty(oldest));
-        if (GNRC_SIXLOWPAN_FRAG_RBUF_AGGRESSIVE_OVERRIDE ||
-            ((now_usec - oldest->super.arrival) >
-            GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US)) {
-            DEBUG("6lo rfrag: reassembly buffer full, remove oldest entry\n");
-            gnrc_pktbuf_release(oldest->pkt);
-            rbuf_rm(oldest);
-            res = oldest;
-#if GNRC_SIXLOWPAN_FRAG_RBUF_AGGRESSIVE_OVERRIDE && \
-    defined(MODULE_GNRC_SIXLOWPAN_FRAG_STATS)
-            _stats.rbuf_full++;
+    /* a single source must not occupy all of the reassembly buffer */
+    if (src_entries >= GNRC_SIXLOWPAN_FRAG_RBUF_SRC_QUOTA) {
+        assert(src_victim != NULL);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+        _stats.rbuf_full++;
 #endif
+        if (!GNRC_SIXLOWPAN_FRAG_RBUF_AGGRESSIVE_OVERRIDE) {
+            DEBUG("6lo rfrag: source exceeds its reassembly buffer quota\n");
+            return NULL;
         }
-        else {
+        res = _rbuf_evict(src_victim);
 #ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
-            _stats.rbuf_full++;
+        _stats.rbuf_evict_quota++;
 #endif
+    }
+    /* entry not in buffer and no empty spot found */
+    else if (res == NULL) {
+        assert((oldest != NULL) && (victim != NULL));
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+        _stats.rbuf_full++;
+#endif
+        if (GNRC_SIXLOWPAN_FRAG_RBUF_AGGRESSIVE_OVERRIDE) {
+            res = _rbuf_evict(victim);
+        }
+        else if ((now_usec - oldest->super.arrival) >
+                 GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US) {
+            res = _rbuf_evict(oldest);
+        }
+        else {
+            DEBUG("6lo rfrag: reassembly buffer full\n");
             return NULL;
         }
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+        _stats.rbuf_evict_full++;
+#endif
     }
 
     /* now we have an empty spot */
@@ -399,6 +572,8 @@ static gnrc_sixlowpan_rbuf_t *_rbuf_get(const void *src, size_t src_len,
     res->super.dst_len = dst_len;
     res->super.tag = tag;
     res->super.current_size = 0;
+    _rbuf_next[res - rbuf] = _rbuf_bucket[hash];
+    _rbuf_bucket[hash] = (uint8_t)(res - rbuf) + 1;
 
     DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
           gnrc_netif_addr_to_str(res->super.src, res->super.src_len,
@@ -425,6 +600,8 @@ void rbuf_reset(void)
         }
     }
     memset(rbuf, 0, sizeof(rbuf));
+    memset(_rbuf_bucket, 0, sizeof(_rbuf_bucket));
+    memset(_rbuf_next, 0, sizeof(_rbuf_next));
 }
 
 const gnrc_sixlowpan_rbuf_t *rbuf_array(void)
@@ -66,7 +66,8 @@ void rbuf_gc(void);
  * @brief   Unsets a reassembly buffer entry (but does not free
  *          rbuf_t::super::pkt)
  *
- * This functions sets rbuf_t::super::pkt to NULL and removes all rbuf::ints.
+ * This functions sets rbuf_t::super::pkt to NULL, removes all rbuf::ints and
+ * removes the entry from the look-up table.
  *
  * @param[in] rbuf  A reassembly buffer entry
  *
@@ -0,0 +1,810 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @author  RIOT developers <devel@riot-os.org>
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/internal.h"
+#include "net/ieee802154.h"
+#include "net/sixlowpan.h"
+#include "thread.h"
+#include "utlist.h"
+#include "xtimer.h"
+
+#include "net/gnrc/sixlowpan/frag/sfr.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#if GNRC_SIXLOWPAN_SFR_WIN_SIZE > 32
+#error "GNRC_SIXLOWPAN_SFR_WIN_SIZE must not be greater than 32"
+#endif
+
+/**
+ * @brief   Maximum number of fragments of a datagram, limited by the bitmap
+ *          of a fragment acknowledgment
+ */
+#define SFR_FRAGS_MAX           (32U)
+
+/**
+ * @brief   Number of disjoint byte intervals a reassembly buffer entry can
+ *          track
+ *
+ * Adjacent intervals are merged, so a datagram received in order needs only
+ * one. A fragment that would need another interval is ignored and, as it is
+ * not acknowledged, sent again later.
+ */
+#ifndef SFR_RBUF_INTS
+#define SFR_RBUF_INTS           (4U)
+#endif
+
+/**
+ * @brief   Sender state of a datagram
+ *
+ * The bitmaps have the same layout as sixlowpan_sfr_ack_t::bitmap: the most
+ * significant bit stands for the fragment with sequence number 0.
+ */
+typedef struct {
+    gnrc_pktsnip_t *pkt;        /**< the datagram, NULL if entry is unused */
+    xtimer_t timer;             /**< timer for pacing and acknowledgments */
+    msg_t timer_msg;            /**< message of _sfr_send_t::timer */
+    uint32_t sent;              /**< fragments sent at least once */
+    uint32_t acked;             /**< fragments acknowledged by the receiver */
+    uint32_t pending;           /**< fragments left in the current burst */
+    uint16_t datagram_size;     /**< size of the compressed datagram */
+    uint16_t frag_size;         /**< payload size of a fragment */
+    uint8_t tag;                /**< datagram tag */
+    uint8_t frags;              /**< number of fragments of the datagram */
+    uint8_t retries;            /**< acknowledgments requested in vain */
+    bool wait_ack;              /**< last fragment of a burst was sent */
+} _sfr_send_t;
+
+/**
+ * @brief   Receiver state of a datagram
+ *
+ * gnrc_sixlowpan_rbuf_base_t::datagram_size is 0 until the fragment with
+ * sequence number 0 arrived. A complete datagram keeps its entry until it
+ * times out (with _sfr_rbuf_t::pkt set to NULL), so a fragment sent again
+ * because an acknowledgment got lost is answered without delivering the
+ * datagram twice.
+ */
+typedef struct {
+    gnrc_sixlowpan_rbuf_base_t super;   /**< base class */
+    gnrc_pktsnip_t *pkt;                /**< the compressed datagram */
+    uint32_t received;                  /**< fragments received, 0 if entry
+                                         *   is unused */
+    /**
+     * @brief   Received bytes, sorted and disjoint, the end is exclusive
+     */
+    struct {
+        uint16_t start;                 /**< first byte of the interval */
+        uint16_t end;                   /**< byte after the interval */
+    } ints[SFR_RBUF_INTS];
+    uint8_t ints_len;                   /**< used intervals in
+                                         *   _sfr_rbuf_t::ints */
+} _sfr_rbuf_t;
+
+static _sfr_send_t _send_buf[GNRC_SIXLOWPAN_MSG_FRAG_SIZE];
+static _sfr_rbuf_t _rbuf[GNRC_SIXLOWPAN_SFR_RBUF_SIZE];
+static xtimer_t _gc_timer;
+static msg_t _gc_timer_msg = { .type = GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF };
+
+static char l2addr_str[3 * IEEE802154_LONG_ADDRESS_LEN];
+
+static inline uint32_t _bit(unsigned seq)
+{
+    return 0x80000000UL >> seq;
+}
+
+/* bitmap of all fragments of a datagram with frags fragments */
+static inline uint32_t _all(unsigned frags)
+{
+    return (frags >= SFR_FRAGS_MAX) ? SIXLOWPAN_SFR_ACK_BITMAP_FULL
+                                    : ~(SIXLOWPAN_SFR_ACK_BITMAP_FULL >> frags);
+}
+
+static inline unsigned _frag_size(const gnrc_netif_t *netif)
+{
+    if (netif->sixlo.max_frag_size <= sizeof(sixlowpan_sfr_rfrag_t)) {
+        return 0;
+    }
+    unsigned res = netif->sixlo.max_frag_size - sizeof(sixlowpan_sfr_rfrag_t);
+
+    return (res > SIXLOWPAN_SFR_FRAG_SIZE_MASK) ? SIXLOWPAN_SFR_FRAG_SIZE_MASK
+                                                : res;
+}
+
+static void _copy_from_pkt(uint8_t *data, const gnrc_pktsnip_t *pkt,
+                           size_t offset, size_t size)
+{
+    while ((pkt != NULL) && (size > 0)) {
+        if (offset >= pkt->size) {
+            offset -= pkt->size;
+        }
+        else {
+            size_t clen = pkt->size - offset;
+
+            if (clen > size) {
+                clen = size;
+            }
+            memcpy(data, ((uint8_t *)pkt->data) + offset, clen);
+            data += clen;
+            size -= clen;
+            offset = 0;
+        }
+        pkt = pkt->next;
+    }
+}
+
+/* sends fragment seq of s, or the abort fragment with seq == SFR_FRAGS_MAX */
+static bool _send_frag(_sfr_send_t *s, unsigned seq, bool ack_req)
+{
+    gnrc_netif_hdr_t *netif_hdr = s->pkt->data, *new_netif_hdr;
+    gnrc_pktsnip_t *netif, *frag;
+    sixlowpan_sfr_rfrag_t *hdr;
+    uint16_t offset = 0, size = 0;
+
+    if (seq < SFR_FRAGS_MAX) {
+        offset = seq * s->frag_size;
+        size = s->datagram_size - offset;
+        if (size > s->frag_size) {
+            size = s->frag_size;
+        }
+    }
+    netif = gnrc_netif_hdr_build(gnrc_netif_hdr_get_src_addr(netif_hdr),
+                                 netif_hdr->src_l2addr_len,
+                                 gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                                 netif_hdr->dst_l2addr_len);
+    if (netif == NULL) {
+        DEBUG("6lo sfr: error allocating new link-layer header\n");
+        return false;
+    }
+    new_netif_hdr = netif->data;
+    new_netif_hdr->if_pid = netif_hdr->if_pid;
+    new_netif_hdr->flags = netif_hdr->flags;
+    new_netif_hdr->rssi = netif_hdr->rssi;
+    new_netif_hdr->lqi = netif_hdr->lqi;
+    if (!ack_req && (seq < SFR_FRAGS_MAX)) {
+        /* Tell the link layer that we will send more fragments */
+        new_netif_hdr->flags |= GNRC_NETIF_HDR_FLAGS_MORE_DATA;
+    }
+    frag = gnrc_pktbuf_add(NULL, NULL, sizeof(sixlowpan_sfr_rfrag_t) + size,
+                           GNRC_NETTYPE_SIXLOWPAN);
+    if (frag == NULL) {
+        DEBUG("6lo sfr: error allocating fragment\n");
+        gnrc_pktbuf_release(netif);
+        return false;
+    }
+    hdr = frag->data;
+    hdr->disp_ecn = SIXLOWPAN_SFR_RFRAG_DISP;
+    hdr->tag = s->tag;
+    hdr->ar_seq_fs = byteorder_htons((ack_req ? SIXLOWPAN_SFR_ACK_REQ : 0) |
+                                     (((seq < SFR_FRAGS_MAX) ? seq : 0) <<
+                                      SIXLOWPAN_SFR_SEQ_POS) | size);
+    /* the first fragment carries the size of the datagram instead of its
+     * offset */
+    hdr->offset = byteorder_htons(((seq == 0) ? s->datagram_size : offset));
+    _copy_from_pkt((uint8_t *)(hdr + 1), s->pkt->next, offset, size);
+    LL_PREPEND(frag, netif);
+    DEBUG("6lo sfr: send fragment (tag: %u, seq: %u, size: %u%s)\n",
+          s->tag, seq, size, ack_req ? ", ACK requested" : "");
+    gnrc_sixlowpan_dispatch_send(frag, NULL, 0);
+    return true;
+}
+
+static _sfr_send_t *_send_get(void)
+{
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_MSG_FRAG_SIZE; i++) {
+        if (_send_buf[i].pkt == NULL) {
+            return &_send_buf[i];
+        }
+    }
+    return NULL;
+}
+
+static void _send_rm(_sfr_send_t *s, int error)
+{
+    xtimer_remove(&s->timer);
+    if (error) {
+        gnrc_pktbuf_release_error(s->pkt, error);
+    }
+    else {
+        gnrc_pktbuf_release(s->pkt);
+    }
+    s->pkt = NULL;
+    s->pending = 0;
+    s->wait_ack = false;
+}
+
+static void _send_abort(_sfr_send_t *s, int error)
+{
+    DEBUG("6lo sfr: abort datagram (tag: %u)\n", s->tag);
+    /* let the receiver free its resources */
+    _send_frag(s, SFR_FRAGS_MAX, false);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+    gnrc_sixlowpan_frag_stats_get()->sfr_aborted++;
+#endif
+    _send_rm(s, error);
+}
+
+static void _send_next(_sfr_send_t *s)
+{
+    unsigned seq = 0;
+    bool last;
+
+    while (!(s->pending & _bit(seq))) {
+        seq++;
+    }
+    s->pending &= ~_bit(seq);
+    last = (s->pending == 0);
+    if (!_send_frag(s, seq, last)) {
+        _send_rm(s, ENOMEM);
+        return;
+    }
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+    gnrc_sixlowpan_frag_stats_get()->sfr_sent++;
+    if (s->sent & _bit(seq)) {
+        gnrc_sixlowpan_frag_stats_get()->sfr_resent++;
+    }
+#endif
+    s->sent |= _bit(seq);
+    if (last) {
+        s->wait_ack = true;
+        s->timer_msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SFR_ARQ_TO;
+        xtimer_set_msg(&s->timer, GNRC_SIXLOWPAN_SFR_ARQ_TIMEOUT_US,
+                       &s->timer_msg, sched_active_pid);
+    }
+    else {
+        s->timer_msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SFR_SND;
+#if GNRC_SIXLOWPAN_SFR_INTER_FRAME_GAP_US > 0
+        xtimer_set_msg(&s->timer, GNRC_SIXLOWPAN_SFR_INTER_FRAME_GAP_US,
+                       &s->timer_msg, sched_active_pid);
+#else
+        msg_t msg = s->timer_msg;
+
+        if (msg_try_send(&msg, sched_active_pid) < 1) {
+            DEBUG("6lo sfr: message queue full, can't issue next fragment "
+                  "sending\n");
+            _send_rm(s, ENOMEM);
+            return;
+        }
+        thread_yield();
+#endif
+    }
+}
+
+/* sends all fragments that got lost and new ones up to the window size */
+static void _start_burst(_sfr_send_t *s)
+{
+    uint32_t burst = s->sent & ~s->acked;
+    unsigned in_flight = 0;
+
+    for (unsigned seq = 0; seq < s->frags; seq++) {
+        if (burst & _bit(seq)) {
+            in_flight++;
+        }
+    }
+    for (unsigned seq = 0; (seq < s->frags) &&
+         (in_flight < GNRC_SIXLOWPAN_SFR_WIN_SIZE); seq++) {
+        if (!(s->sent & _bit(seq))) {
+            burst |= _bit(seq);
+            in_flight++;
+        }
+    }
+    s->pending = burst;
+    s->wait_ack = false;
+    _send_next(s);
+}
+
+static void _arq_timeout(_sfr_send_t *s)
+{
+    uint32_t unacked = s->sent & ~s->acked;
+    unsigned seq = s->frags;
+
+    if ((s->pkt == NULL) || !s->wait_ack) {
+        /* stale event */
+        return;
+    }
+    if (++s->retries > GNRC_SIXLOWPAN_SFR_FRAG_RETRIES) {
+        _send_abort(s, ETIMEDOUT);
+        return;
+    }
+    DEBUG("6lo sfr: acknowledgment timed out (tag: %u)\n", s->tag);
+    /* either the fragment requesting the acknowledgment or the
+     * acknowledgment got lost: request it again with the last unacknowledged
+     * fragment only */
+    while ((seq > 0) && !(unacked & _bit(seq - 1))) {
+        seq--;
+    }
+    if (seq == 0) {
+        _start_burst(s);
+        return;
+    }
+    s->pending = _bit(seq - 1);
+    s->wait_ack = false;
+    _send_next(s);
+}
+
+static void _recv_ack(gnrc_pktsnip_t *pkt, const gnrc_netif_hdr_t *netif_hdr)
+{
+    const sixlowpan_sfr_ack_t *hdr = pkt->data;
+    const uint8_t *src = gnrc_netif_hdr_get_src_addr(netif_hdr);
+
+    if (pkt->size < sizeof(sixlowpan_sfr_ack_t)) {
+        DEBUG("6lo sfr: acknowledgment too short\n");
+        return;
+    }
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+    gnrc_sixlowpan_frag_stats_get()->sfr_acks_recv++;
+#endif
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_MSG_FRAG_SIZE; i++) {
+        _sfr_send_t *s = &_send_buf[i];
+        gnrc_netif_hdr_t *out_hdr;
+        uint32_t bitmap, acked;
+
+        if ((s->pkt == NULL) || (s->tag != hdr->tag)) {
+            continue;
+        }
+        out_hdr = s->pkt->data;
+        if ((out_hdr->dst_l2addr_len != netif_hdr->src_l2addr_len) ||
+            (memcmp(gnrc_netif_hdr_get_dst_addr(out_hdr), src,
+                    out_hdr->dst_l2addr_len) != 0)) {
+            continue;
+        }
+        bitmap = byteorder_ntohl(hdr->bitmap);
+        DEBUG("6lo sfr: received acknowledgment (tag: %u, bitmap: 0x%08lx)\n",
+              s->tag, (unsigned long)bitmap);
+        if (bitmap == 0) {
+            /* receiver aborted reassembly */
+            _send_rm(s, ECONNABORTED);
+            return;
+        }
+        acked = s->acked | (bitmap & _all(s->frags));
+        if (acked == _all(s->frags)) {
+            _send_rm(s, 0);
+            return;
+        }
+        if (acked != s->acked) {
+            s->retries = 0;
+            s->acked = acked;
+        }
+        if (s->wait_ack) {
+            xtimer_remove(&s->timer);
+            _start_burst(s);
+        }
+        return;
+    }
+    DEBUG("6lo sfr: no datagram for acknowledgment\n");
+}
+
+static void _send_ack(const _sfr_rbuf_t *entry,
+                      const gnrc_netif_hdr_t *netif_hdr)
+{
+    gnrc_pktsnip_t *netif, *ack;
+    gnrc_netif_hdr_t *new_netif_hdr;
+    sixlowpan_sfr_ack_t *hdr;
+
+    netif = gnrc_netif_hdr_build(NULL, 0, entry->super.src,
+                                 entry->super.src_len);
+    if (netif == NULL) {
+        DEBUG("6lo sfr: error allocating link-layer header for "
+              "acknowledgment\n");
+        return;
+    }
+    new_netif_hdr = netif->data;
+    new_netif_hdr->if_pid = netif_hdr->if_pid;
+    ack = gnrc_pktbuf_add(NULL, NULL, sizeof(sixlowpan_sfr_ack_t),
+                          GNRC_NETTYPE_SIXLOWPAN);
+    if (ack == NULL) {
+        DEBUG("6lo sfr: error allocating acknowledgment\n");
+        gnrc_pktbuf_release(netif);
+        return;
+    }
+    hdr = ack->data;
+    hdr->disp_ecn = SIXLOWPAN_SFR_ACK_DISP;
+    hdr->tag = (uint8_t)entry->super.tag;
+    hdr->bitmap = byteorder_htonl(entry->received);
+    LL_PREPEND(ack, netif);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+    gnrc_sixlowpan_frag_stats_get()->sfr_acks_sent++;
+#endif
+    gnrc_sixlowpan_dispatch_send(ack, NULL, 0);
+}
+
+static void _rbuf_rm(_sfr_rbuf_t *entry)
+{
+    if (entry->pkt != NULL) {
+        gnrc_pktbuf_release(entry->pkt);
+    }
+    memset(entry, 0, sizeof(*entry));
+}
+
+/* adds [start, end) to the received bytes of entry, returns -EINVAL if it
+ * overlaps with bytes received before and -ENOSPC if entry can not track it */
+static int _rbuf_add_int(_sfr_rbuf_t *entry, uint16_t start, uint16_t end)
+{
+    unsigned i = 0;
+
+    while ((i < entry->ints_len) && (entry->ints[i].end <= start)) {
+        i++;
+    }
+    if ((i < entry->ints_len) && (entry->ints[i].start < end)) {
+        return -EINVAL;
+    }
+    /* entry->ints[i] is the first interval after the new one */
+    bool merge_prev = (i > 0) && (entry->ints[i - 1].end == start);
+    bool merge_next = (i < entry->ints_len) && (entry->ints[i].start == end);
+
+    if (merge_prev && merge_next) {
+        entry->ints[i - 1].end = entry->ints[i].end;
+        memmove(&entry->ints[i], &entry->ints[i + 1],
+                (entry->ints_len - i - 1) * sizeof(entry->ints[0]));
+        entry->ints_len--;
+    }
+    else if (merge_prev) {
+        entry->ints[i - 1].end = end;
+    }
+    else if (merge_next) {
+        entry->ints[i].start = start;
+    }
+    else if (entry->ints_len < SFR_RBUF_INTS) {
+        memmove(&entry->ints[i + 1], &entry->ints[i],
+                (entry->ints_len - i) * sizeof(entry->ints[0]));
+        entry->ints[i].start = start;
+        entry->ints[i].end = end;
+        entry->ints_len++;
+    }
+    else {
+        return -ENOSPC;
+    }
+    return 0;
+}
+
+static inline bool _rbuf_timed_out(const _sfr_rbuf_t *entry, uint32_t now_usec)
+{
+    return (now_usec - entry->super.arrival) > GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US;
+}
+
+static _sfr_rbuf_t *_rbuf_get(const gnrc_netif_hdr_t *netif_hdr, uint8_t tag,
+                              uint32_t now_usec)
+{
+    const uint8_t *src = gnrc_netif_hdr_get_src_addr(netif_hdr);
+    const uint8_t *dst = gnrc_netif_hdr_get_dst_addr(netif_hdr);
+    _sfr_rbuf_t *res = NULL;
+
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_SFR_RBUF_SIZE; i++) {
+        _sfr_rbuf_t *entry = &_rbuf[i];
+
+        if (entry->received == 0) {
+            if (res == NULL) {
+                res = entry;
+            }
+            continue;
+        }
+        if ((entry->super.tag == tag) &&
+            (entry->super.src_len == netif_hdr->src_l2addr_len) &&
+            (entry->super.dst_len == netif_hdr->dst_l2addr_len) &&
+            (memcmp(entry->super.src, src, entry->super.src_len) == 0) &&
+            (memcmp(entry->super.dst, dst, entry->super.dst_len) == 0)) {
+            return entry;
+        }
+        /* complete and timed out datagrams may be overridden */
+        if (((res == NULL) || (res->received != 0)) &&
+            ((entry->pkt == NULL) || _rbuf_timed_out(entry, now_usec))) {
+            res = entry;
+        }
+    }
+    if (res == NULL) {
+        DEBUG("6lo sfr: reassembly buffer full\n");
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+        gnrc_sixlowpan_frag_stats_get()->rbuf_full++;
+#endif
+        return NULL;
+    }
+    _rbuf_rm(res);
+    memcpy(res->super.src, src, netif_hdr->src_l2addr_len);
+    memcpy(res->super.dst, dst, netif_hdr->dst_l2addr_len);
+    res->super.src_len = netif_hdr->src_l2addr_len;
+    res->super.dst_len = netif_hdr->dst_l2addr_len;
+    res->super.tag = tag;
+    xtimer_set_msg(&_gc_timer, GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US,
+                   &_gc_timer_msg, sched_active_pid);
+    return res;
+}
+
+/* passes a complete datagram to the 6LoWPAN thread to be handled like a
+ * single frame */
+static void _deliver(_sfr_rbuf_t *entry, const gnrc_netif_hdr_t *netif_hdr)
+{
+    gnrc_pktsnip_t *netif = gnrc_netif_hdr_build(entry->super.src,
+                                                 entry->super.src_len,
+                                                 entry->super.dst,
+                                                 entry->super.dst_len);
+
+    if (netif == NULL) {
+        DEBUG("6lo sfr: error allocating netif header\n");
+        gnrc_pktbuf_release(entry->pkt);
+    }
+    else {
+        /* copy the transmit information of the latest fragment */
+        gnrc_netif_hdr_t *new_netif_hdr = netif->data;
+
+        new_netif_hdr->if_pid = netif_hdr->if_pid;
+        new_netif_hdr->flags = netif_hdr->flags;
+        new_netif_hdr->lqi = netif_hdr->lqi;
+        new_netif_hdr->rssi = netif_hdr->rssi;
+        LL_APPEND(entry->pkt, netif);
+        if (gnrc_netapi_receive(sched_active_pid, entry->pkt) < 1) {
+            DEBUG("6lo sfr: unable to deliver reassembled datagram\n");
+            gnrc_pktbuf_release(entry->pkt);
+        }
+    }
+    entry->pkt = NULL;
+    entry->received = SIXLOWPAN_SFR_ACK_BITMAP_FULL;
+}
+
+static void _recv_rfrag(gnrc_pktsnip_t *pkt, const gnrc_netif_hdr_t *netif_hdr)
+{
+    const sixlowpan_sfr_rfrag_t *hdr = pkt->data;
+    uint32_t now_usec = xtimer_now_usec();
+    _sfr_rbuf_t *entry;
+    unsigned seq, size;
+    uint16_t offset;
+
+    if (pkt->size < sizeof(sixlowpan_sfr_rfrag_t)) {
+        DEBUG("6lo sfr: fragment too short\n");
+        return;
+    }
+    seq = sixlowpan_sfr_rfrag_get_seq(hdr);
+    size = sixlowpan_sfr_rfrag_get_frag_size(hdr);
+    offset = byteorder_ntohs(hdr->offset);
+    if (size != (pkt->size - sizeof(sixlowpan_sfr_rfrag_t))) {
+        DEBUG("6lo sfr: fragment size mismatch\n");
+        return;
+    }
+    if ((seq == 0) && (size == 0)) {
+        /* sender aborted the datagram */
+        for (unsigned i = 0; i < GNRC_SIXLOWPAN_SFR_RBUF_SIZE; i++) {
+            if ((_rbuf[i].received != 0) && (_rbuf[i].super.tag == hdr->tag) &&
+                (_rbuf[i].super.src_len == netif_hdr->src_l2addr_len) &&
+                (memcmp(_rbuf[i].super.src,
+                        gnrc_netif_hdr_get_src_addr(netif_hdr),
+                        _rbuf[i].super.src_len) == 0)) {
+                DEBUG("6lo sfr: sender aborted datagram\n");
+                _rbuf_rm(&_rbuf[i]);
+            }
+        }
+        return;
+    }
+    if ((entry = _rbuf_get(netif_hdr, hdr->tag, now_usec)) == NULL) {
+        return;
+    }
+    entry->super.arrival = now_usec;
+    if ((entry->pkt != NULL) || (entry->received == 0)) {
+        uint16_t datagram_size = entry->super.datagram_size;
+
+        if (seq == 0) {
+            datagram_size = offset;
+            offset = 0;
+        }
+        if ((datagram_size > 0) &&
+            (((offset + size) > datagram_size) ||
+             ((entry->pkt != NULL) && (entry->pkt->size > datagram_size)) ||
+             ((entry->super.datagram_size > 0) &&
+              (entry->super.datagram_size != datagram_size)))) {
+            DEBUG("6lo sfr: fragment exceeds datagram, dropping datagram\n");
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+            gnrc_sixlowpan_frag_stats_get()->rbuf_invalid++;
+#endif
+            _rbuf_rm(entry);
+            return;
+        }
+        if (!(entry->received & _bit(seq)) && (size > 0)) {
+            size_t pkt_size = (datagram_size > 0) ? datagram_size
+                                                  : (size_t)(offset + size);
+
+            switch (_rbuf_add_int(entry, offset, offset + size)) {
+                case -EINVAL:
+                    DEBUG("6lo sfr: overlapping fragments, dropping "
+                          "datagram\n");
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+                    gnrc_sixlowpan_frag_stats_get()->rbuf_invalid++;
+#endif
+                    _rbuf_rm(entry);
+                    return;
+                case -ENOSPC:
+                    DEBUG("6lo sfr: no space left to track fragment, "
+                          "ignoring it\n");
+                    goto ack;
+                default:
+                    break;
+            }
+            if (entry->pkt == NULL) {
+                entry->pkt = gnrc_pktbuf_add(NULL, NULL, pkt_size,
+                                             GNRC_NETTYPE_SIXLOWPAN);
+            }
+            else if ((entry->pkt->size < pkt_size) &&
+                     (gnrc_pktbuf_realloc_data(entry->pkt, pkt_size) != 0)) {
+                gnrc_pktbuf_release(entry->pkt);
+                entry->pkt = NULL;
+            }
+            if (entry->pkt == NULL) {
+                DEBUG("6lo sfr: can not allocate reassembly buffer space\n");
+                _rbuf_rm(entry);
+                return;
+            }
+            memcpy(((uint8_t *)entry->pkt->data) + offset, hdr + 1, size);
+            entry->super.datagram_size = datagram_size;
+            entry->super.current_size += size;
+            entry->received |= _bit(seq);
+        }
+        if ((entry->super.datagram_size > 0) &&
+            (entry->super.current_size >= entry->super.datagram_size)) {
+            _deliver(entry, netif_hdr);
+        }
+    }
+ack:
+    if (sixlowpan_sfr_rfrag_ack_req(hdr)) {
+        _send_ack(entry, netif_hdr);
+    }
+}
+
+bool gnrc_sixlowpan_frag_sfr_applicable(gnrc_pktsnip_t *pkt,
+                                        gnrc_netif_t *netif)
+{
+    gnrc_netif_hdr_t *netif_hdr = pkt->data;
+
+    assert(pkt->type == GNRC_NETTYPE_NETIF);
+    /* acknowledgments require a unicast destination */
+    if ((netif_hdr->dst_l2addr_len == 0) ||
+        (netif_hdr->flags & (GNRC_NETIF_HDR_FLAGS_BROADCAST |
+                             GNRC_NETIF_HDR_FLAGS_MULTICAST)) ||
+        (gnrc_pkt_len(pkt->next) > (_frag_size(netif) * SFR_FRAGS_MAX))) {
+        return false;
+    }
+    /* rather send with RFC 4944 fragments than drop the datagram, while the
+     * previous one waits for its last acknowledgment */
+    return (_send_get() != NULL);
+}
+
+void gnrc_sixlowpan_frag_sfr_send(gnrc_pktsnip_t *pkt, void *ctx,
+                                  unsigned page)
+{
+    gnrc_netif_t *netif = gnrc_netif_hdr_get_netif(pkt->data);
+    _sfr_send_t *s = _send_get();
+
+    (void)ctx;
+    (void)page;
+    assert(netif != NULL);
+    if (s == NULL) {
+        DEBUG("6lo sfr: Not enough resources to fragment packet. "
+              "Dropping packet\n");
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+        gnrc_sixlowpan_frag_stats_get()->frag_full++;
+#endif
+        gnrc_pktbuf_release_error(pkt, ENOMEM);
+        return;
+    }
+    s->pkt = pkt;
+    s->datagram_size = gnrc_pkt_len(pkt->next);
+    s->frag_size = _frag_size(netif);
+    s->frags = (s->datagram_size + s->frag_size - 1) / s->frag_size;
+    s->tag = (uint8_t)gnrc_sixlowpan_frag_next_tag();
+    s->sent = 0;
+    s->acked = 0;
+    s->retries = 0;
+    s->timer_msg.content.ptr = s;
+    DEBUG("6lo sfr: send datagram (tag: %u, size: %u, fragments: %u)\n",
+          s->tag, s->datagram_size, s->frags);
+    _start_burst(s);
+}
+
+void gnrc_sixlowpan_frag_sfr_recv(gnrc_pktsnip_t *pkt, void *ctx,
+                                  unsigned page)
+{
+    gnrc_pktsnip_t *netif = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_NETIF);
+
+    (void)ctx;
+    (void)page;
+    if (netif == NULL) {
+        DEBUG("6lo sfr: no link-layer header\n");
+    }
+    else if (sixlowpan_sfr_rfrag_is(pkt->data)) {
+        _recv_rfrag(pkt, netif->data);
+    }
+    else if (sixlowpan_sfr_ack_is(pkt->data)) {
+        _recv_ack(pkt, netif->data);
+    }
+    else {
+        DEBUG("6lo sfr: not a recoverable fragment header\n");
+    }
+    gnrc_pktbuf_release(pkt);
+}
+
+void gnrc_sixlowpan_frag_sfr_handle_msg(msg_t *msg)
+{
+    _sfr_send_t *s = msg->content.ptr;
+
+    switch (msg->type) {
+        case GNRC_SIXLOWPAN_MSG_FRAG_SFR_SND:
+            if ((s->pkt != NULL) && (s->pending != 0)) {
+                _send_next(s);
+            }
+            break;
+        case GNRC_SIXLOWPAN_MSG_FRAG_SFR_ARQ_TO:
+            _arq_timeout(s);
+            break;
+        default:
+            break;
+    }
+}
+
+void gnrc_sixlowpan_frag_sfr_gc(void)
+{
+    uint32_t now_usec = xtimer_now_usec();
+    bool pending = false;
+
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_SFR_RBUF_SIZE; i++) {
+        _sfr_rbuf_t *entry = &_rbuf[i];
+
+        if (entry->received == 0) {
+            continue;
+        }
+        if (_rbuf_timed_out(entry, now_usec)) {
+            DEBUG("6lo sfr: entry (%s, ",
+                  gnrc_netif_addr_to_str(entry->super.src,
+                                         entry->super.src_len, l2addr_str));
+            DEBUG("%s, %u) timed out\n",
+                  gnrc_netif_addr_to_str(entry->super.dst,
+                                         entry->super.dst_len, l2addr_str),
+                  entry->super.tag);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+            if (entry->pkt != NULL) {
+                gnrc_sixlowpan_frag_stats_get()->rbuf_timeout++;
+            }
+#endif
+            _rbuf_rm(entry);
+        }
+        else {
+            pending = true;
+        }
+    }
+    if (pending) {
+        xtimer_set_msg(&_gc_timer, GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US,
+                       &_gc_timer_msg, sched_active_pid);
+    }
+}
+
+#ifdef TEST_SUITES
+void gnrc_sixlowpan_frag_sfr_reset(void)
+{
+    xtimer_remove(&_gc_timer);
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_MSG_FRAG_SIZE; i++) {
+        if (_send_buf[i].pkt != NULL) {
+            _send_rm(&_send_buf[i], 0);
+        }
+    }
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_SFR_RBUF_SIZE; i++) {
+        _rbuf_rm(&_rbuf[i]);
+    }
+}
+#endif
+
+/** @} */
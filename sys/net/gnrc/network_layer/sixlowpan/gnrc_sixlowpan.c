@@ -20,6 +20,7 @@
 #include "net/gnrc/ipv6/hdr.h"
 #include "net/gnrc/sixlowpan.h"
 #include "net/gnrc/sixlowpan/frag.h"
+#include "net/gnrc/sixlowpan/frag/sfr.h"
 #include "net/gnrc/sixlowpan/iphc.h"
 #include "net/gnrc/netif.h"
 #include "net/sixlowpan.h"
@@ -116,6 +117,13 @@ void gnrc_sixlowpan_multiplex_by_size(gnrc_pktsnip_t *pkt,
         DEBUG("6lo: Dispatch for sending\n");
         gnrc_sixlowpan_dispatch_send(pkt, NULL, page);
     }
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    else if (gnrc_sixlowpan_frag_sfr_applicable(pkt, netif)) {
+        DEBUG("6lo: Send with recoverable fragments (%u > %u)\n",
+              (unsigned int)datagram_size, netif->sixlo.max_frag_size);
+        gnrc_sixlowpan_frag_sfr_send(pkt, NULL, page);
+    }
+#endif
 #ifdef MODULE_GNRC_SIXLOWPAN_FRAG
     else if (orig_datagram_size <= SIXLOWPAN_FRAG_MAX_LEN) {
         DEBUG("6lo: Send fragmented (%u > %u)\n",
@@ -218,6 +226,13 @@ static void _receive(gnrc_pktsnip_t *pkt)
         return;
     }
 #endif
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    else if (sixlowpan_sfr_rfrag_is(dispatch) || sixlowpan_sfr_ack_is(dispatch)) {
+        DEBUG("6lo: received recoverable fragment or fragment acknowledgment\n");
+        gnrc_sixlowpan_frag_sfr_recv(pkt, NULL, 0);
+        return;
+    }
+#endif
 #ifdef MODULE_GNRC_SIXLOWPAN_IPHC
     else if (sixlowpan_iphc_is(dispatch)) {
         DEBUG("6lo: received 6LoWPAN IPHC comressed datagram\n");
@@ -352,6 +367,13 @@ static void *_event_loop(void *args)
                 gnrc_sixlowpan_frag_rbuf_gc();
                 break;
 #endif
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+            case GNRC_SIXLOWPAN_MSG_FRAG_SFR_SND:
+            case GNRC_SIXLOWPAN_MSG_FRAG_SFR_ARQ_TO:
+                DEBUG("6lo: recoverable fragment event received\n");
+                gnrc_sixlowpan_frag_sfr_handle_msg(&msg);
+                break;
+#endif
 
             default:
                 DEBUG("6lo: operation not supported\n");
@@ -0,0 +1,299 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_gnrc_pktbuf_cache
+ * @{
+ *
+ * @file
+ * @brief   Per-thread packet buffer cache implementation
+ *
+ * Every magazine is only touched by its owner, without the lock of the
+ * packet buffer from gnrc_pktbuf_cache_get() and gnrc_pktbuf_cache_put(),
+ * with the exception of gnrc_pktbuf_cache_drain(). Hence, these three
+ * change magazines with interrupts disabled. Owners change and magazines
+ * move to and from the depot only with the lock of the packet buffer held,
+ * and a magazine only changes owner when its owner exited.
+ *
+ * @author  RIOT developers <devel@riot-os.org>
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "irq.h"
+#include "thread.h"
+#include "net/gnrc/pktbuf/cache.h"
+
+#ifdef MODULE_XTIMER
+#include "xtimer.h"
+#endif
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+typedef struct {
+    void *ptr;
+    size_t size;
+} _chunk_t;
+
+typedef struct {
+    _chunk_t chunks[GNRC_PKTBUF_CACHE_SIZE];
+    unsigned fill;
+} _magazine_t;
+
+typedef struct {
+    _magazine_t mag;
+    kernel_pid_t owner;
+    unsigned hits;          /* allocations served from the magazine */
+    unsigned refills;       /* ... from the depot */
+    unsigned misses;        /* ... from the packet buffer */
+} _cache_t;
+
+static _cache_t _caches[GNRC_PKTBUF_CACHE_NUMOF];
+static _magazine_t _depot[GNRC_PKTBUF_CACHE_DEPOT];
+static unsigned _depot_fill;
+
+static struct {
+    unsigned acquired;
+    unsigned contended;
+#ifdef MODULE_XTIMER
+    uint64_t wait_total;
+    uint32_t wait_max;
+#endif
+} _lock_stats;
+
+static _cache_t *_own(void)
+{
+    kernel_pid_t pid = thread_getpid();
+
+    for (unsigned i = 0; i < GNRC_PKTBUF_CACHE_NUMOF; i++) {
+        if (_caches[i].owner == pid) {
+            return &_caches[i];
+        }
+    }
+    return NULL;
+}
+
+static void _return(_magazine_t *mag, gnrc_pktbuf_cache_free_t free_cb)
+{
+    for (unsigned i = 0; i < mag->fill; i++) {
+        free_cb(mag->chunks[i].ptr, mag->chunks[i].size);
+    }
+    mag->fill = 0;
+}
+
+static _cache_t *_claim(gnrc_pktbuf_cache_free_t free_cb)
+{
+    _cache_t *cache = _own();
+
+    if (cache != NULL) {
+        return cache;
+    }
+    for (unsigned i = 0; i < GNRC_PKTBUF_CACHE_NUMOF; i++) {
+        cache = &_caches[i];
+        if ((cache->owner == KERNEL_PID_UNDEF) ||
+            (thread_get(cache->owner) == NULL)) {
+            DEBUG("pktbuf_cache: cache %u taken over by %" PRIkernel_pid "\n",
+                  i, thread_getpid());
+            _return(&cache->mag, free_cb);
+            memset(cache, 0, sizeof(*cache));
+            cache->owner = thread_getpid();
+            return cache;
+        }
+    }
+    return NULL;
+}
+
+/* searches from the most recently cached chunk on */
+static int _find(const _magazine_t *mag, size_t size)
+{
+    for (int i = mag->fill - 1; i >= 0; i--) {
+        if (mag->chunks[i].size == size) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void *_take(_magazine_t *mag, int idx)
+{
+    void *ptr = mag->chunks[idx].ptr;
+
+    mag->chunks[idx] = mag->chunks[--mag->fill];
+    return ptr;
+}
+
+void gnrc_pktbuf_cache_init(void)
+{
+    memset(_caches, 0, sizeof(_caches));
+    memset(_depot, 0, sizeof(_depot));
+    _depot_fill = 0;
+    memset(&_lock_stats, 0, sizeof(_lock_stats));
+}
+
+void *gnrc_pktbuf_cache_get(size_t size)
+{
+    _cache_t *cache = _own();
+    void *chunk = NULL;
+    unsigned state;
+    int idx;
+
+    if (cache == NULL) {
+        return NULL;
+    }
+    state = irq_disable();
+    if ((idx = _find(&cache->mag, size)) >= 0) {
+        cache->hits++;
+        chunk = _take(&cache->mag, idx);
+    }
+    irq_restore(state);
+    return chunk;
+}
+
+bool gnrc_pktbuf_cache_put(void *chunk, size_t size)
+{
+    _cache_t *cache = _own();
+    bool cached = false;
+    unsigned state;
+
+    if (cache == NULL) {
+        return false;
+    }
+    state = irq_disable();
+    if (cache->mag.fill < GNRC_PKTBUF_CACHE_SIZE) {
+        cache->mag.chunks[cache->mag.fill].ptr = chunk;
+        cache->mag.chunks[cache->mag.fill].size = size;
+        cache->mag.fill++;
+        cached = true;
+    }
+    irq_restore(state);
+    return cached;
+}
+
+void *gnrc_pktbuf_cache_refill(size_t size, gnrc_pktbuf_cache_free_t free_cb)
+{
+    _cache_t *cache = _claim(free_cb);
+
+    if (cache == NULL) {
+        return NULL;
+    }
+    for (int i = _depot_fill - 1; i >= 0; i--) {
+        int idx = _find(&_depot[i], size);
+
+        if (idx >= 0) {
+            _magazine_t tmp = _depot[i];
+
+            if (cache->mag.fill > 0) {
+                _depot[i] = cache->mag;
+            }
+            else {
+                _depot[i] = _depot[--_depot_fill];
+            }
+            cache->mag = tmp;
+            cache->refills++;
+            return _take(&cache->mag, idx);
+        }
+    }
+    cache->misses++;
+    return NULL;
+}
+
+void gnrc_pktbuf_cache_flush(void *chunk, size_t size,
+                             gnrc_pktbuf_cache_free_t free_cb)
+{
+    _cache_t *cache = _claim(free_cb);
+
+    if (cache == NULL) {
+        free_cb(chunk, size);
+        return;
+    }
+    if (cache->mag.fill >= GNRC_PKTBUF_CACHE_SIZE) {
+        if (_depot_fill >= GNRC_PKTBUF_CACHE_DEPOT) {
+            _return(&_depot[0], free_cb);
+            memmove(&_depot[0], &_depot[1],
+                    (GNRC_PKTBUF_CACHE_DEPOT - 1) * sizeof(_depot[0]));
+            _depot_fill--;
+        }
+        _depot[_depot_fill++] = cache->mag;
+        cache->mag.fill = 0;
+    }
+    gnrc_pktbuf_cache_put(chunk, size);
+}
+
+unsigned gnrc_pktbuf_cache_drain(gnrc_pktbuf_cache_free_t free_cb)
+{
+    unsigned drained = 0;
+
+    for (unsigned i = 0; i < GNRC_PKTBUF_CACHE_NUMOF; i++) {
+        /* the owner may use its magazine without the lock */
+        unsigned state = irq_disable();
+        _magazine_t mag = _caches[i].mag;
+
+        _caches[i].mag.fill = 0;
+        irq_restore(state);
+        drained += mag.fill;
+        _return(&mag, free_cb);
+    }
+    for (unsigned i = 0; i < _depot_fill; i++) {
+        drained += _depot[i].fill;
+        _return(&_depot[i], free_cb);
+    }
+    _depot_fill = 0;
+    DEBUG("pktbuf_cache: drained %u chunks\n", drained);
+    return drained;
+}
+
+void gnrc_pktbuf_cache_lock(mutex_t *lock)
+{
+    if (!mutex_trylock(lock)) {
+#ifdef MODULE_XTIMER
+        uint32_t start = xtimer_now().ticks32;
+#endif
+        mutex_lock(lock);
+        _lock_stats.contended++;
+#ifdef MODULE_XTIMER
+        uint32_t wait = xtimer_now().ticks32 - start;
+        _lock_stats.wait_total += wait;
+        if (wait > _lock_stats.wait_max) {
+            _lock_stats.wait_max = wait;
+        }
+#endif
+    }
+    _lock_stats.acquired++;
+}
+
+void gnrc_pktbuf_cache_stats(void)
+{
+    printf("packet buffer caches: %u of %u magazines in depot\n",
+           _depot_fill, GNRC_PKTBUF_CACHE_DEPOT);
+    for (unsigned i = 0; i < GNRC_PKTBUF_CACHE_NUMOF; i++) {
+        _cache_t *cache = &_caches[i];
+        unsigned total = cache->hits + cache->refills + cache->misses;
+
+        if (cache->owner == KERNEL_PID_UNDEF) {
+            continue;
+        }
+        printf("  thread %" PRIkernel_pid ": hits: %u, refills: %u, "
+               "misses: %u (hit rate: %u%%), cached: %u\n", cache->owner,
+               cache->hits, cache->refills, cache->misses,
+               total ? ((100U * (cache->hits + cache->refills)) / total) : 0,
+               cache->mag.fill);
+    }
+    printf("  lock taken: %u times, contended: %u times\n",
+           _lock_stats.acquired, _lock_stats.contended);
+#ifdef MODULE_XTIMER
+    printf("  lock wait: %" PRIu32 " us in total, %" PRIu32 " us at most\n",
+           (uint32_t)_xtimer_usec_from_ticks64(_lock_stats.wait_total),
+           _xtimer_usec_from_ticks(_lock_stats.wait_max));
+#endif
+}
+
+/** @} */
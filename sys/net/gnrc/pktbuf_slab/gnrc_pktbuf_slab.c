@@ -0,0 +1,725 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_gnrc_pktbuf
+ * @{
+ *
+ * @file
+ * @brief   Packet buffer backend with size-class slabs and a buddy system
+ *
+ * The packet buffer is divided into units of GNRC_PKTBUF_SLAB_UNIT bytes.
+ * Free space is kept as aligned power of two blocks of units, one free list
+ * per block order, with the order of each free block noted in a map holding
+ * one byte per unit. Allocations take the smallest fitting block, split it
+ * and give the units behind the requested length back right away, so only
+ * the last unit of an allocation is partially wasted. Since any unit aligned
+ * range can be handed back, snips can be split and shrunk in place just as
+ * with gnrc_pktbuf_static.
+ *
+ * Small allocations come from slabs, blocks of GNRC_PKTBUF_SLAB_PAGE bytes
+ * carved into equally sized objects. Every slab has its own free list and
+ * the slabs of a size class with free objects are kept in a list, so both
+ * allocating and freeing an object is O(1). Empty slabs go back to the buddy
+ * system.
+ *
+ * @author  RIOT developers <devel@riot-os.org>
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "mutex.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pkt.h"
+
+#if defined(DEVELHELP) && defined(MODULE_XTIMER)
+#include "xtimer.h"
+#define _TIMING     (1)
+#endif
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define _UNITS          (GNRC_PKTBUF_SIZE / GNRC_PKTBUF_SLAB_UNIT)
+#define _PAGE_UNITS     (GNRC_PKTBUF_SLAB_PAGE / GNRC_PKTBUF_SLAB_UNIT)
+#define _PAGES          (_UNITS / _PAGE_UNITS)
+#define _CLASSES        (GNRC_PKTBUF_SLAB_MAX / GNRC_PKTBUF_SLAB_UNIT)
+/* upper bound of block orders, the arena limits the ones actually used */
+#define _ORDERS         (16U)
+
+#define _MAP_FREE       (0x80)
+#define _NO_PAGE        (UINT8_MAX)
+
+typedef struct _block {
+    struct _block *next;
+    struct _block *prev;
+} _block_t;
+
+typedef struct {
+    void *free;         /* free objects of this slab */
+    uint8_t cls;        /* size class + 1, 0 if not a slab */
+    uint8_t used;       /* objects handed out */
+    uint8_t next;       /* slabs of the same class with free objects */
+    uint8_t prev;
+} _page_t;
+
+#if (_PAGE_UNITS & (_PAGE_UNITS - 1)) != 0
+#error "GNRC_PKTBUF_SLAB_PAGE must be a power of two multiple of GNRC_PKTBUF_SLAB_UNIT"
+#endif
+#if _PAGES >= _NO_PAGE
+#error "GNRC_PKTBUF_SLAB_PAGE too small for GNRC_PKTBUF_SIZE"
+#endif
+/* a slab of the smallest class holds the most objects, _page_t.used counts them */
+#if _PAGE_UNITS > UINT8_MAX
+#error "GNRC_PKTBUF_SLAB_PAGE too large for GNRC_PKTBUF_SLAB_UNIT"
+#endif
+static_assert(GNRC_PKTBUF_SLAB_UNIT >= sizeof(_block_t),
+              "GNRC_PKTBUF_SLAB_UNIT too small for the free list");
+
+static mutex_t _mutex = MUTEX_INIT;
+static uint8_t _pktbuf[GNRC_PKTBUF_SIZE]
+    __attribute__((aligned(GNRC_PKTBUF_SLAB_UNIT)));
+static uint8_t _map[_UNITS];
+static _block_t *_free_list[_ORDERS];
+static _page_t _pages[_PAGES];
+static uint8_t _partial[_CLASSES];
+static unsigned _free_units;
+
+#ifdef DEVELHELP
+static struct {
+    unsigned allocs;        /* successful allocations */
+    unsigned slab_allocs;   /* of which were served from slabs */
+    unsigned failed;        /* failed allocations */
+    unsigned peak_units;    /* most units in use at a time */
+#ifdef _TIMING
+    uint32_t alloc_max;     /* longest allocation in ticks */
+    uint32_t free_max;      /* longest release in ticks */
+#endif
+} _stats;
+#endif
+
+/* internal gnrc_pktbuf functions */
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                    gnrc_nettype_t type);
+static void *_pktbuf_alloc(size_t size);
+static void _pktbuf_free(void *data, size_t size);
+
+static inline bool _pktbuf_contains(void *ptr)
+{
+    return (unsigned)((uint8_t *)ptr - _pktbuf) < GNRC_PKTBUF_SIZE;
+}
+
+static inline size_t _units(size_t size)
+{
+    return (size + GNRC_PKTBUF_SLAB_UNIT - 1) / GNRC_PKTBUF_SLAB_UNIT;
+}
+
+static inline unsigned _unit_of(const void *ptr)
+{
+    return ((const uint8_t *)ptr - _pktbuf) / GNRC_PKTBUF_SLAB_UNIT;
+}
+
+static inline _block_t *_block_at(unsigned unit)
+{
+    return (_block_t *)&_pktbuf[unit * GNRC_PKTBUF_SLAB_UNIT];
+}
+
+/* slab the pointer belongs to, NULL if it came from the buddy system */
+static inline _page_t *_page_of(const void *ptr)
+{
+    unsigned idx = _unit_of(ptr) / _PAGE_UNITS;
+
+    if ((idx < _PAGES) && _pages[idx].cls) {
+        return &_pages[idx];
+    }
+    return NULL;
+}
+
+static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
+                                void *data, size_t size, gnrc_nettype_t type)
+{
+    pkt->next = next;
+    pkt->data = data;
+    pkt->size = size;
+    pkt->type = type;
+    pkt->users = 1;
+#ifdef MODULE_GNRC_NETERR
+    pkt->err_sub = KERNEL_PID_UNDEF;
+#endif
+}
+
+/* buddy system */
+
+static void _list_push(unsigned unit, unsigned order)
+{
+    _block_t *block = _block_at(unit);
+
+    block->prev = NULL;
+    block->next = _free_list[order];
+    if (block->next) {
+        block->next->prev = block;
+    }
+    _free_list[order] = block;
+    _map[unit] = _MAP_FREE | order;
+}
+
+static void _list_remove(unsigned unit, unsigned order)
+{
+    _block_t *block = _block_at(unit);
+
+    if (block->prev) {
+        block->prev->next = block->next;
+    }
+    else {
+        _free_list[order] = block->next;
+    }
+    if (block->next) {
+        block->next->prev = block->prev;
+    }
+    _map[unit] = 0;
+}
+
+static void _block_free(unsigned unit, unsigned order)
+{
+    _free_units += 1U << order;
+    while (order < (_ORDERS - 1)) {
+        unsigned buddy = unit ^ (1U << order);
+
+        if (((buddy + (1U << order)) > _UNITS) ||
+            (_map[buddy] != (_MAP_FREE | order))) {
+            break;
+        }
+        _list_remove(buddy, order);
+        unit &= ~(1U << order);
+        order++;
+    }
+    _list_push(unit, order);
+}
+
+/* hands back [unit, unit + count) as the largest aligned blocks it holds */
+static void _range_free(unsigned unit, unsigned count)
+{
+    unsigned end = unit + count;
+
+    while (unit < end) {
+        unsigned order = 0;
+
+        while ((order < (_ORDERS - 1)) &&
+               !(unit & (1U << order)) &&
+               ((unit + (2U << order)) <= end)) {
+            order++;
+        }
+        _block_free(unit, order);
+        unit += 1U << order;
+    }
+}
+
+static void *_units_alloc(unsigned count)
+{
+    unsigned order = 0;
+    unsigned found;
+
+    while ((1U << order) < count) {
+        order++;
+    }
+    for (found = order; (found < _ORDERS) && !_free_list[found]; found++) {}
+    if (found >= _ORDERS) {
+        return NULL;
+    }
+
+    unsigned unit = _unit_of(_free_list[found]);
+    _list_remove(unit, found);
+    _free_units -= 1U << found;
+    /* split down to the requested order */
+    while (found > order) {
+        found--;
+        _list_push(unit + (1U << found), found);
+        _free_units += 1U << found;
+    }
+    /* and give back what was not requested */
+    if ((1U << order) > count) {
+        _range_free(unit + count, (1U << order) - count);
+    }
+    return _block_at(unit);
+}
+
+/* slabs */
+
+static void _partial_push(unsigned cls, uint8_t idx)
+{
+    _pages[idx].prev = _NO_PAGE;
+    _pages[idx].next = _partial[cls];
+    if (_partial[cls] != _NO_PAGE) {
+        _pages[_partial[cls]].prev = idx;
+    }
+    _partial[cls] = idx;
+}
+
+static void _partial_remove(unsigned cls, uint8_t idx)
+{
+    _page_t *page = &_pages[idx];
+
+    if (page->prev != _NO_PAGE) {
+        _pages[page->prev].next = page->next;
+    }
+    else {
+        _partial[cls] = page->next;
+    }
+    if (page->next != _NO_PAGE) {
+        _pages[page->next].prev = page->prev;
+    }
+}
+
+static void *_slab_alloc(unsigned cls)
+{
+    uint8_t idx = _partial[cls];
+
+    if (idx == _NO_PAGE) {
+        uint8_t *start = _units_alloc(_PAGE_UNITS);
+        size_t obj_size = (cls + 1) * GNRC_PKTBUF_SLAB_UNIT;
+
+        if (start == NULL) {
+            return NULL;
+        }
+        idx = _unit_of(start) / _PAGE_UNITS;
+        _pages[idx].cls = cls + 1;
+        _pages[idx].used = 0;
+        _pages[idx].free = NULL;
+        for (size_t off = ((GNRC_PKTBUF_SLAB_PAGE / obj_size) - 1) * obj_size;
+             ; off -= obj_size) {
+            *(void **)(start + off) = _pages[idx].free;
+            _pages[idx].free = start + off;
+            if (off == 0) {
+                break;
+            }
+        }
+        _partial_push(cls, idx);
+    }
+
+    _page_t *page = &_pages[idx];
+    void *obj = page->free;
+
+    page->free = *(void **)obj;
+    page->used++;
+    if (page->free == NULL) {
+        _partial_remove(cls, idx);
+    }
+    return obj;
+}
+
+static void _slab_free(_page_t *page, void *obj)
+{
+    uint8_t idx = page - _pages;
+    unsigned cls = page->cls - 1;
+
+    if (page->free == NULL) {
+        _partial_push(cls, idx);
+    }
+    *(void **)obj = page->free;
+    page->free = obj;
+    if (--page->used == 0) {
+        _partial_remove(cls, idx);
+        page->cls = 0;
+        _range_free(idx * _PAGE_UNITS, _PAGE_UNITS);
+    }
+}
+
+/* bytes usable at ptr which was allocated for size bytes */
+static size_t _capacity(void *ptr, size_t size)
+{
+    _page_t *page = _page_of(ptr);
+
+    if (page) {
+        return page->cls * GNRC_PKTBUF_SLAB_UNIT;
+    }
+    return _units(size) * GNRC_PKTBUF_SLAB_UNIT;
+}
+
+void gnrc_pktbuf_init(void)
+{
+    mutex_lock(&_mutex);
+    memset(_map, 0, sizeof(_map));
+    memset(_free_list, 0, sizeof(_free_list));
+    memset(_pages, 0, sizeof(_pages));
+    memset(_partial, _NO_PAGE, sizeof(_partial));
+    _free_units = 0;
+    _range_free(0, _UNITS);
+#ifdef DEVELHELP
+    memset(&_stats, 0, sizeof(_stats));
+#endif
+    mutex_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt;
+
+    if (size > GNRC_PKTBUF_SIZE) {
+        DEBUG("pktbuf: size (%u) > GNRC_PKTBUF_SIZE (%u)\n",
+              (unsigned)size, GNRC_PKTBUF_SIZE);
+        return NULL;
+    }
+    mutex_lock(&_mutex);
+    pkt = _create_snip(next, data, size, type);
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *marked_snip;
+    void *new_data_marked;
+
+    mutex_lock(&_mutex);
+    if ((size == 0) || (pkt == NULL) || (size > pkt->size) || (pkt->data == NULL)) {
+        DEBUG("pktbuf: size == 0 (was %u) or pkt == NULL (was %p) or "
+              "size > pkt->size (was %u) or pkt->data == NULL (was %p)\n",
+              (unsigned)size, (void *)pkt, (pkt ? (unsigned)pkt->size : 0),
+              (pkt ? pkt->data : NULL));
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    /* create new snip descriptor for marked data */
+    marked_snip = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
+    if (marked_snip == NULL) {
+        DEBUG("pktbuf: could not reallocate marked section.\n");
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    /* data can only be split in place at a unit boundary of a buddy
+     * allocation, slab objects are always freed as a whole */
+    if ((pkt->size != size) &&
+        ((size % GNRC_PKTBUF_SLAB_UNIT) || _page_of(pkt->data))) {
+        void *new_data_rest;
+        new_data_marked = _pktbuf_alloc(size);
+        if (new_data_marked == NULL) {
+            DEBUG("pktbuf: could not reallocate marked section.\n");
+            _pktbuf_free(marked_snip, sizeof(gnrc_pktsnip_t));
+            mutex_unlock(&_mutex);
+            return NULL;
+        }
+        new_data_rest = _pktbuf_alloc(pkt->size - size);
+        if (new_data_rest == NULL) {
+            DEBUG("pktbuf: could not reallocate remaining section.\n");
+            _pktbuf_free(marked_snip, sizeof(gnrc_pktsnip_t));
+            _pktbuf_free(new_data_marked, size);
+            mutex_unlock(&_mutex);
+            return NULL;
+        }
+        memcpy(new_data_marked, pkt->data, size);
+        memcpy(new_data_rest, ((uint8_t *)pkt->data) + size, pkt->size - size);
+        _pktbuf_free(pkt->data, pkt->size);
+        marked_snip->data = new_data_marked;
+        pkt->data = new_data_rest;
+    }
+    else {
+        new_data_marked = pkt->data;
+        /* if (pkt->size - size) != 0 take remainder of data, otherwise set NULL */
+        pkt->data = (pkt->size != size) ? (((uint8_t *)pkt->data) + size) :
+                                          NULL;
+    }
+    pkt->size -= size;
+    _set_pktsnip(marked_snip, pkt->next, new_data_marked, size, type);
+    pkt->next = marked_snip;
+    mutex_unlock(&_mutex);
+    return marked_snip;
+}
+
+int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
+{
+    mutex_lock(&_mutex);
+    assert(pkt != NULL);
+    assert(((pkt->size == 0) && (pkt->data == NULL)) ||
+           ((pkt->size > 0) && (pkt->data != NULL) && _pktbuf_contains(pkt->data)));
+    /* new size and old size are equal */
+    if (size == pkt->size) {
+        /* nothing to do */
+        mutex_unlock(&_mutex);
+        return 0;
+    }
+    /* new size is 0 and data pointer isn't already NULL */
+    if ((size == 0) && (pkt->data != NULL)) {
+        /* set data pointer to NULL */
+        _pktbuf_free(pkt->data, pkt->size);
+        pkt->data = NULL;
+    }
+    /* if new size is bigger than what the allocation holds */
+    else if ((pkt->data == NULL) || (size > _capacity(pkt->data, pkt->size))) {
+        void *new_data = _pktbuf_alloc(size);
+        if (new_data == NULL) {
+            DEBUG("pktbuf: error allocating new data section\n");
+            mutex_unlock(&_mutex);
+            return ENOMEM;
+        }
+        if (pkt->data != NULL) {            /* if old data exist */
+            memcpy(new_data, pkt->data, pkt->size);
+        }
+        _pktbuf_free(pkt->data, pkt->size);
+        pkt->data = new_data;
+    }
+    /* shrinking a buddy allocation gives back the units no longer needed */
+    else if (!_page_of(pkt->data) && (_units(pkt->size) > _units(size))) {
+        _range_free(_unit_of(pkt->data) + _units(size),
+                    _units(pkt->size) - _units(size));
+    }
+    pkt->size = size;
+    mutex_unlock(&_mutex);
+    return 0;
+}
+
+void gnrc_pktbuf_hold(gnrc_pktsnip_t *pkt, unsigned int num)
+{
+    mutex_lock(&_mutex);
+    while (pkt) {
+        pkt->users += num;
+        pkt = pkt->next;
+    }
+    mutex_unlock(&_mutex);
+}
+
+static void _release_error_locked(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    while (pkt) {
+        gnrc_pktsnip_t *tmp;
+        assert(_pktbuf_contains(pkt));
+        assert(pkt->users > 0);
+        tmp = pkt->next;
+        if (pkt->users == 1) {
+            pkt->users = 0; /* not necessary but to be on the safe side */
+            _pktbuf_free(pkt->data, pkt->size);
+            _pktbuf_free(pkt, sizeof(gnrc_pktsnip_t));
+        }
+        else {
+            pkt->users--;
+        }
+        DEBUG("pktbuf: report status code %" PRIu32 "\n", err);
+        gnrc_neterr_report(pkt, err);
+        pkt = tmp;
+    }
+}
+
+void gnrc_pktbuf_release_error(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    mutex_lock(&_mutex);
+    _release_error_locked(pkt, err);
+    mutex_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
+{
+    mutex_lock(&_mutex);
+    if (pkt == NULL) {
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    if (pkt->users > 1) {
+        gnrc_pktsnip_t *new;
+        new = _create_snip(pkt->next, pkt->data, pkt->size, pkt->type);
+        if (new != NULL) {
+            pkt->users--;
+        }
+        mutex_unlock(&_mutex);
+        return new;
+    }
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+#ifdef DEVELHELP
+void gnrc_pktbuf_stats(void)
+{
+    unsigned largest = 0;
+    unsigned pages[_CLASSES] = { 0 };
+
+    mutex_lock(&_mutex);
+    for (unsigned order = 0; order < _ORDERS; order++) {
+        if (_free_list[order]) {
+            largest = 1U << order;
+        }
+    }
+    for (unsigned i = 0; i < _PAGES; i++) {
+        if (_pages[i].cls) {
+            pages[_pages[i].cls - 1]++;
+        }
+    }
+    unsigned free_units = _free_units;
+    unsigned used_units = _UNITS - free_units;
+    mutex_unlock(&_mutex);
+
+    printf("packet buffer: first byte: %p, last byte: %p (size: %u)\n",
+           (void *)&_pktbuf[0], (void *)&_pktbuf[GNRC_PKTBUF_SIZE], GNRC_PKTBUF_SIZE);
+    printf("  used: %u bytes (peak: %u), free: %u bytes, "
+           "largest free block: %u bytes\n",
+           used_units * GNRC_PKTBUF_SLAB_UNIT,
+           _stats.peak_units * GNRC_PKTBUF_SLAB_UNIT,
+           free_units * GNRC_PKTBUF_SLAB_UNIT,
+           largest * GNRC_PKTBUF_SLAB_UNIT);
+    /* how far the largest free block falls short of the largest one the
+     * free space could form */
+    unsigned ideal = 1;
+    while ((ideal << 1) <= free_units) {
+        ideal <<= 1;
+    }
+    printf("  fragmentation: %u%%\n",
+           free_units ? (100U - ((100U * largest) / ideal)) : 0);
+    printf("  allocations: %u (from slabs: %u), failed: %u\n",
+           _stats.allocs, _stats.slab_allocs, _stats.failed);
+#ifdef _TIMING
+    printf("  longest allocation: %" PRIu32 " us, longest release: %" PRIu32
+           " us\n", _xtimer_usec_from_ticks(_stats.alloc_max),
+           _xtimer_usec_from_ticks(_stats.free_max));
+#endif
+    for (unsigned cls = 0; cls < _CLASSES; cls++) {
+        printf("  slabs of %3u byte objects: %u\n",
+               (cls + 1) * GNRC_PKTBUF_SLAB_UNIT, pages[cls]);
+    }
+}
+#endif
+
+#ifdef TEST_SUITES
+bool gnrc_pktbuf_is_empty(void)
+{
+    return _free_units == _UNITS;
+}
+
+bool gnrc_pktbuf_is_sane(void)
+{
+    unsigned free_units = 0;
+
+    /* Invariants of this implementation:
+     *  - every block in the free list of an order is aligned to its size,
+     *    lies within the packet buffer and is marked free with that order
+     *  - the free blocks add up to _free_units
+     *  - every slab with free objects is in the list of its class
+     */
+    for (unsigned order = 0; order < _ORDERS; order++) {
+        for (_block_t *block = _free_list[order]; block; block = block->next) {
+            unsigned unit;
+
+            if (!_pktbuf_contains(block)) {
+                return false;
+            }
+            unit = _unit_of(block);
+            if ((unit & ((1U << order) - 1)) ||
+                ((unit + (1U << order)) > _UNITS) ||
+                (_map[unit] != (_MAP_FREE | order))) {
+                return false;
+            }
+            free_units += 1U << order;
+        }
+    }
+    if (free_units != _free_units) {
+        return false;
+    }
+    for (unsigned cls = 0; cls < _CLASSES; cls++) {
+        for (uint8_t idx = _partial[cls]; idx != _NO_PAGE; idx = _pages[idx].next) {
+            if ((idx >= _PAGES) || (_pages[idx].cls != (cls + 1)) ||
+                (_pages[idx].free == NULL)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+#endif
+
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                    gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
+    void *_data = NULL;
+
+    if (pkt == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+        return NULL;
+    }
+    if (size > 0) {
+        _data = _pktbuf_alloc(size);
+        if (_data == NULL) {
+            DEBUG("pktbuf: error allocating data for new packet snip\n");
+            _pktbuf_free(pkt, sizeof(gnrc_pktsnip_t));
+            return NULL;
+        }
+        if (data != NULL) {
+            memcpy(_data, data, size);
+        }
+    }
+    _set_pktsnip(pkt, next, _data, size, type);
+    return pkt;
+}
+
+static void *_pktbuf_alloc(size_t size)
+{
+    void *ptr = NULL;
+#ifdef _TIMING
+    uint32_t start = xtimer_now().ticks32;
+#endif
+
+    if (size <= GNRC_PKTBUF_SLAB_MAX) {
+        ptr = _slab_alloc(_units(size) - 1);
+#ifdef DEVELHELP
+        _stats.slab_allocs += (ptr != NULL);
+#endif
+    }
+    /* falls back to the buddy system if there is no room for another slab */
+    if (ptr == NULL) {
+        ptr = _units_alloc(_units(size));
+    }
+#ifdef DEVELHELP
+    if (ptr == NULL) {
+        DEBUG("pktbuf: no space left in packet buffer\n");
+        _stats.failed++;
+        return NULL;
+    }
+    _stats.allocs++;
+    if ((_UNITS - _free_units) > _stats.peak_units) {
+        _stats.peak_units = _UNITS - _free_units;
+    }
+#endif
+#ifdef _TIMING
+    uint32_t duration = xtimer_now().ticks32 - start;
+    if (duration > _stats.alloc_max) {
+        _stats.alloc_max = duration;
+    }
+#endif
+    return ptr;
+}
+
+static void _pktbuf_free(void *data, size_t size)
+{
+    if (!_pktbuf_contains(data)) {
+        return;
+    }
+#ifdef _TIMING
+    uint32_t start = xtimer_now().ticks32;
+#endif
+
+    _page_t *page = _page_of(data);
+    if (page) {
+        _slab_free(page, data);
+    }
+    else {
+        _range_free(_unit_of(data), _units(size));
+    }
+#ifdef _TIMING
+    uint32_t duration = xtimer_now().ticks32 - start;
+    if (duration > _stats.free_max) {
+        _stats.free_max = duration;
+    }
+#endif
+}
+
+/** @} */
@@ -29,6 +29,10 @@
 #include "net/gnrc/pktbuf.h"
 #include "net/gnrc/nettype.h"
 #include "net/gnrc/pkt.h"
+#ifdef MODULE_GNRC_PKTBUF_CACHE
+#include "irq.h"
+#include "net/gnrc/pktbuf/cache.h"
+#endif
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -79,12 +83,118 @@ static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
 #endif
 }
 
-void gnrc_pktbuf_init(void)
+#ifdef MODULE_GNRC_PKTBUF_CACHE
+static inline void _lock(void)
+{
+    gnrc_pktbuf_cache_lock(&_mutex);
+}
+
+/* lock must be held */
+static void *_alloc(size_t size)
+{
+    void *ptr = gnrc_pktbuf_cache_get(_align(size));
+
+    if (ptr == NULL) {
+        ptr = gnrc_pktbuf_cache_refill(_align(size), _pktbuf_free);
+    }
+    if (ptr == NULL) {
+        ptr = _pktbuf_alloc(size);
+    }
+    if ((ptr == NULL) && (gnrc_pktbuf_cache_drain(_pktbuf_free) > 0)) {
+        /* the space may just be held by chunks of other sizes */
+        ptr = _pktbuf_alloc(size);
+    }
+    return ptr;
+}
+
+/* lock is only taken if the chunk does not fit into the cache, *locked tells
+ * if it is already held */
+static void _free_cached(void *data, size_t size, bool *locked)
+{
+    if (!_pktbuf_contains(data) || gnrc_pktbuf_cache_put(data, _align(size))) {
+        return;
+    }
+    if (!*locked) {
+        _lock();
+        *locked = true;
+    }
+    gnrc_pktbuf_cache_flush(data, _align(size), _pktbuf_free);
+}
+
+/* lock must be held */
+static inline void _free(void *data, size_t size)
+{
+    bool locked = true;
+
+    _free_cached(data, size, &locked);
+}
+
+/* users are changed without holding the lock when using the cache */
+static inline unsigned _users_add(gnrc_pktsnip_t *pkt, int num)
+{
+    unsigned state = irq_disable();
+    unsigned users = (pkt->users += num);
+
+    irq_restore(state);
+    return users;
+}
+
+/* drops one user if there is another one */
+static inline bool _users_drop_shared(gnrc_pktsnip_t *pkt)
+{
+    unsigned state = irq_disable();
+    bool shared = (pkt->users > 1);
+
+    if (shared) {
+        pkt->users--;
+    }
+    irq_restore(state);
+    return shared;
+}
+#else
+static inline void _lock(void)
 {
     mutex_lock(&_mutex);
+}
+
+static inline void *_alloc(size_t size)
+{
+    return _pktbuf_alloc(size);
+}
+
+static inline void _free(void *data, size_t size)
+{
+    _pktbuf_free(data, size);
+}
+
+static inline void _free_cached(void *data, size_t size, bool *locked)
+{
+    (void)locked;
+    _pktbuf_free(data, size);
+}
+
+static inline unsigned _users_add(gnrc_pktsnip_t *pkt, int num)
+{
+    return (pkt->users += num);
+}
+
+static inline bool _users_drop_shared(gnrc_pktsnip_t *pkt)
+{
+    (void)pkt;
+    /* users can't change while the lock is held */
+    return true;
+}
+#endif
+
+void gnrc_pktbuf_init(void)
+{
+    _lock();
     _first_unused = (_unused_t *)_pktbuf;
     _first_unused->next = NULL;
     _first_unused->size = sizeof(_pktbuf);
+#ifdef MODULE_GNRC_PKTBUF_CACHE
+    gnrc_pktbuf_cache_init();
+#endif
     mutex_unlock(&_mutex);
 }
 
@@ -98,7 +208,24 @@ gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, const void *data, size_t s
               (unsigned)size, GNRC_PKTBUF_SIZE);
         return NULL;
     }
-    mutex_lock(&_mutex);
+#ifdef MODULE_GNRC_PKTBUF_CACHE
+    /* try to get by without the lock first */
+    void *_data = NULL;
+    if ((size == 0) || ((_data = gnrc_pktbuf_cache_get(_align(size))) != NULL)) {
+        pkt = gnrc_pktbuf_cache_get(_align(sizeof(gnrc_pktsnip_t)));
+        if (pkt != NULL) {
+            if ((data != NULL) && (size > 0)) {
+                memcpy(_data, data, size);
+            }
+            _set_pktsnip(pkt, next, _data, size, type);
+            return pkt;
+        }
+        if (_data != NULL) {
+            gnrc_pktbuf_cache_put(_data, _align(size));
+        }
+    }
+#endif
+    _lock();
     pkt = _create_snip(next, data, size, type);
     mutex_unlock(&_mutex);
     return pkt;
@@ -111,7 +238,7 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
     size_t required_new_size = _align(size);
     void *new_data_marked;
 
-    mutex_lock(&_mutex);
+    _lock();
     if ((size == 0) || (pkt == NULL) || (size > pkt->size) || (pkt->data == NULL)) {
         DEBUG("pktbuf: size == 0 (was %u) or pkt == NULL (was %p) or "
               "size > pkt->size (was %u) or pkt->data == NULL (was %p)\n",
@@ -121,7 +248,7 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
         return NULL;
     }
     /* create new snip descriptor for marked data */
-    marked_snip = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
+    marked_snip = _alloc(sizeof(gnrc_pktsnip_t));
     if (marked_snip == NULL) {
         DEBUG("pktbuf: could not reallocate marked section.\n");
         mutex_unlock(&_mutex);
@@ -131,24 +258,24 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
      * for proper free */
     if ((pkt->size != size) && (size < required_new_size)) {
         void *new_data_rest;
-        new_data_marked = _pktbuf_alloc(size);
+        new_data_marked = _alloc(size);
         if (new_data_marked == NULL) {
             DEBUG("pktbuf: could not reallocate marked section.\n");
-            _pktbuf_free(marked_snip, sizeof(gnrc_pktsnip_t));
+            _free(marked_snip, sizeof(gnrc_pktsnip_t));
             mutex_unlock(&_mutex);
             return NULL;
         }
-        new_data_rest = _pktbuf_alloc(pkt->size - size);
+        new_data_rest = _alloc(pkt->size - size);
         if (new_data_rest == NULL) {
             DEBUG("pktbuf: could not reallocate remaining section.\n");
-            _pktbuf_free(marked_snip, sizeof(gnrc_pktsnip_t));
-            _pktbuf_free(new_data_marked, size);
+            _free(marked_snip, sizeof(gnrc_pktsnip_t));
+            _free(new_data_marked, size);
             mutex_unlock(&_mutex);
             return NULL;
         }
         memcpy(new_data_marked, pkt->data, size);
         memcpy(new_data_rest, ((uint8_t *)pkt->data) + size, pkt->size - size);
-        _pktbuf_free(pkt->data, pkt->size);
+        _free(pkt->data, pkt->size);
         marked_snip->data = new_data_marked;
         pkt->data = new_data_rest;
     }
@@ -169,7 +296,7 @@ int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
 {
     size_t aligned_size = _align(size);
 
-    mutex_lock(&_mutex);
+    _lock();
     assert(pkt != NULL);
     assert(((pkt->size == 0) && (pkt->data == NULL)) ||
            ((pkt->size > 0) && (pkt->data != NULL) && _pktbuf_contains(pkt->data)));
@@ -182,12 +309,12 @@ int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
     /* new size is 0 and data pointer isn't already NULL */
     if ((size == 0) && (pkt->data != NULL)) {
         /* set data pointer to NULL */
-        _pktbuf_free(pkt->data, pkt->size);
+        _free(pkt->data, pkt->size);
         pkt->data = NULL;
     }
     /* if new size is bigger than old size */
     else if (size > pkt->size) {    /* new size does not fit */
-        void *new_data = _pktbuf_alloc(size);
+        void *new_data = _alloc(size);
         if (new_data == NULL) {
             DEBUG("pktbuf: error allocating new data section\n");
             mutex_unlock(&_mutex);
@@ -196,11 +323,11 @@ int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
         if (pkt->data != NULL) {            /* if old data exist */
             memcpy(new_data, pkt->data, (pkt->size < size) ? pkt->size : size);
         }
-        _pktbuf_free(pkt->data, pkt->size);
+        _free(pkt->data, pkt->size);
         pkt->data = new_data;
     }
     else if (_align(pkt->size) > aligned_size) {
-        _pktbuf_free(((uint8_t *)pkt->data) + aligned_size,
+        _free(((uint8_t *)pkt->data) + aligned_size,
                      pkt->size - aligned_size);
     }
     pkt->size = size;
@@ -210,45 +337,49 @@ int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
 
 void gnrc_pktbuf_hold(gnrc_pktsnip_t *pkt, unsigned int num)
 {
-    mutex_lock(&_mutex);
+#ifndef MODULE_GNRC_PKTBUF_CACHE
+    _lock();
+#endif
     while (pkt) {
-        pkt->users += num;
+        _users_add(pkt, num);
         pkt = pkt->next;
     }
+#ifndef MODULE_GNRC_PKTBUF_CACHE
     mutex_unlock(&_mutex);
+#endif
 }
 
-static void _release_error_locked(gnrc_pktsnip_t *pkt, uint32_t err)
+void gnrc_pktbuf_release_error(gnrc_pktsnip_t *pkt, uint32_t err)
 {
+#ifdef MODULE_GNRC_PKTBUF_CACHE
+    /* only taken once a chunk does not fit into the cache */
+    bool locked = false;
+#else
+    bool locked = true;
+
+    _lock();
+#endif
     while (pkt) {
         gnrc_pktsnip_t *tmp;
         assert(_pktbuf_contains(pkt));
         assert(pkt->users > 0);
         tmp = pkt->next;
-        if (pkt->users == 1) {
-            pkt->users = 0; /* not necessary but to be on the safe side */
-            _pktbuf_free(pkt->data, pkt->size);
-            _pktbuf_free(pkt, sizeof(gnrc_pktsnip_t));
-        }
-        else {
-            pkt->users--;
+        if (_users_add(pkt, -1) == 0) {
+            _free_cached(pkt->data, pkt->size, &locked);
+            _free_cached(pkt, sizeof(gnrc_pktsnip_t), &locked);
         }
         DEBUG("pktbuf: report status code %" PRIu32 "\n", err);
         gnrc_neterr_report(pkt, err);
         pkt = tmp;
     }
-}
-
-void gnrc_pktbuf_release_error(gnrc_pktsnip_t *pkt, uint32_t err)
-{
-    mutex_lock(&_mutex);
-    _release_error_locked(pkt, err);
-    mutex_unlock(&_mutex);
+    if (locked) {
+        mutex_unlock(&_mutex);
+    }
 }
 
 gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
 {
-    mutex_lock(&_mutex);
+    _lock();
     if (pkt == NULL) {
         mutex_unlock(&_mutex);
         return NULL;
@@ -256,8 +387,11 @@ gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
     if (pkt->users > 1) {
         gnrc_pktsnip_t *new;
         new = _create_snip(pkt->next, pkt->data, pkt->size, pkt->type);
-        if (new != NULL) {
-            pkt->users--;
+        if ((new != NULL) && !_users_drop_shared(pkt)) {
+            /* all other users released pkt in the meantime */
+            _free(new->data, new->size);
+            _free(new, sizeof(gnrc_pktsnip_t));
+            new = pkt;
         }
         mutex_unlock(&_mutex);
         return new;
@@ -284,6 +418,9 @@ static inline void _print_unused(_unused_t *ptr)
 
 void gnrc_pktbuf_stats(void)
 {
+#ifdef MODULE_GNRC_PKTBUF_CACHE
+    gnrc_pktbuf_cache_stats();
+#endif
 #ifdef MODULE_OD
     _unused_t *ptr = _first_unused;
     uint8_t *chunk = &_pktbuf[0];
@@ -327,6 +464,12 @@ void gnrc_pktbuf_stats(void)
 #ifdef TEST_SUITES
 bool gnrc_pktbuf_is_empty(void)
 {
+#ifdef MODULE_GNRC_PKTBUF_CACHE
+    /* cached chunks are not in use */
+    _lock();
+    gnrc_pktbuf_cache_drain(_pktbuf_free);
+    mutex_unlock(&_mutex);
+#endif
     return (_first_unused == (_unused_t *)_pktbuf) &&
            (_first_unused->size == sizeof(_pktbuf));
 }
@@ -366,7 +509,7 @@ bool gnrc_pktbuf_is_sane(void)
 static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size_t size,
                                     gnrc_nettype_t type)
 {
-    gnrc_pktsnip_t *pkt = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
+    gnrc_pktsnip_t *pkt = _alloc(sizeof(gnrc_pktsnip_t));
     void *_data = NULL;
 
     if (pkt == NULL) {
@@ -374,10 +517,10 @@ static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size
         return NULL;
     }
     if (size > 0) {
-        _data = _pktbuf_alloc(size);
+        _data = _alloc(size);
         if (_data == NULL) {
             DEBUG("pktbuf: error allocating data for new packet snip\n");
-            _pktbuf_free(pkt, sizeof(gnrc_pktsnip_t));
+            _free(pkt, sizeof(gnrc_pktsnip_t));
             return NULL;
         }
         if (data != NULL) {
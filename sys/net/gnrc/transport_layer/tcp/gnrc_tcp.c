@@ -30,6 +30,7 @@
 #include "internal/option.h"
 #include "internal/eventloop.h"
 #include "internal/rcvbuf.h"
+#include "internal/tcb_table.h"
 
 #ifdef MODULE_GNRC_IPV6
 #include "net/gnrc/ipv6.h"
@@ -52,16 +53,6 @@ static char _stack[TCP_EVENTLOOP_STACK_SIZE];
  */
 kernel_pid_t gnrc_tcp_pid = KERNEL_PID_UNDEF;
 
-/**
- * @brief Head of liked TCB list.
- */
-gnrc_tcp_tcb_t *_list_tcb_head;
-
-/**
- * @brief Mutex for TCB list synchronization.
- */
-mutex_t _list_tcb_lock;
-
 /**
  * @brief Helper struct, holding all argument data for_cb_mbox_put_msg.
  */
@@ -119,7 +110,7 @@ static int _gnrc_tcp_open(gnrc_tcp_tcb_t *tcb, char *target_addr, uint16_t targe
                           const char *local_addr, uint16_t local_port, uint8_t passive)
 {
     msg_t msg;
-    xtimer_t connection_timeout;
+    xtimer_t connection_timeout = { 0 };
     cb_arg_t connection_timeout_arg = {MSG_TYPE_CONNECTION_TIMEOUT, &(tcb->mbox)};
     int8_t ret = 0;
 
@@ -247,6 +238,25 @@ static int _gnrc_tcp_open(gnrc_tcp_tcb_t *tcb, char *target_addr, uint16_t targe
     return ret;
 }
 
+/**
+ * @brief Puts a closed TCB, that was accepted from a listening queue, back to LISTEN.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _return_to_queue(gnrc_tcp_tcb_t *tcb)
+{
+    mutex_lock(&(tcb->fsm_lock));
+    bool reopen = (tcb->queue != NULL) && (tcb->state == FSM_STATE_CLOSED);
+    if (reopen) {
+        tcb->status &= ~STATUS_ACCEPTED;
+    }
+    mutex_unlock(&(tcb->fsm_lock));
+
+    if (reopen) {
+        _fsm(tcb, FSM_EVENT_CALL_OPEN, NULL, NULL, 0);
+    }
+}
+
 /* External GNRC TCP API */
 int gnrc_tcp_init(void)
 {
@@ -255,11 +265,8 @@ int gnrc_tcp_init(void)
         return -1;
     }
 
-    /* Initialize mutex for TCB list synchronization */
-    mutex_init(&(_list_tcb_lock));
-
-    /* Initialize TCB list */
-    _list_tcb_head = NULL;
+    /* Initialize TCB table */
+    _tcb_table_init();
     _rcvbuf_init();
 
     /* Start TCP processing thread */
@@ -333,6 +340,164 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
     return _gnrc_tcp_open(tcb, NULL, 0, local_addr, local_port, 1);
 }
 
+int gnrc_tcp_listen(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t *tcbs, size_t tcbs_len,
+                    uint8_t address_family, const char *local_addr, uint16_t local_port)
+{
+    assert(queue != NULL);
+    assert(tcbs != NULL);
+    assert(tcbs_len > 0);
+    assert(local_port != PORT_UNSPEC);
+
+    /* Check AF-Family support */
+#ifdef MODULE_GNRC_IPV6
+    ipv6_addr_t addr;
+
+    if (address_family != AF_INET6) {
+        return -EAFNOSUPPORT;
+    }
+    if (local_addr != NULL && ipv6_addr_from_str(&addr, local_addr) == NULL) {
+        DEBUG("gnrc_tcp.c : gnrc_tcp_listen() : Invalid local addr\n");
+        return -EINVAL;
+    }
+#else
+    (void) address_family;
+    (void) local_addr;
+    return -EAFNOSUPPORT;
+#endif
+
+    memset(queue, 0, sizeof(gnrc_tcp_tcb_queue_t));
+    mutex_init(&(queue->lock));
+    mbox_init(&(queue->mbox), queue->mbox_raw, GNRC_TCP_TCB_MBOX_SIZE);
+    queue->tcbs = tcbs;
+    queue->tcbs_len = tcbs_len;
+    queue->local_port = local_port;
+
+    /* Register queue, so connection requests are dropped while all TCBs are busy */
+    mutex_lock(&_tcb_table_lock);
+    _tcb_table_add_queue(queue);
+    mutex_unlock(&_tcb_table_lock);
+
+    /* Put all TCBs into LISTEN */
+    for (size_t i = 0; i < tcbs_len; i++) {
+        gnrc_tcp_tcb_t *tcb = &tcbs[i];
+
+        gnrc_tcp_tcb_init(tcb);
+        tcb->queue = queue;
+        tcb->status |= STATUS_PASSIVE;
+        if (local_addr == NULL) {
+            tcb->status |= STATUS_ALLOW_ANY_ADDR;
+        }
+#ifdef MODULE_GNRC_IPV6
+        else {
+            memcpy(tcb->local_addr, &addr, sizeof(ipv6_addr_t));
+        }
+#endif
+        tcb->local_port = local_port;
+        _fsm(tcb, FSM_EVENT_CALL_OPEN, NULL, NULL, 0);
+    }
+    return 0;
+}
+
+int gnrc_tcp_accept(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t **tcb,
+                    const uint32_t timeout_duration_us)
+{
+    assert(queue != NULL);
+    assert(tcb != NULL);
+
+    msg_t msg;
+    xtimer_t user_timeout = { 0 };
+    cb_arg_t user_timeout_arg = {MSG_TYPE_USER_SPEC_TIMEOUT, &(queue->mbox)};
+    int ret = -EAGAIN;
+
+    /* Lock the queue for this function call */
+    mutex_lock(&(queue->lock));
+
+    /* Check if queue is listening */
+    if (queue->tcbs == NULL) {
+        mutex_unlock(&(queue->lock));
+        return -EINVAL;
+    }
+
+    /* 'Flush' mbox */
+    while (mbox_try_get(&(queue->mbox), &msg) != 0) {
+    }
+
+    /* Setup user specified timeout, if this call is blocking */
+    if (timeout_duration_us > 0) {
+        _setup_timeout(&user_timeout, timeout_duration_us, _cb_mbox_put_msg, &user_timeout_arg);
+    }
+
+    /* Search for an established connection, that was not accepted yet */
+    *tcb = NULL;
+    while (*tcb == NULL) {
+        for (size_t i = 0; i < queue->tcbs_len; i++) {
+            gnrc_tcp_tcb_t *iter = &(queue->tcbs[i]);
+
+            mutex_lock(&(iter->fsm_lock));
+            if ((iter->state == FSM_STATE_ESTABLISHED || iter->state == FSM_STATE_CLOSE_WAIT) &&
+                !(iter->status & STATUS_ACCEPTED)) {
+                iter->status |= STATUS_ACCEPTED;
+                *tcb = iter;
+            }
+            mutex_unlock(&(iter->fsm_lock));
+            if (*tcb != NULL) {
+                ret = 0;
+                break;
+            }
+        }
+
+        /* Return if nothing was found and this call is non-blocking */
+        if (*tcb != NULL || timeout_duration_us == 0) {
+            break;
+        }
+
+        /* Wait until a connection changed its state or the timeout fires */
+        mbox_get(&(queue->mbox), &msg);
+        if (msg.type == MSG_TYPE_USER_SPEC_TIMEOUT) {
+            DEBUG("gnrc_tcp.c : gnrc_tcp_accept() : USER_SPEC_TIMEOUT\n");
+            ret = -ETIMEDOUT;
+            break;
+        }
+    }
+
+    /* Cleanup */
+    if (timeout_duration_us > 0) {
+        xtimer_remove(&user_timeout);
+    }
+    mutex_unlock(&(queue->lock));
+    return ret;
+}
+
+void gnrc_tcp_stop_listen(gnrc_tcp_tcb_queue_t *queue)
+{
+    assert(queue != NULL);
+
+    mutex_lock(&(queue->lock));
+
+    /* Stop dropping connection requests */
+    mutex_lock(&_tcb_table_lock);
+    _tcb_table_remove_queue(queue);
+    mutex_unlock(&_tcb_table_lock);
+
+    /* Detach all TCBs from the queue, abort those the user does not hold */
+    for (size_t i = 0; i < queue->tcbs_len; i++) {
+        gnrc_tcp_tcb_t *tcb = &(queue->tcbs[i]);
+        bool accepted;
+
+        mutex_lock(&(tcb->fsm_lock));
+        tcb->queue = NULL;
+        accepted = (tcb->status & STATUS_ACCEPTED);
+        tcb->status &= ~STATUS_ACCEPTED;
+        mutex_unlock(&(tcb->fsm_lock));
+        if (!accepted) {
+            gnrc_tcp_abort(tcb);
+        }
+    }
+    queue->tcbs = NULL;
+    queue->tcbs_len = 0;
+    mutex_unlock(&(queue->lock));
+}
+
 ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                       const uint32_t timeout_duration_us)
 {
@@ -340,11 +505,11 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
     assert(data != NULL);
 
     msg_t msg;
-    xtimer_t connection_timeout;
+    xtimer_t connection_timeout = { 0 };
     cb_arg_t connection_timeout_arg = {MSG_TYPE_CONNECTION_TIMEOUT, &(tcb->mbox)};
-    xtimer_t user_timeout;
+    xtimer_t user_timeout = { 0 };
     cb_arg_t user_timeout_arg = {MSG_TYPE_USER_SPEC_TIMEOUT, &(tcb->mbox)};
-    xtimer_t probe_timeout;
+    xtimer_t probe_timeout = { 0 };
     cb_arg_t probe_timeout_arg = {MSG_TYPE_PROBE_TIMEOUT, &(tcb->mbox)};
     uint32_t probe_timeout_duration_us = 0;
     ssize_t ret = 0;
@@ -375,8 +540,8 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
         _setup_timeout(&user_timeout, timeout_duration_us, _cb_mbox_put_msg, &user_timeout_arg);
     }
 
-    /* Loop until something was sent and acked */
-    while (ret == 0 || tcb->pkt_retransmit != NULL) {
+    /* Loop until something was sent and the retransmit queue has room for more */
+    while (ret == 0 || tcb->rtx_len >= GNRC_TCP_RETRANSMIT_QUEUE_SIZE) {
         /* Check if the connections state is closed. If so, a reset was received */
         if (tcb->state == FSM_STATE_CLOSED) {
             ret = -ECONNRESET;
@@ -398,6 +563,9 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
         /* Try to send data in case there nothing has been sent and we are not probing */
         if (ret == 0 && !probing_mode) {
             ret = _fsm(tcb, FSM_EVENT_CALL_SEND, NULL, (void *) data, len);
+            if (ret < 0) {
+                break;
+            }
         }
 
         /* Wait for responses */
@@ -465,9 +633,9 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
     assert(data != NULL);
 
     msg_t msg;
-    xtimer_t connection_timeout;
+    xtimer_t connection_timeout = { 0 };
     cb_arg_t connection_timeout_arg = {MSG_TYPE_CONNECTION_TIMEOUT, &(tcb->mbox)};
-    xtimer_t user_timeout;
+    xtimer_t user_timeout = { 0 };
     cb_arg_t user_timeout_arg = {MSG_TYPE_USER_SPEC_TIMEOUT, &(tcb->mbox)};
     ssize_t ret = 0;
 
@@ -555,7 +723,7 @@ void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb)
     assert(tcb != NULL);
 
     msg_t msg;
-    xtimer_t connection_timeout;
+    xtimer_t connection_timeout = { 0 };
     cb_arg_t connection_timeout_arg = {MSG_TYPE_CONNECTION_TIMEOUT, &(tcb->mbox)};
 
     /* Lock the TCB for this function call */
@@ -563,6 +731,7 @@ void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb)
 
     /* Return if connection is closed */
     if (tcb->state == FSM_STATE_CLOSED) {
+        _return_to_queue(tcb);
         mutex_unlock(&(tcb->function_lock));
         return;
     }
@@ -602,6 +771,7 @@ void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb)
     /* Cleanup */
     xtimer_remove(&connection_timeout);
     tcb->status &= ~STATUS_WAIT_FOR_MSG;
+    _return_to_queue(tcb);
     mutex_unlock(&(tcb->function_lock));
 }
 
@@ -615,6 +785,7 @@ void gnrc_tcp_abort(gnrc_tcp_tcb_t *tcb)
         /* Call FSM ABORT event */
         _fsm(tcb, FSM_EVENT_CALL_ABORT, NULL, NULL, 0);
     }
+    _return_to_queue(tcb);
     mutex_unlock(&(tcb->function_lock));
 }
 
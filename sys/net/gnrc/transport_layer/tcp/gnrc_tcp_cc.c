@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc
+ * @{
+ *
+ * @file
+ * @brief       Implementation of internal/cc.h
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ * @}
+ */
+#include "internal/common.h"
+#include "internal/pkt.h"
+#include "internal/cc.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#ifdef MODULE_GNRC_TCP_SLIDING_WINDOW
+
+/**
+ * @brief Loss recovery states, stored in gnrc_tcp_tcb_t::in_recovery
+ * @{
+ */
+#define RECOVERY_NONE (0U)  /**< No loss detected */
+#define RECOVERY_FAST (1U)  /**< Fast recovery after fast retransmit */
+#define RECOVERY_RTO  (2U)  /**< Slow start after retransmission timeout */
+/** @} */
+
+static inline uint32_t _min(const uint32_t x, const uint32_t y)
+{
+    return (x < y) ? x : y;
+}
+
+static inline uint32_t _max(const uint32_t x, const uint32_t y)
+{
+    return (x > y) ? x : y;
+}
+
+/**
+ * @brief Sender maximum segment size, as used by _fsm_call_send().
+ */
+static inline uint32_t _smss(const gnrc_tcp_tcb_t *tcb)
+{
+    return _min(GNRC_TCP_MSS, tcb->mss);
+}
+
+/**
+ * @brief Slow start threshold after a loss (RFC 5681, eqn. 4).
+ */
+static inline uint32_t _loss_ssthresh(const gnrc_tcp_tcb_t *tcb)
+{
+    return _max((tcb->snd_nxt - tcb->snd_una) / 2, 2 * _smss(tcb));
+}
+
+/**
+ * @brief Opens the congestion window by @p inc, up to the number of bytes
+ *        the retransmission queue can hold.
+ */
+static void _open_cwnd(gnrc_tcp_tcb_t *tcb, uint32_t inc)
+{
+    uint32_t max = GNRC_TCP_RETRANSMIT_QUEUE_SIZE * _smss(tcb);
+
+    tcb->cwnd = (tcb->cwnd + inc < max) ? tcb->cwnd + inc : _max(max, tcb->cwnd);
+}
+
+void _cc_init(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t smss = _smss(tcb);
+
+    /* Initial window (RFC 3390) */
+    tcb->cwnd = _min(4 * smss, _max(2 * smss, 4380));
+    tcb->ssthresh = UINT32_MAX;
+    tcb->recover = tcb->iss;
+    tcb->dupacks = 0;
+    tcb->in_recovery = RECOVERY_NONE;
+}
+
+void _cc_ack(gnrc_tcp_tcb_t *tcb, uint32_t acked)
+{
+    uint32_t smss = _smss(tcb);
+
+    tcb->dupacks = 0;
+    if (tcb->in_recovery != RECOVERY_NONE) {
+        /* Partial ACK: the oldest unacknowledged segment is lost as well */
+        if (LSS_32_BIT(tcb->snd_una, tcb->recover)) {
+            DEBUG("gnrc_tcp_cc.c : _cc_ack() : partial ACK\n");
+            _pkt_retransmit(tcb);
+            if (tcb->in_recovery == RECOVERY_FAST) {
+                /* Deflate by the acknowledged data, allow one new segment */
+                tcb->cwnd = ((tcb->cwnd > acked) ? tcb->cwnd - acked : 0) + smss;
+            }
+            else {
+                _open_cwnd(tcb, _min(acked, smss));
+            }
+            return;
+        }
+        /* Full ACK: all data sent before the loss is acknowledged */
+        DEBUG("gnrc_tcp_cc.c : _cc_ack() : leave loss recovery\n");
+        if (tcb->in_recovery == RECOVERY_FAST) {
+            tcb->cwnd = _min(tcb->ssthresh,
+                             _max(tcb->snd_nxt - tcb->snd_una, smss) + smss);
+        }
+        tcb->in_recovery = RECOVERY_NONE;
+        return;
+    }
+
+    /* Slow start (RFC 5681, eqn. 2) */
+    if (tcb->cwnd < tcb->ssthresh) {
+        _open_cwnd(tcb, _min(acked, smss));
+    }
+    /* Congestion avoidance (RFC 5681, eqn. 3) */
+    else {
+        _open_cwnd(tcb, _max(1, (smss * smss) / tcb->cwnd));
+    }
+}
+
+void _cc_dupack(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t smss = _smss(tcb);
+
+    if (tcb->dupacks < UINT8_MAX) {
+        tcb->dupacks++;
+    }
+
+    /* Every further duplicate ACK signals a segment that left the network */
+    if (tcb->in_recovery == RECOVERY_FAST) {
+        tcb->cwnd += smss;
+#ifdef MODULE_GNRC_TCP_SACK
+        /* Repair the next hole the peer reported, instead of one per RTT (RFC 6675) */
+        _pkt_retransmit(tcb);
+#endif
+        return;
+    }
+
+    /* Fast retransmit, unless the duplicate ACKs stem from a previous loss (RFC 6582, 3.2) */
+    if (tcb->dupacks == GNRC_TCP_DUPACK_THRESHOLD &&
+        tcb->in_recovery == RECOVERY_NONE && LSS_32_BIT(tcb->recover, tcb->snd_una)) {
+        DEBUG("gnrc_tcp_cc.c : _cc_dupack() : fast retransmit\n");
+        tcb->ssthresh = _loss_ssthresh(tcb);
+        tcb->recover = tcb->snd_nxt;
+#ifdef MODULE_GNRC_TCP_SACK
+        tcb->rtx_resent = 0;
+#endif
+        _pkt_retransmit(tcb);
+        tcb->cwnd = tcb->ssthresh + (GNRC_TCP_DUPACK_THRESHOLD * smss);
+        tcb->in_recovery = RECOVERY_FAST;
+    }
+}
+
+void _cc_timeout(gnrc_tcp_tcb_t *tcb)
+{
+    DEBUG("gnrc_tcp_cc.c : _cc_timeout()\n");
+
+    /* Only the first timeout of a loss reduces the slow start threshold */
+    if (tcb->retries == 0) {
+        tcb->ssthresh = _loss_ssthresh(tcb);
+    }
+    tcb->cwnd = _smss(tcb);
+    tcb->recover = tcb->snd_nxt;
+    tcb->dupacks = 0;
+    tcb->in_recovery = RECOVERY_RTO;
+#ifdef MODULE_GNRC_TCP_SACK
+    /* Retransmissions might have been lost as well */
+    tcb->rtx_resent = 0;
+#endif
+}
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_GNRC_TCP_SLIDING_WINDOW */
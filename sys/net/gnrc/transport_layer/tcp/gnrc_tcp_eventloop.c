@@ -25,6 +25,7 @@
 #include "internal/common.h"
 #include "internal/pkt.h"
 #include "internal/fsm.h"
+#include "internal/tcb_table.h"
 #include "internal/eventloop.h"
 
 #ifdef MODULE_GNRC_IPV6
@@ -172,48 +173,41 @@ static int _receive(gnrc_pktsnip_t *pkt)
     }
 
     /* Validate checksum */
-    if (byteorder_ntohs(hdr->checksum) != _pkt_calc_csum(tcp, ip, pkt)) {
+    if (!(gnrc_netif_hdr_get_flag(pkt) & GNRC_NETIF_HDR_FLAGS_CSUM_VERIFIED) &&
+        (byteorder_ntohs(hdr->checksum) != _pkt_calc_csum(tcp, ip, pkt))) {
         DEBUG("gnrc_tcp_eventloop.c : _receive() : Invalid checksum\n");
         gnrc_pktbuf_release(pkt);
         return -EINVAL;
     }
 
     /* Find TCB to for this packet */
-    mutex_lock(&_list_tcb_lock);
-    tcb = _list_tcb_head;
-    while (tcb) {
+    mutex_lock(&_tcb_table_lock);
 #ifdef MODULE_GNRC_IPV6
-        /* Check if current TCB is fitting for the incomming packet */
-        if (ip->type == GNRC_NETTYPE_IPV6 && tcb->address_family == AF_INET6) {
-            /* If SYN is set, a connection is listening on that port ... */
-            ipv6_addr_t *tmp_addr = NULL;
-            if (syn && tcb->local_port == dst && tcb->state == FSM_STATE_LISTEN) {
-                /* ... and local addr is unspec or pre configured */
-                tmp_addr = &((ipv6_hdr_t *)ip->data)->dst;
-                if (ipv6_addr_equal((ipv6_addr_t *) tcb->local_addr, (ipv6_addr_t *) tmp_addr) ||
-                    ipv6_addr_is_unspecified((ipv6_addr_t *) tcb->local_addr)) {
-                    break;
-                }
-            }
+    ipv6_hdr_t *ip_hdr = (ipv6_hdr_t *)ip->data;
 
-            /* If SYN is not set and the ports match ... */
-            if (!syn && tcb->local_port == dst && tcb->peer_port == src) {
-                /* .. and the IPv6 addresses match */
-                tmp_addr = &((ipv6_hdr_t * )ip->data)->src;
-                if (ipv6_addr_equal((ipv6_addr_t *) tcb->peer_addr, (ipv6_addr_t *) tmp_addr)) {
-                    break;
-                }
-            }
+    /* If SYN is set, a connection must be listening on that port ... */
+    if (syn) {
+        tcb = _tcb_table_find_listener(dst, ip_hdr->dst.u8);
+
+        /* ... if all TCBs of a listening queue are busy: Drop SYN, the peer retries */
+        if (tcb == NULL && _tcb_table_port_has_queue(dst)) {
+            mutex_unlock(&_tcb_table_lock);
+            DEBUG("gnrc_tcp_eventloop.c : _receive() : Listening queue is full\n");
+            gnrc_pktbuf_release(pkt);
+            return 0;
         }
+    }
+    /* ... else ports and the peer address must match */
+    else {
+        tcb = _tcb_table_find(dst, src, ip_hdr->src.u8);
+    }
 #else
-        /* Supress compiler warnings if TCP is build without network layer */
-        (void) syn;
-        (void) src;
-        (void) dst;
+    /* Supress compiler warnings if TCP is build without network layer */
+    (void) syn;
+    (void) src;
+    (void) dst;
 #endif
-        tcb = tcb->next;
-    }
-    mutex_unlock(&_list_tcb_lock);
+    mutex_unlock(&_tcb_table_lock);
 
     /* Call FSM with event RCVD_PKT if a fitting TCB was found */
     if (tcb != NULL) {
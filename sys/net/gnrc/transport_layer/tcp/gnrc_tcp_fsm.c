@@ -26,6 +26,8 @@
 #include "internal/pkt.h"
 #include "internal/option.h"
 #include "internal/rcvbuf.h"
+#include "internal/cc.h"
+#include "internal/tcb_table.h"
 #include "internal/fsm.h"
 
 #ifdef MODULE_GNRC_IPV6
@@ -35,31 +37,11 @@
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
-/**
- * @brief Helper macro for LL_SEARCH to compare TCBs
- */
-#define TCB_EQUAL(a,b)      ((a) != (b))
-
-/**
- * @brief Checks if a given port number is currently used by a TCB as local_port.
- *
- * @note Must be called from a context where the TCB list is locked.
- *
- * @param[in] port_number   Port number that should be checked.
- *
- * @returns   Zero if @p port_number is currently not used.
- *            1 if @p port_number is used by an active connection.
- */
-static int _is_local_port_in_use(const uint16_t port_number)
-{
-    gnrc_tcp_tcb_t *iter = NULL;
-    LL_SEARCH_SCALAR(_list_tcb_head, iter, local_port, port_number);
-    return (iter != NULL);
-}
-
 /**
  * @brief Generate random unused local port above the well-known ports (> 1024).
  *
+ * @note Must be called from a context where the TCB table is locked.
+ *
  * @returns   Generated port number.
  */
 static uint16_t _get_random_local_port(void)
@@ -70,7 +52,7 @@ static uint16_t _get_random_local_port(void)
         if (ret < 1024) {
             continue;
         }
-    } while(_is_local_port_in_use(ret));
+    } while(_tcb_table_port_in_use(ret));
     return ret;
 }
 
@@ -83,11 +65,18 @@ static uint16_t _get_random_local_port(void)
  */
 static int _clear_retransmit(gnrc_tcp_tcb_t *tcb)
 {
-    if (tcb->pkt_retransmit != NULL) {
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
+    if (tcb->rtx_len > 0) {
+        for (uint8_t i = 0; i < tcb->rtx_len; i++) {
+            gnrc_pktbuf_release(tcb->rtx_queue[i]);
+        }
         xtimer_remove(&(tcb->tim_tout));
-        tcb->pkt_retransmit = NULL;
+        tcb->rtx_len = 0;
     }
+#ifdef MODULE_GNRC_TCP_SACK
+    tcb->rtx_sacked = 0;
+    tcb->rtx_resent = 0;
+#endif
+    tcb->status &= ~STATUS_RTT_SAMPLE;
     return 0;
 }
 
@@ -119,17 +108,15 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
 {
     DEBUG("_transition_to: %d\n", state);
 
-    gnrc_tcp_tcb_t *iter = NULL;
-
     switch (state) {
         case FSM_STATE_CLOSED:
             /* Clear retransmit queue */
             _clear_retransmit(tcb);
 
             /* Remove connection from active connections */
-            mutex_lock(&_list_tcb_lock);
-            LL_DELETE(_list_tcb_head, tcb);
-            mutex_unlock(&_list_tcb_lock);
+            mutex_lock(&_tcb_table_lock);
+            _tcb_table_remove(tcb);
+            mutex_unlock(&_tcb_table_lock);
 
             /* Free potencially allocated receive buffer */
             _rcvbuf_release_buffer(tcb);
@@ -137,6 +124,10 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
             break;
 
         case FSM_STATE_LISTEN:
+            /* Remove connection from active connections, clearing the peer changes its key */
+            mutex_lock(&_tcb_table_lock);
+            _tcb_table_remove(tcb);
+
             /* Clear address info */
 #ifdef MODULE_GNRC_IPV6
             if (tcb->address_family == AF_INET6) {
@@ -148,18 +139,19 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
 #endif
             tcb->peer_port = PORT_UNSPEC;
 
-            /* Allocate receive buffer */
-            if (_rcvbuf_get_buffer(tcb) == -ENOMEM) {
+            /* Allocate receive buffer. TCBs of a listening queue allocate it with
+             * each connection request instead, so idle TCBs of a queue hold none. */
+            if (tcb->queue != NULL) {
+                _rcvbuf_release_buffer(tcb);
+            }
+            else if (_rcvbuf_get_buffer(tcb) == -ENOMEM) {
+                mutex_unlock(&_tcb_table_lock);
                 return -ENOMEM;
             }
 
-            /* Add connection to active connections (if not already active) */
-            mutex_lock(&_list_tcb_lock);
-            LL_SEARCH(_list_tcb_head, iter, tcb, TCB_EQUAL);
-            if (iter == NULL) {
-                LL_PREPEND(_list_tcb_head, tcb);
-            }
-            mutex_unlock(&_list_tcb_lock);
+            /* Add connection to active connections */
+            _tcb_table_add(tcb);
+            mutex_unlock(&_tcb_table_lock);
             break;
 
         case FSM_STATE_SYN_SENT:
@@ -168,31 +160,31 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
                 return -ENOMEM;
             }
 
-            /* Add connection to active connections (if not already active) */
-            mutex_lock(&_list_tcb_lock);
-            LL_SEARCH(_list_tcb_head, iter, tcb, TCB_EQUAL);
-            /* If connection is not already active: Check port number, append TCB */
-            if (iter == NULL) {
-                /* Check if port number was specified */
-                if (tcb->local_port != PORT_UNSPEC) {
-                    /* Check if given port number is use: return error and release buffer */
-                    if (_is_local_port_in_use(tcb->local_port)) {
-                        mutex_unlock(&_list_tcb_lock);
-                        _rcvbuf_release_buffer(tcb);
-                        return -EADDRINUSE;
-                    }
+            /* Add connection to active connections */
+            mutex_lock(&_tcb_table_lock);
+            /* Check if port number was specified */
+            if (tcb->local_port != PORT_UNSPEC) {
+                /* Check if given port number is use: return error and release buffer */
+                if (_tcb_table_port_in_use(tcb->local_port)) {
+                    mutex_unlock(&_tcb_table_lock);
+                    _rcvbuf_release_buffer(tcb);
+                    return -EADDRINUSE;
                 }
-                /* Pick random port */
-                else {
-                    tcb->local_port = _get_random_local_port();
-                }
-                LL_PREPEND(_list_tcb_head, tcb);
             }
-            mutex_unlock(&_list_tcb_lock);
+            /* Pick random port */
+            else {
+                tcb->local_port = _get_random_local_port();
+            }
+            _tcb_table_add(tcb);
+            mutex_unlock(&_tcb_table_lock);
             break;
 
-        case FSM_STATE_SYN_RCVD:
         case FSM_STATE_ESTABLISHED:
+            _cc_init(tcb);
+            tcb->status |= STATUS_NOTIFY_USER;
+            break;
+
+        case FSM_STATE_SYN_RCVD:
         case FSM_STATE_CLOSE_WAIT:
             tcb->status |= STATUS_NOTIFY_USER;
             break;
@@ -262,29 +254,45 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
  * @param[in]     len   Maximum Number of Bytes to send from @p buf.
  *
  * @returns   Number of successfully transmitted bytes.
+ *            -ENOMEM if no packet could be allocated.
  */
 static int _fsm_call_send(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_call_send()\n");
 
-    size_t payload = (tcb->snd_una + tcb->snd_wnd) - tcb->snd_nxt;
+    size_t sent = 0;
+
+    /* Send segments as long as the retransmit queue and the send window have room */
+    while (sent < len && tcb->rtx_len < GNRC_TCP_RETRANSMIT_QUEUE_SIZE) {
+        uint32_t wnd = _cc_wnd(tcb);
+        uint32_t flight = tcb->snd_nxt - tcb->snd_una;
+
+        wnd = (wnd < tcb->snd_wnd) ? wnd : tcb->snd_wnd;
+        if (wnd <= flight) {
+            break;
+        }
 
-    /* Check if window is open and all packets were transmitted */
-    if (payload > 0 && tcb->snd_wnd > 0 && tcb->pkt_retransmit == NULL) {
         /* Calculate segment size */
+        size_t payload = wnd - flight;
         payload = (payload < GNRC_TCP_MSS) ? payload : GNRC_TCP_MSS;
         payload = (payload < tcb->mss) ? payload : tcb->mss;
-        payload = (payload < len) ? payload : len;
+        payload = (payload < len - sent) ? payload : len - sent;
+        if (payload == 0) {
+            break;
+        }
 
-        /* Calculate payload size for this segment */
+        /* Build and send segment */
         gnrc_pktsnip_t *out_pkt = NULL;
         uint16_t seq_con = 0;
-        _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH, tcb->snd_nxt, tcb->rcv_nxt, buf, payload);
+        if (_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH, tcb->snd_nxt, tcb->rcv_nxt,
+                       (uint8_t *)buf + sent, payload) < 0) {
+            return (sent > 0) ? (int)sent : -ENOMEM;
+        }
         _pkt_setup_retransmit(tcb, out_pkt, false);
         _pkt_send(tcb, out_pkt, seq_con, false);
-        return payload;
+        sent += payload;
     }
-    return 0;
+    return sent;
 }
 
 /**
@@ -449,30 +457,23 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
             uint16_t dst = byteorder_ntohs(tcp_hdr->dst_port);
 
             /* Check if SYN request is handled by another connection */
-            lst = _list_tcb_head;
-            while (lst) {
-                /* Compare port numbers and network layer adresses */
-                if (lst->local_port == dst && lst->peer_port == src) {
 #ifdef MODULE_GNRC_IPV6
-                    if (snp->type == GNRC_NETTYPE_IPV6 && lst->address_family == AF_INET6) {
-                        ipv6_addr_t *dst_addr = &((ipv6_hdr_t *)ip)->dst;
-                        ipv6_addr_t *src_addr = &((ipv6_hdr_t *)ip)->src;
-
-                        if (ipv6_addr_equal((ipv6_addr_t *)lst->local_addr, dst_addr) &&
-                            ipv6_addr_equal((ipv6_addr_t *)lst->peer_addr, src_addr)) {
-                            break;
-                        }
-                    }
+            mutex_lock(&_tcb_table_lock);
+            lst = _tcb_table_find(dst, src, (uint8_t *) &((ipv6_hdr_t *)ip)->src);
+            mutex_unlock(&_tcb_table_lock);
 #endif
-                }
-                lst = lst->next;
-            }
             /* Return if connection is already handled (port and addresses match) */
             if (lst != NULL) {
                 DEBUG("gnrc_tcp_fsm.c : _fsm_rcvd_pkt() : Connection already handled\n");
                 return 0;
             }
 
+            /* TCBs of a listening queue allocate their receive buffer now */
+            if (_rcvbuf_get_buffer(tcb) == -ENOMEM) {
+                DEBUG("gnrc_tcp_fsm.c : _fsm_rcvd_pkt() : Out of receive buffers\n");
+                return 0;
+            }
+
             /* SYN request is valid, fill TCB with connection information */
 #ifdef MODULE_GNRC_IPV6
             if (snp->type == GNRC_NETTYPE_IPV6 && tcb->address_family == AF_INET6) {
@@ -498,8 +499,15 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
             return 0;
 #endif
 
+            /* Rehash the connection by its 4-tuple */
+            mutex_lock(&_tcb_table_lock);
+            _tcb_table_remove(tcb);
             tcb->local_port = dst;
             tcb->peer_port = src;
+            _tcb_table_add(tcb);
+            mutex_unlock(&_tcb_table_lock);
+
+            tcb->retries = 0;
             tcb->irs = byteorder_ntohl(tcp_hdr->seq_num);
             tcb->rcv_nxt = tcb->irs + 1;
             tcb->iss = random_uint32();
@@ -632,8 +640,19 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 tcb->state == FSM_STATE_CLOSING || tcb->state == FSM_STATE_LAST_ACK) {
                 /* Acknowledge previously sent data */
                 if (LSS_32_BIT(tcb->snd_una, seg_ack) && LEQ_32_BIT(seg_ack, tcb->snd_nxt)) {
+                    uint32_t acked = seg_ack - tcb->snd_una;
+
                     tcb->snd_una = seg_ack;
                     _pkt_acknowledge(tcb, seg_ack);
+                    _cc_ack(tcb, acked);
+
+                    /* Signal user, the retransmit queue has room again */
+                    tcb->status |= STATUS_NOTIFY_USER;
+                }
+                /* Duplicate ACK: Segments after a missing one arrived (RFC 5681) */
+                else if (seg_ack == tcb->snd_una && pay_len == 0 && !(ctl & MSK_FIN) &&
+                         seg_wnd == tcb->snd_wnd && tcb->rtx_len > 0) {
+                    _cc_dupack(tcb);
                 }
                 /* ACK received for something not yet sent: Reply with pure ACK */
                 else if (LSS_32_BIT(tcb->snd_nxt, seg_ack)) {
@@ -657,25 +676,25 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 /* Additional processing */
                 /* Check additionaly if previously sent FIN was acknowledged */
                 if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->rtx_len == 0) {
                         _transition_to(tcb, FSM_STATE_FIN_WAIT_2);
                     }
                 }
                 /* If retransmission queue is empty, acknowledge close operation */
                 if (tcb->state == FSM_STATE_FIN_WAIT_2) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->rtx_len == 0) {
                         /* Optional: Unblock user close operation */
                     }
                 }
                 /* If our FIN has been acknowledged: Transition to TIME_WAIT */
                 if (tcb->state == FSM_STATE_CLOSING) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->rtx_len == 0) {
                         _transition_to(tcb, FSM_STATE_TIME_WAIT);
                     }
                 }
                 /* If our FIN was acknowledged and status is LAST_ACK: close connection */
                 if (tcb->state == FSM_STATE_LAST_ACK) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->rtx_len == 0) {
                         _transition_to(tcb, FSM_STATE_CLOSED);
                         return 0;
                     }
@@ -700,11 +719,22 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                         tcb->rcv_nxt += ringbuffer_add(&(tcb->rcv_buf), snp->data, snp->size);
                         snp = snp->next;
                     }
+#ifdef MODULE_GNRC_TCP_SACK
+                    /* Data received out of order before might follow directly now */
+                    _rcvbuf_ooo_merge(tcb);
+#endif
                     /* Shrink receive window */
                     tcb->rcv_wnd = ringbuffer_get_free(&(tcb->rcv_buf));
                     /* Notify owner because new data is available */
                     tcb->status |= STATUS_NOTIFY_USER;
                 }
+#ifdef MODULE_GNRC_TCP_SACK
+                /* Keep data after a gap, the ACK reports it in a SACK block. A FIN
+                 * is processed in order only, so its segment is left to the peer. */
+                else if (LSS_32_BIT(tcb->rcv_nxt, seg_seq) && !(ctl & MSK_FIN)) {
+                    _rcvbuf_ooo_add(tcb, seg_seq, snp, pay_len);
+                }
+#endif
                 /* Send ACK, if FIN processing sends ACK already */
                 /* NOTE: this is the place to add payload piggybagging in the future */
                 if (!(ctl & MSK_FIN)) {
@@ -720,6 +750,12 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 tcb->state == FSM_STATE_SYN_SENT) {
                 return 0;
             }
+            /* Process FIN only if everything before it was received, else ask for the gap */
+            if (tcb->rcv_nxt != seg_seq + pay_len) {
+                _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt, NULL, 0);
+                _pkt_send(tcb, out_pkt, seq_con, false);
+                return 0;
+            }
             /* Advance rcv_nxt over FIN bit */
             tcb->rcv_nxt = seg_seq + seg_len;
             _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt, NULL, 0);
@@ -729,7 +765,7 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 _transition_to(tcb, FSM_STATE_CLOSE_WAIT);
             }
             else if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                if (tcb->pkt_retransmit == NULL) {
+                if (tcb->rtx_len == 0) {
                     _transition_to(tcb, FSM_STATE_TIME_WAIT);
                 }
                 else {
@@ -771,9 +807,18 @@ static int _fsm_timeout_timewait(gnrc_tcp_tcb_t *tcb)
 static int _fsm_timeout_retransmit(gnrc_tcp_tcb_t *tcb)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit()\n");
-    if (tcb->pkt_retransmit != NULL) {
-        _pkt_setup_retransmit(tcb, tcb->pkt_retransmit, true);
-        _pkt_send(tcb, tcb->pkt_retransmit, 0, true);
+
+    /* Drop connection requests to a listening queue, that are not completed */
+    if (tcb->queue != NULL && tcb->state == FSM_STATE_SYN_RCVD &&
+        tcb->retries >= GNRC_TCP_SYN_ACK_RETRIES) {
+        DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit() : SYN+ACK not acknowledged\n");
+        _clear_retransmit(tcb);
+        return _transition_to(tcb, FSM_STATE_LISTEN);
+    }
+    if (tcb->rtx_len > 0) {
+        _cc_timeout(tcb);
+        _pkt_setup_retransmit(tcb, tcb->rtx_queue[0], true);
+        _pkt_send(tcb, tcb->rtx_queue[0], 0, true);
     }
     else {
         DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit() : Retransmit queue is empty\n");
@@ -896,12 +941,25 @@ int _fsm(gnrc_tcp_tcb_t *tcb, fsm_event_t event, gnrc_pktsnip_t *in_pkt, void *b
     tcb->status &= ~STATUS_NOTIFY_USER;
     int32_t result = _fsm_unprotected(tcb, event, in_pkt, buf, len);
 
+    /* Put closed connections of a listening queue back to LISTEN, unless they were accepted */
+    if (tcb->queue != NULL && tcb->state == FSM_STATE_CLOSED &&
+        !(tcb->status & STATUS_ACCEPTED) && event != FSM_EVENT_CALL_OPEN) {
+        _fsm_call_open(tcb);
+    }
+
     /* Notify blocked thread if something interesting happend */
     if ((tcb->status & STATUS_NOTIFY_USER) && (tcb->status & STATUS_WAIT_FOR_MSG)) {
         msg_t msg;
         msg.type = MSG_TYPE_NOTIFY_USER;
         mbox_try_put(&(tcb->mbox), &msg);
     }
+    /* Notify thread waiting for connections to accept */
+    if ((tcb->status & STATUS_NOTIFY_USER) && tcb->queue != NULL &&
+        !(tcb->status & STATUS_ACCEPTED)) {
+        msg_t msg;
+        msg.type = MSG_TYPE_NOTIFY_USER;
+        mbox_try_put(&(tcb->queue->mbox), &msg);
+    }
     /* Unlock FSM */
     mutex_unlock(&(tcb->fsm_lock));
     return result;
@@ -16,8 +16,10 @@
  * @author      Simon Brummer <simon.brummer@posteo.de>
  * @}
  */
+#include <string.h>
 #include "internal/common.h"
 #include "internal/option.h"
+#include "internal/pkt.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -25,7 +27,15 @@
 int _option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
 {
     /* Extract offset value. Return if no options are set */
-    uint8_t offset = GET_OFFSET(byteorder_ntohs(hdr->off_ctl));
+    uint16_t ctl = byteorder_ntohs(hdr->off_ctl);
+    uint8_t offset = GET_OFFSET(ctl);
+
+#ifdef MODULE_GNRC_TCP_SACK
+    /* SACK is permitted only, if the peers SYN says so */
+    if (ctl & MSK_SYN) {
+        tcb->status &= ~STATUS_SACK_PERMITTED;
+    }
+#endif
     if (offset <= TCP_HDR_OFFSET_MIN) {
         return 0;
     }
@@ -60,6 +70,41 @@ int _option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
                       tcb->mss);
                 break;
 
+            case TCP_OPTION_KIND_SACK_PERM:
+                if (option->length != TCP_OPTION_LENGTH_SACK_PERM) {
+                    DEBUG("gnrc_tcp_option.c : _option_parse() : invalid SACK permitted Option length.\n");
+                    return -1;
+                }
+#ifdef MODULE_GNRC_TCP_SACK
+                if (ctl & MSK_SYN) {
+                    tcb->status |= STATUS_SACK_PERMITTED;
+                }
+#endif
+                DEBUG("gnrc_tcp_option.c : _option_parse() : SACK permitted option found\n");
+                break;
+
+            case TCP_OPTION_KIND_SACK:
+                if (option->length > opt_left || option->length < 2 ||
+                    (option->length - 2) % TCP_OPTION_LENGTH_SACK_BLOCK != 0) {
+                    DEBUG("gnrc_tcp_option.c : _option_parse() : invalid SACK Option length.\n");
+                    return -1;
+                }
+#ifdef MODULE_GNRC_TCP_SACK
+                /* Mark the segments the peer received already, so they are not retransmitted */
+                if (ctl & MSK_ACK) {
+                    for (uint8_t i = 0; i < option->length - 2; i += TCP_OPTION_LENGTH_SACK_BLOCK) {
+                        network_uint32_t left;
+                        network_uint32_t right;
+
+                        memcpy(&left, option->value + i, sizeof(left));
+                        memcpy(&right, option->value + i + sizeof(left), sizeof(right));
+                        _pkt_sack(tcb, byteorder_ntohl(left), byteorder_ntohl(right));
+                    }
+                }
+#endif
+                DEBUG("gnrc_tcp_option.c : _option_parse() : SACK option found\n");
+                break;
+
             default:
                 DEBUG("gnrc_tcp_option.c : _option_parse() : Unknown option found.\
                       KIND=%"PRIu8", LENGTH=%"PRIu8"\n", option->kind, option->length);
@@ -75,3 +120,34 @@ int _option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
     }
     return 0;
 }
+
+#ifdef MODULE_GNRC_TCP_SACK
+#if GNRC_TCP_SACK_BLOCKS > 4
+#error "GNRC_TCP_SACK_BLOCKS must not exceed 4, more blocks do not fit into the TCP header"
+#endif
+
+uint8_t _option_sack_words(const gnrc_tcp_tcb_t *tcb)
+{
+    if (!(tcb->status & STATUS_SACK_PERMITTED) || tcb->ooo_len == 0) {
+        return 0;
+    }
+    return 1 + (tcb->ooo_len * TCP_OPTION_LENGTH_SACK_BLOCK) / sizeof(network_uint32_t);
+}
+
+void _option_build_sack(const gnrc_tcp_tcb_t *tcb, uint8_t *opt_ptr)
+{
+    *opt_ptr++ = TCP_OPTION_KIND_NOP;
+    *opt_ptr++ = TCP_OPTION_KIND_NOP;
+    *opt_ptr++ = TCP_OPTION_KIND_SACK;
+    *opt_ptr++ = 2 + tcb->ooo_len * TCP_OPTION_LENGTH_SACK_BLOCK;
+
+    for (uint8_t i = 0; i < tcb->ooo_len; i++) {
+        network_uint32_t left = byteorder_htonl(tcb->ooo[i].left);
+        network_uint32_t right = byteorder_htonl(tcb->ooo[i].right);
+
+        memcpy(opt_ptr, &left, sizeof(left));
+        memcpy(opt_ptr + sizeof(left), &right, sizeof(right));
+        opt_ptr += TCP_OPTION_LENGTH_SACK_BLOCK;
+    }
+}
+#endif /* MODULE_GNRC_TCP_SACK */
@@ -20,6 +20,7 @@
 #include <utlist.h>
 #include <errno.h>
 #include "byteorder.h"
+#include "kernel_defines.h"
 #include "net/inet_csum.h"
 #include "net/gnrc.h"
 #include "internal/common.h"
@@ -33,6 +34,10 @@
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+#if defined(MODULE_GNRC_TCP_SACK) && (GNRC_TCP_RETRANSMIT_QUEUE_SIZE >= 16)
+#error "gnrc_tcp_sack supports a GNRC_TCP_RETRANSMIT_QUEUE_SIZE of up to 15"
+#endif
+
 /**
  * @brief Calculates the maximum of two unsigned numbers.
  *
@@ -171,12 +176,26 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
     /* Add MSS option if SYN is sent */
     if (ctl & MSK_SYN) {
         offset += 1;
+#ifdef MODULE_GNRC_TCP_SACK
+        /* Add SACK permitted option, to a SYN+ACK only if the peer sent it */
+        if (!(ctl & MSK_ACK) || (tcb->status & STATUS_SACK_PERMITTED)) {
+            offset += 1;
+        }
+#endif
     }
+#ifdef MODULE_GNRC_TCP_SACK
+    /* Add SACK option to pure ACKs. Packets that are retransmitted would carry stale blocks */
+    uint8_t sack_words = 0;
+    if (ctl == MSK_ACK && payload_len == 0) {
+        sack_words = _option_sack_words(tcb);
+        offset += sack_words;
+    }
+#endif
     /* Set offset and control bit accordingly */
     tcp_hdr.off_ctl = byteorder_htons(_option_build_offset_control(offset, ctl));
 
     /* Allocate TCP header: size = offset * 4 bytes */
-    tcp_snp = gnrc_pktbuf_add(pay_snp, &tcp_hdr, offset * 4, GNRC_NETTYPE_TCP);
+    tcp_snp = gnrc_pktbuf_add(pay_snp, NULL, offset * 4, GNRC_NETTYPE_TCP);
     if (tcp_snp == NULL) {
         DEBUG("gnrc_tcp_pkt.c : _pkt_build() : Can't allocate buffer for TCP Header\n.");
         gnrc_pktbuf_release(pay_snp);
@@ -184,6 +203,9 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
         return -ENOMEM;
     }
     else {
+        /* The options follow the fixed header, tcp_hdr does not hold them */
+        memcpy(tcp_snp->data, &tcp_hdr, sizeof(tcp_hdr));
+
         /* Add options if existing */
         if (TCP_HDR_OFFSET_MIN < offset) {
             uint8_t *opt_ptr = (uint8_t *) tcp_snp->data + sizeof(tcp_hdr);
@@ -196,7 +218,23 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
             if (ctl & MSK_SYN) {
                 network_uint32_t mss_option = byteorder_htonl(_option_build_mss(GNRC_TCP_MSS));
                 memcpy(opt_ptr, &mss_option, sizeof(mss_option));
+                opt_ptr += sizeof(mss_option);
+                opt_left -= sizeof(mss_option);
             }
+#ifdef MODULE_GNRC_TCP_SACK
+            /* If the SYN has room left, it is for the SACK permitted option */
+            if ((ctl & MSK_SYN) && opt_left > 0) {
+                network_uint32_t sack_perm = byteorder_htonl(_option_build_sack_perm());
+                memcpy(opt_ptr, &sack_perm, sizeof(sack_perm));
+                opt_ptr += sizeof(sack_perm);
+                opt_left -= sizeof(sack_perm);
+            }
+            if (sack_words > 0) {
+                _option_build_sack(tcb, opt_ptr);
+                opt_ptr += sack_words * sizeof(network_uint32_t);
+                opt_left -= sack_words * sizeof(network_uint32_t);
+            }
+#endif
             /* Increase opt_ptr and decrease opt_left, if other options are added */
             /* NOTE: Add additional options here */
         }
@@ -262,12 +300,20 @@ int _pkt_send(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *out_pkt, const uint16_t seq_c
 
     /* If this is no retransmission, advance sequence number and measure time */
     if (!retransmit) {
-        tcb->retries = 0;
         tcb->snd_nxt += seq_con;
-        tcb->rtt_start = xtimer_now().ticks32;
+
+        /* Time one segment at a time, segments without sequence space are not acknowledged */
+        if (seq_con > 0 && !(tcb->status & STATUS_RTT_SAMPLE)) {
+            tcb->status |= STATUS_RTT_SAMPLE;
+            tcb->rtt_seq = tcb->snd_nxt;
+            tcb->rtt_start = xtimer_now().ticks32;
+        }
     }
     else {
         tcb->retries += 1;
+
+        /* The ACK can not tell, which transmission it acknowledges (Karns Algorithm) */
+        tcb->status &= ~STATUS_RTT_SAMPLE;
     }
 
     /* Pass packet down the network stack */
@@ -342,6 +388,44 @@ uint32_t _pkt_get_pay_len(gnrc_pktsnip_t *pkt)
     return seg_len;
 }
 
+/**
+ * @brief Calculates the RTO from the current round trip time estimation.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _update_rto(gnrc_tcp_tcb_t *tcb)
+{
+    /* Without a measurement rto is 1 sec (Lower Bound) */
+    if (tcb->srtt == RTO_UNINITIALIZED || tcb->rtt_var == RTO_UNINITIALIZED) {
+        tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
+    }
+    else {
+        tcb->rto = tcb->srtt + _max(GNRC_TCP_RTO_GRANULARITY,  GNRC_TCP_RTO_K * tcb->rtt_var);
+    }
+}
+
+/**
+ * @brief Restarts the retransmission timer with the current RTO.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _restart_retransmit_timer(gnrc_tcp_tcb_t *tcb)
+{
+    /* Perform boundry checks on current RTO before usage */
+    if (tcb->rto < (int32_t) GNRC_TCP_RTO_LOWER_BOUND) {
+        tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
+    }
+    else if (tcb->rto > (int32_t) GNRC_TCP_RTO_UPPER_BOUND) {
+        tcb->rto = GNRC_TCP_RTO_UPPER_BOUND;
+    }
+
+    /* Setup retransmission timer, msg to TCP thread with ptr to TCB */
+    xtimer_remove(&(tcb->tim_tout));
+    tcb->msg_tout.type = MSG_TYPE_RETRANSMISSION;
+    tcb->msg_tout.content.ptr = (void *) tcb;
+    xtimer_set_msg(&tcb->tim_tout, tcb->rto, &tcb->msg_tout, gnrc_tcp_pid);
+}
+
 int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool retransmit)
 {
     gnrc_pktsnip_t *snp = NULL;
@@ -354,10 +438,27 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
         return -EINVAL;
     }
 
-    /* Check if retransmit queue is full and pkt is not already in retransmit queue */
-    if (tcb->pkt_retransmit != NULL && tcb->pkt_retransmit != pkt) {
-        DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : Nothing to do\n");
-        return -ENOMEM;
+    /* A retransmission is always the oldest unacknowledged packet */
+    if (retransmit) {
+        if (tcb->rtx_len == 0 || tcb->rtx_queue[0] != pkt) {
+            DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : pkt is not queued\n");
+            return -EINVAL;
+        }
+
+        /* Increase users: every send attempt consumes a user */
+        gnrc_pktbuf_hold(pkt, 1);
+
+        /* Double the rto (Timer Backoff) */
+        tcb->rto *= 2;
+
+        /* If the transmission has been tried five times, we assume srtt and rtt_var are bogus */
+        /* New measurements must be taken the next time something is sent. */
+        if (tcb->retries >= 5) {
+            tcb->srtt = RTO_UNINITIALIZED;
+            tcb->rtt_var = RTO_UNINITIALIZED;
+        }
+        _restart_retransmit_timer(tcb);
+        return 0;
     }
 
     /* Extract control bits and segment length */
@@ -370,76 +471,98 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
         return 0;
     }
 
-    /* Assign pkt and increase users: every send attempt consumes a user */
-    tcb->pkt_retransmit = pkt;
+    /* Check if retransmit queue is full */
+    if (tcb->rtx_len >= ARRAY_SIZE(tcb->rtx_queue)) {
+        DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : Retransmit queue is full\n");
+        return -ENOMEM;
+    }
+
+    /* Append pkt and increase users: every send attempt consumes a user */
+    tcb->rtx_queue[tcb->rtx_len++] = pkt;
     gnrc_pktbuf_hold(pkt, 1);
 
-    /* RTO adjustment */
-    if (!retransmit) {
-        /* If this is the first transmission: rto is 1 sec (Lower Bound) */
-        if (tcb->srtt == RTO_UNINITIALIZED || tcb->rtt_var == RTO_UNINITIALIZED) {
-            tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
-        }
-        else {
-            tcb->rto = tcb->srtt + _max(GNRC_TCP_RTO_GRANULARITY,  GNRC_TCP_RTO_K * tcb->rtt_var);
-        }
+    /* The timer runs for the oldest packet only, start it if this is the oldest */
+    if (tcb->rtx_len == 1) {
+        _update_rto(tcb);
+        _restart_retransmit_timer(tcb);
     }
-    else {
-        /* If this is a retransmission: Double the rto (Timer Backoff) */
-        tcb->rto *= 2;
+    return 0;
+}
 
-        /* If the transmission has been tried five times, we assume srtt and rtt_var are bogus */
-        /* New measurements must be taken the next time something is sent. */
-        if (tcb->retries >= 5) {
-            tcb->srtt = RTO_UNINITIALIZED;
-            tcb->rtt_var = RTO_UNINITIALIZED;
-        }
+int _pkt_retransmit(gnrc_tcp_tcb_t *tcb)
+{
+    uint8_t i = 0;
+
+    if (tcb->rtx_len == 0) {
+        DEBUG("gnrc_tcp_pkt.c : _pkt_retransmit() : Retransmit queue is empty\n");
+        return -ENODATA;
     }
 
-    /* Perform boundry checks on current RTO before usage */
-    if (tcb->rto < (int32_t) GNRC_TCP_RTO_LOWER_BOUND) {
-        tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
+#ifdef MODULE_GNRC_TCP_SACK
+    /* Find the oldest packet, that is neither acknowledged selectively nor retransmitted yet */
+    while (i < tcb->rtx_len && (((tcb->rtx_sacked | tcb->rtx_resent) >> i) & 1)) {
+        i++;
     }
-    else if (tcb->rto > (int32_t) GNRC_TCP_RTO_UPPER_BOUND) {
-        tcb->rto = GNRC_TCP_RTO_UPPER_BOUND;
+    /* Beyond the oldest one, only packets below a selectively acknowledged one are lost */
+    if (i >= tcb->rtx_len || (i > 0 && (tcb->rtx_sacked >> i) == 0)) {
+        return -ENODATA;
     }
+    tcb->rtx_resent |= (1U << i);
+#endif
 
-    /* Setup retransmission timer, msg to TCP thread with ptr to TCB */
-    tcb->msg_tout.type = MSG_TYPE_RETRANSMISSION;
-    tcb->msg_tout.content.ptr = (void *) tcb;
-    xtimer_set_msg(&tcb->tim_tout, tcb->rto, &tcb->msg_tout, gnrc_tcp_pid);
-    return 0;
+    /* Increase users: every send attempt consumes a user */
+    gnrc_pktbuf_hold(tcb->rtx_queue[i], 1);
+    return _pkt_send(tcb, tcb->rtx_queue[i], 0, true);
 }
 
 int _pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack)
 {
-    uint32_t seg = 0;
-    gnrc_pktsnip_t *snp = NULL;
-    tcp_hdr_t *hdr;
+    uint8_t acked = 0;
 
     /* Retransmission queue is empty. Nothing to ACK there */
-    if (tcb->pkt_retransmit == NULL) {
+    if (tcb->rtx_len == 0) {
         DEBUG("gnrc_tcp_pkt.c : _pkt_acknowledge() : There is no packet to ack\n");
         return -ENODATA;
     }
 
-    LL_SEARCH_SCALAR(tcb->pkt_retransmit, snp, type, GNRC_NETTYPE_TCP);
-    hdr = (tcp_hdr_t *) snp->data;
+    /* Release every packet, whose last sequence number is acknowledged */
+    while (acked < tcb->rtx_len) {
+        gnrc_pktsnip_t *pkt = tcb->rtx_queue[acked];
+        gnrc_pktsnip_t *snp = NULL;
 
-    /* There must be a packet, waiting to be acknowledged. */
-    seg = byteorder_ntohl(hdr->seq_num) + _pkt_get_seg_len(tcb->pkt_retransmit) - 1;
-
-    /* If segment can be acknowledged -> stop timer, release packet from pktbuf and update rto. */
-    if (LSS_32_BIT(seg, ack)) {
-        xtimer_remove(&(tcb->tim_tout));
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
-        tcb->pkt_retransmit = NULL;
+        LL_SEARCH_SCALAR(pkt, snp, type, GNRC_NETTYPE_TCP);
+        uint32_t seg = byteorder_ntohl(((tcp_hdr_t *) snp->data)->seq_num) +
+                       _pkt_get_seg_len(pkt) - 1;
+        if (!LSS_32_BIT(seg, ack)) {
+            break;
+        }
+        gnrc_pktbuf_release(pkt);
+        acked++;
+    }
+    if (acked == 0) {
+        return 0;
+    }
+#ifdef MODULE_GNRC_TCP_SACK
+    /* Count packets, the peer received although packets before them were lost */
+    for (uint8_t i = 0; i < acked; i++) {
+        if (((tcb->rtx_sacked & ~tcb->rtx_resent) >> i) & 1) {
+            tcb->rtx_avoided++;
+        }
+    }
+    tcb->rtx_sacked >>= acked;
+    tcb->rtx_resent >>= acked;
+#endif
+    tcb->rtx_len -= acked;
+    memmove(tcb->rtx_queue, tcb->rtx_queue + acked, tcb->rtx_len * sizeof(tcb->rtx_queue[0]));
 
-        /* Measure round trip time */
+    /* Measure round trip time, if the timed segment was acknowledged */
+    if ((tcb->status & STATUS_RTT_SAMPLE) && LEQ_32_BIT(tcb->rtt_seq, ack)) {
         int32_t rtt = xtimer_now().ticks32 - tcb->rtt_start;
 
-        /* Use time only if ther was no timer overflow and no retransmission (Karns Alogrithm) */
-        if (tcb->retries == 0 && rtt > 0) {
+        tcb->status &= ~STATUS_RTT_SAMPLE;
+
+        /* Use time only if ther was no timer overflow */
+        if (rtt > 0) {
             /* If this is the first sample taken */
             if (tcb->srtt == RTO_UNINITIALIZED && tcb->rtt_var == RTO_UNINITIALIZED) {
                 tcb->srtt = rtt;
@@ -454,6 +577,16 @@ int _pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack)
             }
         }
     }
+
+    /* New data was acknowledged: restart the timer for the remaining packets (RFC 6298 5.3) */
+    tcb->retries = 0;
+    if (tcb->rtx_len == 0) {
+        xtimer_remove(&(tcb->tim_tout));
+    }
+    else {
+        _update_rto(tcb);
+        _restart_retransmit_timer(tcb);
+    }
     return 0;
 }
 
@@ -493,3 +626,18 @@ uint16_t _pkt_calc_csum(const gnrc_pktsnip_t *hdr, const gnrc_pktsnip_t *pseudo_
     }
     return ~csum;
 }
+
+#ifdef MODULE_GNRC_TCP_SACK
+void _pkt_sack(gnrc_tcp_tcb_t *tcb, const uint32_t left, const uint32_t right)
+{
+    for (uint8_t i = 0; i < tcb->rtx_len; i++) {
+        gnrc_pktsnip_t *snp = NULL;
+
+        LL_SEARCH_SCALAR(tcb->rtx_queue[i], snp, type, GNRC_NETTYPE_TCP);
+        uint32_t seq = byteorder_ntohl(((tcp_hdr_t *) snp->data)->seq_num);
+        if (LEQ_32_BIT(left, seq) && LEQ_32_BIT(seq + _pkt_get_seg_len(tcb->rtx_queue[i]), right)) {
+            tcb->rtx_sacked |= (1U << i);
+        }
+    }
+}
+#endif
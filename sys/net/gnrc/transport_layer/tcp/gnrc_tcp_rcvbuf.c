@@ -16,6 +16,8 @@
  * @author      Simon Brummer <simon.brummer@posteo.de>
  */
 #include <errno.h>
+#include <string.h>
+#include "internal/common.h"
 #include "internal/rcvbuf.h"
 
 #define ENABLE_DEBUG (0)
@@ -87,6 +89,10 @@ int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb)
         }
         else {
             ringbuffer_init(&tcb->rcv_buf, (char *) tcb->rcv_buf_raw, GNRC_TCP_RCV_BUF_SIZE);
+#ifdef MODULE_GNRC_TCP_SACK
+            tcb->ooo_len = 0;
+            tcb->ooo_bytes = 0;
+#endif
         }
     }
     return 0;
@@ -99,3 +105,119 @@ void _rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb)
         tcb->rcv_buf_raw = NULL;
     }
 }
+
+#ifdef MODULE_GNRC_TCP_SACK
+/**
+ * @brief Copies payload into the free part of the receive buffer.
+ *
+ * @param[in,out] tcb      TCB holding the receive buffer.
+ * @param[in]     offset   Offset behind the data available for reading.
+ * @param[in]     snp      First payload snip.
+ * @param[in]     len      Number of bytes to copy.
+ */
+static void _rcvbuf_write_at(gnrc_tcp_tcb_t *tcb, uint32_t offset, const gnrc_pktsnip_t *snp,
+                             uint32_t len)
+{
+    ringbuffer_t *rb = &(tcb->rcv_buf);
+    unsigned pos = (rb->start + rb->avail + offset) % rb->size;
+
+    while (snp && snp->type == GNRC_NETTYPE_UNDEF && len > 0) {
+        const uint8_t *data = snp->data;
+        uint32_t left = (snp->size < len) ? snp->size : len;
+
+        len -= left;
+        while (left > 0) {
+            uint32_t chunk = rb->size - pos;
+
+            if (chunk > left) {
+                chunk = left;
+            }
+            memcpy(rb->buf + pos, data, chunk);
+            pos = (pos + chunk) % rb->size;
+            data += chunk;
+            left -= chunk;
+        }
+        snp = snp->next;
+    }
+}
+
+/**
+ * @brief Removes a range from tcb->ooo and updates tcb->ooo_bytes.
+ *
+ * @param[in,out] tcb   TCB holding the ranges.
+ * @param[in]     i     Index of the range to remove.
+ */
+static void _rcvbuf_ooo_remove(gnrc_tcp_tcb_t *tcb, uint8_t i)
+{
+    tcb->ooo_bytes -= tcb->ooo[i].right - tcb->ooo[i].left;
+    tcb->ooo_len -= 1;
+    memmove(&tcb->ooo[i], &tcb->ooo[i + 1], (tcb->ooo_len - i) * sizeof(tcb->ooo[0]));
+}
+
+int _rcvbuf_ooo_add(gnrc_tcp_tcb_t *tcb, uint32_t seq, const gnrc_pktsnip_t *snp,
+                    uint32_t pay_len)
+{
+    uint32_t offset = seq - tcb->rcv_nxt;
+    uint32_t left = seq;
+    uint32_t right = 0;
+    uint8_t overlaps = 0;
+
+    /* Keep only what fits into the receive window, the buffer has room for it */
+    if (offset >= tcb->rcv_wnd) {
+        return -ENOSPC;
+    }
+    if (pay_len > tcb->rcv_wnd - offset) {
+        pay_len = tcb->rcv_wnd - offset;
+    }
+    right = seq + pay_len;
+
+    /* Drop the payload, if it would start one range too many */
+    for (uint8_t i = 0; i < tcb->ooo_len; i++) {
+        if (LEQ_32_BIT(tcb->ooo[i].left, right) && LEQ_32_BIT(left, tcb->ooo[i].right)) {
+            overlaps++;
+        }
+    }
+    if (overlaps == 0 && tcb->ooo_len >= GNRC_TCP_SACK_BLOCKS) {
+        DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_ooo_add() : Too many out-of-order ranges\n");
+        return -ENOMEM;
+    }
+    _rcvbuf_write_at(tcb, offset, snp, pay_len);
+
+    /* Join all ranges the payload overlaps or adjoins */
+    for (uint8_t i = 0; i < tcb->ooo_len;) {
+        if (LEQ_32_BIT(tcb->ooo[i].left, right) && LEQ_32_BIT(left, tcb->ooo[i].right)) {
+            left = LSS_32_BIT(tcb->ooo[i].left, left) ? tcb->ooo[i].left : left;
+            right = LSS_32_BIT(right, tcb->ooo[i].right) ? tcb->ooo[i].right : right;
+            _rcvbuf_ooo_remove(tcb, i);
+        }
+        else {
+            i++;
+        }
+    }
+
+    /* The range changed last is reported first (RFC 2018, 4) */
+    memmove(&tcb->ooo[1], &tcb->ooo[0], tcb->ooo_len * sizeof(tcb->ooo[0]));
+    tcb->ooo[0].left = left;
+    tcb->ooo[0].right = right;
+    tcb->ooo_len += 1;
+    tcb->ooo_bytes += right - left;
+    return 0;
+}
+
+void _rcvbuf_ooo_merge(gnrc_tcp_tcb_t *tcb)
+{
+    /* Ranges neither overlap nor adjoin, so at most one continues at rcv_nxt */
+    for (uint8_t i = 0; i < tcb->ooo_len;) {
+        if (LSS_32_BIT(tcb->rcv_nxt, tcb->ooo[i].left)) {
+            i++;
+            continue;
+        }
+        /* The data is in place already, just make it available for reading */
+        if (LSS_32_BIT(tcb->rcv_nxt, tcb->ooo[i].right)) {
+            tcb->rcv_buf.avail += tcb->ooo[i].right - tcb->rcv_nxt;
+            tcb->rcv_nxt = tcb->ooo[i].right;
+        }
+        _rcvbuf_ooo_remove(tcb, i);
+    }
+}
+#endif /* MODULE_GNRC_TCP_SACK */
@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc
+ * @{
+ *
+ * @file
+ * @brief       Implementation of internal/tcb_table.h
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ * @}
+ */
+#include <string.h>
+#include <utlist.h>
+
+#include "net/af.h"
+#include "internal/common.h"
+#include "internal/fsm.h"
+#include "internal/tcb_table.h"
+
+#ifdef MODULE_GNRC_IPV6
+#include "net/gnrc/ipv6.h"
+#endif
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#if (GNRC_TCP_TCB_TABLE_SIZE & (GNRC_TCP_TCB_TABLE_SIZE - 1)) != 0
+#error "GNRC_TCP_TCB_TABLE_SIZE must be a power of two"
+#endif
+
+mutex_t _tcb_table_lock;
+
+/**
+ * @brief Buckets of the TCB table, chained by gnrc_tcp_tcb_t::next.
+ */
+static gnrc_tcp_tcb_t *_table[GNRC_TCP_TCB_TABLE_SIZE];
+
+/**
+ * @brief Head of the list of listening queues.
+ */
+static gnrc_tcp_tcb_queue_t *_queue_head;
+
+/**
+ * @brief Calculates the bucket of a TCB.
+ *
+ * @param[in] local_port   Local port number.
+ * @param[in] peer_port    Peer port number, PORT_UNSPEC for TCBs in LISTEN.
+ * @param[in] peer_addr    Peer network layer address, ignored if @p peer_port
+ *                         is PORT_UNSPEC.
+ *
+ * @returns   Index of the bucket.
+ */
+static unsigned _hash(uint16_t local_port, uint16_t peer_port, const uint8_t *peer_addr)
+{
+    uint32_t hash = ((uint32_t)peer_port << 16) | local_port;
+
+#ifdef MODULE_GNRC_IPV6
+    /* Byte-wise, the addresses in a TCB are not aligned */
+    if (peer_port != PORT_UNSPEC) {
+        for (unsigned i = 0; i < sizeof(ipv6_addr_t); i++) {
+            hash = (hash * 33) ^ peer_addr[i];
+        }
+    }
+#else
+    (void) peer_addr;
+#endif
+    hash ^= hash >> 16;
+    hash ^= hash >> 8;
+    return hash & (GNRC_TCP_TCB_TABLE_SIZE - 1);
+}
+
+static inline unsigned _tcb_hash(const gnrc_tcp_tcb_t *tcb)
+{
+#ifdef MODULE_GNRC_IPV6
+    return _hash(tcb->local_port, tcb->peer_port, tcb->peer_addr);
+#else
+    return _hash(tcb->local_port, tcb->peer_port, NULL);
+#endif
+}
+
+void _tcb_table_init(void)
+{
+    mutex_init(&_tcb_table_lock);
+    memset(_table, 0, sizeof(_table));
+    _queue_head = NULL;
+}
+
+void _tcb_table_add(gnrc_tcp_tcb_t *tcb)
+{
+    LL_PREPEND(_table[_tcb_hash(tcb)], tcb);
+}
+
+void _tcb_table_remove(gnrc_tcp_tcb_t *tcb)
+{
+    gnrc_tcp_tcb_t **head = &_table[_tcb_hash(tcb)];
+    gnrc_tcp_tcb_t *iter = NULL;
+
+    LL_FOREACH(*head, iter) {
+        if (iter == tcb) {
+            LL_DELETE(*head, tcb);
+            tcb->next = NULL;
+            return;
+        }
+    }
+}
+
+gnrc_tcp_tcb_t *_tcb_table_find(uint16_t local_port, uint16_t peer_port,
+                                const uint8_t *peer_addr)
+{
+    gnrc_tcp_tcb_t *iter = NULL;
+
+    LL_FOREACH(_table[_hash(local_port, peer_port, peer_addr)], iter) {
+        if (iter->local_port != local_port || iter->peer_port != peer_port) {
+            continue;
+        }
+#ifdef MODULE_GNRC_IPV6
+        if (iter->address_family == AF_INET6 &&
+            memcmp(iter->peer_addr, peer_addr, sizeof(ipv6_addr_t)) == 0) {
+            return iter;
+        }
+#endif
+    }
+    return NULL;
+}
+
+gnrc_tcp_tcb_t *_tcb_table_find_listener(uint16_t local_port, const uint8_t *local_addr)
+{
+    gnrc_tcp_tcb_t *iter = NULL;
+
+    LL_FOREACH(_table[_hash(local_port, PORT_UNSPEC, NULL)], iter) {
+        if (iter->state != FSM_STATE_LISTEN || iter->local_port != local_port) {
+            continue;
+        }
+#ifdef MODULE_GNRC_IPV6
+        /* Local address must be unspecified or match the destination */
+        if (iter->address_family == AF_INET6 &&
+            (ipv6_addr_is_unspecified((ipv6_addr_t *) iter->local_addr) ||
+             memcmp(iter->local_addr, local_addr, sizeof(ipv6_addr_t)) == 0)) {
+            return iter;
+        }
+#else
+        (void) local_addr;
+#endif
+    }
+    return NULL;
+}
+
+int _tcb_table_port_in_use(uint16_t port_number)
+{
+    for (unsigned i = 0; i < GNRC_TCP_TCB_TABLE_SIZE; i++) {
+        gnrc_tcp_tcb_t *iter = NULL;
+
+        LL_SEARCH_SCALAR(_table[i], iter, local_port, port_number);
+        if (iter != NULL) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void _tcb_table_add_queue(gnrc_tcp_tcb_queue_t *queue)
+{
+    LL_PREPEND(_queue_head, queue);
+}
+
+void _tcb_table_remove_queue(gnrc_tcp_tcb_queue_t *queue)
+{
+    gnrc_tcp_tcb_queue_t *iter = NULL;
+
+    LL_FOREACH(_queue_head, iter) {
+        if (iter == queue) {
+            LL_DELETE(_queue_head, queue);
+            return;
+        }
+    }
+}
+
+int _tcb_table_port_has_queue(uint16_t port_number)
+{
+    gnrc_tcp_tcb_queue_t *iter = NULL;
+
+    LL_SEARCH_SCALAR(_queue_head, iter, local_port, port_number);
+    return (iter != NULL);
+}
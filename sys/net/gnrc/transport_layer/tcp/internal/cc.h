@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_tcp
+ *
+ * @{
+ *
+ * @file
+ * @brief       Congestion control of the sliding window send path.
+ *
+ * Implements slow start and congestion avoidance (RFC 5681) as well as fast
+ * retransmit and NewReno fast recovery (RFC 6582). Without the module
+ * `gnrc_tcp_sliding_window` only one segment is in flight at a time, so
+ * there is no congestion control and all functions do nothing.
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ */
+
+#ifndef CC_H
+#define CC_H
+
+#include <stdint.h>
+#include "net/gnrc/tcp/tcb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(MODULE_GNRC_TCP_SLIDING_WINDOW) || defined(DOXYGEN)
+/**
+ * @brief Initializes congestion control for an established connection.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _cc_init(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Gets the congestion window.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   Number of bytes, that may be in flight.
+ */
+static inline uint32_t _cc_wnd(const gnrc_tcp_tcb_t *tcb)
+{
+    return tcb->cwnd;
+}
+
+/**
+ * @brief Processes an ACK that acknowledged new data.
+ *
+ * @pre tcb->snd_una is already advanced.
+ *
+ * @param[in,out] tcb     TCB holding the connection information.
+ * @param[in]     acked   Number of newly acknowledged bytes.
+ */
+void _cc_ack(gnrc_tcp_tcb_t *tcb, uint32_t acked);
+
+/**
+ * @brief Processes a duplicate ACK.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _cc_dupack(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Processes an expired retransmission timer.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _cc_timeout(gnrc_tcp_tcb_t *tcb);
+#else
+static inline void _cc_init(gnrc_tcp_tcb_t *tcb)
+{
+    (void)tcb;
+}
+
+static inline uint32_t _cc_wnd(const gnrc_tcp_tcb_t *tcb)
+{
+    (void)tcb;
+    return UINT32_MAX;
+}
+
+static inline void _cc_ack(gnrc_tcp_tcb_t *tcb, uint32_t acked)
+{
+    (void)tcb;
+    (void)acked;
+}
+
+static inline void _cc_dupack(gnrc_tcp_tcb_t *tcb)
+{
+    (void)tcb;
+}
+
+static inline void _cc_timeout(gnrc_tcp_tcb_t *tcb)
+{
+    (void)tcb;
+}
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CC_H */
+/** @} */
@@ -47,6 +47,9 @@ extern "C" {
 #define STATUS_ALLOW_ANY_ADDR (1 << 1)
 #define STATUS_NOTIFY_USER    (1 << 2)
 #define STATUS_WAIT_FOR_MSG   (1 << 3)
+#define STATUS_RTT_SAMPLE     (1 << 4)
+#define STATUS_ACCEPTED       (1 << 5)
+#define STATUS_SACK_PERMITTED (1 << 6)
 /** @} */
 
 /**
@@ -120,16 +123,6 @@ extern "C" {
  */
 extern kernel_pid_t gnrc_tcp_pid;
 
-/**
- * @brief Head of linked TCB list.
- */
-extern gnrc_tcp_tcb_t *_list_tcb_head;
-
-/**
- * @brief Mutex to protect TCB list.
- */
-extern mutex_t _list_tcb_lock;
-
 #ifdef __cplusplus
 }
 #endif
@@ -42,6 +42,19 @@ static inline uint32_t _option_build_mss(uint16_t mss)
             ((uint32_t) TCP_OPTION_LENGTH_MSS << 16) | mss);
 }
 
+/**
+ * @brief Helper function to build the SACK permitted option, preceded by two
+ *        NOP options for alignment.
+ *
+ * @returns   SACK permitted option value.
+ */
+static inline uint32_t _option_build_sack_perm(void)
+{
+    return (((uint32_t) TCP_OPTION_KIND_NOP << 24) |
+            ((uint32_t) TCP_OPTION_KIND_NOP << 16) |
+            ((uint32_t) TCP_OPTION_KIND_SACK_PERM << 8) | TCP_OPTION_LENGTH_SACK_PERM);
+}
+
 /**
  * @brief Helper function to build the combined option and control flag field.
  *
@@ -67,6 +80,27 @@ static inline uint16_t _option_build_offset_control(uint16_t nopts, uint16_t ctl
  */
 int _option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr);
 
+#if defined(MODULE_GNRC_TCP_SACK) || defined(DOXYGEN)
+/**
+ * @brief Gets the size of the SACK option, that reports the out-of-order
+ *        data held by a connection.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   Size of the option in 32-bit words.
+ *            Zero if there is nothing to report or the peer does not permit it.
+ */
+uint8_t _option_sack_words(const gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Builds the SACK option, preceded by two NOP options for alignment.
+ *
+ * @param[in]  tcb       TCB holding the connection information.
+ * @param[out] opt_ptr   Buffer of _option_sack_words() words to write to.
+ */
+void _option_build_sack(const gnrc_tcp_tcb_t *tcb, uint8_t *opt_ptr);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
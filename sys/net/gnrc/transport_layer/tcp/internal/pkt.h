@@ -108,18 +108,39 @@ uint32_t _pkt_get_pay_len(gnrc_pktsnip_t *pkt);
 /**
  * @brief Adds a packet to the retransmission mechanism.
  *
+ * @note A new packet is appended to the retransmission queue. A retransmitted
+ *       packet must be the oldest packet in the queue, its retransmission
+ *       timer is backed off.
+ *
  * @param[in,out] tcb          TCB holding the connection information.
  * @param[in]     pkt          Packet to add to the retransmission mechanism.
  * @param[in]     retransmit   Flag used to indicate that @p pkt is a retransmit.
  *
  * @returns   Zero on success.
  *            -ENOMEM if the retransmission queue is full.
- *            -EINVAL if pkt is null.
+ *            -EINVAL if pkt is null or a retransmitted @p pkt is not the oldest queued packet.
  */
 int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool retransmit);
 
 /**
- * @brief Acknowledges and removes packet from the retransmission mechanism.
+ * @brief Sends the oldest unacknowledged packet again, without touching the
+ *        retransmission timer.
+ *
+ * With the module `gnrc_tcp_sack`, packets the peer acknowledged selectively
+ * and packets retransmitted during the current loss recovery are skipped.
+ * Then a packet other than the oldest one is sent only, if the peer
+ * acknowledged a later packet selectively, so it must be lost (RFC 6675).
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ *
+ * @returns   Zero on success.
+ *            -ENODATA if the retransmission queue is empty or holds no
+ *            packet to retransmit.
+ */
+int _pkt_retransmit(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Acknowledges and removes packets from the retransmission mechanism.
  *
  * @param[in,out] tcb   TCB holding the connection information.
  * @param[in]     ack   Acknowldegment number used to acknowledge packets.
@@ -129,6 +150,18 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
  */
 int _pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack);
 
+#if defined(MODULE_GNRC_TCP_SACK) || defined(DOXYGEN)
+/**
+ * @brief Marks packets in the retransmission queue, that the peer acknowledged
+ *        selectively.
+ *
+ * @param[in,out] tcb     TCB holding the connection information.
+ * @param[in]     left    First sequence number of a SACK block.
+ * @param[in]     right   Sequence number following a SACK block.
+ */
+void _pkt_sack(gnrc_tcp_tcb_t *tcb, const uint32_t left, const uint32_t right);
+#endif
+
 /**
  * @brief Calculates checksum over payload, TCP header and network layer header.
  *
@@ -22,6 +22,7 @@
 
 #include <stdint.h>
 #include "mutex.h"
+#include "net/gnrc/pkt.h"
 #include "net/gnrc/tcp/config.h"
 #include "net/gnrc/tcp/tcb.h"
 
@@ -67,6 +68,37 @@ int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb);
  */
 void _rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb);
 
+#if defined(MODULE_GNRC_TCP_SACK) || defined(DOXYGEN)
+/**
+ * @brief Stores payload received out of order.
+ *
+ * The payload is copied to its final position in the receive buffer, behind
+ * the data available for reading, and its range is recorded in tcb->ooo.
+ * Payload beyond the receive window is cut off.
+ *
+ * @param[in,out] tcb       TCB holding the receive buffer.
+ * @param[in]     seq       Sequence number of the first payload byte,
+ *                          must be after tcb->rcv_nxt.
+ * @param[in]     snp       First payload snip of the received packet.
+ * @param[in]     pay_len   Payload length of the received packet.
+ *
+ * @returns   Zero on success.
+ *            -ENOSPC if the payload is outside of the receive window.
+ *            -ENOMEM if the payload starts another range, but there are
+ *            @ref GNRC_TCP_SACK_BLOCKS already.
+ */
+int _rcvbuf_ooo_add(gnrc_tcp_tcb_t *tcb, uint32_t seq, const gnrc_pktsnip_t *snp,
+                    uint32_t pay_len);
+
+/**
+ * @brief Makes data received out of order available for reading, if it
+ *        follows tcb->rcv_nxt now. Advances tcb->rcv_nxt accordingly.
+ *
+ * @param[in,out] tcb   TCB holding the receive buffer.
+ */
+void _rcvbuf_ooo_merge(gnrc_tcp_tcb_t *tcb);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_tcp
+ *
+ * @{
+ *
+ * @file
+ * @brief       Table of active TCBs.
+ *
+ * Connected TCBs are hashed by their 4-tuple (local port, peer port and peer
+ * address), TCBs in state LISTEN by their local port only. So the TCB of a
+ * received segment is found without walking all active connections.
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ */
+
+#ifndef TCB_TABLE_H
+#define TCB_TABLE_H
+
+#include <stdint.h>
+#include "mutex.h"
+#include "net/gnrc/tcp/config.h"
+#include "net/gnrc/tcp/tcb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Mutex to protect the TCB table and the list of listening queues.
+ */
+extern mutex_t _tcb_table_lock;
+
+/**
+ * @brief Initializes the TCB table.
+ */
+void _tcb_table_init(void);
+
+/**
+ * @brief Adds a TCB to the table.
+ *
+ * The TCB is hashed by its 4-tuple, or by its local port only if the peer
+ * port is unspecified. The key must not change, while the TCB is in the table.
+ *
+ * @note Must be called from a context where the table is locked.
+ *
+ * @param[in,out] tcb   TCB to add.
+ */
+void _tcb_table_add(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Removes a TCB from the table, if it was added.
+ *
+ * @note Must be called from a context where the table is locked.
+ *
+ * @param[in,out] tcb   TCB to remove.
+ */
+void _tcb_table_remove(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Finds the TCB of a connection.
+ *
+ * @note Must be called from a context where the table is locked.
+ *
+ * @param[in] local_port   Local port number of the connection.
+ * @param[in] peer_port    Peer port number of the connection.
+ * @param[in] peer_addr    Peer network layer address of the connection.
+ *
+ * @returns   The TCB of the connection.
+ *            NULL if there is none.
+ */
+gnrc_tcp_tcb_t *_tcb_table_find(uint16_t local_port, uint16_t peer_port,
+                                const uint8_t *peer_addr);
+
+/**
+ * @brief Finds a TCB in state LISTEN.
+ *
+ * @note Must be called from a context where the table is locked.
+ *
+ * @param[in] local_port   Port number the TCB listens on.
+ * @param[in] local_addr   Network layer address the connection request was
+ *                         sent to.
+ *
+ * @returns   A TCB listening for @p local_addr and @p local_port.
+ *            NULL if there is none.
+ */
+gnrc_tcp_tcb_t *_tcb_table_find_listener(uint16_t local_port, const uint8_t *local_addr);
+
+/**
+ * @brief Checks if a given port number is currently used by a TCB as local_port.
+ *
+ * @note Must be called from a context where the table is locked.
+ *
+ * @param[in] port_number   Port number that should be checked.
+ *
+ * @returns   Zero if @p port_number is currently not used.
+ *            1 if @p port_number is used by an active connection.
+ */
+int _tcb_table_port_in_use(uint16_t port_number);
+
+/**
+ * @brief Adds a listening queue.
+ *
+ * @note Must be called from a context where the table is locked.
+ *
+ * @param[in,out] queue   Queue to add.
+ */
+void _tcb_table_add_queue(gnrc_tcp_tcb_queue_t *queue);
+
+/**
+ * @brief Removes a listening queue.
+ *
+ * @note Must be called from a context where the table is locked.
+ *
+ * @param[in,out] queue   Queue to remove.
+ */
+void _tcb_table_remove_queue(gnrc_tcp_tcb_queue_t *queue);
+
+/**
+ * @brief Checks if a listening queue uses a given port number.
+ *
+ * @note Must be called from a context where the table is locked.
+ *
+ * @param[in] port_number   Port number that should be checked.
+ *
+ * @returns   Zero if no listening queue uses @p port_number.
+ *            1 if a listening queue uses @p port_number.
+ */
+int _tcb_table_port_has_queue(uint16_t port_number);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TCB_TABLE_H */
+/** @} */
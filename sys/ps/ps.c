@@ -15,6 +15,7 @@
  * @}
  */
 
+#include <inttypes.h>
 #include <stdio.h>
 
 #include "thread.h"
@@ -22,6 +23,14 @@
 #include "thread.h"
 #include "kernel_types.h"
 
+#ifdef MODULE_SCHEDSTATISTICS
+#include "timex.h"
+#endif
+
+#ifdef MODULE_IRQ_STATS
+#include "irq_stats.h"
+#endif
+
 #ifdef MODULE_TLSF_MALLOC
 #include "tlsf.h"
 #include "tlsf-malloc.h"
@@ -62,7 +71,14 @@ void ps(void)
            "| stack  ( used) | base addr  | current     "
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
-           "| runtime  | switches"
+           "| runtime  | switches | volunt.  | involun. | cpu (ms) "
+           "| lat max  | stk peak"
+#endif
+#ifdef MODULE_IRQ_STATS
+           " | irq (us)"
+#endif
+#ifdef MODULE_CORE_MSG_MPSC
+           " | msg lost"
 #endif
            "\n",
 #ifdef DEVELHELP
@@ -111,6 +127,8 @@ void ps(void)
             unsigned runtime_major = runtime_ticks / rt_sum;
             unsigned runtime_minor = ((runtime_ticks % rt_sum) * 1000) / rt_sum;
             unsigned switches = sched_pidlist[i].schedules;
+            schedstat_snapshot_t snap;
+            sched_statistics_snapshot(i, &snap);
 #endif
             printf("\t%3" PRIkernel_pid
 #ifdef DEVELHELP
@@ -121,7 +139,14 @@ void ps(void)
                    " | %6i (%5i) | %10p | %10p "
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
-                   " | %2d.%03d%% |  %8u"
+                   " | %2d.%03d%% |  %8u | %8u | %8u | %8" PRIu32
+                   " | %8" PRIu32 " | %8u"
+#endif
+#ifdef MODULE_IRQ_STATS
+                   " | %8" PRIu32
+#endif
+#ifdef MODULE_CORE_MSG_MPSC
+                   " | %8u"
 #endif
                    "\n",
                    p->pid,
@@ -134,6 +159,15 @@ void ps(void)
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
                    , runtime_major, runtime_minor, switches
+                   , snap.voluntary, snap.involuntary
+                   , (uint32_t)(snap.runtime_us / US_PER_MS)
+                   , snap.latency_max_us, snap.stack_peak
+#endif
+#ifdef MODULE_IRQ_STATS
+                   , (uint32_t)irq_stats_thread_us(i)
+#endif
+#ifdef MODULE_CORE_MSG_MPSC
+                   , p->msg_overflows
 #endif
                   );
         }
@@ -24,9 +24,20 @@ int _gnrc_6lo_frag_stats(int argc, char **argv)
     (void)argc;
     (void)argv;
     printf("rbuf full: %u\n", stats->rbuf_full);
+    printf("rbuf timeout: %u\n", stats->rbuf_timeout);
+    printf("rbuf evicted (full): %u\n", stats->rbuf_evict_full);
+    printf("rbuf evicted (quota): %u\n", stats->rbuf_evict_quota);
+    printf("rbuf invalid: %u\n", stats->rbuf_invalid);
     printf("frag full: %u\n", stats->frag_full);
 #ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
     printf("VRB full: %u\n", stats->vrb_full);
+#endif
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    printf("SFR fragments sent: %u\n", stats->sfr_sent);
+    printf("SFR fragments resent: %u\n", stats->sfr_resent);
+    printf("SFR ACKs sent: %u\n", stats->sfr_acks_sent);
+    printf("SFR ACKs received: %u\n", stats->sfr_acks_recv);
+    printf("SFR datagrams aborted: %u\n", stats->sfr_aborted);
 #endif
     return 0;
 }
@@ -66,10 +66,11 @@ static void _usage(char **argv)
 
 static void _usage_nib_neigh(char **argv)
 {
-    printf("usage: %s %s [show|add|del|help]\n", argv[0], argv[1]);
+    printf("usage: %s %s [show|add|del|stats|help]\n", argv[0], argv[1]);
     printf("       %s %s add <iface> <ipv6 addr> [<l2 addr>]\n", argv[0], argv[1]);
     printf("       %s %s del <iface> <ipv6 addr>\n", argv[0], argv[1]);
     printf("       %s %s show [iface]\n", argv[0], argv[1]);
+    printf("       %s %s stats\n", argv[0], argv[1]);
 }
 
 static void _usage_nib_prefix(char **argv)
@@ -113,6 +114,9 @@ static int _nib_neigh(int argc, char **argv)
             gnrc_ipv6_nib_nc_print(&entry);
         }
     }
+    else if ((argc > 2) && (strcmp(argv[2], "stats") == 0)) {
+        gnrc_ipv6_nib_nc_print_stats();
+    }
     else if ((argc > 2) && (strcmp(argv[2], "help") == 0)) {
         _usage_nib_neigh(argv);
     }
@@ -70,6 +70,8 @@ static const struct {
     { "rx_single", NETOPT_SINGLE_RECEIVE },
     { "chan_hop", NETOPT_CHANNEL_HOP },
     { "checksum", NETOPT_CHECKSUM },
+    { "rx_csum", NETOPT_RX_CSUM_VERIFIED },
+    { "tx_csum", NETOPT_TX_CSUM_OFFLOAD },
 };
 
 /* utility functions */
@@ -119,12 +121,13 @@ static int _netif_stats(kernel_pid_t iface, unsigned module, bool reset)
     }
     else {
         printf("          Statistics for %s\n"
-               "            RX packets %u  bytes %u\n"
+               "            RX packets %u  bytes %u  copied %u\n"
                "            TX packets %u (Multicast: %u)  bytes %u\n"
                "            TX succeeded %u errors %u\n",
                _netstats_module_to_str(module),
                (unsigned) stats->rx_count,
                (unsigned) stats->rx_bytes,
+               (unsigned) stats->rx_copied,
                (unsigned) (stats->tx_unicast_count + stats->tx_mcast_count),
                (unsigned) stats->tx_mcast_count,
                (unsigned) stats->tx_bytes,
@@ -284,6 +287,14 @@ static void _print_netopt(netopt_t opt)
             printf("PHY busy");
             break;
 
+        case NETOPT_RX_CSUM_VERIFIED:
+            printf("checksums of received packets verified by device");
+            break;
+
+        case NETOPT_TX_CSUM_OFFLOAD:
+            printf("checksums of sent packets calculated by device");
+            break;
+
         default:
             /* we don't serve these options here */
             break;
@@ -497,6 +508,10 @@ static void _netif_list(kernel_pid_t iface)
                                    line_thresh);
     line_thresh = _netif_list_flag(iface, NETOPT_CHANNEL_HOP, "CHAN_HOP",
                                    line_thresh);
+    line_thresh = _netif_list_flag(iface, NETOPT_RX_CSUM_VERIFIED, "RX_CSUM  ",
+                                   line_thresh);
+    line_thresh = _netif_list_flag(iface, NETOPT_TX_CSUM_OFFLOAD, "TX_CSUM  ",
+                                   line_thresh);
     res = gnrc_netapi_get(iface, NETOPT_MAX_PDU_SIZE, 0, &u16, sizeof(u16));
     if (res > 0) {
         printf("L2-PDU:%" PRIu16 " ", u16);
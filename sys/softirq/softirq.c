@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_softirq
+ * @{
+ *
+ * @file
+ * @brief       Deferred interrupt work implementation
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ *
+ * @}
+ */
+
+#include "assert.h"
+#include "softirq.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static char _stack[SOFTIRQ_STACKSIZE];
+static event_queue_t _queue = EVENT_QUEUE_INIT_DETACHED;
+
+static void *_worker(void *arg)
+{
+    (void)arg;
+
+    event_queue_claim(&_queue);
+
+    while (1) {
+        softirq_t *sirq = (softirq_t *)event_wait(&_queue);
+        unsigned items = SOFTIRQ_RUN_ITEMS;
+
+        do {
+            DEBUG("softirq: running %p\n", (void *)sirq);
+            if (sirq->handler(sirq, SOFTIRQ_BUDGET)) {
+                /* budget exhausted, line up behind the others */
+                event_post(&_queue, &sirq->super);
+            }
+        } while (--items && (sirq = (softirq_t *)event_get(&_queue)));
+
+        if (!items) {
+            /* run is over, leave the CPU to the threads for a while */
+            DEBUG("softirq: pausing\n");
+            xtimer_usleep(SOFTIRQ_RUN_GAP_US);
+        }
+    }
+
+    return NULL;
+}
+
+void softirq_init(void)
+{
+    kernel_pid_t pid = thread_create(_stack, sizeof(_stack), SOFTIRQ_PRIO,
+                                     THREAD_CREATE_STACKTEST,
+                                     _worker, NULL, "softirq");
+
+    (void)pid;
+    assert(pid_is_valid(pid));
+}
+
+void softirq_raise(softirq_t *sirq)
+{
+    assert(sirq && sirq->handler);
+    event_post(&_queue, &sirq->super);
+}
+
+void softirq_cancel(softirq_t *sirq)
+{
+    assert(sirq);
+    event_cancel(&_queue, &sirq->super);
+}
@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_tpool
+ * @{
+ *
+ * @file
+ * @brief       Thread pool implementation
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "assert.h"
+#include "irq.h"
+#include "thread.h"
+#include "tpool.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#ifdef MODULE_TPOOL_PTHREAD
+/* implemented by the native CPU */
+void tpool_host_submit(tpool_t *pool, tpool_job_t *job);
+int tpool_host_cancel(tpool_t *pool, tpool_job_t *job);
+#endif
+
+static void *_worker(void *arg)
+{
+    tpool_t *pool = arg;
+
+    while (1) {
+        clist_node_t *node;
+
+        mutex_lock(&pool->lock);
+        while ((node = clist_lpop(&pool->queue)) == NULL) {
+            cond_wait(&pool->avail, &pool->lock);
+        }
+        tpool_job_t *job = container_of(node, tpool_job_t, node);
+        job->state = TPOOL_JOB_RUNNING;
+        mutex_unlock(&pool->lock);
+
+        DEBUG("tpool: %" PRIkernel_pid " runs job %p\n", sched_active_pid,
+              (void *)job);
+        job->fn(job->arg);
+
+        /* the job is only reported done once the worker let go of it, the
+         * pool lock keeps a woken waiter from submitting it again before */
+        mutex_lock(&pool->lock);
+        mutex_unlock(&job->done);
+        job->state = TPOOL_JOB_DONE;
+        mutex_unlock(&pool->lock);
+    }
+
+    return NULL;
+}
+
+void tpool_init(tpool_t *pool)
+{
+    assert(pool);
+    memset(pool, 0, sizeof(*pool));
+    mutex_init(&pool->lock);
+    cond_init(&pool->avail);
+}
+
+unsigned tpool_start(tpool_t *pool, char *stacks, size_t stacksize,
+                     unsigned n, uint8_t priority)
+{
+    assert(pool && stacks);
+#ifdef MODULE_TPOOL_PTHREAD
+    assert(!pool->host);
+#endif
+    unsigned started = 0;
+
+    for (unsigned i = 0; i < n; i++) {
+        kernel_pid_t pid = thread_create(stacks + (i * stacksize), stacksize,
+                                         priority, THREAD_CREATE_STACKTEST,
+                                         _worker, pool, "tpool");
+        if (pid <= KERNEL_PID_UNDEF) {
+            break;
+        }
+        started++;
+    }
+
+    return started;
+}
+
+static void _prepare(tpool_t *pool, tpool_job_t *job, tpool_fn_t fn,
+                     void *arg)
+{
+    assert((job->state != TPOOL_JOB_QUEUED) &&
+           (job->state != TPOOL_JOB_RUNNING));
+
+    job->pool = pool;
+    job->fn = fn;
+    job->arg = arg;
+    job->node.next = NULL;
+    job->state = TPOOL_JOB_QUEUED;
+    mutex_init(&job->done);
+    mutex_lock(&job->done);
+}
+
+void tpool_submit(tpool_t *pool, tpool_job_t *job, tpool_fn_t fn, void *arg)
+{
+    assert(pool && job && fn && !irq_is_in());
+
+#ifdef MODULE_TPOOL_PTHREAD
+    if (pool->host) {
+        /* host backed jobs are reported done from interrupt context, only
+         * after the host threads let go of them */
+        _prepare(pool, job, fn, arg);
+        tpool_host_submit(pool, job);
+        return;
+    }
+#endif
+
+    mutex_lock(&pool->lock);
+    _prepare(pool, job, fn, arg);
+    clist_rpush(&pool->queue, &job->node);
+    cond_signal(&pool->avail);
+    mutex_unlock(&pool->lock);
+}
+
+int tpool_cancel(tpool_t *pool, tpool_job_t *job)
+{
+    assert(pool && job);
+
+#ifdef MODULE_TPOOL_PTHREAD
+    if (pool->host) {
+        return tpool_host_cancel(pool, job);
+    }
+#endif
+
+    int res = -EBUSY;
+
+    mutex_lock(&pool->lock);
+    if (job->state == TPOOL_JOB_QUEUED) {
+        clist_remove(&pool->queue, &job->node);
+        job->state = TPOOL_JOB_CANCELLED;
+        mutex_unlock(&job->done);
+        res = 0;
+    }
+    mutex_unlock(&pool->lock);
+
+    return res;
+}
+
+tpool_job_state_t tpool_wait(tpool_job_t *job)
+{
+    assert(job && (job->state != TPOOL_JOB_IDLE));
+
+    mutex_lock(&job->done);
+    mutex_unlock(&job->done);
+#ifdef MODULE_TPOOL_PTHREAD
+    if (!job->pool->host)
+#endif
+    {
+        /* the worker may have been preempted between releasing the job and
+         * marking it done */
+        mutex_lock(&job->pool->lock);
+        mutex_unlock(&job->pool->lock);
+    }
+
+    return job->state;
+}
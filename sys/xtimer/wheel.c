@@ -0,0 +1,342 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup sys_xtimer
+ *
+ * @{
+ * @file
+ * @brief   Hierarchical timing wheel for xtimer
+ *
+ * Timers are hashed into one of 32 slots of one of @ref XTIMER_WHEEL_LEVELS
+ * levels by their absolute 64 bit target time. A slot of level `l` spans
+ * `XTIMER_WHEEL_GRANULARITY * 32^l` ticks, a level spans exactly one slot of
+ * the next higher level. A timer is always stored in the lowest level whose
+ * current span contains its target, so the slot a timer is stored in lies
+ * strictly in the future.
+ *
+ * An internal timer is kept in the sorted lists of the
+ * xtimer core and expires at the start of the next non-empty slot, or, for
+ * the lowest level, at the earliest target stored in that slot. When that
+ * happens all timers of that slot are redistributed to the lower levels
+ * ("cascaded") in one pass, timers of a slot of the lowest level are handed
+ * over to the xtimer core. The xtimer core then fires them precisely.
+ *
+ * Empty slots are skipped using one occupation bitmap per level, so there is
+ * no periodic tick.
+ *
+ * @author  RIOT developers <devel@riot-os.org>
+ * @}
+ */
+
+#include <assert.h>
+#include <stdint.h>
+
+#include "bitarithm.h"
+#include "irq.h"
+#include "xtimer.h"
+
+#include "wheel.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+#define SLOT_BITS       (5U)
+#define SLOT_NUMOF      (1U << SLOT_BITS)
+#define SLOT_MASK       (SLOT_NUMOF - 1)
+
+/* number of bits of a tick count covered by a slot of level l */
+#define LEVEL_SHIFT(l)  (XTIMER_WHEEL_GRANULARITY_SHIFT + ((l) * SLOT_BITS))
+
+/* number of bits of a tick count covered by the whole wheel */
+#define WHEEL_SHIFT     LEVEL_SHIFT(XTIMER_WHEEL_LEVELS)
+
+/* the internal timer is never set further than this into the future, so
+ * its target can always be represented by the lower 32 bit */
+#define ARM_MAX         (1LU << 30)
+
+#if XTIMER_WHEEL_GRANULARITY_SHIFT > 16
+#error "XTIMER_WHEEL_GRANULARITY_SHIFT must not exceed 16"
+#endif
+
+static xtimer_t *_slots[XTIMER_WHEEL_LEVELS][SLOT_NUMOF];
+static uint32_t _slot_map[XTIMER_WHEEL_LEVELS];
+/* earliest target in each slot of the lowest level, relative to the slot
+ * start. Not updated on removal, so it may be too early, never too late */
+static uint16_t _slot_first[SLOT_NUMOF];
+static xtimer_t *_far_list;
+
+/* start of the current slot of level 0 */
+static uint64_t _wheel_time;
+/* latest time stamp seen, used to keep _now() monotonic */
+static uint64_t _last_now;
+/* target of _wheel_timer, 0 if not set */
+static uint64_t _armed;
+
+static void _wheel_tick(void *arg);
+
+static xtimer_t _wheel_timer = { .callback = _wheel_tick };
+
+static inline unsigned _lsb32(uint32_t v)
+{
+    unsigned res = 0;
+
+    /* bitarithm_lsb() takes an unsigned, which may be only 16 bit wide */
+    if (!(v & 0xffff)) {
+        v >>= 16;
+        res = 16;
+    }
+    return res + bitarithm_lsb((unsigned)(v & 0xffff));
+}
+
+static inline uint64_t _target(const xtimer_t *timer)
+{
+    return ((uint64_t)timer->long_target << 32) | timer->target;
+}
+
+static uint64_t _now(void)
+{
+    uint64_t now = _xtimer_now64();
+
+    /* the upper bits are only advanced by the xtimer ISR, so a time stamp
+     * taken right after the low-level timer overflowed may lag behind */
+    if (now < _last_now) {
+        now = _last_now;
+    }
+    _last_now = now;
+    return now;
+}
+
+static void _link(xtimer_t **head, xtimer_t *timer)
+{
+    timer->next = *head;
+    if (timer->next) {
+        timer->next->pprev = &timer->next;
+    }
+    timer->pprev = head;
+    *head = timer;
+}
+
+void _xtimer_wheel_remove(xtimer_t *timer)
+{
+    xtimer_t **pprev = timer->pprev;
+    uintptr_t slot = (uintptr_t)pprev - (uintptr_t)&_slots[0][0];
+
+    *pprev = timer->next;
+    if (timer->next) {
+        timer->next->pprev = pprev;
+    }
+    timer->pprev = NULL;
+    timer->next = NULL;
+
+    /* was it the last timer of a slot? */
+    slot /= sizeof(_slots[0][0]);
+    if ((slot < (XTIMER_WHEEL_LEVELS * SLOT_NUMOF)) && !*pprev) {
+        _slot_map[slot / SLOT_NUMOF] &= ~(1LU << (slot % SLOT_NUMOF));
+    }
+}
+
+/**
+ * @brief   Stores @p timer in the wheel
+ *
+ * @return  0 if the timer was stored
+ * @return  1 if the timer expires in the current slot of the lowest level
+ */
+static int _place(xtimer_t *timer)
+{
+    uint64_t target = _target(timer);
+
+    if ((target >> LEVEL_SHIFT(0)) <= (_wheel_time >> LEVEL_SHIFT(0))) {
+        return 1;
+    }
+    for (unsigned l = 0; l < XTIMER_WHEEL_LEVELS; l++) {
+        if ((target >> LEVEL_SHIFT(l + 1)) == (_wheel_time >> LEVEL_SHIFT(l + 1))) {
+            unsigned idx = (target >> LEVEL_SHIFT(l)) & SLOT_MASK;
+
+            if (l == 0) {
+                uint16_t first = target & (XTIMER_WHEEL_GRANULARITY - 1);
+
+                if (!(_slot_map[0] & (1LU << idx)) || (first < _slot_first[idx])) {
+                    _slot_first[idx] = first;
+                }
+            }
+            _link(&_slots[l][idx], timer);
+            _slot_map[l] |= (1LU << idx);
+            return 0;
+        }
+    }
+    _link(&_far_list, timer);
+    return 0;
+}
+
+/**
+ * @brief   Returns the time the next slot holding timers needs processing
+ */
+static uint64_t _next_event(void)
+{
+    for (unsigned l = 0; l < XTIMER_WHEEL_LEVELS; l++) {
+        unsigned cur = (_wheel_time >> LEVEL_SHIFT(l)) & SLOT_MASK;
+        /* slots up to and including the current one are empty by design */
+        uint32_t pending = _slot_map[l] & ~((2LU << cur) - 1);
+
+        assert(!(_slot_map[l] & ~pending));
+        if (pending) {
+            /* all slots of a level lie within the current slot of the next
+             * higher level, so this is the earliest event */
+            uint64_t base = (_wheel_time >> LEVEL_SHIFT(l + 1)) << LEVEL_SHIFT(l + 1);
+            unsigned idx = _lsb32(pending);
+
+            base += ((uint64_t)idx << LEVEL_SHIFT(l));
+            /* no need to wake up before the first timer of a slot of the
+             * lowest level, it is handed over to the xtimer core anyway */
+            return (l == 0) ? (base + _slot_first[idx]) : base;
+        }
+    }
+    if (_far_list) {
+        return ((_wheel_time >> WHEEL_SHIFT) + 1) << WHEEL_SHIFT;
+    }
+    return UINT64_MAX;
+}
+
+static void _cascade(xtimer_t *list, xtimer_t **expired)
+{
+    while (list) {
+        xtimer_t *timer = list;
+
+        list = timer->next;
+        timer->pprev = NULL;
+        if (_place(timer)) {
+            timer->next = *expired;
+            *expired = timer;
+        }
+    }
+}
+
+/**
+ * @brief   Advances the wheel to @p now
+ *
+ * All timers of slots that started until @p now are collected in @p expired.
+ */
+static void _advance(uint64_t now, xtimer_t **expired)
+{
+    uint64_t event;
+
+    while ((event = _next_event()) <= now) {
+        event &= ~((uint64_t)XTIMER_WHEEL_GRANULARITY - 1);
+        _wheel_time = event;
+        if (!(event & ((1ULL << WHEEL_SHIFT) - 1))) {
+            xtimer_t *list = _far_list;
+
+            _far_list = NULL;
+            _cascade(list, expired);
+        }
+        /* cascade from the top, so timers end up in their final slot */
+        for (int l = XTIMER_WHEEL_LEVELS - 1; l >= 0; l--) {
+            if (!(event & ((1ULL << LEVEL_SHIFT(l)) - 1))) {
+                unsigned idx = (event >> LEVEL_SHIFT(l)) & SLOT_MASK;
+                xtimer_t *list = _slots[l][idx];
+
+                if (list) {
+                    _slots[l][idx] = NULL;
+                    _slot_map[l] &= ~(1LU << idx);
+                    _cascade(list, expired);
+                }
+            }
+        }
+    }
+    now &= ~((uint64_t)XTIMER_WHEEL_GRANULARITY - 1);
+    /* the slot of the next event must stay in the future, even if that
+     * event is still a bit away */
+    event &= ~((uint64_t)XTIMER_WHEEL_GRANULARITY - 1);
+    if (now >= event) {
+        now = event - XTIMER_WHEEL_GRANULARITY;
+    }
+    if (now > _wheel_time) {
+        _wheel_time = now;
+    }
+}
+
+/**
+ * @brief   Hands expired timers over to the xtimer core
+ */
+static void _expire(xtimer_t *expired, uint64_t now)
+{
+    while (expired) {
+        xtimer_t *timer = expired;
+        uint64_t target = _target(timer);
+
+        expired = timer->next;
+        timer->next = NULL;
+        if (target > now) {
+            _xtimer_list_set_absolute(timer, (uint32_t)target);
+        }
+        else {
+            /* late, fire right away */
+            timer->target = 0;
+            timer->long_target = 0;
+            timer->callback(timer->arg);
+        }
+    }
+}
+
+static void _arm(uint64_t now)
+{
+    uint64_t event = _next_event();
+
+    if (event == UINT64_MAX) {
+        /* stale wake-ups of _wheel_timer are harmless, so leave it be */
+        return;
+    }
+    if (event < now) {
+        event = now;
+    }
+    else if (event - now > ARM_MAX) {
+        event = now + ARM_MAX;
+    }
+    if (_armed && (_armed <= event)) {
+        return;
+    }
+    DEBUG("xtimer_wheel: arming for %" PRIu32 "\n", (uint32_t)event);
+    _armed = event;
+    xtimer_remove(&_wheel_timer);
+    _xtimer_list_set_absolute(&_wheel_timer, (uint32_t)event);
+}
+
+static void _wheel_tick(void *arg)
+{
+    (void)arg;
+    xtimer_t *expired = NULL;
+    unsigned state = irq_disable();
+    uint64_t now = _now();
+
+    _armed = 0;
+    _advance(now, &expired);
+    _arm(now);
+    _expire(expired, now);
+    irq_restore(state);
+}
+
+void _xtimer_wheel_set(xtimer_t *timer, uint64_t target)
+{
+    xtimer_t *expired = NULL;
+    unsigned state = irq_disable();
+    uint64_t now = _now();
+
+    /* bring the wheel up to date, so the timer is hashed relative to now */
+    _advance(now, &expired);
+
+    timer->target = (uint32_t)target;
+    timer->long_target = (uint32_t)(target >> 32);
+    if ((target <= now) || _place(timer)) {
+        timer->next = expired;
+        expired = timer;
+    }
+    _arm(now);
+    _expire(expired, now);
+    irq_restore(state);
+}
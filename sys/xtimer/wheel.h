@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_xtimer
+ * @{
+ *
+ * @file
+ * @internal
+ * @brief       Interface between the xtimer core and the timing wheel backend
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ */
+#ifndef WHEEL_H
+#define WHEEL_H
+
+#include <stdint.h>
+
+#include "xtimer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Insert @p timer into the sorted timer lists of the xtimer core
+ *
+ * This is what `_xtimer_set_absolute()` does when the timing wheel is not
+ * used. The wheel uses it to hand over timers that are about to expire.
+ *
+ * @pre     @p timer is not set
+ *
+ * @param[in] timer     timer to set
+ * @param[in] target    absolute (lower 32 bit) target time in ticks
+ *
+ * @return  0
+ */
+int _xtimer_list_set_absolute(xtimer_t *timer, uint32_t target);
+
+/**
+ * @brief   Insert @p timer into the timing wheel
+ *
+ * @pre     @p timer is not set
+ *
+ * @param[in] timer     timer to set
+ * @param[in] target    absolute 64 bit target time in ticks
+ */
+void _xtimer_wheel_set(xtimer_t *timer, uint64_t target);
+
+/**
+ * @brief   Remove @p timer from the timing wheel
+ *
+ * @pre     Interrupts are disabled
+ * @pre     @p timer is stored in the wheel, i.e. xtimer_t::pprev is set
+ *
+ * @param[in] timer     timer to remove
+ */
+void _xtimer_wheel_remove(xtimer_t *timer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WHEEL_H */
+/** @} */
@@ -75,11 +75,13 @@ void _xtimer_tsleep(uint32_t offset, uint32_t long_offset)
 }
 
 void _xtimer_periodic_wakeup(uint32_t *last_wakeup, uint32_t period) {
-    xtimer_t timer;
-    mutex_t mutex = MUTEX_INIT;
+    _xtimer_periodic_wakeup_slack(last_wakeup, period, 0);
+}
 
-    timer.callback = _callback_unlock_mutex;
-    timer.arg = (void*) &mutex;
+void _xtimer_periodic_wakeup_slack(uint32_t *last_wakeup, uint32_t period,
+                                   uint32_t slack) {
+    mutex_t mutex = MUTEX_INIT;
+    xtimer_t timer = { .callback = _callback_unlock_mutex, .arg = &mutex };
 
     uint32_t target = (*last_wakeup) + period;
     uint32_t now = _xtimer_now();
@@ -132,7 +134,12 @@ void _xtimer_periodic_wakeup(uint32_t *last_wakeup, uint32_t period) {
         }
         mutex_lock(&mutex);
         DEBUG("xps, abs: %" PRIu32 "\n", target);
+#ifdef MODULE_XTIMER_SLACK
+        _xtimer_set_absolute_slack(&timer, target, slack);
+#else
+        (void)slack;
         _xtimer_set_absolute(&timer, target);
+#endif
         mutex_lock(&mutex);
     }
 out:
@@ -259,6 +266,9 @@ static void _mutex_timeout(void *arg)
         if (mt->mutex->queue.next == NULL) {
             mt->mutex->queue.next = MUTEX_LOCKED;
         }
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+        mutex_waiter_removed(mt->mutex);
+#endif
         sched_set_status(mt->thread, STATUS_PENDING);
         irq_restore(irqstate);
         sched_switch(mt->thread->priority);
@@ -269,12 +279,10 @@ static void _mutex_timeout(void *arg)
 
 int xtimer_mutex_lock_timeout(mutex_t *mutex, uint64_t timeout)
 {
-    xtimer_t t;
     mutex_thread_t mt = { mutex, (thread_t *)sched_active_thread, 0 };
+    xtimer_t t = { .callback = _mutex_timeout, .arg = &mt };
 
     if (timeout != 0) {
-        t.callback = _mutex_timeout;
-        t.arg = (void *)((mutex_thread_t *)&mt);
         xtimer_set64(&t, timeout);
     }
 
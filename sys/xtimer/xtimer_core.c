@@ -29,6 +29,8 @@
 #include "xtimer.h"
 #include "irq.h"
 
+#include "wheel.h"
+
 /* WARNING! enabling this will have side effects and can lead to timer underflows. */
 #define ENABLE_DEBUG 0
 #include "debug.h"
@@ -56,13 +58,58 @@ static uint32_t _time_left(uint32_t target, uint32_t reference);
 static void _timer_callback(void);
 static void _periph_timer_callback(void *arg, int chan);
 
+static void _set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset);
+static void _set(xtimer_t *timer, uint32_t offset);
+static int _set_absolute(xtimer_t *timer, uint32_t target);
+
 static inline int _this_high_period(uint32_t target);
 
+#ifdef MODULE_XTIMER_SLACK
+static xtimer_slack_stats_t _slack_stats;
+#endif
+
 static inline int _is_set(xtimer_t *timer)
 {
     return (timer->target || timer->long_target);
 }
 
+static inline void _init_slack(xtimer_t *timer, uint32_t slack)
+{
+#ifdef MODULE_XTIMER_SLACK
+    /* the lists rely on the slack of set timers to stay the same */
+    xtimer_remove(timer);
+    timer->slack = slack;
+#else
+    (void)timer;
+    (void)slack;
+#endif
+}
+
+/**
+ * @brief   Returns the time the low-level timer should expire at for the
+ *          head of the current timer list
+ *
+ * With `xtimer_slack`, this is the latest target of all timers whose
+ * windows overlap with the one of the list head, so they expire together.
+ */
+static inline uint32_t _head_target(void)
+{
+    xtimer_t *timer = timer_list_head;
+    uint32_t target = timer->target;
+#ifdef MODULE_XTIMER_SLACK
+    uint32_t deadline = (timer->slack > (UINT32_MAX - target))
+                      ? UINT32_MAX : (target + timer->slack);
+
+    while ((timer = timer->next) && (timer->target <= deadline)) {
+        target = timer->target;
+        if ((timer->slack < (deadline - target))) {
+            deadline = target + timer->slack;
+        }
+    }
+#endif
+    return target;
+}
+
 static inline void xtimer_spin_until(uint32_t target)
 {
 #if XTIMER_MASK
@@ -107,13 +154,58 @@ uint64_t _xtimer_now64(void)
 }
 
 void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset)
+{
+    _init_slack(timer, 0);
+    _set64(timer, offset, long_offset);
+}
+
+void _xtimer_set(xtimer_t *timer, uint32_t offset)
+{
+    _init_slack(timer, 0);
+    _set(timer, offset);
+}
+
+int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
+{
+    _init_slack(timer, 0);
+    return _set_absolute(timer, target);
+}
+
+#ifdef MODULE_XTIMER_SLACK
+void _xtimer_set64_slack(xtimer_t *timer, uint32_t offset, uint32_t long_offset,
+                         uint32_t slack)
+{
+    _init_slack(timer, slack);
+    _set64(timer, offset, long_offset);
+}
+
+int _xtimer_set_absolute_slack(xtimer_t *timer, uint32_t target, uint32_t slack)
+{
+    _init_slack(timer, slack);
+    return _set_absolute(timer, target);
+}
+
+void xtimer_slack_get_stats(xtimer_slack_stats_t *stats)
+{
+    unsigned state = irq_disable();
+    *stats = _slack_stats;
+    irq_restore(state);
+}
+#endif
+
+static void _set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset)
 {
     DEBUG(" _xtimer_set64() offset=%" PRIu32 " long_offset=%" PRIu32 "\n", offset, long_offset);
     if (!long_offset) {
         /* timer fits into the short timer */
-        _xtimer_set(timer, (uint32_t)offset);
+        _set(timer, (uint32_t)offset);
     }
     else {
+#ifdef MODULE_XTIMER_WHEEL
+        xtimer_remove(timer);
+        _xtimer_wheel_set(timer, _xtimer_now64() +
+                                 (((uint64_t)long_offset << 32) | offset));
+#else
         int state = irq_disable();
         if (_is_set(timer)) {
             _remove(timer);
@@ -130,10 +222,11 @@ void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset)
         irq_restore(state);
         DEBUG("xtimer_set64(): added longterm timer (long_target=%" PRIu32 " target=%" PRIu32 ")\n",
               timer->long_target, timer->target);
+#endif
     }
 }
 
-void _xtimer_set(xtimer_t *timer, uint32_t offset)
+static void _set(xtimer_t *timer, uint32_t offset)
 {
     DEBUG("timer_set(): offset=%" PRIu32 " now=%" PRIu32 " (%" PRIu32 ")\n",
           offset, xtimer_now().ticks32, _xtimer_lltimer_now());
@@ -150,7 +243,7 @@ void _xtimer_set(xtimer_t *timer, uint32_t offset)
     }
     else {
         uint32_t target = _xtimer_now() + offset;
-        _xtimer_set_absolute(timer, target);
+        _set_absolute(timer, target);
     }
 }
 
@@ -175,12 +268,33 @@ static inline void _lltimer_set(uint32_t target)
     timer_set_absolute(XTIMER_DEV, XTIMER_CHAN, _xtimer_lltimer_mask(target));
 }
 
-int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
+static int _set_absolute(xtimer_t *timer, uint32_t target)
+{
+#ifdef MODULE_XTIMER_WHEEL
+    /* the timer may be stored in the wheel, which the lists know nothing of */
+    xtimer_remove(timer);
+
+    uint64_t now = _xtimer_now64();
+    uint32_t offset = target - (uint32_t)now;
+
+    if ((offset >= XTIMER_WHEEL_GRANULARITY) && (offset <= (UINT32_MAX >> 1))) {
+        /* far enough in the future to be worth hashing into the wheel */
+        _xtimer_wheel_set(timer, now + offset);
+        return 0;
+    }
+#endif
+    return _xtimer_list_set_absolute(timer, target);
+}
+
+int _xtimer_list_set_absolute(xtimer_t *timer, uint32_t target)
 {
     uint32_t now = _xtimer_now();
     int res = 0;
 
     timer->next = NULL;
+#ifdef MODULE_XTIMER_WHEEL
+    timer->pprev = NULL;
+#endif
 
     /* Ensure that offset is bigger than 'XTIMER_BACKOFF',
      * 'target - now' will allways be the offset no matter if target < or > now.
@@ -240,10 +354,15 @@ int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
             DEBUG("timer_set_absolute(): timer will expire in this timer period.\n");
             _add_timer_to_list(&timer_list_head, timer);
 
+#ifdef MODULE_XTIMER_SLACK
+            /* the timer may change the time the list head expires with */
+            _lltimer_set(_head_target() - XTIMER_OVERHEAD);
+#else
             if (timer_list_head == timer) {
                 DEBUG("timer_set_absolute(): timer is new list head. updating lltimer.\n");
                 _lltimer_set(target);
             }
+#endif
         }
     }
 
@@ -289,12 +408,18 @@ static int _remove_timer_from_list(xtimer_t **list_head, xtimer_t *timer)
 
 static void _remove(xtimer_t *timer)
 {
+#ifdef MODULE_XTIMER_WHEEL
+    if (timer->pprev) {
+        _xtimer_wheel_remove(timer);
+        return;
+    }
+#endif
     if (timer_list_head == timer) {
         uint32_t next;
         timer_list_head = timer->next;
         if (timer_list_head) {
             /* schedule callback on next timer target time */
-            next = timer_list_head->target - XTIMER_OVERHEAD;
+            next = _head_target() - XTIMER_OVERHEAD;
         }
         else {
             next = _xtimer_lltimer_mask(0xFFFFFFFF);
@@ -467,6 +592,9 @@ static void _timer_callback(void)
 {
     uint32_t next_target;
     uint32_t reference;
+#ifdef MODULE_XTIMER_SLACK
+    int fired = 0;
+#endif
 
     _in_handler = 1;
 
@@ -513,6 +641,11 @@ overflow:
         timer->target = 0;
         timer->long_target = 0;
 
+#ifdef MODULE_XTIMER_SLACK
+        _slack_stats.fired++;
+        fired = 1;
+#endif
+
         /* fire timer */
         _shoot(timer);
     }
@@ -535,7 +668,7 @@ overflow:
 
     if (timer_list_head) {
         /* schedule callback on next timer target time */
-        next_target = timer_list_head->target - XTIMER_OVERHEAD;
+        next_target = _head_target() - XTIMER_OVERHEAD;
 
         /* make sure we're not setting a time in the past */
         if (next_target < (_xtimer_now() + XTIMER_ISR_BACKOFF)) {
@@ -568,6 +701,10 @@ overflow:
 
     _in_handler = 0;
 
+#ifdef MODULE_XTIMER_SLACK
+    _slack_stats.wakeups += fired;
+#endif
+
     /* set low level timer */
     _lltimer_set(next_target);
 }
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       NIB forwarding table lookup benchmark
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "kernel_defines.h"
+#include "net/gnrc/ipv6/nib/ft.h"
+#include "xtimer.h"
+
+/* lookups per number of routes */
+#ifndef TEST_LOOKUPS
+#define TEST_LOOKUPS        (10000U)
+#endif
+
+/* every TEST_PFX_EVERY-th route is one to a prefix */
+#define TEST_PFX_EVERY      (8U)
+#define TEST_PFX_LEN        (64U)
+#define TEST_NEXT_HOPS      (4U)
+#define TEST_IFACE          (1U)
+
+static const unsigned _routes[] = { 16, 128, 512 };
+static uint32_t _seed = 1;
+
+/* deterministic so both lookup variants see the same workload */
+static uint32_t _rand(void)
+{
+    _seed = (_seed * 1103515245U) + 12345U;
+    return _seed >> 8;
+}
+
+/* the address of route idx (or of a destination within its prefix),
+ * 2001:db8:0:<prefix>::<node> */
+static void _dst(ipv6_addr_t *addr, unsigned idx, bool within)
+{
+    ipv6_addr_from_str(addr, "2001:db8::");
+    if ((idx % TEST_PFX_EVERY) == 0) {
+        addr->u16[3] = byteorder_htons(1 + idx);
+        if (within) {
+            addr->u32[3] = byteorder_htonl(_rand());
+        }
+    }
+    else {
+        addr->u16[7] = byteorder_htons(idx);
+    }
+}
+
+static void _next_hop(ipv6_addr_t *addr, unsigned idx)
+{
+    ipv6_addr_from_str(addr, "fe80::");
+    addr->u8[15] = 1 + (idx % TEST_NEXT_HOPS);
+}
+
+static void _run(unsigned start, unsigned routes)
+{
+    ipv6_addr_t dst, next_hop;
+    gnrc_ipv6_nib_ft_t fte;
+    unsigned found = 0;
+
+    for (unsigned i = start; i < routes; i++) {
+        _dst(&dst, i, false);
+        _next_hop(&next_hop, i);
+        if (gnrc_ipv6_nib_ft_add(&dst, ((i % TEST_PFX_EVERY) == 0) ?
+                                 TEST_PFX_LEN : IPV6_ADDR_BIT_LEN,
+                                 &next_hop, TEST_IFACE, 0) < 0) {
+            printf("unable to add route %u\n", i);
+            return;
+        }
+    }
+
+    uint32_t start_time = xtimer_now_usec();
+
+    for (unsigned i = 0; i < TEST_LOOKUPS; i++) {
+        unsigned idx = _rand() % routes;
+
+        if ((i % 4) == 0) {
+            /* a node not in the network */
+            _dst(&dst, routes + idx, false);
+        }
+        else {
+            _dst(&dst, idx, true);
+        }
+        if (gnrc_ipv6_nib_ft_get(&dst, NULL, &fte) == 0) {
+            found++;
+        }
+    }
+    uint32_t duration = xtimer_now_usec() - start_time;
+
+    printf("{ \"routes\" : %u, \"lookups\" : %u, \"us\" : %" PRIu32
+           ", \"found\" : %u }\n", routes, TEST_LOOKUPS, duration, found);
+}
+
+int main(void)
+{
+    unsigned start = 0;
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_routes); i++) {
+        _run(start, _routes[i]);
+        start = _routes[i];
+    }
+    puts("done");
+    return 0;
+}
@@ -0,0 +1,22 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 RIOT developers
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    for routes in (16, 128, 512):
+        child.expect(r"{{ \"routes\" : {}, \"lookups\" : (\d+), "
+                     r"\"us\" : \d+, \"found\" : (\d+) }}".format(routes))
+        assert 0 < int(child.match.group(2)) < int(child.match.group(1))
+    child.expect_exact("done")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
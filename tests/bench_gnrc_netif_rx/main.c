@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Network interface reception benchmark
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "irq.h"
+#include "msg.h"
+#include "net/gnrc.h"
+#include "shell.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define MSG_QUEUE_SIZE      (16U)
+
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+static msg_t _msg_queue[MSG_QUEUE_SIZE];
+
+static struct {
+    uint32_t received;
+    uint32_t bytes;
+    uint32_t first;
+    uint32_t last;
+} _stats;
+
+static void *_sink(void *arg)
+{
+    gnrc_netreg_entry_t entry = GNRC_NETREG_ENTRY_INIT_PID(
+                                            GNRC_NETREG_DEMUX_CTX_ALL,
+                                            sched_active_pid);
+    msg_t msg;
+
+    (void)arg;
+    msg_init_queue(_msg_queue, MSG_QUEUE_SIZE);
+    gnrc_netreg_register(GNRC_NETTYPE_UNDEF, &entry);
+    while (1) {
+        msg_receive(&msg);
+        if (msg.type == GNRC_NETAPI_MSG_TYPE_RCV) {
+            gnrc_pktsnip_t *pkt = msg.content.ptr;
+            uint32_t now = xtimer_now_usec();
+            unsigned state = irq_disable();
+
+            if (_stats.received++ == 0) {
+                _stats.first = now;
+            }
+            _stats.last = now;
+            _stats.bytes += gnrc_pkt_len(pkt);
+            irq_restore(state);
+            gnrc_pktbuf_release(pkt);
+        }
+    }
+    return NULL;
+}
+
+static int _reset(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    unsigned state = irq_disable();
+
+    _stats.received = 0;
+    _stats.bytes = 0;
+    irq_restore(state);
+    return 0;
+}
+
+static int _print_stats(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    unsigned state = irq_disable();
+    uint32_t received = _stats.received;
+    uint32_t bytes = _stats.bytes;
+    uint32_t us = _stats.last - _stats.first;
+
+    irq_restore(state);
+    if (received == 0) {
+        us = 0;
+    }
+    /* the first frame starts the clock */
+    printf("{ \"received\" : %" PRIu32 ", \"bytes\" : %" PRIu32
+           ", \"us\" : %" PRIu32 ", \"pps\" : %" PRIu32 " }\n",
+           received, bytes, us,
+           us ? (uint32_t)(((uint64_t)(received - 1) * US_PER_SEC) / us) : 0);
+    return 0;
+}
+
+static const shell_command_t shell_commands[] = {
+    { "reset", "Clears the reception counters", _reset },
+    { "stats", "Prints the reception counters", _print_stats },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+
+    thread_create(_stack, sizeof(_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _sink, NULL, "sink");
+    shell_run(shell_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+    return 0;
+}
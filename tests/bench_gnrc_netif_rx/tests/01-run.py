@@ -0,0 +1,43 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 RIOT developers
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+from scapy.all import Ether, Raw, sendp
+from testrunner import run
+
+
+FRAMES = 10000
+PAYLOAD_LEN = 100
+# local experimental EtherType, unknown to GNRC
+ETHERTYPE = 0x88b5
+
+
+def testfunc(child):
+    tap = os.environ["TAP"]
+    child.sendline("reset")
+    frame = Ether(dst="ff:ff:ff:ff:ff:ff", type=ETHERTYPE) / \
+        Raw(b"\x00" * PAYLOAD_LEN)
+    sendp(frame, iface=tap, count=FRAMES, verbose=0)
+    child.sendline("stats")
+    child.expect(r"{ \"received\" : (\d+), \"bytes\" : \d+, \"us\" : \d+, "
+                 r"\"pps\" : \d+ }")
+    assert 0 < int(child.match.group(1)) <= FRAMES
+    child.sendline("ifconfig")
+    child.expect(r"RX packets \d+")
+    print("SUCCESS")
+
+
+if __name__ == "__main__":
+    if os.geteuid() != 0:
+        print("\x1b[1;31mThis test requires root privileges.\n"
+              "It's constructing and sending Ethernet frames.\x1b[0m\n",
+              file=sys.stderr)
+        sys.exit(1)
+    sys.exit(run(testfunc, timeout=10, echo=False))
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Network protocol registry lookup benchmark
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "msg.h"
+#include "net/gnrc/netreg.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef TEST_ENTRIES_MAX
+#define TEST_ENTRIES_MAX    (256U)
+#endif
+
+/* lookups per number of registrations */
+#ifndef TEST_LOOKUPS
+#define TEST_LOOKUPS        (10000U)
+#endif
+
+/* registered contexts resemble the UDP ports of sockets */
+#define TEST_CTX_BASE       (49152U)
+
+#define MSG_QUEUE_SIZE      (4U)
+
+static gnrc_netreg_entry_t _entries[TEST_ENTRIES_MAX];
+static msg_t _msg_queue[MSG_QUEUE_SIZE];
+
+static void _run(unsigned entries)
+{
+    unsigned missed = 0;
+
+    for (unsigned i = 0; i < entries; i++) {
+        gnrc_netreg_entry_init_pid(&_entries[i], TEST_CTX_BASE + (3 * i),
+                                   sched_active_pid);
+        gnrc_netreg_register(GNRC_NETTYPE_UNDEF, &_entries[i]);
+    }
+
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < TEST_LOOKUPS; i++) {
+        /* every (entries + 1)-th lookup is for a context not registered */
+        unsigned idx = i % (entries + 1);
+
+        if (gnrc_netreg_lookup(GNRC_NETTYPE_UNDEF,
+                               TEST_CTX_BASE + (3 * idx)) == NULL) {
+            missed++;
+        }
+    }
+    uint32_t duration = xtimer_now_usec() - start;
+
+    printf("{ \"entries\" : %u, \"lookups\" : %u, \"us\" : %" PRIu32
+           ", \"missed\" : %u }\n", entries, TEST_LOOKUPS, duration, missed);
+    for (unsigned i = 0; i < entries; i++) {
+        gnrc_netreg_unregister(GNRC_NETTYPE_UNDEF, &_entries[i]);
+    }
+}
+
+int main(void)
+{
+    /* only threads with a message queue may register */
+    msg_init_queue(_msg_queue, MSG_QUEUE_SIZE);
+    gnrc_netreg_init();
+    for (unsigned entries = 1; entries <= TEST_ENTRIES_MAX; entries *= 2) {
+        _run(entries);
+    }
+    puts("done");
+    return 0;
+}
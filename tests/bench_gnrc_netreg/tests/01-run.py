@@ -0,0 +1,21 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 RIOT developers
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    for entries in (1, 2, 4, 8, 16, 32, 64, 128, 256):
+        child.expect(r"{{ \"entries\" : {}, \"lookups\" : \d+, "
+                     r"\"us\" : \d+, \"missed\" : \d+ }}".format(entries))
+    child.expect_exact("done")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
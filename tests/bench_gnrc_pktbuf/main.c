@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Packet buffer backend benchmark
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "msg.h"
+#include "net/gnrc/pktbuf.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef TEST_ROUNDS
+#define TEST_ROUNDS         (1000U)
+#endif
+
+/* packets allocated per burst */
+#ifndef TEST_BURST
+#define TEST_BURST          (12U)
+#endif
+
+/* packets passed on in the forwarding test */
+#ifndef TEST_FORWARD
+#define TEST_FORWARD        (10000U)
+#endif
+
+#define MSG_QUEUE_SIZE      (8U)
+
+static gnrc_pktsnip_t *_pkts[TEST_BURST];
+static bool _held[TEST_BURST];
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+static msg_t _msg_queue[MSG_QUEUE_SIZE];
+static uint32_t _seed = 1;
+
+/* deterministic so both backends see the same workload */
+static unsigned _rand(unsigned limit)
+{
+    _seed = (_seed * 1103515245U) + 12345U;
+    return (_seed >> 16) % limit;
+}
+
+static gnrc_pktsnip_t *_packet(void)
+{
+    /* payload as received over an IEEE 802.15.4 link */
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, 40 + _rand(88),
+                                          GNRC_NETTYPE_UNDEF);
+    gnrc_pktsnip_t *hdr;
+
+    if (pkt == NULL) {
+        return NULL;
+    }
+    /* decompressed IPv6 header and UDP header */
+    if ((gnrc_pktbuf_mark(pkt, 8 + _rand(32), GNRC_NETTYPE_UNDEF) == NULL) ||
+        (gnrc_pktbuf_mark(pkt, 8, GNRC_NETTYPE_UNDEF) == NULL)) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    /* link layer header */
+    hdr = gnrc_pktbuf_add(pkt, NULL, 12 + _rand(8), GNRC_NETTYPE_NETIF);
+    if (hdr == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    /* grow the payload as reassembly would */
+    if (_rand(4) == 0) {
+        if (gnrc_pktbuf_realloc_data(pkt, pkt->size + 32 + _rand(64)) != 0) {
+            gnrc_pktbuf_release(hdr);
+            return NULL;
+        }
+    }
+    return hdr;
+}
+
+/* the next layer releasing the packets passed on to it */
+static void *_receiver(void *arg)
+{
+    (void)arg;
+
+    msg_init_queue(_msg_queue, MSG_QUEUE_SIZE);
+    while (1) {
+        msg_t msg;
+
+        msg_receive(&msg);
+        gnrc_pktbuf_release(msg.content.ptr);
+    }
+    return NULL;
+}
+
+int main(void)
+{
+    unsigned packets = 0, failed = 0;
+
+    printf("main starting\n");
+
+    uint32_t start = xtimer_now_usec();
+    for (unsigned round = 0; round < TEST_ROUNDS; round++) {
+        unsigned burst = 1 + _rand(TEST_BURST);
+
+        for (unsigned i = 0; i < burst; i++) {
+            _pkts[i] = _packet();
+            _held[i] = false;
+            if (_pkts[i] == NULL) {
+                failed++;
+                continue;
+            }
+            packets++;
+            /* a second user, e.g. a sniffer */
+            if (_rand(3) == 0) {
+                gnrc_pktbuf_hold(_pkts[i], 1);
+                _held[i] = true;
+            }
+        }
+        /* release every other packet first to interleave free and used
+         * space, then the rest and finally the second users */
+        for (unsigned i = 0; i < burst; i += 2) {
+            gnrc_pktbuf_release(_pkts[i]);
+        }
+        for (unsigned i = 1; i < burst; i += 2) {
+            gnrc_pktbuf_release(_pkts[i]);
+        }
+        for (unsigned i = 0; i < burst; i++) {
+            if (_held[i]) {
+                gnrc_pktbuf_release(_pkts[i]);
+            }
+        }
+    }
+    uint32_t duration = xtimer_now_usec() - start;
+
+    printf("{ \"packets\" : %u, \"failed\" : %u, \"us\" : %" PRIu32 " }\n",
+           packets, failed, duration);
+
+    /* allocate in this thread and release in another one, as when
+     * forwarding packets; the receiver runs whenever its queue is full */
+    kernel_pid_t receiver = thread_create(_stack, sizeof(_stack),
+                                          THREAD_PRIORITY_MAIN + 1,
+                                          THREAD_CREATE_STACKTEST,
+                                          _receiver, NULL, "receiver");
+    packets = 0;
+    failed = 0;
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_FORWARD; i++) {
+        msg_t msg;
+
+        msg.content.ptr = _packet();
+        if (msg.content.ptr == NULL) {
+            failed++;
+            thread_yield();
+            continue;
+        }
+        packets++;
+        msg_send(&msg, receiver);
+    }
+    /* let the receiver drain its queue */
+    xtimer_usleep(10000);
+    duration = xtimer_now_usec() - start;
+
+    printf("{ \"forwarded\" : %u, \"failed\" : %u, \"us\" : %" PRIu32 " }\n",
+           packets, failed, duration);
+#ifdef DEVELHELP
+    gnrc_pktbuf_stats();
+#endif
+    puts("done");
+
+    return 0;
+}
@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       6LoWPAN fragmentation goodput benchmark
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "net/ipv6/addr.h"
+#include "net/sock/udp.h"
+#include "shell.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define MAIN_QUEUE_SIZE     (8U)
+
+#define PORT                (8765U)
+
+/* fills the minimum IPv6 MTU */
+#define PAYLOAD_MAX         (1232U)
+
+/* time to wait for the echo of a datagram */
+#define ECHO_TIMEOUT_US     (2U * US_PER_SEC)
+
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+static char _echo_stack[THREAD_STACKSIZE_MAIN];
+static uint8_t _buf[PAYLOAD_MAX];
+
+/* echoes the sequence number of every datagram received */
+static void *_echo_thread(void *arg)
+{
+    static uint8_t buf[PAYLOAD_MAX];
+    sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+    sock_udp_t sock;
+
+    (void)arg;
+    local.port = PORT;
+    if (sock_udp_create(&sock, &local, NULL, 0) < 0) {
+        puts("unable to create echo socket");
+        return NULL;
+    }
+    while (1) {
+        sock_udp_ep_t remote;
+        ssize_t res = sock_udp_recv(&sock, buf, sizeof(buf), SOCK_NO_TIMEOUT,
+                                    &remote);
+
+        if (res >= (ssize_t)sizeof(uint32_t)) {
+            sock_udp_send(&sock, buf, sizeof(uint32_t), &remote);
+        }
+    }
+    return NULL;
+}
+
+static int _send(int argc, char **argv)
+{
+    sock_udp_ep_t remote = { .family = AF_INET6, .port = PORT };
+    sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+    sock_udp_t sock;
+    uint32_t count, size, delivered = 0;
+    gnrc_netif_t *netif = gnrc_netif_iter(NULL);
+
+    if (argc < 4) {
+        printf("usage: %s <addr> <datagrams> <bytes>\n", argv[0]);
+        return 1;
+    }
+    if ((netif == NULL) ||
+        (ipv6_addr_from_str((ipv6_addr_t *)&remote.addr.ipv6, argv[1]) == NULL)) {
+        puts("invalid address");
+        return 1;
+    }
+    remote.netif = netif->pid;
+    count = strtoul(argv[2], NULL, 10);
+    size = strtoul(argv[3], NULL, 10);
+    if ((size < sizeof(uint32_t)) || (size > PAYLOAD_MAX)) {
+        printf("bytes must be between %u and %u\n", (unsigned)sizeof(uint32_t),
+               PAYLOAD_MAX);
+        return 1;
+    }
+    if (sock_udp_create(&sock, &local, NULL, 0) < 0) {
+        puts("unable to create socket");
+        return 1;
+    }
+
+    uint32_t start = xtimer_now_usec();
+
+    /* one datagram at a time, so a sender never runs out of fragmentation
+     * buffers */
+    for (uint32_t i = 0; i < count; i++) {
+        network_uint32_t seq = byteorder_htonl(i);
+        uint32_t deadline;
+
+        memcpy(_buf, &seq, sizeof(seq));
+        if (sock_udp_send(&sock, _buf, size, &remote) < 0) {
+            puts("unable to send");
+            continue;
+        }
+        deadline = xtimer_now_usec() + ECHO_TIMEOUT_US;
+        while (1) {
+            uint32_t now = xtimer_now_usec();
+            network_uint32_t echo;
+
+            if ((int32_t)(deadline - now) <= 0) {
+                break;
+            }
+            if ((sock_udp_recv(&sock, &echo, sizeof(echo), deadline - now,
+                               NULL) == sizeof(echo)) &&
+                (byteorder_ntohl(echo) == i)) {
+                delivered++;
+                break;
+            }
+        }
+    }
+    sock_udp_close(&sock);
+
+    uint32_t duration = xtimer_now_usec() - start;
+    gnrc_sixlowpan_frag_stats_t *stats = gnrc_sixlowpan_frag_stats_get();
+
+    printf("{ \"datagrams\" : %" PRIu32 ", \"delivered\" : %" PRIu32
+           ", \"bytes\" : %" PRIu32 ", \"us\" : %" PRIu32
+           ", \"kbps\" : %" PRIu32,
+           count, delivered, size, duration,
+           duration ? (uint32_t)(((uint64_t)delivered * size * 8 * MS_PER_SEC) /
+                                 duration)
+                    : 0);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    printf(", \"frags_sent\" : %u, \"frags_resent\" : %u",
+           stats->sfr_sent, stats->sfr_resent);
+#else
+    (void)stats;
+#endif
+    puts(" }");
+    return 0;
+}
+
+static const shell_command_t shell_commands[] = {
+    { "send", "Sends <datagrams> UDP datagrams of <bytes> each to <addr>",
+      _send },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+
+    for (unsigned i = 0; i < PAYLOAD_MAX; i++) {
+        _buf[i] = i;
+    }
+    thread_create(_echo_stack, sizeof(_echo_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _echo_thread, NULL, "echo");
+    /* shell commands like ping6 receive from the network stack */
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+    shell_run(shell_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+    return 0;
+}
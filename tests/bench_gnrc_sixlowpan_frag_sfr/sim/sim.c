@@ -0,0 +1,431 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       Host simulation of the goodput of selective fragment recovery
+ *              and of the fragments of RFC 4944 over a lossy link
+ *
+ * The sender side of the comparison runs the actual
+ * `gnrc_sixlowpan_frag_sfr` implementation, everything it uses from the rest
+ * of RIOT is provided here: packets are allocated on the heap, timers and
+ * messages are events of a discrete event simulation and frames are put
+ * on a simulated IEEE 802.15.4 channel that drops every frame independently
+ * with a given probability.
+ *
+ * Channel model: 250 kbit/s, 29 bytes of MAC and PHY overhead and 1 ms of
+ * medium access and turnaround per frame. Every datagram is a 1232 byte UDP
+ * payload, compressed to 1240 bytes and sent in fragments of at most
+ * 102 bytes. A datagram counts as delivered, when a 12 byte echo frame gets
+ * back to the sender, which otherwise waits for two seconds.
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "net/gnrc/sixlowpan/frag/sfr.h"
+#include "panic.h"
+#include "xtimer.h"
+
+#define PAYLOAD_LEN     (1232U)     /**< UDP payload of a datagram */
+#define DGRAM_LEN       (1240U)     /**< compressed datagram */
+#define FRAG_SIZE       (102U)      /**< maximum fragment size */
+#define ECHO_LEN        (12U)       /**< frame of the echo */
+#define ECHO_TIMEOUT    (2U * US_PER_SEC)
+/* 32 us per byte at 250 kbit/s */
+#define FRAME_US(len)   ((((len) + 23U + 6U) * 32U) + 1000U)
+
+enum {
+    EV_FRAME,
+    EV_TIMER,
+    EV_MSG,
+};
+
+typedef struct ev {
+    struct ev *next;
+    void *ptr;
+    msg_t msg;
+    uint32_t time;
+    int kind;
+} ev_t;
+
+static ev_t *_evq;
+static uint32_t _now;
+static uint32_t _chan_free;
+static double _loss;
+static unsigned _frames;
+static unsigned _delivered;
+static int _snips;
+static gnrc_netif_t _netif;
+static gnrc_sixlowpan_frag_stats_t _stats;
+static uint16_t _tag;
+static const uint8_t _addr_a[] = { 0xa, 0, 0, 0, 0, 0, 0, 0 };
+static const uint8_t _addr_b[] = { 0xb, 0, 0, 0, 0, 0, 0, 0 };
+
+volatile thread_t *sched_active_thread;
+volatile kernel_pid_t sched_active_pid;
+volatile uint32_t _xtimer_high_cnt;
+const char assert_crash_message[] = "FAILED ASSERTION.";
+
+/* packet buffer */
+gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, const void *data,
+                                size_t size, gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt = calloc(1, sizeof(*pkt));
+
+    pkt->next = next;
+    pkt->size = size;
+    pkt->type = type;
+    pkt->users = 1;
+    pkt->data = (size) ? malloc(size) : NULL;
+    if (data) {
+        memcpy(pkt->data, data, size);
+    }
+    _snips++;
+    return pkt;
+}
+
+int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
+{
+    pkt->data = realloc(pkt->data, size);
+    pkt->size = size;
+    return 0;
+}
+
+static void _free(gnrc_pktsnip_t *pkt)
+{
+    while (pkt) {
+        gnrc_pktsnip_t *next = pkt->next;
+
+        free(pkt->data);
+        free(pkt);
+        _snips--;
+        pkt = next;
+    }
+}
+
+void gnrc_pktbuf_release_error(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    (void)err;
+    _free(pkt);
+}
+
+gnrc_pktsnip_t *gnrc_pktsnip_search_type(gnrc_pktsnip_t *pkt,
+                                         gnrc_nettype_t type)
+{
+    while (pkt && (pkt->type != type)) {
+        pkt = pkt->next;
+    }
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_netif_hdr_build(const uint8_t *src, uint8_t src_len,
+                                     const uint8_t *dst, uint8_t dst_len)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL,
+                                          sizeof(gnrc_netif_hdr_t) +
+                                          src_len + dst_len,
+                                          GNRC_NETTYPE_NETIF);
+
+    gnrc_netif_hdr_init(pkt->data, src_len, dst_len);
+    if (src) {
+        gnrc_netif_hdr_set_src_addr(pkt->data, src, src_len);
+    }
+    if (dst) {
+        gnrc_netif_hdr_set_dst_addr(pkt->data, dst, dst_len);
+    }
+    return pkt;
+}
+
+/* remaining dependencies of the module */
+gnrc_netif_t *gnrc_netif_get_by_pid(kernel_pid_t pid)
+{
+    (void)pid;
+    return &_netif;
+}
+
+char *gnrc_netif_addr_to_str(const uint8_t *addr, size_t addr_len, char *out)
+{
+    (void)addr;
+    (void)addr_len;
+    out[0] = '\0';
+    return out;
+}
+
+uint16_t gnrc_sixlowpan_frag_next_tag(void)
+{
+    return ++_tag;
+}
+
+gnrc_sixlowpan_frag_stats_t *gnrc_sixlowpan_frag_stats_get(void)
+{
+    return &_stats;
+}
+
+NORETURN void core_panic(core_panic_t crash_code, const char *message)
+{
+    (void)crash_code;
+    fprintf(stderr, "%s\n", message);
+    abort();
+}
+
+void thread_yield(void)
+{
+}
+
+/* events */
+static void _ev_add(uint32_t time, int kind, void *ptr, const msg_t *msg)
+{
+    ev_t *ev = calloc(1, sizeof(*ev));
+    ev_t **pos = &_evq;
+
+    ev->time = time;
+    ev->kind = kind;
+    ev->ptr = ptr;
+    if (msg) {
+        ev->msg = *msg;
+    }
+    /* keep the queue sorted, events of the same time in order of insertion */
+    while (*pos && ((int32_t)((*pos)->time - time) <= 0)) {
+        pos = &(*pos)->next;
+    }
+    ev->next = *pos;
+    *pos = ev;
+}
+
+static void _run_until(uint32_t deadline)
+{
+    while (_evq && ((int32_t)(_evq->time - deadline) <= 0)) {
+        ev_t *ev = _evq;
+
+        _evq = ev->next;
+        _now = ev->time;
+        if (ev->kind == EV_FRAME) {
+            gnrc_sixlowpan_frag_sfr_recv(ev->ptr, NULL, 0);
+        }
+        else if (ev->msg.type == GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF) {
+            gnrc_sixlowpan_frag_sfr_gc();
+        }
+        else {
+            gnrc_sixlowpan_frag_sfr_handle_msg(&ev->msg);
+        }
+        free(ev);
+    }
+    _now = deadline;
+}
+
+unsigned int timer_read(tim_t dev)
+{
+    (void)dev;
+    return _now;
+}
+
+void xtimer_remove(xtimer_t *timer)
+{
+    ev_t **pos = &_evq;
+
+    while (*pos) {
+        if (((*pos)->kind == EV_TIMER) && ((*pos)->ptr == timer)) {
+            ev_t *ev = *pos;
+
+            *pos = ev->next;
+            free(ev);
+        }
+        else {
+            pos = &(*pos)->next;
+        }
+    }
+}
+
+void _xtimer_set_msg(xtimer_t *timer, uint32_t offset, msg_t *msg,
+                     kernel_pid_t target_pid)
+{
+    (void)target_pid;
+    xtimer_remove(timer);
+    _ev_add(_now + offset, EV_TIMER, timer, msg);
+}
+
+int msg_try_send(msg_t *msg, kernel_pid_t target_pid)
+{
+    (void)target_pid;
+    _ev_add(_now, EV_MSG, NULL, msg);
+    return 1;
+}
+
+/* channel */
+static bool _lost(void)
+{
+    return ((double)rand() / RAND_MAX) < _loss;
+}
+
+/* returns the time the frame is completely on air */
+static uint32_t _airtime(size_t len)
+{
+    uint32_t start = ((int32_t)(_chan_free - _now) > 0) ? _chan_free : _now;
+
+    _chan_free = start + FRAME_US(len);
+    _frames++;
+    return _chan_free;
+}
+
+void gnrc_sixlowpan_dispatch_send(gnrc_pktsnip_t *pkt, void *context,
+                                  unsigned page)
+{
+    gnrc_netif_hdr_t *hdr = pkt->data;
+    const uint8_t *dst = gnrc_netif_hdr_get_dst_addr(hdr);
+    uint32_t time = _airtime(pkt->next->size);
+
+    (void)context;
+    (void)page;
+    if (!_lost()) {
+        /* the sender of the frame is the destination's peer */
+        const uint8_t *src = (dst[0] == _addr_b[0]) ? _addr_a : _addr_b;
+        gnrc_pktsnip_t *rx = gnrc_pktbuf_add(NULL, pkt->next->data,
+                                             pkt->next->size,
+                                             GNRC_NETTYPE_SIXLOWPAN);
+
+        rx->next = gnrc_netif_hdr_build(src, sizeof(_addr_a),
+                                        dst, sizeof(_addr_b));
+        _ev_add(time, EV_FRAME, rx, NULL);
+    }
+    _free(pkt);
+}
+
+/* reassembled datagrams end here */
+int _gnrc_netapi_send_recv(kernel_pid_t pid, gnrc_pktsnip_t *pkt,
+                           uint16_t type)
+{
+    const uint8_t *data = pkt->data;
+
+    (void)pid;
+    (void)type;
+    if ((pkt->size != DGRAM_LEN) || (pkt->type != GNRC_NETTYPE_SIXLOWPAN)) {
+        core_panic(PANIC_GENERAL_ERROR, "unexpected datagram");
+    }
+    for (unsigned i = 1; i < DGRAM_LEN; i++) {
+        if (data[i] != data[0]) {
+            core_panic(PANIC_GENERAL_ERROR, "corrupted datagram");
+        }
+    }
+    _delivered++;
+    _free(pkt);
+    return 1;
+}
+
+/* fragments of RFC 4944, 96 bytes of payload behind at most 5 bytes header,
+ * sent back to back; a single lost fragment costs the whole datagram */
+static bool _send_classic(void)
+{
+    bool complete = true;
+    uint32_t time = _now;
+
+    for (unsigned i = 0; i < (DGRAM_LEN + 95U) / 96U; i++) {
+        time = _airtime(96U + 5U);
+        complete = complete && !_lost();
+    }
+    if (complete) {
+        time = _airtime(ECHO_LEN);
+        if (!_lost()) {
+            _run_until(time);
+            return true;
+        }
+    }
+    _run_until(time + ECHO_TIMEOUT);
+    return false;
+}
+
+static bool _send_sfr(unsigned i)
+{
+    gnrc_pktsnip_t *pkt = gnrc_netif_hdr_build(_addr_a, sizeof(_addr_a),
+                                               _addr_b, sizeof(_addr_b));
+    unsigned delivered = _delivered;
+    uint32_t deadline = _now + ECHO_TIMEOUT;
+
+    pkt->next = gnrc_pktbuf_add(NULL, NULL, DGRAM_LEN, GNRC_NETTYPE_SIXLOWPAN);
+    memset(pkt->next->data, i, DGRAM_LEN);
+    if (!gnrc_sixlowpan_frag_sfr_applicable(pkt, &_netif)) {
+        /* all senders busy with earlier datagrams */
+        _free(pkt);
+        return _send_classic();
+    }
+    gnrc_sixlowpan_frag_sfr_send(pkt, NULL, 0);
+    while (_evq && ((int32_t)(_evq->time - deadline) <= 0)) {
+        _run_until(_evq->time);
+        if (_delivered > delivered) {
+            uint32_t time = _airtime(ECHO_LEN);
+
+            if (!_lost()) {
+                _run_until(time);
+                return true;
+            }
+            break;
+        }
+    }
+    _run_until(deadline);
+    return false;
+}
+
+static double _kbps(unsigned ok, uint32_t us)
+{
+    return (ok * PAYLOAD_LEN * 8.0) / (us / 1000.0);
+}
+
+int main(int argc, char **argv)
+{
+    double losses[] = { 0.0, 0.01, 0.02, 0.05, 0.1, 0.2 };
+    unsigned n_losses = sizeof(losses) / sizeof(losses[0]);
+    unsigned n = (argc > 1) ? (unsigned)atoi(argv[1]) : 500U;
+
+    if (argc > 2) {
+        losses[0] = atof(argv[2]);
+        n_losses = 1;
+    }
+    _netif.sixlo.max_frag_size = FRAG_SIZE;
+    srand(1);
+    puts(" loss |  RFC 4944 kbps deliv frames |    SFR kbps deliv frames");
+    for (unsigned l = 0; l < n_losses; l++) {
+        unsigned ok[2] = { 0, 0 }, frames[2];
+        uint32_t us[2];
+
+        _loss = losses[l];
+        for (unsigned sfr = 0; sfr < 2; sfr++) {
+            uint32_t start = _now;
+
+            _frames = 0;
+            for (unsigned i = 0; i < n; i++) {
+                ok[sfr] += (sfr) ? _send_sfr(i) : _send_classic();
+            }
+            us[sfr] = _now - start;
+            frames[sfr] = _frames;
+            /* let the last sender give up before the next run */
+            _run_until(_now + (10U * US_PER_SEC));
+        }
+        printf("%4.0f%% | %13.1f %4.0f%% %6.1f | %8.1f %4.0f%% %6.1f\n",
+               _loss * 100,
+               _kbps(ok[0], us[0]), ok[0] * 100.0 / n, (double)frames[0] / n,
+               _kbps(ok[1], us[1]), ok[1] * 100.0 / n, (double)frames[1] / n);
+    }
+    gnrc_sixlowpan_frag_sfr_reset();
+    if (_snips != 0) {
+        fprintf(stderr, "%d packet snips leaked\n", _snips);
+        return 1;
+    }
+    return 0;
+}
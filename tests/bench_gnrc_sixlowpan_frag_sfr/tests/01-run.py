@@ -0,0 +1,48 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 RIOT developers
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+import pexpect
+from testrunner import run
+
+
+DATAGRAMS = 20
+BYTES = 1232
+
+
+def start_peer():
+    env = os.environ.copy()
+    # swap the ZEP ports of the instance under test
+    local = env.get("ZEP_PORT_LOCAL", "17754")
+    remote = env.get("ZEP_PORT_REMOTE", "17755")
+    env["ZEP_PORT_LOCAL"] = remote
+    env["ZEP_PORT_REMOTE"] = local
+    peer = pexpect.spawnu("make", ["term"], env=env, timeout=10)
+    peer.logfile = sys.stdout
+    peer.sendline("ifconfig")
+    peer.expect(r"inet6 addr: (fe80:[0-9a-f:]+)\s+scope: local")
+    return peer, peer.match.group(1)
+
+
+def testfunc(child):
+    peer, addr = start_peer()
+    try:
+        child.sendline("send {} {} {}".format(addr, DATAGRAMS, BYTES))
+        child.expect(r"{{ \"datagrams\" : {0}, \"delivered\" : {0}, "
+                     r"\"bytes\" : {1}, \"us\" : \d+, \"kbps\" : \d+"
+                     r"(, \"frags_sent\" : \d+, \"frags_resent\" : \d+)? }}"
+                     .format(DATAGRAMS, BYTES))
+    finally:
+        peer.terminate(force=True)
+    print("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=60))
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       GNRC TCP send throughput benchmark
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "net/af.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/tcp.h"
+#include "net/ipv6/addr.h"
+#include "shell.h"
+#include "xtimer.h"
+
+#define MAIN_QUEUE_SIZE     (8U)
+
+/* a multiple of 256, so byte n of the stream is always n % 256 */
+#define CHUNK_SIZE          (1024U)
+
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+static gnrc_tcp_tcb_t _tcb;
+static uint8_t _chunk[CHUNK_SIZE];
+
+static int _send(int argc, char **argv)
+{
+    /* room for the address, "%" and the interface */
+    char addr[IPV6_ADDR_MAX_STR_LEN + 6];
+    uint32_t bytes, sent = 0;
+    int res;
+
+    if (argc < 4) {
+        printf("usage: %s <addr> <port> <bytes>\n", argv[0]);
+        return 1;
+    }
+    if (strchr(argv[1], '%') == NULL) {
+        /* link-local addresses need the interface */
+        gnrc_netif_t *netif = gnrc_netif_iter(NULL);
+
+        snprintf(addr, sizeof(addr), "%s%%%d", argv[1],
+                 (netif != NULL) ? (int)netif->pid : 0);
+    }
+    else {
+        strncpy(addr, argv[1], sizeof(addr) - 1);
+        addr[sizeof(addr) - 1] = '\0';
+    }
+    bytes = strtoul(argv[3], NULL, 10);
+
+    uint32_t start = xtimer_now_usec();
+
+    gnrc_tcp_tcb_init(&_tcb);
+    res = gnrc_tcp_open_active(&_tcb, AF_INET6, addr, atoi(argv[2]), 0);
+    if (res < 0) {
+        printf("unable to connect: %d\n", res);
+        return 1;
+    }
+    while (sent < bytes) {
+        uint32_t off = sent % CHUNK_SIZE;
+        uint32_t len = CHUNK_SIZE - off;
+        ssize_t tmp;
+
+        if (len > (bytes - sent)) {
+            len = bytes - sent;
+        }
+        tmp = gnrc_tcp_send(&_tcb, _chunk + off, len, 0);
+        if (tmp < 0) {
+            printf("unable to send: %d\n", (int)tmp);
+            gnrc_tcp_abort(&_tcb);
+            return 1;
+        }
+        sent += tmp;
+    }
+    /* returns when all data was acknowledged */
+    gnrc_tcp_close(&_tcb);
+
+    uint32_t duration = xtimer_now_usec() - start;
+
+    printf("{ \"bytes\" : %" PRIu32 ", \"us\" : %" PRIu32
+           ", \"kbps\" : %" PRIu32 ", \"max_in_flight\" : %u",
+           bytes, duration,
+           duration ? (uint32_t)(((uint64_t)bytes * 8 * MS_PER_SEC) / duration) : 0,
+           GNRC_TCP_RETRANSMIT_QUEUE_SIZE);
+#ifdef MODULE_GNRC_TCP_SACK
+    printf(", \"rtx_avoided\" : %" PRIu32, _tcb.rtx_avoided);
+#endif
+    puts(" }");
+    return 0;
+}
+
+static const shell_command_t shell_commands[] = {
+    { "send", "Sends <bytes> to a TCP server at <addr> <port>", _send },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+
+    for (unsigned i = 0; i < CHUNK_SIZE; i++) {
+        _chunk[i] = i;
+    }
+    /* shell commands like ping6 receive from the network stack */
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+    shell_run(shell_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+    return 0;
+}
@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 RIOT developers
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import socket
+import subprocess
+import sys
+import threading
+
+from testrunner import run
+
+
+BYTES = 200000
+PORT = 8765
+
+
+def get_link_local(iface):
+    out = subprocess.check_output(["ip", "-6", "addr", "show", "dev", iface,
+                                   "scope", "link"]).decode()
+    for line in out.splitlines():
+        line = line.strip()
+        if line.startswith("inet6 "):
+            return line.split()[1].split("/")[0]
+    raise RuntimeError("{} has no link-local address".format(iface))
+
+
+class Server(threading.Thread):
+    def __init__(self, addr, iface):
+        super().__init__(daemon=True)
+        self.sock = socket.socket(socket.AF_INET6, socket.SOCK_STREAM)
+        self.sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+        self.sock.bind((addr, PORT, 0, socket.if_nametoindex(iface)))
+        self.sock.listen(1)
+        self.received = bytearray()
+
+    def run(self):
+        conn, _ = self.sock.accept()
+        with conn:
+            while True:
+                data = conn.recv(4096)
+                if not data:
+                    break
+                self.received += data
+
+
+def testfunc(child):
+    tap = os.environ["TAP"]
+    addr = get_link_local(tap)
+    server = Server(addr, tap)
+    server.start()
+    child.sendline("send {} {} {}".format(addr, PORT, BYTES))
+    child.expect(r"{{ \"bytes\" : {}, \"us\" : \d+, \"kbps\" : \d+, "
+                 r"\"max_in_flight\" : \d+(, \"rtx_avoided\" : \d+)? }}".format(BYTES))
+    server.join(timeout=10)
+    assert len(server.received) == BYTES
+    assert all(b == (i % 256) for i, b in enumerate(server.received))
+    print("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=60))
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Internet checksum benchmark
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "kernel_defines.h"
+#include "net/inet_csum.h"
+#include "xtimer.h"
+
+/* checksum calculations per length and offset */
+#ifndef TEST_RUNS
+#define TEST_RUNS           (1000U)
+#endif
+
+#define TEST_BUF_SIZE       (1500U + 1U)
+
+static const uint16_t _lens[] = { 64, 128, 256, 512, 1024, 1500 };
+static uint8_t _buf[TEST_BUF_SIZE] __attribute__((aligned(4)));
+
+/* the byte-by-byte checksum inet_csum() used to implement */
+static uint16_t _bytewise(uint16_t sum, const uint8_t *buf, uint16_t len)
+{
+    uint32_t csum = sum;
+
+    for (unsigned i = 0; i < (len >> 1U); buf += 2, i++) {
+        csum += (uint16_t)(*buf << 8) + *(buf + 1);
+    }
+    if (len & 1) {
+        csum += (uint16_t)(*buf << 8);
+    }
+    while (csum >> 16) {
+        csum = (csum & 0xffff) + (csum >> 16);
+    }
+    return csum;
+}
+
+static void _run(uint16_t len, unsigned offset)
+{
+    const uint8_t *buf = &_buf[offset];
+    uint16_t csum = 0, ref = 0;
+    uint32_t start, duration, bytewise;
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        /* chain the results so the calls can't be optimized out */
+        csum = inet_csum(csum, buf, len);
+    }
+    duration = xtimer_now_usec() - start;
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        ref = _bytewise(ref, buf, len);
+    }
+    bytewise = xtimer_now_usec() - start;
+    printf("{ \"len\" : %u, \"offset\" : %u, \"runs\" : %u, \"us\" : %" PRIu32
+           ", \"bytewise_us\" : %" PRIu32 ", \"match\" : %s }\n",
+           len, offset, TEST_RUNS, duration, bytewise,
+           (csum == ref) ? "true" : "false");
+}
+
+int main(void)
+{
+    for (unsigned i = 0; i < sizeof(_buf); i++) {
+        _buf[i] = (uint8_t)((i * 0x9d) ^ (i >> 3));
+    }
+    for (unsigned i = 0; i < ARRAY_SIZE(_lens); i++) {
+        _run(_lens[i], 0);
+        _run(_lens[i], 1);
+    }
+    puts("done");
+    return 0;
+}
@@ -0,0 +1,23 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 RIOT developers
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    for length in (64, 128, 256, 512, 1024, 1500):
+        for offset in (0, 1):
+            child.expect(r"{{ \"len\" : {}, \"offset\" : {}, \"runs\" : \d+, "
+                         r"\"us\" : \d+, \"bytewise_us\" : \d+, "
+                         r"\"match\" : true }}".format(length, offset))
+    child.expect_exact("done")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
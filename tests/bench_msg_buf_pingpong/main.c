@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Message buffer ping-pong benchmark test application
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "msg.h"
+#include "msg_buf.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef TEST_DURATION
+#define TEST_DURATION       (1000000U)
+#endif
+
+#define MAX_SIZE            (1024U)
+
+#define TYPE_COPY           (0)
+#define TYPE_MSG_BUF        (1)
+
+static volatile unsigned _flag;
+static char _stack[THREAD_STACKSIZE_MAIN];
+static kernel_pid_t _main_pid;
+
+static MSG_BUF_POOL_STORAGE(_storage, MAX_SIZE, 1);
+static msg_buf_pool_t _pool;
+
+/* shared buffer and private buffers of both threads for copying */
+static uint8_t _shared[MAX_SIZE];
+static uint8_t _local[2][MAX_SIZE];
+static size_t _size;
+
+static const uint16_t _sizes[] = { 64, 128, 256, 512, 1024 };
+
+static void _timer_callback(void *arg)
+{
+    (void)arg;
+
+    _flag = 1;
+}
+
+static void _touch(uint8_t *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        data[i]++;
+    }
+}
+
+static void *_second_thread(void *arg)
+{
+    (void)arg;
+    msg_t m;
+
+    while (1) {
+        msg_receive(&m);
+        if (m.type == TYPE_COPY) {
+            memcpy(_local[1], _shared, _size);
+            _touch(_local[1], _size);
+            memcpy(_shared, _local[1], _size);
+            msg_send(&m, _main_pid);
+        }
+        else {
+            msg_buf_t *buf = msg_buf_claim(&m);
+            _touch(msg_buf_data(buf), buf->len);
+            msg_buf_send(&m, buf, _main_pid);
+        }
+    }
+
+    return NULL;
+}
+
+static uint32_t _run_copy(kernel_pid_t other)
+{
+    xtimer_t timer = { .callback = _timer_callback };
+    msg_t m = { .type = TYPE_COPY };
+    uint32_t n = 0;
+
+    _flag = 0;
+    xtimer_set(&timer, TEST_DURATION);
+    while (!_flag) {
+        _touch(_local[0], _size);
+        memcpy(_shared, _local[0], _size);
+        msg_send(&m, other);
+        msg_receive(&m);
+        memcpy(_local[0], _shared, _size);
+        n++;
+    }
+    return n;
+}
+
+static uint32_t _run_msg_buf(kernel_pid_t other)
+{
+    xtimer_t timer = { .callback = _timer_callback };
+    msg_t m = { .type = TYPE_MSG_BUF };
+    msg_buf_t *buf = msg_buf_alloc(&_pool);
+    uint32_t n = 0;
+
+    buf->len = _size;
+    _flag = 0;
+    xtimer_set(&timer, TEST_DURATION);
+    while (!_flag) {
+        _touch(msg_buf_data(buf), buf->len);
+        msg_buf_send(&m, buf, other);
+        msg_receive(&m);
+        buf = msg_buf_claim(&m);
+        n++;
+    }
+    msg_buf_free(buf);
+    return n;
+}
+
+int main(void)
+{
+    printf("main starting\n");
+
+    _main_pid = thread_getpid();
+    msg_buf_pool_init(&_pool, _storage, MAX_SIZE, 1);
+
+    kernel_pid_t other = thread_create(_stack,
+                                       sizeof(_stack),
+                                       (THREAD_PRIORITY_MAIN - 1),
+                                       THREAD_CREATE_STACKTEST,
+                                       _second_thread,
+                                       NULL,
+                                       "second_thread");
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_sizes); i++) {
+        _size = _sizes[i];
+        uint32_t copy = _run_copy(other);
+        uint32_t zero_copy = _run_msg_buf(other);
+
+        printf("{ \"size\" : %u, \"copy\" : %" PRIu32 ", \"msg_buf\" : %"
+               PRIu32 " }\n", (unsigned)_size, copy, zero_copy);
+    }
+
+    puts("done");
+
+    return 0;
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Round-robin time slicing benchmark test application
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "sched.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef TEST_DURATION
+#define TEST_DURATION       (1000000U)
+#endif
+
+#ifndef TEST_THREADS
+#define TEST_THREADS        (3U)
+#endif
+
+/* lets the busy threads see the end of a run and exit */
+#define TEST_SETTLE         (10U * US_PER_MS)
+
+static char _stacks[TEST_THREADS][THREAD_STACKSIZE_DEFAULT];
+static kernel_pid_t _pids[TEST_THREADS];
+static volatile uint32_t _work[TEST_THREADS];
+static volatile unsigned _running;
+static volatile uint32_t _switches;
+
+static int _is_busy(kernel_pid_t pid)
+{
+    for (unsigned i = 0; i < TEST_THREADS; i++) {
+        if (_pids[i] == pid) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void _sched_cb(kernel_pid_t active, kernel_pid_t next)
+{
+    if (_is_busy(active) && _is_busy(next)) {
+        _switches++;
+    }
+}
+
+static void *_busy_thread(void *arg)
+{
+    volatile uint32_t *work = arg;
+
+    while (_running) {
+        (*work)++;
+    }
+
+    return NULL;
+}
+
+static uint32_t _run(unsigned numof)
+{
+    uint32_t total = 0;
+
+    _running = 1;
+    _switches = 0;
+    for (unsigned i = 0; i < numof; i++) {
+        _work[i] = 0;
+        _pids[i] = thread_create(_stacks[i], sizeof(_stacks[i]),
+                                 THREAD_PRIORITY_MAIN + 1,
+                                 THREAD_CREATE_WOUT_YIELD | THREAD_CREATE_STACKTEST,
+                                 _busy_thread, (void *)&_work[i], "busy");
+    }
+
+    xtimer_usleep(TEST_DURATION);
+    _running = 0;
+    xtimer_usleep(TEST_SETTLE);
+
+    for (unsigned i = 0; i < numof; i++) {
+        _pids[i] = KERNEL_PID_UNDEF;
+        total += _work[i];
+    }
+    return total;
+}
+
+int main(void)
+{
+    puts("round-robin benchmark starting");
+
+    for (unsigned i = 0; i < TEST_THREADS; i++) {
+        _pids[i] = KERNEL_PID_UNDEF;
+    }
+    sched_register_cb(_sched_cb);
+
+    uint32_t single = _run(1);
+    uint32_t total = _run(TEST_THREADS);
+
+    uint32_t min = UINT32_MAX;
+    uint32_t max = 0;
+    for (unsigned i = 0; i < TEST_THREADS; i++) {
+        printf("thread %u: %" PRIu32 "\n", i, _work[i]);
+        if (_work[i] < min) {
+            min = _work[i];
+        }
+        if (_work[i] > max) {
+            max = _work[i];
+        }
+    }
+
+    uint32_t overhead = 0;
+    if (_switches && (total < single)) {
+        /* work lost per switch, converted to time */
+        overhead = (uint64_t)(single - total) * TEST_DURATION * NS_PER_US
+                   / single / _switches;
+    }
+
+    printf("{ \"switches\" : %" PRIu32 ", \"fairness\" : %" PRIu32
+           ", \"overhead\" : %" PRIu32 " }\n",
+           _switches, max ? (uint32_t)((uint64_t)min * 100 / max) : 0,
+           overhead);
+
+    return 0;
+}
@@ -0,0 +1,21 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 RIOT developers
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect(r"{ \"switches\" : (\d+), \"fairness\" : (\d+), "
+                 r"\"overhead\" : \d+ }")
+    assert int(child.match.group(1)) > 0
+    assert int(child.match.group(2)) > 0
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -241,6 +241,24 @@ extern "C" {
 /* estimate_cpu_overhead will loop for this many iterations to get a proper estimate */
 #define ESTIMATE_CPU_ITERATIONS 2048
 
+/* Measure xtimer_set/xtimer_remove cost versus the number of armed timers
+ * before running the statistical benchmark, only used with TEST_XTIMER */
+#ifndef TEST_XTIMER_SCALING
+#define TEST_XTIMER_SCALING 0
+#endif
+/* Maximum number of simultaneously armed timers in the scaling benchmark */
+#ifndef TEST_SCALING_MAX
+#define TEST_SCALING_MAX 1000
+#endif
+/* Number of set/remove calls averaged per table row */
+#ifndef TEST_SCALING_REPEAT
+#define TEST_SCALING_REPEAT 256
+#endif
+/* Background timers are spread over this many seconds */
+#ifndef TEST_SCALING_SPREAD
+#define TEST_SCALING_SPREAD 60
+#endif
+
 #if TEST_XTIMER
 #define READ_TUT() _xtimer_now()
 #else
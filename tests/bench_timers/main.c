@@ -41,6 +41,7 @@
 #include "periph/timer.h"
 
 #include "print_results.h"
+#include "scaling.h"
 #include "spin_random.h"
 #include "bench_timers_config.h"
 
@@ -731,6 +732,10 @@ int main(void)
 
     set_limits();
 
+#if TEST_XTIMER && TEST_XTIMER_SCALING
+    bench_xtimer_scaling();
+#endif
+
     print_str("Calibrating spin delay...\n");
     uint32_t spin_max = spin_random_calibrate(TIM_TEST_DEV, SPIN_MAX_TARGET);
     print_str("spin_max = ");
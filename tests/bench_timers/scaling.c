@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       xtimer insertion/removal cost versus number of armed timers
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ *
+ * @}
+ */
+
+#include <stdint.h>
+
+#include "fmt.h"
+#include "kernel_defines.h"
+#include "random.h"
+#include "periph/timer.h"
+
+#include "bench_timers_config.h"
+#include "scaling.h"
+
+#if TEST_XTIMER_SCALING
+
+/* Background timers, these are armed but never expire during a measurement */
+static xtimer_t background[TEST_SCALING_MAX];
+
+/* Timer that is set and removed while the background timers are armed */
+static xtimer_t probe;
+
+/* Number of background timers for each row of the result table */
+static const unsigned steps[] = { 1, 10, 50, 100, 250, 500, 1000 };
+
+static void nop(void *arg)
+{
+    (void)arg;
+}
+
+static uint32_t random_offset(void)
+{
+    /* spread the timers between one and TEST_SCALING_SPREAD seconds into
+     * the future, so none of them expires during the measurement */
+    return xtimer_ticks_from_usec(US_PER_SEC +
+               random_uint32_range(0, TEST_SCALING_SPREAD * US_PER_SEC)).ticks32;
+}
+
+void bench_xtimer_scaling(void)
+{
+    unsigned armed = 0;
+
+    print_str("\nxtimer_set/xtimer_remove cost (reference ticks per call)\n");
+    print_str("timers        set     remove\n");
+    for (unsigned k = 0; k < ARRAY_SIZE(steps); ++k) {
+        unsigned num = steps[k];
+        uint32_t set_total = 0;
+        uint32_t remove_total = 0;
+
+        if (num > TEST_SCALING_MAX) {
+            break;
+        }
+        while (armed < num) {
+            background[armed].callback = nop;
+            _xtimer_set(&background[armed], random_offset());
+            ++armed;
+        }
+        probe.callback = nop;
+        for (unsigned i = 0; i < TEST_SCALING_REPEAT; ++i) {
+            uint32_t offset = random_offset();
+            unsigned int begin = timer_read(TIM_REF_DEV);
+            _xtimer_set(&probe, offset);
+            unsigned int mid = timer_read(TIM_REF_DEV);
+            xtimer_remove(&probe);
+            unsigned int end = timer_read(TIM_REF_DEV);
+            set_total += mid - begin;
+            remove_total += end - mid;
+        }
+        print_u32_dec(num);
+        print_str("\t");
+        print_u32_dec(set_total / TEST_SCALING_REPEAT);
+        print_str("\t");
+        print_u32_dec(remove_total / TEST_SCALING_REPEAT);
+        print_str("\n");
+    }
+    while (armed) {
+        xtimer_remove(&background[--armed]);
+    }
+    print_str("\n");
+}
+
+#endif /* TEST_XTIMER_SCALING */
@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       xtimer insertion/removal cost versus number of armed timers
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ */
+
+#ifndef SCALING_H
+#define SCALING_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Measure the cost of xtimer_set and xtimer_remove while an
+ *          increasing number of other timers is armed
+ *
+ * Results are printed as a table on stdout, in reference timer ticks.
+ *
+ * @pre     The reference timer must be initialized
+ */
+void bench_xtimer_scaling(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCALING_H */
+/** @} */
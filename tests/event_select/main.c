@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for waiting on several event sources
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "assert.h"
+#include "event.h"
+#include "msg.h"
+#include "thread.h"
+
+#define MSG_QUEUE_SIZE  (4U)
+#define TEST_FLAG       (0x2)
+#define MSG_TYPE        (0x4242)
+
+static char stack[THREAD_STACKSIZE_DEFAULT];
+static msg_t msg_queue[MSG_QUEUE_SIZE];
+
+static event_queue_t queues[2];
+static void handler(event_t *event);
+static event_t ev_high = { .handler = handler };
+static event_t ev_low = { .handler = handler };
+
+static thread_t *main_thread;
+
+static void handler(event_t *event)
+{
+    (void)event;
+}
+
+static void *_source(void *arg)
+{
+    (void)arg;
+    msg_t msg = { .type = MSG_TYPE };
+
+    /* main blocks on event_select() whenever this thread gets to run */
+    msg_send(&msg, main_thread->pid);
+    event_post(&queues[1], &ev_low);
+    thread_flags_set(main_thread, TEST_FLAG);
+
+    return NULL;
+}
+
+static const char *_select(const event_select_t *sel)
+{
+    event_select_res_t res;
+
+    switch (event_select(sel, &res)) {
+        case EVENT_SELECT_EVENT:
+            if (res.event == &ev_high) {
+                assert(res.queue == 0);
+                return "high";
+            }
+            assert(res.event == &ev_low);
+            assert(res.queue == 1);
+            return "low";
+        case EVENT_SELECT_FLAGS:
+            assert(res.flags == TEST_FLAG);
+            return "flags";
+        case EVENT_SELECT_MSG:
+            assert(sel->msg->type == MSG_TYPE);
+            return "msg";
+    }
+    return "?";
+}
+
+int main(void)
+{
+    msg_t msg = { .type = MSG_TYPE };
+    event_select_t sel = {
+        .queues = queues,
+        .n_queues = 2,
+        .flags = TEST_FLAG,
+        .msg = &msg,
+    };
+
+    main_thread = (thread_t *)sched_active_thread;
+    msg_init_queue(msg_queue, MSG_QUEUE_SIZE);
+    event_queue_init(&queues[0]);
+    event_queue_init(&queues[1]);
+
+    /* all sources ready at once: served by priority, one per call */
+    msg_send_to_self(&msg);
+    thread_flags_set(main_thread, TEST_FLAG);
+    event_post(&queues[1], &ev_low);
+    event_post(&queues[0], &ev_high);
+
+    printf("priority order:");
+    for (unsigned i = 0; i < 4; i++) {
+        printf(" %s", _select(&sel));
+    }
+    puts("");
+
+    /* sources becoming ready while blocked: served as they arrive */
+    thread_create(stack, sizeof(stack), THREAD_PRIORITY_MAIN + 1,
+                  THREAD_CREATE_STACKTEST, _source, NULL, "source");
+
+    printf("blocking:");
+    for (unsigned i = 0; i < 3; i++) {
+        printf(" %s", _select(&sel));
+    }
+    puts("");
+
+    assert(event_get_multi(queues, 2) == NULL);
+    puts("[SUCCESS]");
+
+    return 0;
+}
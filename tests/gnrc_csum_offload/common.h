@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    tests_gnrc_csum_offload Common header for GNRC's checksum
+ *                                      offload tests
+ * @ingroup     tests
+ * @brief       Common definitions for GNRC's checksum offload tests
+ * @{
+ *
+ * @file
+ *
+ * @author  RIOT developers <devel@riot-os.org>
+ */
+#ifndef COMMON_H
+#define COMMON_H
+
+#include "net/gnrc/netif.h"
+#include "net/netdev_test.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define _LL0            (0xce)
+#define _LL1            (0xab)
+#define _LL2            (0xfe)
+#define _LL3            (0xad)
+#define _LL4            (0xf7)
+#define _LL5            (0x26)
+
+extern gnrc_netif_t *_mock_netif;
+extern netdev_test_t _mock_netdev;
+
+void _tests_init(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COMMON_H */
+/** @} */
@@ -0,0 +1,281 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests checksum offloading in GNRC
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "common.h"
+#include "embUnit.h"
+#include "msg.h"
+#include "net/ethernet/hdr.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/ipv6/nib.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/udp.h"
+#include "net/protnum.h"
+#include "net/udp.h"
+#include "sched.h"
+#include "xtimer.h"
+
+#define _MSG_QUEUE_SIZE     (4U)
+#define _MSG_TYPE_SENT      (0x4343)
+#define _TIMEOUT            (100U * US_PER_MS)
+#define _SRC_PORT           (0x4d2a)
+#define _DST_PORT           (0x4d2b)
+#define _WRONG_CSUM         (0xdead)
+#define _NBR_MAC            { 0x57, 0x44, 0x33, 0x22, 0x11, 0x00, }
+#define _NBR_LINK_LOCAL     { 0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, \
+                              0x55, 0x44, 0x33, 0xff, 0xfe, 0x22, 0x11, 0x00, }
+
+static const uint8_t _nbr_mac[] = _NBR_MAC;
+static const ipv6_addr_t _nbr_ll = { .u8 = _NBR_LINK_LOCAL };
+static const uint8_t _payload[] = { 0x54, 0xb8, 0x59, 0xaf, 0x3a, 0xb4,
+                                    0x5c, 0x85, 0x1e, 0xce, 0xe2, 0xeb };
+static msg_t _msg_queue[_MSG_QUEUE_SIZE];
+static gnrc_netreg_entry_t _udp_entry;
+static kernel_pid_t _main_pid;
+static uint8_t _frame[sizeof(ethernet_hdr_t) + sizeof(ipv6_hdr_t) +
+                      sizeof(udp_hdr_t) + sizeof(_payload)];
+
+static int _send_frame(netdev_t *dev, const iolist_t *iolist)
+{
+    size_t len = 0;
+    ipv6_hdr_t *ipv6 = (ipv6_hdr_t *)&_frame[sizeof(ethernet_hdr_t)];
+    msg_t msg = { .type = _MSG_TYPE_SENT };
+
+    (void)dev;
+    for (; iolist != NULL; iolist = iolist->iol_next) {
+        if ((len + iolist->iol_len) > sizeof(_frame)) {
+            /* not one of ours */
+            return len + iolist->iol_len;
+        }
+        memcpy(&_frame[len], iolist->iol_base, iolist->iol_len);
+        len += iolist->iol_len;
+    }
+    /* ignore neighbor discovery */
+    if ((len == sizeof(_frame)) && (ipv6->nh == PROTNUM_UDP)) {
+        msg_try_send(&msg, _main_pid);
+    }
+    return len;
+}
+
+static bool _wait_for(msg_t *msg, uint16_t type)
+{
+    uint32_t start = xtimer_now_usec();
+    uint32_t waited;
+
+    while ((waited = xtimer_now_usec() - start) < _TIMEOUT) {
+        if (xtimer_msg_receive_timeout(msg, _TIMEOUT - waited) < 0) {
+            return false;
+        }
+        if (msg->type == type) {
+            return true;
+        }
+        if (msg->type == GNRC_NETAPI_MSG_TYPE_RCV) {
+            gnrc_pktbuf_release(msg->content.ptr);
+        }
+    }
+    return false;
+}
+
+static bool _recv_udp(uint16_t *csum)
+{
+    msg_t msg;
+    gnrc_pktsnip_t *udp;
+
+    if (!_wait_for(&msg, GNRC_NETAPI_MSG_TYPE_RCV)) {
+        return false;
+    }
+    udp = gnrc_pktsnip_search_type(msg.content.ptr, GNRC_NETTYPE_UDP);
+    if (udp != NULL) {
+        *csum = byteorder_ntohs(((udp_hdr_t *)udp->data)->checksum);
+    }
+    gnrc_pktbuf_release(msg.content.ptr);
+    return (udp != NULL);
+}
+
+static uint16_t _sent_csum(void)
+{
+    udp_hdr_t *udp = (udp_hdr_t *)&_frame[sizeof(ethernet_hdr_t) +
+                                          sizeof(ipv6_hdr_t)];
+
+    return byteorder_ntohs(udp->checksum);
+}
+
+static void _set_tx_csum_offload(netopt_enable_t enable)
+{
+    int res = gnrc_netapi_set(_mock_netif->pid, NETOPT_TX_CSUM_OFFLOAD, 0,
+                              &enable, sizeof(enable));
+
+    (void)res;
+    assert(res == sizeof(enable));
+}
+
+static gnrc_pktsnip_t *_build_recvd_pkt(uint8_t netif_hdr_flags)
+{
+    gnrc_pktsnip_t *netif, *pkt;
+    gnrc_netif_hdr_t *netif_hdr;
+    ipv6_hdr_t *ipv6;
+    udp_hdr_t *udp;
+    const size_t udp_len = sizeof(udp_hdr_t) + sizeof(_payload);
+
+    netif = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
+    assert(netif != NULL);
+    netif_hdr = netif->data;
+    gnrc_netif_hdr_set_netif(netif_hdr, _mock_netif);
+    netif_hdr->flags = netif_hdr_flags;
+    pkt = gnrc_pktbuf_add(netif, NULL, sizeof(ipv6_hdr_t) + udp_len,
+                          GNRC_NETTYPE_IPV6);
+    assert(pkt != NULL);
+    ipv6 = pkt->data;
+    memset(ipv6, 0, sizeof(ipv6_hdr_t));
+    ipv6_hdr_set_version(ipv6);
+    ipv6->len = byteorder_htons(udp_len);
+    ipv6->nh = PROTNUM_UDP;
+    ipv6->hl = 64;
+    memcpy(&ipv6->src, &_nbr_ll, sizeof(ipv6->src));
+    memcpy(&ipv6->dst, &_mock_netif->ipv6.addrs[0], sizeof(ipv6->dst));
+    udp = (udp_hdr_t *)(ipv6 + 1);
+    udp->src_port = byteorder_htons(_SRC_PORT);
+    udp->dst_port = byteorder_htons(_DST_PORT);
+    udp->length = byteorder_htons(udp_len);
+    udp->checksum = byteorder_htons(_WRONG_CSUM);
+    memcpy(udp + 1, _payload, sizeof(_payload));
+    return pkt;
+}
+
+static void _send_udp(const ipv6_addr_t *dst)
+{
+    gnrc_pktsnip_t *pkt, *netif;
+
+    pkt = gnrc_pktbuf_add(NULL, _payload, sizeof(_payload),
+                          GNRC_NETTYPE_UNDEF);
+    assert(pkt != NULL);
+    pkt = gnrc_udp_hdr_build(pkt, _SRC_PORT, _DST_PORT);
+    assert(pkt != NULL);
+    pkt = gnrc_ipv6_hdr_build(pkt, NULL, dst);
+    assert(pkt != NULL);
+    netif = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
+    assert(netif != NULL);
+    gnrc_netif_hdr_set_netif(netif->data, _mock_netif);
+    LL_PREPEND(pkt, netif);
+    if (!gnrc_netapi_dispatch_send(GNRC_NETTYPE_UDP, GNRC_NETREG_DEMUX_CTX_ALL,
+                                   pkt)) {
+        gnrc_pktbuf_release(pkt);
+    }
+}
+
+static void set_up(void)
+{
+    _set_tx_csum_offload(NETOPT_DISABLE);
+}
+
+static void test_recv__verified_wrong_csum(void)
+{
+    uint16_t csum = 0;
+
+    TEST_ASSERT(gnrc_netapi_dispatch_receive(
+            GNRC_NETTYPE_IPV6, GNRC_NETREG_DEMUX_CTX_ALL,
+            _build_recvd_pkt(GNRC_NETIF_HDR_FLAGS_CSUM_VERIFIED)) > 0);
+    TEST_ASSERT(_recv_udp(&csum));
+    TEST_ASSERT_EQUAL_INT(_WRONG_CSUM, csum);
+}
+
+static void test_recv__unverified_wrong_csum(void)
+{
+    uint16_t csum = 0;
+
+    TEST_ASSERT(gnrc_netapi_dispatch_receive(GNRC_NETTYPE_IPV6,
+                                             GNRC_NETREG_DEMUX_CTX_ALL,
+                                             _build_recvd_pkt(0)) > 0);
+    TEST_ASSERT(!_recv_udp(&csum));
+}
+
+static void test_send__no_offload(void)
+{
+    msg_t msg;
+
+    TEST_ASSERT(!(_mock_netif->flags & GNRC_NETIF_FLAGS_TX_CSUM_OFFLOAD));
+    _send_udp(&_nbr_ll);
+    TEST_ASSERT(_wait_for(&msg, _MSG_TYPE_SENT));
+    TEST_ASSERT(_sent_csum() != 0);
+}
+
+static void test_send__offload(void)
+{
+    msg_t msg;
+
+    _set_tx_csum_offload(NETOPT_ENABLE);
+    TEST_ASSERT(_mock_netif->flags & GNRC_NETIF_FLAGS_TX_CSUM_OFFLOAD);
+    _send_udp(&_nbr_ll);
+    TEST_ASSERT(_wait_for(&msg, _MSG_TYPE_SENT));
+    /* left as gnrc_udp_hdr_build() initialized it for the device */
+    TEST_ASSERT_EQUAL_INT(0, _sent_csum());
+}
+
+static void test_send__offload_to_self(void)
+{
+    uint16_t csum = 0;
+
+    _set_tx_csum_offload(NETOPT_ENABLE);
+    _send_udp(&_mock_netif->ipv6.addrs[0]);
+    /* gnrc_udp drops packets with a zero or wrong checksum, so receiving it
+     * shows the checksum was calculated although the device offloads it */
+    TEST_ASSERT(_recv_udp(&csum));
+    TEST_ASSERT(csum != 0);
+}
+
+static Test *tests_gnrc_csum_offload(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_recv__verified_wrong_csum),
+        new_TestFixture(test_recv__unverified_wrong_csum),
+        new_TestFixture(test_send__no_offload),
+        new_TestFixture(test_send__offload),
+        new_TestFixture(test_send__offload_to_self),
+    };
+
+    EMB_UNIT_TESTCALLER(tests, set_up, NULL, fixtures);
+
+    return (Test *)&tests;
+}
+
+int main(void)
+{
+    int res;
+
+    _main_pid = sched_active_pid;
+    msg_init_queue(_msg_queue, _MSG_QUEUE_SIZE);
+    _tests_init();
+    netdev_test_set_send_cb(&_mock_netdev, _send_frame);
+    res = gnrc_ipv6_nib_nc_set(&_nbr_ll, _mock_netif->pid,
+                               _nbr_mac, sizeof(_nbr_mac));
+    (void)res;
+    assert(res == 0);
+    gnrc_netreg_entry_init_pid(&_udp_entry, _DST_PORT, _main_pid);
+    gnrc_netreg_register(GNRC_NETTYPE_UDP, &_udp_entry);
+
+    TESTS_START();
+    TESTS_RUN(tests_gnrc_csum_offload());
+    TESTS_END();
+
+    return 0;
+}
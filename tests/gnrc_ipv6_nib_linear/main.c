@@ -0,0 +1,36 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Runs the NIB unittests without indexes for its tables
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ *
+ * @}
+ */
+
+#include "embUnit.h"
+#include "net/gnrc/ipv6/nib/conf.h"
+
+#include "tests-gnrc_ipv6_nib.h"
+
+#if GNRC_IPV6_NIB_CONF_FT_TRIE || GNRC_IPV6_NIB_CONF_NC_HASH
+#error "tests the linear lookups of the NIB"
+#endif
+
+int main(void)
+{
+    TESTS_START();
+    tests_gnrc_ipv6_nib();
+    TESTS_END();
+    return 0;
+}
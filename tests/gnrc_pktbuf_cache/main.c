@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the per-thread packet buffer caches
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ *
+ * @}
+ */
+
+#include <stddef.h>
+
+#include "embUnit.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/pktbuf/cache.h"
+
+/* magazine of the thread and full depot */
+#define TEST_CACHED         ((1 + GNRC_PKTBUF_CACHE_DEPOT) * \
+                             GNRC_PKTBUF_CACHE_SIZE)
+/* packets of a snip and a data chunk each, so the caches can hold all */
+#define TEST_NUMOF          (TEST_CACHED / 2)
+/* the packets take up nearly all of the packet buffer ... */
+#define TEST_SMALL_SIZE     ((GNRC_PKTBUF_SIZE / TEST_NUMOF) - \
+                             (2 * sizeof(gnrc_pktsnip_t)))
+/* ... so this does not fit while the caches hold them */
+#define TEST_LARGE_SIZE     (GNRC_PKTBUF_SIZE / 2)
+
+static gnrc_pktsnip_t *_pkts[TEST_NUMOF];
+
+static void _set_up(void)
+{
+    gnrc_pktbuf_init();
+}
+
+static void _fill(size_t size)
+{
+    for (unsigned i = 0; i < TEST_NUMOF; i++) {
+        _pkts[i] = gnrc_pktbuf_add(NULL, NULL, size, GNRC_NETTYPE_UNDEF);
+        TEST_ASSERT_NOT_NULL(_pkts[i]);
+    }
+}
+
+static void _release(void)
+{
+    for (unsigned i = 0; i < TEST_NUMOF; i++) {
+        gnrc_pktbuf_release(_pkts[i]);
+    }
+}
+
+static void test_pktbuf_cache__same_size(void)
+{
+    _fill(TEST_SMALL_SIZE);
+    _release();
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    /* served from the caches */
+    _fill(TEST_SMALL_SIZE);
+    _release();
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_cache__other_size(void)
+{
+    gnrc_pktsnip_t *pkt;
+
+    _fill(TEST_SMALL_SIZE);
+    _release();
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    /* only the caches have space of the size needed */
+    pkt = gnrc_pktbuf_add(NULL, NULL, TEST_LARGE_SIZE, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_INT(TEST_LARGE_SIZE, pkt->size);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_cache__realloc_other_size(void)
+{
+    gnrc_pktsnip_t *pkt;
+
+    _fill(TEST_SMALL_SIZE);
+    _release();
+    pkt = gnrc_pktbuf_add(NULL, NULL, TEST_SMALL_SIZE, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt, TEST_LARGE_SIZE));
+    TEST_ASSERT_EQUAL_INT(TEST_LARGE_SIZE, pkt->size);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static Test *tests_pktbuf_cache(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_pktbuf_cache__same_size),
+        new_TestFixture(test_pktbuf_cache__other_size),
+        new_TestFixture(test_pktbuf_cache__realloc_other_size),
+    };
+
+    EMB_UNIT_TESTCALLER(pktbuf_cache_tests, _set_up, NULL, fixtures);
+
+    return (Test *)&pktbuf_cache_tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_pktbuf_cache());
+    TESTS_END();
+    return 0;
+}
@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the packet buffer with size-class slabs
+ *
+ * Runs the packet buffer unittests with gnrc_pktbuf_slab and cases for the
+ * slabs and the buddy system. These leave the packet buffer empty again.
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ *
+ * @}
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "net/gnrc/pktbuf.h"
+
+#include "tests-pktbuf.h"
+
+/* sizes of all slab classes and a few in between */
+#define TEST_SIZE_STEP      (GNRC_PKTBUF_SLAB_UNIT / 2)
+#define TEST_SIZES          (GNRC_PKTBUF_SLAB_MAX / TEST_SIZE_STEP)
+/* served from the buddy system */
+#define TEST_LARGE_SIZE     (4 * GNRC_PKTBUF_SLAB_MAX)
+
+static uint8_t _data[TEST_LARGE_SIZE];
+
+static void _set_up(void)
+{
+    gnrc_pktbuf_init();
+}
+
+static void _tear_down(void)
+{
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_slab__classes(void)
+{
+    gnrc_pktsnip_t *pkts[TEST_SIZES];
+
+    for (unsigned i = 0; i < TEST_SIZES; i++) {
+        size_t size = (i + 1) * TEST_SIZE_STEP;
+
+        pkts[i] = gnrc_pktbuf_add(NULL, _data + i, size, GNRC_NETTYPE_UNDEF);
+        TEST_ASSERT_NOT_NULL(pkts[i]);
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    /* no object overlaps another one */
+    for (unsigned i = 0; i < TEST_SIZES; i++) {
+        TEST_ASSERT_EQUAL_INT(0, memcmp(pkts[i]->data, _data + i, pkts[i]->size));
+    }
+    /* every other one first, so slabs are partially used in between */
+    for (unsigned i = 0; i < TEST_SIZES; i += 2) {
+        gnrc_pktbuf_release(pkts[i]);
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    for (unsigned i = 1; i < TEST_SIZES; i += 2) {
+        gnrc_pktbuf_release(pkts[i]);
+    }
+}
+
+static void test_pktbuf_slab__slabs_returned(void)
+{
+    gnrc_pktsnip_t *pkt = NULL, *tmp;
+    size_t large = GNRC_PKTBUF_SLAB_PAGE;
+
+    /* fill the packet buffer with slabs of the smallest objects */
+    while ((tmp = gnrc_pktbuf_add(pkt, NULL, 1, GNRC_NETTYPE_UNDEF)) != NULL) {
+        pkt = tmp;
+    }
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(pkt);
+
+    /* the empty slabs joined again to the largest aligned block */
+    while ((2 * large) <= (GNRC_PKTBUF_SIZE / 2)) {
+        large *= 2;
+    }
+    pkt = gnrc_pktbuf_add(NULL, NULL, large, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(pkt);
+    gnrc_pktbuf_release(pkt);
+}
+
+static void test_pktbuf_slab__reverse_snips_too_full(void)
+{
+    gnrc_pktsnip_t *pkt, *pkt_next, *fill = NULL, *tmp;
+
+    pkt_next = gnrc_pktbuf_add(NULL, _data, 8, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt_next);
+    /* hold to enforce duplication */
+    gnrc_pktbuf_hold(pkt_next, 1);
+    pkt = gnrc_pktbuf_add(pkt_next, _data, 8, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt);
+    /* filling up rest of packet buffer */
+    while ((tmp = gnrc_pktbuf_add(fill, NULL, 1, GNRC_NETTYPE_UNDEF)) != NULL) {
+        fill = tmp;
+    }
+    TEST_ASSERT_NULL(gnrc_pktbuf_reverse_snips(pkt));
+    gnrc_pktbuf_release(fill);
+    /* release because of hold above */
+    gnrc_pktbuf_release(pkt_next);
+}
+
+static void test_pktbuf_slab__mark(void)
+{
+    gnrc_pktsnip_t *pkt, *hdr;
+    void *data;
+
+    /* slab objects are freed as a whole, so the marked part is copied */
+    pkt = gnrc_pktbuf_add(NULL, _data, GNRC_PKTBUF_SLAB_MAX, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(pkt);
+    hdr = gnrc_pktbuf_mark(pkt, 3, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(hdr);
+    TEST_ASSERT_EQUAL_INT(3, hdr->size);
+    TEST_ASSERT_EQUAL_INT(GNRC_PKTBUF_SLAB_MAX - 3, pkt->size);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(hdr->data, _data, hdr->size));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(pkt->data, _data + 3, pkt->size));
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(pkt);
+
+    /* buddy allocations are split in place at a unit boundary */
+    pkt = gnrc_pktbuf_add(NULL, _data, TEST_LARGE_SIZE, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(pkt);
+    data = pkt->data;
+    hdr = gnrc_pktbuf_mark(pkt, GNRC_PKTBUF_SLAB_UNIT, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(hdr);
+    TEST_ASSERT(hdr->data == data);
+    TEST_ASSERT((uint8_t *)pkt->data == (uint8_t *)data + GNRC_PKTBUF_SLAB_UNIT);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(pkt->data, _data + GNRC_PKTBUF_SLAB_UNIT,
+                                    pkt->size));
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(pkt);
+}
+
+static void test_pktbuf_slab__realloc(void)
+{
+    gnrc_pktsnip_t *pkt;
+    void *data;
+
+    pkt = gnrc_pktbuf_add(NULL, _data, 1, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(pkt);
+    data = pkt->data;
+    /* grows within the slab object */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt, GNRC_PKTBUF_SLAB_UNIT));
+    TEST_ASSERT(pkt->data == data);
+    /* moves to the buddy system */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt, TEST_LARGE_SIZE));
+    TEST_ASSERT_EQUAL_INT(_data[0], *(uint8_t *)pkt->data);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    /* shrinks in place */
+    data = pkt->data;
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt, GNRC_PKTBUF_SLAB_UNIT + 1));
+    TEST_ASSERT(pkt->data == data);
+    TEST_ASSERT_EQUAL_INT(_data[0], *(uint8_t *)pkt->data);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(pkt);
+}
+
+static Test *tests_pktbuf_slab_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_pktbuf_slab__classes),
+        new_TestFixture(test_pktbuf_slab__slabs_returned),
+        new_TestFixture(test_pktbuf_slab__reverse_snips_too_full),
+        new_TestFixture(test_pktbuf_slab__mark),
+        new_TestFixture(test_pktbuf_slab__realloc),
+    };
+
+    EMB_UNIT_TESTCALLER(pktbuf_slab_tests, _set_up, _tear_down, fixtures);
+
+    return (Test *)&pktbuf_slab_tests;
+}
+
+int main(void)
+{
+    for (unsigned i = 0; i < TEST_LARGE_SIZE; i++) {
+        _data[i] = i;
+    }
+    TESTS_START();
+    tests_pktbuf();
+    TESTS_RUN(tests_pktbuf_slab_tests());
+    TESTS_END();
+    return 0;
+}
@@ -204,6 +204,38 @@ static void _set_up(void)
     _set_fragment_offset(_fragment4, TEST_FRAGMENT4_OFFSET);
 }
 
+static void _set_netif_hdr_src(uint8_t suffix)
+{
+    uint8_t *src = gnrc_netif_hdr_get_src_addr(&_test_netif_hdr.hdr);
+
+    /* overwrite last byte of source address to get a distinct source */
+    src[_test_netif_hdr.hdr.src_l2addr_len - 1] = suffix;
+}
+
+static unsigned _count_non_empty_rbuf(void)
+{
+    const gnrc_sixlowpan_rbuf_t *rbuf = rbuf_array();
+    unsigned count = 0;
+
+    for (unsigned i = 0; i < RBUF_SIZE; i++) {
+        if (!rbuf_entry_empty(&rbuf[i])) {
+            count++;
+        }
+    }
+    return count;
+}
+
+static void _release_rbuf(void)
+{
+    const gnrc_sixlowpan_rbuf_t *rbuf = rbuf_array();
+
+    for (unsigned i = 0; i < RBUF_SIZE; i++) {
+        if (!rbuf_entry_empty(&rbuf[i])) {
+            gnrc_pktbuf_release(rbuf[i].pkt);
+        }
+    }
+}
+
 static const gnrc_sixlowpan_rbuf_t *_first_non_empty_rbuf(void)
 {
     const gnrc_sixlowpan_rbuf_t *rbuf = rbuf_array();
@@ -357,6 +389,8 @@ static void test_rbuf_add__full_rbuf(void)
         rbuf_add(&_test_netif_hdr.hdr, pkt, TEST_FRAGMENT1_OFFSET,
                  TEST_PAGE);
         _set_fragment_tag(_fragment1, TEST_TAG + i + 1);
+        /* use distinct sources to not run into the per-source quota */
+        _set_netif_hdr_src(i + 1);
         /* pkt is released in rbuf_add() */
     }
     pkt = gnrc_pktbuf_add(NULL, _fragment1, sizeof(_fragment1),
@@ -383,6 +417,107 @@ static void test_rbuf_add__full_rbuf(void)
     _check_pktbuf(NULL);
 }
 
+static void test_rbuf_add__full_rbuf_least_complete(void)
+{
+    gnrc_pktsnip_t *pkt;
+    const gnrc_sixlowpan_rbuf_t *rbuf;
+    unsigned more_complete = 0;
+
+    /* oldest datagram is the most complete one */
+    pkt = gnrc_pktbuf_add(NULL, _fragment3, sizeof(_fragment3),
+                          GNRC_NETTYPE_SIXLOWPAN);
+    TEST_ASSERT_NOT_NULL(pkt);
+    rbuf_add(&_test_netif_hdr.hdr, pkt, TEST_FRAGMENT3_OFFSET, TEST_PAGE);
+    for (unsigned i = 0; i < RBUF_SIZE; i++) {
+        pkt = gnrc_pktbuf_add(NULL, _fragment2, sizeof(_fragment2),
+                              GNRC_NETTYPE_SIXLOWPAN);
+        TEST_ASSERT_NOT_NULL(pkt);
+        rbuf_add(&_test_netif_hdr.hdr, pkt, TEST_FRAGMENT2_OFFSET, TEST_PAGE);
+        _set_netif_hdr_src(i + 1);
+    }
+    TEST_ASSERT_EQUAL_INT(RBUF_SIZE, _count_non_empty_rbuf());
+    /* datagram of yet another source replaces a less complete datagram */
+    pkt = gnrc_pktbuf_add(NULL, _fragment2, sizeof(_fragment2),
+                          GNRC_NETTYPE_SIXLOWPAN);
+    TEST_ASSERT_NOT_NULL(pkt);
+    rbuf_add(&_test_netif_hdr.hdr, pkt, TEST_FRAGMENT2_OFFSET, TEST_PAGE);
+    TEST_ASSERT_EQUAL_INT(RBUF_SIZE, _count_non_empty_rbuf());
+    rbuf = rbuf_array();
+    for (unsigned i = 0; i < RBUF_SIZE; i++) {
+        if (rbuf[i].super.current_size > (TEST_FRAGMENT3_OFFSET -
+                                          TEST_FRAGMENT2_OFFSET)) {
+            TEST_ASSERT_MESSAGE(memcmp(rbuf[i].super.src, _test_netif_hdr_src,
+                                       rbuf[i].super.src_len) == 0,
+                                "Most complete datagram has unexpected source");
+            more_complete++;
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(1U, more_complete);
+    _release_rbuf();
+    _check_pktbuf(NULL);
+}
+
+static void test_rbuf_add__src_quota(void)
+{
+    gnrc_pktsnip_t *pkt;
+
+    for (unsigned i = 0; i < RBUF_SIZE; i++) {
+        pkt = gnrc_pktbuf_add(NULL, _fragment1, sizeof(_fragment1),
+                              GNRC_NETTYPE_SIXLOWPAN);
+        TEST_ASSERT_NOT_NULL(pkt);
+        rbuf_add(&_test_netif_hdr.hdr, pkt, TEST_FRAGMENT1_OFFSET,
+                 TEST_PAGE);
+        _set_fragment_tag(_fragment1, TEST_TAG + i + 1);
+    }
+    TEST_ASSERT_EQUAL_INT(GNRC_SIXLOWPAN_FRAG_RBUF_SRC_QUOTA,
+                          _count_non_empty_rbuf());
+    /* another source still finds space */
+    _set_netif_hdr_src(0);
+    pkt = gnrc_pktbuf_add(NULL, _fragment1, sizeof(_fragment1),
+                          GNRC_NETTYPE_SIXLOWPAN);
+    TEST_ASSERT_NOT_NULL(pkt);
+    rbuf_add(&_test_netif_hdr.hdr, pkt, TEST_FRAGMENT1_OFFSET, TEST_PAGE);
+    TEST_ASSERT_EQUAL_INT(GNRC_SIXLOWPAN_FRAG_RBUF_SRC_QUOTA + 1,
+                          _count_non_empty_rbuf());
+    _release_rbuf();
+    _check_pktbuf(NULL);
+}
+
+static void test_rbuf_add__sorted_ints(void)
+{
+    gnrc_pktsnip_t *pkt2 = gnrc_pktbuf_add(NULL, _fragment2, sizeof(_fragment2),
+                                           GNRC_NETTYPE_SIXLOWPAN);
+    gnrc_pktsnip_t *pkt3 = gnrc_pktbuf_add(NULL, _fragment3, sizeof(_fragment3),
+                                           GNRC_NETTYPE_SIXLOWPAN);
+    gnrc_pktsnip_t *pkt4 = gnrc_pktbuf_add(NULL, _fragment4, sizeof(_fragment4),
+                                           GNRC_NETTYPE_SIXLOWPAN);
+    const gnrc_sixlowpan_rbuf_t *entry;
+    const gnrc_sixlowpan_rbuf_int_t *ptr;
+
+    TEST_ASSERT_NOT_NULL(pkt3);
+    rbuf_add(&_test_netif_hdr.hdr, pkt3, TEST_FRAGMENT3_OFFSET, TEST_PAGE);
+    TEST_ASSERT_NOT_NULL(pkt4);
+    rbuf_add(&_test_netif_hdr.hdr, pkt4, TEST_FRAGMENT4_OFFSET, TEST_PAGE);
+    TEST_ASSERT_NOT_NULL(pkt2);
+    rbuf_add(&_test_netif_hdr.hdr, pkt2, TEST_FRAGMENT2_OFFSET, TEST_PAGE);
+    entry = _first_non_empty_rbuf();
+    TEST_ASSERT_NOT_NULL(entry);
+    TEST_ASSERT_EQUAL_INT(TEST_DATAGRAM_SIZE - TEST_FRAGMENT2_OFFSET,
+                          entry->super.current_size);
+    ptr = entry->super.ints;
+    TEST_ASSERT_NOT_NULL(ptr);
+    TEST_ASSERT_EQUAL_INT(TEST_FRAGMENT2_OFFSET, ptr->start);
+    ptr = ptr->next;
+    TEST_ASSERT_NOT_NULL(ptr);
+    TEST_ASSERT_EQUAL_INT(TEST_FRAGMENT3_OFFSET, ptr->start);
+    ptr = ptr->next;
+    TEST_ASSERT_NOT_NULL(ptr);
+    TEST_ASSERT_EQUAL_INT(TEST_FRAGMENT4_OFFSET, ptr->start);
+    TEST_ASSERT_EQUAL_INT(TEST_DATAGRAM_SIZE - 1, ptr->end);
+    TEST_ASSERT_NULL(ptr->next);
+    _check_pktbuf(entry);
+}
+
 static void test_rbuf_add__too_big_fragment(void)
 {
     gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, _fragment1,
@@ -553,6 +688,9 @@ static void run_unittests(void)
         new_TestFixture(test_rbuf_add__success_duplicate_fragments),
         new_TestFixture(test_rbuf_add__success_complete),
         new_TestFixture(test_rbuf_add__full_rbuf),
+        new_TestFixture(test_rbuf_add__full_rbuf_least_complete),
+        new_TestFixture(test_rbuf_add__src_quota),
+        new_TestFixture(test_rbuf_add__sorted_ints),
         new_TestFixture(test_rbuf_add__too_big_fragment),
         new_TestFixture(test_rbuf_add__overlap_lhs),
         new_TestFixture(test_rbuf_add__overlap_rhs),
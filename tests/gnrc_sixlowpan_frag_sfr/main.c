@@ -0,0 +1,504 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests 6LoWPAN selective fragment recovery
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "embUnit.h"
+#include "msg.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/frag/sfr.h"
+#include "net/netdev_test.h"
+#include "net/sixlowpan.h"
+#include "utlist.h"
+#include "xtimer.h"
+
+#define TEST_L2ADDR_PEER        { 0xb3, 0x47, 0x60, 0x49, \
+                                  0x78, 0xfe, 0x95, 0x48 }
+#define TEST_L2ADDR_OWN         { 0xa4, 0xf2, 0xd2, 0xc9, \
+                                  0x13, 0xb9, 0xbb, 0x25 }
+#define TEST_TAG                (0x69U)
+#define TEST_PAGE               (0)
+#define TEST_RECEIVE_TIMEOUT    (10U * US_PER_MS)
+/* time for the sender to give up on a datagram nobody acknowledges */
+#define TEST_ABORT_TIMEOUT      (2U * GNRC_SIXLOWPAN_SFR_ARQ_TIMEOUT_US)
+#define TEST_MSG_TYPE_SENT      (0x8f01)
+#define TEST_MSG_QUEUE_SIZE     (8U)
+
+/* 3 full fragments and one with the remaining 8 bytes */
+#define TEST_FRAG_SIZE          (64U)
+#define TEST_FRAGS              (4U)
+#define TEST_DATAGRAM_SIZE      (((TEST_FRAGS - 1) * TEST_FRAG_SIZE) + 8U)
+
+#define TEST_BITMAP(seq)        (0x80000000UL >> (seq))
+#define TEST_BITMAP_ALL         (TEST_BITMAP(0) | TEST_BITMAP(1) | \
+                                 TEST_BITMAP(2) | TEST_BITMAP(3))
+
+static const uint8_t _l2addr_peer[] = TEST_L2ADDR_PEER;
+static const uint8_t _l2addr_own[] = TEST_L2ADDR_OWN;
+
+static uint8_t _datagram[TEST_DATAGRAM_SIZE];
+static msg_t _msg_queue[TEST_MSG_QUEUE_SIZE];
+static char _netif_stack[THREAD_STACKSIZE_DEFAULT];
+static netdev_test_t _dev;
+static gnrc_netif_t *_netif;
+static kernel_pid_t _main_pid;
+
+/* hands everything the interface is asked to send to the test thread */
+static int _netif_send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    msg_t msg = { .type = TEST_MSG_TYPE_SENT, .content = { .ptr = pkt } };
+
+    (void)netif;
+    if (msg_try_send(&msg, _main_pid) < 1) {
+        gnrc_pktbuf_release(pkt);
+    }
+    return 0;
+}
+
+static gnrc_pktsnip_t *_netif_recv(gnrc_netif_t *netif)
+{
+    (void)netif;
+    return NULL;
+}
+
+static int _netif_set(gnrc_netif_t *netif, const gnrc_netapi_opt_t *opt)
+{
+    (void)netif;
+    (void)opt;
+    return -ENOTSUP;
+}
+
+static const gnrc_netif_ops_t _netif_ops = {
+    .send = _netif_send,
+    .recv = _netif_recv,
+    .get = gnrc_netif_get_from_netdev,
+    .set = _netif_set,
+};
+
+static int _netdev_test_device_type(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    assert(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = NETDEV_TYPE_TEST;
+    return sizeof(uint16_t);
+}
+
+static void _set_up(void)
+{
+    msg_t msg;
+
+    gnrc_sixlowpan_frag_sfr_reset();
+    while (msg_try_receive(&msg) > 0) {}
+    gnrc_pktbuf_init();
+}
+
+/* waits for a message of type, while serving the timers of the sender */
+static gnrc_pktsnip_t *_wait_for(uint16_t type, uint32_t timeout)
+{
+    msg_t msg;
+
+    while (xtimer_msg_receive_timeout(&msg, timeout) >= 0) {
+        switch (msg.type) {
+            case GNRC_SIXLOWPAN_MSG_FRAG_SFR_SND:
+            case GNRC_SIXLOWPAN_MSG_FRAG_SFR_ARQ_TO:
+                gnrc_sixlowpan_frag_sfr_handle_msg(&msg);
+                break;
+            case TEST_MSG_TYPE_SENT:
+            case GNRC_NETAPI_MSG_TYPE_RCV:
+                if (msg.type == type) {
+                    return msg.content.ptr;
+                }
+                /* unexpected packet */
+                gnrc_pktbuf_release(msg.content.ptr);
+                return NULL;
+            default:
+                break;
+        }
+    }
+    return NULL;
+}
+
+static gnrc_pktsnip_t *_netif_hdr(const uint8_t *src, const uint8_t *dst)
+{
+    gnrc_pktsnip_t *netif = gnrc_netif_hdr_build(src, sizeof(_l2addr_own),
+                                                 dst, sizeof(_l2addr_own));
+
+    if (netif != NULL) {
+        gnrc_netif_hdr_set_netif(netif->data, _netif);
+    }
+    return netif;
+}
+
+/* feeds the fragment seq of _datagram into the receiver, offset is the
+ * datagram size for seq == 0 */
+static void _recv_rfrag(unsigned seq, uint16_t offset, uint16_t size,
+                        size_t len, bool ack_req)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL,
+                                          sizeof(sixlowpan_sfr_rfrag_t) + len,
+                                          GNRC_NETTYPE_SIXLOWPAN);
+    gnrc_pktsnip_t *netif = _netif_hdr(_l2addr_peer, _l2addr_own);
+    sixlowpan_sfr_rfrag_t *hdr;
+    size_t start = (seq == 0) ? 0 : offset;
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_NOT_NULL(netif);
+    hdr = pkt->data;
+    /* fragments exceeding the datagram are padded with zeros */
+    memset(hdr + 1, 0, len);
+    if (start < TEST_DATAGRAM_SIZE) {
+        memcpy(hdr + 1, &_datagram[start],
+               ((start + len) > TEST_DATAGRAM_SIZE) ? (TEST_DATAGRAM_SIZE - start)
+                                                    : len);
+    }
+    hdr->disp_ecn = SIXLOWPAN_SFR_RFRAG_DISP;
+    hdr->tag = TEST_TAG;
+    hdr->ar_seq_fs = byteorder_htons((ack_req ? SIXLOWPAN_SFR_ACK_REQ : 0) |
+                                     (seq << SIXLOWPAN_SFR_SEQ_POS) | size);
+    hdr->offset = byteorder_htons(offset);
+    LL_APPEND(pkt, netif);
+    gnrc_sixlowpan_frag_sfr_recv(pkt, NULL, TEST_PAGE);
+}
+
+/* feeds the regular fragment seq of _datagram into the receiver */
+static void _recv_frag(unsigned seq, bool ack_req)
+{
+    uint16_t offset = seq * TEST_FRAG_SIZE;
+    uint16_t size = TEST_DATAGRAM_SIZE - offset;
+
+    if (size > TEST_FRAG_SIZE) {
+        size = TEST_FRAG_SIZE;
+    }
+    _recv_rfrag(seq, (seq == 0) ? TEST_DATAGRAM_SIZE : offset, size, size,
+                ack_req);
+}
+
+static void _recv_ack(uint8_t tag, uint32_t bitmap)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL,
+                                          sizeof(sixlowpan_sfr_ack_t),
+                                          GNRC_NETTYPE_SIXLOWPAN);
+    gnrc_pktsnip_t *netif = _netif_hdr(_l2addr_peer, _l2addr_own);
+    sixlowpan_sfr_ack_t *hdr;
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_NOT_NULL(netif);
+    hdr = pkt->data;
+    hdr->disp_ecn = SIXLOWPAN_SFR_ACK_DISP;
+    hdr->tag = tag;
+    hdr->bitmap = byteorder_htonl(bitmap);
+    LL_APPEND(pkt, netif);
+    gnrc_sixlowpan_frag_sfr_recv(pkt, NULL, TEST_PAGE);
+}
+
+static void _test_dst(const gnrc_pktsnip_t *pkt)
+{
+    const gnrc_netif_hdr_t *netif_hdr;
+
+    TEST_ASSERT_EQUAL_INT(GNRC_NETTYPE_NETIF, pkt->type);
+    netif_hdr = pkt->data;
+    TEST_ASSERT_EQUAL_INT(sizeof(_l2addr_peer), netif_hdr->dst_l2addr_len);
+    TEST_ASSERT_MESSAGE(memcmp(gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                               _l2addr_peer, sizeof(_l2addr_peer)) == 0,
+                        "Packet not sent to peer");
+    TEST_ASSERT_NOT_NULL(pkt->next);
+}
+
+static void _expect_ack(uint32_t bitmap)
+{
+    gnrc_pktsnip_t *pkt = _wait_for(TEST_MSG_TYPE_SENT, TEST_RECEIVE_TIMEOUT);
+    const sixlowpan_sfr_ack_t *hdr;
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    _test_dst(pkt);
+    TEST_ASSERT_EQUAL_INT(sizeof(sixlowpan_sfr_ack_t), pkt->next->size);
+    hdr = pkt->next->data;
+    TEST_ASSERT(sixlowpan_sfr_ack_is((const uint8_t *)hdr));
+    TEST_ASSERT_EQUAL_INT(TEST_TAG, hdr->tag);
+    TEST_ASSERT_EQUAL_INT(bitmap, byteorder_ntohl(hdr->bitmap));
+    gnrc_pktbuf_release(pkt);
+}
+
+static void _expect_nothing_sent(void)
+{
+    TEST_ASSERT_NULL(_wait_for(TEST_MSG_TYPE_SENT, TEST_RECEIVE_TIMEOUT));
+}
+
+static void _expect_delivered(void)
+{
+    gnrc_pktsnip_t *pkt = _wait_for(GNRC_NETAPI_MSG_TYPE_RCV,
+                                    TEST_RECEIVE_TIMEOUT);
+    gnrc_pktsnip_t *netif;
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_INT(TEST_DATAGRAM_SIZE, pkt->size);
+    TEST_ASSERT_MESSAGE(memcmp(_datagram, pkt->data, TEST_DATAGRAM_SIZE) == 0,
+                        "Reassembled datagram does not contain expected data");
+    netif = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_NETIF);
+    TEST_ASSERT_NOT_NULL(netif);
+    TEST_ASSERT_MESSAGE(memcmp(gnrc_netif_hdr_get_src_addr(netif->data),
+                               _l2addr_peer, sizeof(_l2addr_peer)) == 0,
+                        "Reassembled datagram has unexpected source");
+    gnrc_pktbuf_release(pkt);
+}
+
+/* sends _datagram to the peer, tag is set to the tag chosen by the sender */
+static void _send_datagram(uint8_t *tag)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, _datagram, TEST_DATAGRAM_SIZE,
+                                          GNRC_NETTYPE_SIXLOWPAN);
+    gnrc_pktsnip_t *netif = _netif_hdr(_l2addr_own, _l2addr_peer);
+    /* the sender takes the tag after the one taken here */
+    *tag = (uint8_t)(gnrc_sixlowpan_frag_next_tag() + 1);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_NOT_NULL(netif);
+    LL_PREPEND(pkt, netif);
+    TEST_ASSERT(gnrc_sixlowpan_frag_sfr_applicable(pkt, _netif));
+    gnrc_sixlowpan_frag_sfr_send(pkt, NULL, TEST_PAGE);
+}
+
+static void _expect_rfrag(uint8_t tag, unsigned seq, bool ack_req,
+                          uint32_t timeout)
+{
+    gnrc_pktsnip_t *pkt = _wait_for(TEST_MSG_TYPE_SENT, timeout);
+    const sixlowpan_sfr_rfrag_t *hdr;
+    uint16_t offset = seq * TEST_FRAG_SIZE;
+    uint16_t size = TEST_DATAGRAM_SIZE - offset;
+
+    if (size > TEST_FRAG_SIZE) {
+        size = TEST_FRAG_SIZE;
+    }
+    TEST_ASSERT_NOT_NULL(pkt);
+    _test_dst(pkt);
+    hdr = pkt->next->data;
+    TEST_ASSERT(sixlowpan_sfr_rfrag_is((const uint8_t *)hdr));
+    TEST_ASSERT_EQUAL_INT(tag, hdr->tag);
+    TEST_ASSERT_EQUAL_INT(seq, sixlowpan_sfr_rfrag_get_seq(hdr));
+    TEST_ASSERT_EQUAL_INT(ack_req, sixlowpan_sfr_rfrag_ack_req(hdr));
+    TEST_ASSERT_EQUAL_INT(size, sixlowpan_sfr_rfrag_get_frag_size(hdr));
+    TEST_ASSERT_EQUAL_INT(sizeof(sixlowpan_sfr_rfrag_t) + size,
+                          pkt->next->size);
+    TEST_ASSERT_EQUAL_INT((seq == 0) ? TEST_DATAGRAM_SIZE : offset,
+                          byteorder_ntohs(hdr->offset));
+    TEST_ASSERT_MESSAGE(memcmp(hdr + 1, &_datagram[offset], size) == 0,
+                        "Fragment does not contain expected data");
+    gnrc_pktbuf_release(pkt);
+}
+
+static void _check_pktbuf(void)
+{
+    TEST_ASSERT_MESSAGE(gnrc_pktbuf_is_empty(), "Packet buffer is not empty");
+}
+
+static void test_sfr_recv__out_of_order(void)
+{
+    _recv_frag(2, false);
+    _recv_frag(3, false);
+    _recv_frag(0, false);
+    _recv_frag(1, true);
+    _expect_delivered();
+    /* the entry of a complete datagram acknowledges all fragments */
+    _expect_ack(SIXLOWPAN_SFR_ACK_BITMAP_FULL);
+    _check_pktbuf();
+}
+
+static void test_sfr_recv__ack_bitmap(void)
+{
+    _recv_frag(0, false);
+    _recv_frag(2, true);
+    _expect_ack(TEST_BITMAP(0) | TEST_BITMAP(2));
+    _recv_frag(3, true);
+    _expect_ack(TEST_BITMAP(0) | TEST_BITMAP(2) | TEST_BITMAP(3));
+    /* duplicates do not change anything */
+    _recv_frag(2, true);
+    _expect_ack(TEST_BITMAP(0) | TEST_BITMAP(2) | TEST_BITMAP(3));
+    gnrc_sixlowpan_frag_sfr_reset();
+    _check_pktbuf();
+}
+
+static void test_sfr_recv__abort(void)
+{
+    _recv_frag(0, false);
+    _recv_frag(2, false);
+    /* abort fragment: sequence number and fragment size 0 */
+    _recv_rfrag(0, 0, 0, 0, false);
+    _check_pktbuf();
+    /* a new datagram with the same tag starts from scratch */
+    _recv_frag(1, true);
+    _expect_ack(TEST_BITMAP(1));
+    gnrc_sixlowpan_frag_sfr_reset();
+    _check_pktbuf();
+}
+
+static void test_sfr_recv__duplicate_after_complete(void)
+{
+    for (unsigned seq = 0; seq < TEST_FRAGS; seq++) {
+        _recv_frag(seq, false);
+    }
+    _expect_delivered();
+    /* the acknowledgment requested got lost and the fragment is sent again */
+    _recv_frag(3, true);
+    _expect_ack(SIXLOWPAN_SFR_ACK_BITMAP_FULL);
+    /* the datagram is not delivered twice */
+    TEST_ASSERT_NULL(_wait_for(GNRC_NETAPI_MSG_TYPE_RCV,
+                               TEST_RECEIVE_TIMEOUT));
+    _check_pktbuf();
+}
+
+static void test_sfr_recv__size_mismatch(void)
+{
+    /* fragment size field does not match the payload */
+    _recv_rfrag(1, TEST_FRAG_SIZE, TEST_FRAG_SIZE, TEST_FRAG_SIZE + 1, true);
+    _expect_nothing_sent();
+    _check_pktbuf();
+}
+
+static void test_sfr_recv__offset_mismatch(void)
+{
+    _recv_frag(0, false);
+    /* a full fragment at the offset of the last one exceeds the datagram */
+    _recv_rfrag(3, 3 * TEST_FRAG_SIZE, TEST_FRAG_SIZE, TEST_FRAG_SIZE, true);
+    _expect_nothing_sent();
+    _check_pktbuf();
+}
+
+static void test_sfr_recv__overlap(void)
+{
+    _recv_frag(0, false);
+    /* covers the second half of the first fragment */
+    _recv_rfrag(1, TEST_FRAG_SIZE / 2, TEST_FRAG_SIZE, TEST_FRAG_SIZE, true);
+    _expect_nothing_sent();
+    _check_pktbuf();
+    /* the datagram is received again from scratch */
+    for (unsigned seq = 0; seq < TEST_FRAGS; seq++) {
+        _recv_frag(seq, false);
+    }
+    _expect_delivered();
+    _check_pktbuf();
+}
+
+static void test_sfr_send__ack_bitmap(void)
+{
+    uint8_t tag;
+
+    _send_datagram(&tag);
+
+    for (unsigned seq = 0; seq < TEST_FRAGS; seq++) {
+        /* the last fragment of the burst requests an acknowledgment */
+        _expect_rfrag(tag, seq, seq == (TEST_FRAGS - 1), TEST_RECEIVE_TIMEOUT);
+    }
+    _recv_ack(tag, TEST_BITMAP_ALL & ~TEST_BITMAP(2));
+    /* only the lost fragment is sent again */
+    _expect_rfrag(tag, 2, true, TEST_RECEIVE_TIMEOUT);
+    _expect_nothing_sent();
+    _recv_ack(tag, TEST_BITMAP_ALL);
+    _expect_nothing_sent();
+    _check_pktbuf();
+}
+
+static void test_sfr_send__null_bitmap(void)
+{
+    uint8_t tag;
+
+    _send_datagram(&tag);
+
+    for (unsigned seq = 0; seq < TEST_FRAGS; seq++) {
+        _expect_rfrag(tag, seq, seq == (TEST_FRAGS - 1), TEST_RECEIVE_TIMEOUT);
+    }
+    /* receiver aborted the reassembly */
+    _recv_ack(tag, 0);
+    _expect_nothing_sent();
+    _check_pktbuf();
+}
+
+static void test_sfr_send__abort(void)
+{
+    gnrc_pktsnip_t *pkt;
+    const sixlowpan_sfr_rfrag_t *hdr;
+    uint8_t tag;
+
+    _send_datagram(&tag);
+
+    for (unsigned seq = 0; seq < TEST_FRAGS; seq++) {
+        _expect_rfrag(tag, seq, seq == (TEST_FRAGS - 1), TEST_RECEIVE_TIMEOUT);
+    }
+    /* the acknowledgment is requested again with the last fragment */
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_SFR_FRAG_RETRIES; i++) {
+        _expect_rfrag(tag, TEST_FRAGS - 1, true, TEST_ABORT_TIMEOUT);
+    }
+    /* until the sender gives up and tells the receiver so */
+    pkt = _wait_for(TEST_MSG_TYPE_SENT, TEST_ABORT_TIMEOUT);
+    TEST_ASSERT_NOT_NULL(pkt);
+    _test_dst(pkt);
+    TEST_ASSERT_EQUAL_INT(sizeof(sixlowpan_sfr_rfrag_t), pkt->next->size);
+    hdr = pkt->next->data;
+    TEST_ASSERT(sixlowpan_sfr_rfrag_is((const uint8_t *)hdr));
+    TEST_ASSERT_EQUAL_INT(tag, hdr->tag);
+    TEST_ASSERT_EQUAL_INT(0, sixlowpan_sfr_rfrag_get_seq(hdr));
+    TEST_ASSERT_EQUAL_INT(0, sixlowpan_sfr_rfrag_get_frag_size(hdr));
+    gnrc_pktbuf_release(pkt);
+    _check_pktbuf();
+}
+
+static void run_unittests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_sfr_recv__out_of_order),
+        new_TestFixture(test_sfr_recv__ack_bitmap),
+        new_TestFixture(test_sfr_recv__abort),
+        new_TestFixture(test_sfr_recv__duplicate_after_complete),
+        new_TestFixture(test_sfr_recv__size_mismatch),
+        new_TestFixture(test_sfr_recv__offset_mismatch),
+        new_TestFixture(test_sfr_recv__overlap),
+        new_TestFixture(test_sfr_send__ack_bitmap),
+        new_TestFixture(test_sfr_send__null_bitmap),
+        new_TestFixture(test_sfr_send__abort),
+    };
+
+    EMB_UNIT_TESTCALLER(sixlo_frag_sfr_tests, _set_up, NULL, fixtures);
+    TESTS_START();
+    TESTS_RUN((Test *)&sixlo_frag_sfr_tests);
+    TESTS_END();
+}
+
+int main(void)
+{
+    /* no auto-init, so xtimer needs to be initialized manually */
+    xtimer_init();
+    msg_init_queue(_msg_queue, TEST_MSG_QUEUE_SIZE);
+    _main_pid = sched_active_pid;
+    for (unsigned i = 0; i < TEST_DATAGRAM_SIZE; i++) {
+        _datagram[i] = i;
+    }
+    netdev_test_setup(&_dev, NULL);
+    netdev_test_set_get_cb(&_dev, NETOPT_DEVICE_TYPE, _netdev_test_device_type);
+    _netif = gnrc_netif_create(_netif_stack, sizeof(_netif_stack),
+                               GNRC_NETIF_PRIO, "test-netif",
+                               &_dev.netdev, &_netif_ops);
+    _netif->sixlo.max_frag_size = sizeof(sixlowpan_sfr_rfrag_t) +
+                                  TEST_FRAG_SIZE;
+    run_unittests();
+    return 0;
+}
@@ -0,0 +1,401 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the sliding window and the congestion control of GNRC TCP
+ *
+ * The test takes the place of the network layer: it receives every segment
+ * GNRC TCP sends and injects the ACKs of the peer directly.
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "embUnit.h"
+#include "msg.h"
+#include "net/af.h"
+#include "net/gnrc/ipv6/hdr.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/tcp.h"
+#include "net/inet_csum.h"
+#include "net/ipv6/addr.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+#include "net/tcp.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define TEST_ADDR_LOCAL         { { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00, \
+                                    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01 } }
+#define TEST_ADDR_PEER          { { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00, \
+                                    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02 } }
+#define TEST_PORT_LOCAL         (8080U)
+#define TEST_PORT_PEER          (49152U)
+#define TEST_RECEIVE_TIMEOUT    (100U * US_PER_MS)
+/* nothing is measured on the link, so the RTO stays at its lower bound */
+#define TEST_RTO_TIMEOUT        (GNRC_TCP_RTO_LOWER_BOUND + TEST_RECEIVE_TIMEOUT)
+#define TEST_MSG_QUEUE_SIZE     (16U)
+
+/* the peer announces a small MSS, so the initial window is four segments */
+#define TEST_MSS                (100U)
+#define TEST_WINDOW             (1220U)
+#define TEST_IRS                (1000U)
+#define TEST_SEGS               (4U)
+#define TEST_DATA_SIZE          (TEST_SEGS * TEST_MSS)
+
+/* the peer sends no data, so its sequence number stays the same */
+#define TEST_SEQ                (TEST_IRS + 1)
+
+/* control bits of the TCP header */
+#define TEST_CTL_SYN            (0x0002)
+#define TEST_CTL_ACK            (0x0010)
+
+/* messages between the server thread and the main thread */
+#define TEST_MSG_TYPE_OPEN      (0x8f01)
+#define TEST_MSG_TYPE_SEND      (0x8f02)
+
+typedef struct {
+    uint16_t ctl;
+    uint32_t seq;
+    uint32_t ack;
+    size_t pay_len;
+    uint8_t pay[TEST_MSS];
+} _segment_t;
+
+static const ipv6_addr_t _local = TEST_ADDR_LOCAL;
+static const ipv6_addr_t _peer = TEST_ADDR_PEER;
+static msg_t _msg_queue[TEST_MSG_QUEUE_SIZE];
+static char _server_stack[THREAD_STACKSIZE_MAIN];
+static kernel_pid_t _main_pid;
+static kernel_pid_t _server_pid;
+static gnrc_netreg_entry_t _netreg_entry;
+static gnrc_tcp_tcb_t _tcb;
+static uint32_t _iss;
+/* first sequence number of the data the server sends next */
+static uint32_t _snd_base;
+static msg_t _reply;
+static bool _reply_pending;
+static uint8_t _data[TEST_DATA_SIZE];
+
+static void *_server(void *arg)
+{
+    msg_t msg;
+
+    (void)arg;
+    gnrc_tcp_tcb_init(&_tcb);
+    msg.type = TEST_MSG_TYPE_OPEN;
+    msg.content.value = gnrc_tcp_open_passive(&_tcb, AF_INET6, NULL, TEST_PORT_LOCAL);
+    msg_send(&msg, _main_pid);
+
+    /* the main thread tells how many bytes to send */
+    while (1) {
+        msg_receive(&msg);
+        if (msg.type == TEST_MSG_TYPE_SEND) {
+            msg.content.value = gnrc_tcp_send(&_tcb, _data, msg.content.value, 0);
+            msg_send(&msg, _main_pid);
+        }
+    }
+    return NULL;
+}
+
+static void _inject(uint16_t ctl, uint32_t seq, uint32_t ack,
+                    const uint8_t *opts, size_t opts_len)
+{
+    size_t hdr_len = sizeof(tcp_hdr_t) + opts_len;
+    gnrc_pktsnip_t *tcp, *ipv6;
+    ipv6_hdr_t *ipv6_hdr;
+    tcp_hdr_t *hdr;
+    uint16_t csum;
+
+    tcp = gnrc_pktbuf_add(NULL, NULL, hdr_len, GNRC_NETTYPE_TCP);
+    TEST_ASSERT_NOT_NULL(tcp);
+    hdr = tcp->data;
+    memset(hdr, 0, sizeof(tcp_hdr_t));
+    hdr->src_port = byteorder_htons(TEST_PORT_PEER);
+    hdr->dst_port = byteorder_htons(TEST_PORT_LOCAL);
+    hdr->seq_num = byteorder_htonl(seq);
+    hdr->ack_num = byteorder_htonl(ack);
+    hdr->off_ctl = byteorder_htons(((hdr_len / 4) << 12) | ctl);
+    hdr->window = byteorder_htons(TEST_WINDOW);
+    memcpy((uint8_t *)tcp->data + sizeof(tcp_hdr_t), opts, opts_len);
+
+    ipv6 = gnrc_ipv6_hdr_build(NULL, &_peer, &_local);
+    TEST_ASSERT_NOT_NULL(ipv6);
+    ipv6_hdr = ipv6->data;
+    ipv6_hdr->len = byteorder_htons(tcp->size);
+    ipv6_hdr->nh = PROTNUM_TCP;
+    ipv6_hdr->hl = 64;
+    tcp->next = ipv6;
+
+    csum = inet_csum(0, tcp->data, tcp->size);
+    csum = ipv6_hdr_inet_csum(csum, ipv6_hdr, PROTNUM_TCP, tcp->size);
+    hdr->checksum = byteorder_htons(~csum);
+
+    TEST_ASSERT_EQUAL_INT(1, gnrc_netapi_dispatch_receive(GNRC_NETTYPE_TCP,
+                                                          GNRC_NETREG_DEMUX_CTX_ALL,
+                                                          tcp));
+}
+
+static void _inject_ack(unsigned n)
+{
+    /* acknowledges the first n segments sent since _snd_base */
+    _inject(TEST_CTL_ACK, TEST_SEQ, _snd_base + (n * TEST_MSS), NULL, 0);
+}
+
+static bool _recv_segment(_segment_t *seg, uint32_t timeout)
+{
+    gnrc_pktsnip_t *pkt, *tcp;
+    tcp_hdr_t *hdr;
+    size_t hdr_len;
+    msg_t msg;
+
+    while (1) {
+        if (xtimer_msg_receive_timeout(&msg, timeout) < 0) {
+            return false;
+        }
+        if (msg.type == GNRC_NETAPI_MSG_TYPE_SND) {
+            break;
+        }
+        /* the server replies as soon as its data is queued */
+        _reply = msg;
+        _reply_pending = true;
+    }
+    pkt = msg.content.ptr;
+    tcp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_TCP);
+    if (tcp == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return false;
+    }
+    hdr = tcp->data;
+    memset(seg, 0, sizeof(*seg));
+    seg->ctl = byteorder_ntohs(hdr->off_ctl);
+    seg->seq = byteorder_ntohl(hdr->seq_num);
+    seg->ack = byteorder_ntohl(hdr->ack_num);
+    hdr_len = (seg->ctl >> 12) * 4;
+    seg->ctl &= 0x3f;
+    if ((hdr_len < sizeof(tcp_hdr_t)) || (hdr_len > tcp->size) ||
+        (gnrc_pkt_len(tcp->next) > sizeof(seg->pay))) {
+        gnrc_pktbuf_release(pkt);
+        return false;
+    }
+    for (gnrc_pktsnip_t *snp = tcp->next; snp != NULL; snp = snp->next) {
+        memcpy(seg->pay + seg->pay_len, snp->data, snp->size);
+        seg->pay_len += snp->size;
+    }
+    gnrc_pktbuf_release(pkt);
+    return true;
+}
+
+static void _expect_data(unsigned n)
+{
+    _segment_t seg;
+
+    TEST_ASSERT(_recv_segment(&seg, TEST_RECEIVE_TIMEOUT));
+    TEST_ASSERT_EQUAL_INT(_snd_base + (n * TEST_MSS), seg.seq);
+    TEST_ASSERT_EQUAL_INT(TEST_MSS, seg.pay_len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&_data[n * TEST_MSS], seg.pay, TEST_MSS));
+}
+
+static void _expect_nothing(void)
+{
+    _segment_t seg;
+
+    TEST_ASSERT(!_recv_segment(&seg, TEST_RECEIVE_TIMEOUT));
+}
+
+static int _wait_server(uint16_t type)
+{
+    msg_t msg;
+
+    if (_reply_pending && (_reply.type == type)) {
+        _reply_pending = false;
+        return (int)_reply.content.value;
+    }
+    while (xtimer_msg_receive_timeout(&msg, TEST_RECEIVE_TIMEOUT) >= 0) {
+        if (msg.type == type) {
+            return (int)msg.content.value;
+        }
+        if (msg.type == GNRC_NETAPI_MSG_TYPE_SND) {
+            gnrc_pktbuf_release(msg.content.ptr);
+        }
+    }
+    /* no reply from the server */
+    return -1;
+}
+
+static void _send(unsigned segs)
+{
+    msg_t msg = { .type = TEST_MSG_TYPE_SEND };
+
+    msg.content.value = segs * TEST_MSS;
+    msg_send(&msg, _server_pid);
+}
+
+static void _drain(void)
+{
+    msg_t msg;
+
+    while (msg_try_receive(&msg) == 1) {
+        if (msg.type == GNRC_NETAPI_MSG_TYPE_SND) {
+            gnrc_pktbuf_release(msg.content.ptr);
+        }
+    }
+}
+
+static void test_tcp_cc__handshake(void)
+{
+    static const uint8_t opts[] = {
+        TCP_OPTION_KIND_MSS, TCP_OPTION_LENGTH_MSS, TEST_MSS >> 8, TEST_MSS & 0xff,
+    };
+    _segment_t seg;
+
+    _inject(TEST_CTL_SYN, TEST_IRS, 0, opts, sizeof(opts));
+    TEST_ASSERT(_recv_segment(&seg, TEST_RECEIVE_TIMEOUT));
+    TEST_ASSERT_EQUAL_INT(TEST_CTL_SYN | TEST_CTL_ACK, seg.ctl);
+    TEST_ASSERT_EQUAL_INT(TEST_SEQ, seg.ack);
+    _iss = seg.seq;
+    _snd_base = _iss + 1;
+
+    _inject(TEST_CTL_ACK, TEST_SEQ, _snd_base, NULL, 0);
+    TEST_ASSERT_EQUAL_INT(0, _wait_server(TEST_MSG_TYPE_OPEN));
+    /* initial window (RFC 3390), opened by the acknowledged SYN */
+    TEST_ASSERT_EQUAL_INT((TEST_SEGS * TEST_MSS) + 1, _tcb.cwnd);
+}
+
+static void test_tcp_cc__cumulative_ack(void)
+{
+    uint32_t cwnd = _tcb.cwnd;
+
+    /* the whole initial window goes out without waiting for an ACK */
+    _send(TEST_SEGS);
+    for (unsigned i = 0; i < TEST_SEGS; i++) {
+        _expect_data(i);
+    }
+    TEST_ASSERT_EQUAL_INT(TEST_DATA_SIZE, _wait_server(TEST_MSG_TYPE_SEND));
+    TEST_ASSERT_EQUAL_INT(TEST_SEGS, _tcb.rtx_len);
+
+    /* one ACK releases all of them */
+    _inject_ack(TEST_SEGS);
+    TEST_ASSERT_EQUAL_INT(0, _tcb.rtx_len);
+    TEST_ASSERT_EQUAL_INT(_snd_base + TEST_DATA_SIZE, _tcb.snd_una);
+    /* slow start grows by at most one segment per ACK */
+    TEST_ASSERT_EQUAL_INT(cwnd + TEST_MSS, _tcb.cwnd);
+    _expect_nothing();
+    _snd_base += TEST_DATA_SIZE;
+}
+
+static void test_tcp_cc__fast_retransmit(void)
+{
+    _send(TEST_SEGS);
+    for (unsigned i = 0; i < TEST_SEGS; i++) {
+        _expect_data(i);
+    }
+    TEST_ASSERT_EQUAL_INT(TEST_DATA_SIZE, _wait_server(TEST_MSG_TYPE_SEND));
+
+    /* the first segment is lost, the others cause duplicate ACKs */
+    for (unsigned i = 1; i < GNRC_TCP_DUPACK_THRESHOLD; i++) {
+        _inject_ack(0);
+    }
+    _expect_nothing();
+    /* the third one retransmits the lost segment, and nothing else */
+    _inject_ack(0);
+    _expect_data(0);
+    _expect_nothing();
+    TEST_ASSERT_EQUAL_INT(TEST_DATA_SIZE / 2, _tcb.ssthresh);
+    TEST_ASSERT_EQUAL_INT(_tcb.ssthresh + (GNRC_TCP_DUPACK_THRESHOLD * TEST_MSS),
+                          _tcb.cwnd);
+
+    /* further duplicate ACKs only inflate the window */
+    _inject_ack(0);
+    _expect_nothing();
+    TEST_ASSERT_EQUAL_INT(_tcb.ssthresh + ((GNRC_TCP_DUPACK_THRESHOLD + 1) * TEST_MSS),
+                          _tcb.cwnd);
+
+    /* the ACK for all data ends fast recovery with the window deflated */
+    _inject_ack(TEST_SEGS);
+    TEST_ASSERT_EQUAL_INT(0, _tcb.rtx_len);
+    TEST_ASSERT_EQUAL_INT(_tcb.ssthresh, _tcb.cwnd);
+    _expect_nothing();
+    _snd_base += TEST_DATA_SIZE;
+}
+
+static void test_tcp_cc__retransmission_timeout(void)
+{
+    unsigned segs = _tcb.cwnd / TEST_MSS;
+    _segment_t seg;
+
+    _send(segs);
+    for (unsigned i = 0; i < segs; i++) {
+        _expect_data(i);
+    }
+    TEST_ASSERT_EQUAL_INT(segs * TEST_MSS, _wait_server(TEST_MSG_TYPE_SEND));
+
+    /* no ACK at all: the oldest segment is retransmitted after the RTO ... */
+    TEST_ASSERT(_recv_segment(&seg, TEST_RTO_TIMEOUT));
+    TEST_ASSERT_EQUAL_INT(_snd_base, seg.seq);
+    TEST_ASSERT_EQUAL_INT(TEST_MSS, seg.pay_len);
+    /* ... and the window collapses to one segment */
+    TEST_ASSERT_EQUAL_INT(TEST_MSS, _tcb.cwnd);
+    TEST_ASSERT_EQUAL_INT(2 * TEST_MSS, _tcb.ssthresh);
+    _expect_nothing();
+
+    _inject_ack(segs);
+    TEST_ASSERT_EQUAL_INT(0, _tcb.rtx_len);
+    _expect_nothing();
+    _snd_base += segs * TEST_MSS;
+}
+
+static void run_unittests(void)
+{
+    /* the fixtures run in order on one connection */
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_tcp_cc__handshake),
+        new_TestFixture(test_tcp_cc__cumulative_ack),
+        new_TestFixture(test_tcp_cc__fast_retransmit),
+        new_TestFixture(test_tcp_cc__retransmission_timeout),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_tcp_cc_tests, NULL, NULL, fixtures);
+    TESTS_START();
+    TESTS_RUN((Test *)&gnrc_tcp_cc_tests);
+    TESTS_END();
+}
+
+int main(void)
+{
+    /* no auto-init, so the modules need to be initialized manually */
+    xtimer_init();
+    gnrc_pktbuf_init();
+    gnrc_tcp_init();
+    msg_init_queue(_msg_queue, TEST_MSG_QUEUE_SIZE);
+    _main_pid = sched_active_pid;
+    for (unsigned i = 0; i < TEST_DATA_SIZE; i++) {
+        _data[i] = i;
+    }
+    /* receive what GNRC TCP sends to the network layer */
+    gnrc_netreg_entry_init_pid(&_netreg_entry, GNRC_NETREG_DEMUX_CTX_ALL, _main_pid);
+    gnrc_netreg_register(GNRC_NETTYPE_IPV6, &_netreg_entry);
+    _server_pid = thread_create(_server_stack, sizeof(_server_stack),
+                                THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                                _server, NULL, "server");
+    run_unittests();
+    gnrc_tcp_abort(&_tcb);
+    _drain();
+    return 0;
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       GNRC TCP listening queue test: one thread serves concurrent
+ *              clients
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "net/af.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/tcp.h"
+#include "net/ipv6/addr.h"
+#include "xtimer.h"
+
+#ifndef POOL_SIZE
+#define POOL_SIZE           (4U)
+#endif
+
+#define SERVER_PORT         (8765U)
+/* every client sends a message of this size and gets it echoed */
+#define MSG_SIZE            (64U)
+#define ACCEPT_TIMEOUT      (1U * US_PER_SEC)
+#define IDLE_SLEEP          (1U * US_PER_MS)
+
+typedef struct {
+    gnrc_tcp_tcb_t *tcb;
+    size_t rcvd;
+    uint8_t buf[MSG_SIZE];
+} conn_t;
+
+static gnrc_tcp_tcb_t _pool[POOL_SIZE];
+static gnrc_tcp_tcb_queue_t _queue;
+static conn_t _conns[POOL_SIZE];
+static unsigned _open;
+static unsigned _served;
+
+static void _print_link_local(void)
+{
+    gnrc_netif_t *netif = gnrc_netif_iter(NULL);
+    ipv6_addr_t addrs[GNRC_NETIF_IPV6_ADDRS_NUMOF];
+    char addr_str[IPV6_ADDR_MAX_STR_LEN];
+    int res;
+
+    if (netif == NULL) {
+        puts("No network interface found");
+        return;
+    }
+    res = gnrc_netif_ipv6_addrs_get(netif, addrs, sizeof(addrs));
+    for (int i = 0; i < (int)(res / sizeof(ipv6_addr_t)); i++) {
+        if (ipv6_addr_is_link_local(&addrs[i])) {
+            printf("Listening on [%s]:%u with %u TCBs\n",
+                   ipv6_addr_to_str(addr_str, &addrs[i], sizeof(addr_str)),
+                   SERVER_PORT, POOL_SIZE);
+        }
+    }
+}
+
+static void _accept(gnrc_tcp_tcb_t *tcb)
+{
+    for (unsigned i = 0; i < POOL_SIZE; i++) {
+        if (_conns[i].tcb == NULL) {
+            _conns[i].tcb = tcb;
+            _conns[i].rcvd = 0;
+            _open++;
+            return;
+        }
+    }
+    /* can't happen, every TCB of the pool is accepted at most once */
+    gnrc_tcp_abort(tcb);
+}
+
+static void _finish(conn_t *conn, int res)
+{
+    if (res < 0) {
+        printf("Connection failed: %d\n", res);
+        gnrc_tcp_abort(conn->tcb);
+    }
+    else {
+        /* the client shuts down first, so this does not wait for TIME_WAIT */
+        gnrc_tcp_close(conn->tcb);
+        printf("Served %u\n", ++_served);
+    }
+    conn->tcb = NULL;
+    _open--;
+}
+
+/* returns true if something happened on the connection */
+static bool _serve(conn_t *conn)
+{
+    ssize_t res = gnrc_tcp_recv(conn->tcb, conn->buf + conn->rcvd,
+                                MSG_SIZE - conn->rcvd, 0);
+
+    if (res == -EAGAIN) {
+        return false;
+    }
+    if (res < 0) {
+        _finish(conn, res);
+        return true;
+    }
+    conn->rcvd += res;
+    if (conn->rcvd < MSG_SIZE) {
+        return true;
+    }
+    /* echo the message */
+    for (size_t sent = 0; sent < MSG_SIZE; sent += res) {
+        res = gnrc_tcp_send(conn->tcb, conn->buf + sent, MSG_SIZE - sent, 0);
+        if (res < 0) {
+            _finish(conn, res);
+            return true;
+        }
+    }
+    _finish(conn, 0);
+    return true;
+}
+
+int main(void)
+{
+    int res = gnrc_tcp_listen(&_queue, _pool, POOL_SIZE, AF_INET6, NULL, SERVER_PORT);
+
+    if (res < 0) {
+        printf("Unable to listen: %d\n", res);
+        return 1;
+    }
+    _print_link_local();
+
+    while (1) {
+        gnrc_tcp_tcb_t *tcb;
+        bool busy = false;
+
+        /* take all established connections, block only if nothing is open */
+        while (gnrc_tcp_accept(&_queue, &tcb, (_open == 0) ? ACCEPT_TIMEOUT : 0) == 0) {
+            _accept(tcb);
+            busy = true;
+        }
+        for (unsigned i = 0; i < POOL_SIZE; i++) {
+            if (_conns[i].tcb != NULL) {
+                busy |= _serve(&_conns[i]);
+            }
+        }
+        if (!busy) {
+            xtimer_usleep(IDLE_SLEEP);
+        }
+    }
+    return 0;
+}
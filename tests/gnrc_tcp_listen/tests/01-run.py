@@ -0,0 +1,57 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 RIOT developers
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import socket
+import sys
+import threading
+
+from testrunner import run
+
+
+# more clients than TCBs in the pool, the others are served after retrying
+CLIENTS = 12
+MSG_SIZE = 64
+
+
+class Client(threading.Thread):
+    def __init__(self, addr, port, iface, idx):
+        super().__init__(daemon=True)
+        self.dst = (addr, port, 0, socket.if_nametoindex(iface))
+        self.msg = bytes((idx + i) % 256 for i in range(MSG_SIZE))
+        self.echo = bytearray()
+
+    def run(self):
+        with socket.create_connection(self.dst, timeout=30) as sock:
+            sock.sendall(self.msg)
+            sock.shutdown(socket.SHUT_WR)
+            while True:
+                data = sock.recv(MSG_SIZE)
+                if not data:
+                    break
+                self.echo += data
+
+
+def testfunc(child):
+    child.expect(r"Listening on \[(fe80::[0-9a-f:]+)\]:(\d+) with (\d+) TCBs")
+    addr = child.match.group(1)
+    port = int(child.match.group(2))
+    clients = [Client(addr, port, os.environ["TAP"], i)
+               for i in range(CLIENTS)]
+    for client in clients:
+        client.start()
+    for i in range(CLIENTS):
+        child.expect_exact("Served {}".format(i + 1), timeout=60)
+    for client in clients:
+        client.join(timeout=10)
+        assert client.echo == client.msg
+    print("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=10))
@@ -0,0 +1,467 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests GNRC TCP with out-of-order segments and SACK
+ *
+ * The test takes the place of the network layer: it receives every segment
+ * GNRC TCP sends and injects the segments of the peer directly.
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "embUnit.h"
+#include "kernel_defines.h"
+#include "msg.h"
+#include "net/af.h"
+#include "net/gnrc/ipv6/hdr.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/tcp.h"
+#include "net/inet_csum.h"
+#include "net/ipv6/addr.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+#include "net/tcp.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define TEST_ADDR_LOCAL         { { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00, \
+                                    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01 } }
+#define TEST_ADDR_PEER          { { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00, \
+                                    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02 } }
+#define TEST_PORT_LOCAL         (8080U)
+#define TEST_PORT_PEER          (49152U)
+#define TEST_RECEIVE_TIMEOUT    (100U * US_PER_MS)
+#define TEST_MSG_QUEUE_SIZE     (16U)
+
+/* the peer announces a small MSS, so the server sends several segments */
+#define TEST_MSS                (100U)
+#define TEST_WINDOW             (1220U)
+#define TEST_IRS                (1000U)
+#define TEST_SEGS               (5U)
+#define TEST_DATA_SIZE          (TEST_SEGS * TEST_MSS)
+#define TEST_SEND_SEGS          (4U)
+#define TEST_SEND_SIZE          (TEST_SEND_SEGS * TEST_MSS)
+
+/* first sequence number of segment n of the peer, n = 0 is segment A */
+#define TEST_SEQ(n)             (TEST_IRS + 1 + ((n) * TEST_MSS))
+/* first sequence number of segment n the server sends */
+#define TEST_SND_SEQ(n)         (_iss + 1 + ((n) * TEST_MSS))
+
+/* control bits of the TCP header */
+#define TEST_CTL_SYN            (0x0002)
+#define TEST_CTL_ACK            (0x0010)
+
+/* messages between the server thread and the main thread */
+#define TEST_MSG_TYPE_OPEN      (0x8f01)
+#define TEST_MSG_TYPE_RECV      (0x8f02)
+#define TEST_MSG_TYPE_SEND      (0x8f03)
+
+typedef struct {
+    uint16_t ctl;
+    uint32_t seq;
+    uint32_t ack;
+    bool sack_perm;
+    unsigned sack_len;
+    gnrc_tcp_sack_block_t sack[GNRC_TCP_SACK_BLOCKS];
+    size_t pay_len;
+    uint8_t pay[TEST_MSS];
+} _segment_t;
+
+static const ipv6_addr_t _local = TEST_ADDR_LOCAL;
+static const ipv6_addr_t _peer = TEST_ADDR_PEER;
+static msg_t _msg_queue[TEST_MSG_QUEUE_SIZE];
+static char _server_stack[THREAD_STACKSIZE_MAIN];
+static kernel_pid_t _main_pid;
+static kernel_pid_t _server_pid;
+static gnrc_netreg_entry_t _netreg_entry;
+static gnrc_tcp_tcb_t _tcb;
+static uint32_t _iss;
+static msg_t _reply;
+static bool _reply_pending;
+static uint8_t _data[TEST_DATA_SIZE];
+static uint8_t _received[TEST_DATA_SIZE];
+
+static void *_server(void *arg)
+{
+    msg_t msg;
+
+    (void)arg;
+    gnrc_tcp_tcb_init(&_tcb);
+    msg.type = TEST_MSG_TYPE_OPEN;
+    msg.content.value = gnrc_tcp_open_passive(&_tcb, AF_INET6, NULL, TEST_PORT_LOCAL);
+    msg_send(&msg, _main_pid);
+
+    /* the main thread tells when to read or to send */
+    while (1) {
+        ssize_t res = 0;
+
+        msg_receive(&msg);
+        if (msg.type == TEST_MSG_TYPE_RECV) {
+            size_t got = 0;
+
+            while (got < TEST_DATA_SIZE) {
+                res = gnrc_tcp_recv(&_tcb, _received + got, TEST_DATA_SIZE - got,
+                                    TEST_RECEIVE_TIMEOUT);
+                if (res <= 0) {
+                    break;
+                }
+                got += res;
+            }
+            res = got;
+        }
+        else if (msg.type == TEST_MSG_TYPE_SEND) {
+            res = gnrc_tcp_send(&_tcb, _data, TEST_SEND_SIZE, 0);
+        }
+        msg.content.value = res;
+        msg_send(&msg, _main_pid);
+    }
+    return NULL;
+}
+
+static void _inject(uint16_t ctl, uint32_t seq, uint32_t ack,
+                    const uint8_t *opts, size_t opts_len,
+                    const uint8_t *data, size_t len)
+{
+    size_t hdr_len = sizeof(tcp_hdr_t) + opts_len;
+    gnrc_pktsnip_t *tcp, *ipv6;
+    ipv6_hdr_t *ipv6_hdr;
+    tcp_hdr_t *hdr;
+    uint16_t csum;
+
+    /* header and payload in one snip, as received from the network layer */
+    tcp = gnrc_pktbuf_add(NULL, NULL, hdr_len + len, GNRC_NETTYPE_TCP);
+    TEST_ASSERT_NOT_NULL(tcp);
+    hdr = tcp->data;
+    memset(hdr, 0, sizeof(tcp_hdr_t));
+    hdr->src_port = byteorder_htons(TEST_PORT_PEER);
+    hdr->dst_port = byteorder_htons(TEST_PORT_LOCAL);
+    hdr->seq_num = byteorder_htonl(seq);
+    hdr->ack_num = byteorder_htonl(ack);
+    hdr->off_ctl = byteorder_htons(((hdr_len / 4) << 12) | ctl);
+    hdr->window = byteorder_htons(TEST_WINDOW);
+    memcpy((uint8_t *)tcp->data + sizeof(tcp_hdr_t), opts, opts_len);
+    memcpy((uint8_t *)tcp->data + hdr_len, data, len);
+
+    ipv6 = gnrc_ipv6_hdr_build(NULL, &_peer, &_local);
+    TEST_ASSERT_NOT_NULL(ipv6);
+    ipv6_hdr = ipv6->data;
+    ipv6_hdr->len = byteorder_htons(tcp->size);
+    ipv6_hdr->nh = PROTNUM_TCP;
+    ipv6_hdr->hl = 64;
+    tcp->next = ipv6;
+
+    csum = inet_csum(0, tcp->data, tcp->size);
+    csum = ipv6_hdr_inet_csum(csum, ipv6_hdr, PROTNUM_TCP, tcp->size);
+    hdr->checksum = byteorder_htons(~csum);
+
+    TEST_ASSERT_EQUAL_INT(1, gnrc_netapi_dispatch_receive(GNRC_NETTYPE_TCP,
+                                                          GNRC_NETREG_DEMUX_CTX_ALL,
+                                                          tcp));
+}
+
+static void _inject_data(unsigned n)
+{
+    _inject(TEST_CTL_ACK, TEST_SEQ(n), _iss + 1, NULL, 0,
+            &_data[n * TEST_MSS], TEST_MSS);
+}
+
+static void _inject_sack(uint32_t ack, const gnrc_tcp_sack_block_t *blocks,
+                         unsigned blocks_len)
+{
+    uint8_t opts[4 + (GNRC_TCP_SACK_BLOCKS * TCP_OPTION_LENGTH_SACK_BLOCK)] = {
+        TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_SACK,
+        2 + (blocks_len * TCP_OPTION_LENGTH_SACK_BLOCK),
+    };
+
+    for (unsigned i = 0; i < blocks_len; i++) {
+        network_uint32_t left = byteorder_htonl(blocks[i].left);
+        network_uint32_t right = byteorder_htonl(blocks[i].right);
+
+        memcpy(&opts[4 + (i * TCP_OPTION_LENGTH_SACK_BLOCK)], &left, sizeof(left));
+        memcpy(&opts[8 + (i * TCP_OPTION_LENGTH_SACK_BLOCK)], &right, sizeof(right));
+    }
+    _inject(TEST_CTL_ACK, TEST_SEQ(TEST_SEGS), ack, opts,
+            4 + (blocks_len * TCP_OPTION_LENGTH_SACK_BLOCK), NULL, 0);
+}
+
+static void _parse_options(_segment_t *seg, const uint8_t *opt, size_t opt_len)
+{
+    size_t i = 0;
+
+    while (i < opt_len) {
+        if (opt[i] == TCP_OPTION_KIND_EOL) {
+            break;
+        }
+        if (opt[i] == TCP_OPTION_KIND_NOP) {
+            i++;
+            continue;
+        }
+        if ((i + 1 >= opt_len) || (opt[i + 1] < 2)) {
+            break;
+        }
+        if (opt[i] == TCP_OPTION_KIND_SACK_PERM) {
+            seg->sack_perm = true;
+        }
+        else if (opt[i] == TCP_OPTION_KIND_SACK) {
+            seg->sack_len = (opt[i + 1] - 2) / TCP_OPTION_LENGTH_SACK_BLOCK;
+            for (unsigned j = 0; (j < seg->sack_len) && (j < GNRC_TCP_SACK_BLOCKS); j++) {
+                network_uint32_t tmp;
+
+                memcpy(&tmp, &opt[i + 2 + (j * TCP_OPTION_LENGTH_SACK_BLOCK)],
+                       sizeof(tmp));
+                seg->sack[j].left = byteorder_ntohl(tmp);
+                memcpy(&tmp, &opt[i + 6 + (j * TCP_OPTION_LENGTH_SACK_BLOCK)],
+                       sizeof(tmp));
+                seg->sack[j].right = byteorder_ntohl(tmp);
+            }
+        }
+        i += opt[i + 1];
+    }
+}
+
+static bool _recv_segment(_segment_t *seg)
+{
+    gnrc_pktsnip_t *pkt, *tcp;
+    tcp_hdr_t *hdr;
+    size_t hdr_len;
+    msg_t msg;
+
+    while (1) {
+        if (xtimer_msg_receive_timeout(&msg, TEST_RECEIVE_TIMEOUT) < 0) {
+            return false;
+        }
+        if (msg.type == GNRC_NETAPI_MSG_TYPE_SND) {
+            break;
+        }
+        /* the server may reply while the connection is still busy */
+        _reply = msg;
+        _reply_pending = true;
+    }
+    pkt = msg.content.ptr;
+    tcp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_TCP);
+    if (tcp == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return false;
+    }
+    hdr = tcp->data;
+    memset(seg, 0, sizeof(*seg));
+    seg->ctl = byteorder_ntohs(hdr->off_ctl);
+    seg->seq = byteorder_ntohl(hdr->seq_num);
+    seg->ack = byteorder_ntohl(hdr->ack_num);
+    hdr_len = (seg->ctl >> 12) * 4;
+    seg->ctl &= 0x3f;
+    if ((hdr_len < sizeof(tcp_hdr_t)) || (hdr_len > tcp->size) ||
+        (gnrc_pkt_len(tcp->next) > sizeof(seg->pay))) {
+        gnrc_pktbuf_release(pkt);
+        return false;
+    }
+    _parse_options(seg, (uint8_t *)tcp->data + sizeof(tcp_hdr_t),
+                   hdr_len - sizeof(tcp_hdr_t));
+    for (gnrc_pktsnip_t *snp = tcp->next; snp != NULL; snp = snp->next) {
+        memcpy(seg->pay + seg->pay_len, snp->data, snp->size);
+        seg->pay_len += snp->size;
+    }
+    gnrc_pktbuf_release(pkt);
+    return true;
+}
+
+static void _expect_ack(uint32_t ack, const gnrc_tcp_sack_block_t *blocks,
+                        unsigned blocks_len)
+{
+    _segment_t seg;
+
+    TEST_ASSERT(_recv_segment(&seg));
+    TEST_ASSERT_EQUAL_INT(TEST_CTL_ACK, seg.ctl);
+    TEST_ASSERT_EQUAL_INT(ack, seg.ack);
+    TEST_ASSERT_EQUAL_INT(0, seg.pay_len);
+    TEST_ASSERT_EQUAL_INT(blocks_len, seg.sack_len);
+    for (unsigned i = 0; i < blocks_len; i++) {
+        TEST_ASSERT_EQUAL_INT(blocks[i].left, seg.sack[i].left);
+        TEST_ASSERT_EQUAL_INT(blocks[i].right, seg.sack[i].right);
+    }
+}
+
+static int _wait_server(uint16_t type)
+{
+    msg_t msg;
+
+    if (_reply_pending && (_reply.type == type)) {
+        _reply_pending = false;
+        return (int)_reply.content.value;
+    }
+    /* segments sent meanwhile, e.g. window updates, are of no interest */
+    while (xtimer_msg_receive_timeout(&msg, TEST_RECEIVE_TIMEOUT) >= 0) {
+        if (msg.type == type) {
+            return (int)msg.content.value;
+        }
+        if (msg.type == GNRC_NETAPI_MSG_TYPE_SND) {
+            gnrc_pktbuf_release(msg.content.ptr);
+        }
+    }
+    /* no reply from the server */
+    return -1;
+}
+
+static void _drain(void)
+{
+    msg_t msg;
+
+    while (msg_try_receive(&msg) == 1) {
+        if (msg.type == GNRC_NETAPI_MSG_TYPE_SND) {
+            gnrc_pktbuf_release(msg.content.ptr);
+        }
+    }
+}
+
+static void test_tcp_sack__handshake(void)
+{
+    static const uint8_t opts[] = {
+        TCP_OPTION_KIND_MSS, TCP_OPTION_LENGTH_MSS, TEST_MSS >> 8, TEST_MSS & 0xff,
+        TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_NOP,
+        TCP_OPTION_KIND_SACK_PERM, TCP_OPTION_LENGTH_SACK_PERM,
+    };
+    _segment_t seg;
+
+    _inject(TEST_CTL_SYN, TEST_IRS, 0, opts, sizeof(opts), NULL, 0);
+    TEST_ASSERT(_recv_segment(&seg));
+    TEST_ASSERT_EQUAL_INT(TEST_CTL_SYN | TEST_CTL_ACK, seg.ctl);
+    TEST_ASSERT_EQUAL_INT(TEST_SEQ(0), seg.ack);
+    TEST_ASSERT(seg.sack_perm);
+    _iss = seg.seq;
+
+    _inject(TEST_CTL_ACK, TEST_SEQ(0), _iss + 1, NULL, 0, NULL, 0);
+    TEST_ASSERT_EQUAL_INT(0, _wait_server(TEST_MSG_TYPE_OPEN));
+}
+
+static void test_tcp_sack__recv_out_of_order(void)
+{
+    /* segments A to E are injected in the order C, E, B, A, D */
+    const gnrc_tcp_sack_block_t c[] = { { TEST_SEQ(2), TEST_SEQ(3) } };
+    const gnrc_tcp_sack_block_t ec[] = { { TEST_SEQ(4), TEST_SEQ(5) },
+                                         { TEST_SEQ(2), TEST_SEQ(3) } };
+    const gnrc_tcp_sack_block_t bc_e[] = { { TEST_SEQ(1), TEST_SEQ(3) },
+                                           { TEST_SEQ(4), TEST_SEQ(5) } };
+    const gnrc_tcp_sack_block_t e[] = { { TEST_SEQ(4), TEST_SEQ(5) } };
+
+    _inject_data(2);
+    _expect_ack(TEST_SEQ(0), c, ARRAY_SIZE(c));
+    TEST_ASSERT_EQUAL_INT(TEST_MSS, _tcb.ooo_bytes);
+
+    _inject_data(4);
+    _expect_ack(TEST_SEQ(0), ec, ARRAY_SIZE(ec));
+    TEST_ASSERT_EQUAL_INT(2 * TEST_MSS, _tcb.ooo_bytes);
+
+    /* B joins C, the joined range is reported first */
+    _inject_data(1);
+    _expect_ack(TEST_SEQ(0), bc_e, ARRAY_SIZE(bc_e));
+    TEST_ASSERT_EQUAL_INT(3 * TEST_MSS, _tcb.ooo_bytes);
+
+    /* A fills the gap up to D */
+    _inject_data(0);
+    _expect_ack(TEST_SEQ(3), e, ARRAY_SIZE(e));
+    TEST_ASSERT_EQUAL_INT(TEST_MSS, _tcb.ooo_bytes);
+
+    _inject_data(3);
+    _expect_ack(TEST_SEQ(5), NULL, 0);
+    TEST_ASSERT_EQUAL_INT(0, _tcb.ooo_bytes);
+}
+
+static void test_tcp_sack__recv_data(void)
+{
+    msg_t msg = { .type = TEST_MSG_TYPE_RECV };
+
+    msg_send(&msg, _server_pid);
+    TEST_ASSERT_EQUAL_INT(TEST_DATA_SIZE, _wait_server(TEST_MSG_TYPE_RECV));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_data, _received, TEST_DATA_SIZE));
+}
+
+static void test_tcp_sack__send_skip_sacked(void)
+{
+    msg_t msg = { .type = TEST_MSG_TYPE_SEND };
+    gnrc_tcp_sack_block_t sack = { TEST_SND_SEQ(1), TEST_SND_SEQ(1) };
+    _segment_t seg;
+
+    _drain();
+    msg_send(&msg, _server_pid);
+    for (unsigned i = 0; i < TEST_SEND_SEGS; i++) {
+        TEST_ASSERT(_recv_segment(&seg));
+        TEST_ASSERT_EQUAL_INT(TEST_SND_SEQ(i), seg.seq);
+        TEST_ASSERT_EQUAL_INT(TEST_MSS, seg.pay_len);
+    }
+
+    /* the first segment is lost, the peer reports all others */
+    for (unsigned i = 1; i < TEST_SEND_SEGS; i++) {
+        sack.right = TEST_SND_SEQ(i + 1);
+        _inject_sack(TEST_SND_SEQ(0), &sack, 1);
+    }
+    /* the third duplicate ACK retransmits the lost segment only ... */
+    TEST_ASSERT(_recv_segment(&seg));
+    TEST_ASSERT_EQUAL_INT(TEST_SND_SEQ(0), seg.seq);
+    TEST_ASSERT_EQUAL_INT(TEST_MSS, seg.pay_len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_data, seg.pay, TEST_MSS));
+    /* ... and further duplicate ACKs find no other hole */
+    _inject_sack(TEST_SND_SEQ(0), &sack, 1);
+    TEST_ASSERT(!_recv_segment(&seg));
+
+    _inject(TEST_CTL_ACK, TEST_SEQ(TEST_SEGS), TEST_SND_SEQ(TEST_SEND_SEGS),
+            NULL, 0, NULL, 0);
+    TEST_ASSERT_EQUAL_INT(TEST_SEND_SIZE, _wait_server(TEST_MSG_TYPE_SEND));
+    TEST_ASSERT_EQUAL_INT(TEST_SEND_SEGS - 1, _tcb.rtx_avoided);
+}
+
+static void run_unittests(void)
+{
+    /* the fixtures run in order on one connection */
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_tcp_sack__handshake),
+        new_TestFixture(test_tcp_sack__recv_out_of_order),
+        new_TestFixture(test_tcp_sack__recv_data),
+        new_TestFixture(test_tcp_sack__send_skip_sacked),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_tcp_sack_tests, NULL, NULL, fixtures);
+    TESTS_START();
+    TESTS_RUN((Test *)&gnrc_tcp_sack_tests);
+    TESTS_END();
+}
+
+int main(void)
+{
+    /* no auto-init, so the modules need to be initialized manually */
+    xtimer_init();
+    gnrc_pktbuf_init();
+    gnrc_tcp_init();
+    msg_init_queue(_msg_queue, TEST_MSG_QUEUE_SIZE);
+    _main_pid = sched_active_pid;
+    for (unsigned i = 0; i < TEST_DATA_SIZE; i++) {
+        _data[i] = i;
+    }
+    /* receive what GNRC TCP sends to the network layer */
+    gnrc_netreg_entry_init_pid(&_netreg_entry, GNRC_NETREG_DEMUX_CTX_ALL, _main_pid);
+    gnrc_netreg_register(GNRC_NETTYPE_IPV6, &_netreg_entry);
+    _server_pid = thread_create(_server_stack, sizeof(_server_stack),
+                                THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                                _server, NULL, "server");
+    run_unittests();
+    gnrc_tcp_abort(&_tcb);
+    _drain();
+    return 0;
+}
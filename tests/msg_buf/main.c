@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the ownership of message buffers
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "embUnit.h"
+#include "msg.h"
+#include "msg_buf.h"
+#include "sched.h"
+#include "thread.h"
+
+#define BUF_SIZE        (32U)
+#define BUF_NUMOF       (2U)
+#define QUEUE_SIZE      (2U)
+#define PATTERN         (0xa5)
+
+static MSG_BUF_POOL_STORAGE(_storage, BUF_SIZE, BUF_NUMOF);
+static msg_buf_pool_t _pool;
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+static msg_t _queue[QUEUE_SIZE];
+static kernel_pid_t _claimed_by;
+static unsigned _allocated;
+
+static unsigned _alloc_all(msg_buf_t **bufs)
+{
+    unsigned num = 0;
+
+    while ((num < BUF_NUMOF) && (bufs[num] = msg_buf_alloc(&_pool))) {
+        num++;
+    }
+    return num;
+}
+
+static void _free_all(msg_buf_t **bufs, unsigned num)
+{
+    for (unsigned i = 0; i < num; i++) {
+        msg_buf_free(bufs[i]);
+    }
+}
+
+static void *_echo(void *arg)
+{
+    msg_t msg;
+    msg_buf_t *buf;
+
+    (void)arg;
+    msg_receive(&msg);
+    buf = msg_buf_claim(&msg);
+    _claimed_by = buf->owner;
+    memset(msg_buf_data(buf), PATTERN, BUF_SIZE);
+    buf->len = BUF_SIZE;
+    msg_buf_send(&msg, buf, msg.sender_pid);
+    return NULL;
+}
+
+static void *_sleep(void *arg)
+{
+    if (arg != NULL) {
+        msg_init_queue(arg, QUEUE_SIZE);
+    }
+    thread_sleep();
+    /* exit without receiving what may be queued */
+    return NULL;
+}
+
+static void *_alloc_and_exit(void *arg)
+{
+    msg_buf_t *bufs[BUF_NUMOF];
+
+    (void)arg;
+    _allocated = _alloc_all(bufs);
+    return NULL;
+}
+
+static kernel_pid_t _create(thread_task_func_t func, void *arg)
+{
+    /* runs until it blocks or exits */
+    return thread_create(_stack, sizeof(_stack), THREAD_PRIORITY_MAIN - 1,
+                         THREAD_CREATE_STACKTEST, func, arg, "msg_buf");
+}
+
+static void test_msg_buf_send__round_trip(void)
+{
+    msg_t msg;
+    msg_buf_t *buf = msg_buf_alloc(&_pool);
+    kernel_pid_t echo = _create(_echo, NULL);
+
+    TEST_ASSERT_NOT_NULL(buf);
+    TEST_ASSERT_EQUAL_INT(sched_active_pid, buf->owner);
+    TEST_ASSERT_EQUAL_INT(1, msg_buf_send(&msg, buf, echo));
+    TEST_ASSERT_EQUAL_INT(echo, _claimed_by);
+    msg_receive(&msg);
+    TEST_ASSERT(buf == msg_buf_claim(&msg));
+    TEST_ASSERT_EQUAL_INT(sched_active_pid, buf->owner);
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE, buf->len);
+    TEST_ASSERT_EQUAL_INT(PATTERN, msg_buf_data(buf)[BUF_SIZE - 1]);
+    msg_buf_free(buf);
+}
+
+static void test_msg_buf_try_send__not_delivered(void)
+{
+    msg_t msg;
+    msg_buf_t *buf = msg_buf_alloc(&_pool);
+    /* neither receiving nor queueing messages */
+    kernel_pid_t target = _create(_sleep, NULL);
+
+    TEST_ASSERT_NOT_NULL(buf);
+    TEST_ASSERT_EQUAL_INT(0, msg_buf_try_send(&msg, buf, target));
+    TEST_ASSERT_EQUAL_INT(sched_active_pid, buf->owner);
+    thread_wakeup(target);
+    msg_buf_free(buf);
+}
+
+static void test_msg_buf_release_all__queued(void)
+{
+    msg_t msg;
+    msg_buf_t *bufs[BUF_NUMOF];
+    msg_buf_t *buf = msg_buf_alloc(&_pool);
+    kernel_pid_t target = _create(_sleep, _queue);
+
+    TEST_ASSERT_NOT_NULL(buf);
+    TEST_ASSERT_EQUAL_INT(1, msg_buf_try_send(&msg, buf, target));
+    /* queued buffers already belong to the receiver */
+    TEST_ASSERT_EQUAL_INT(target, buf->owner);
+    TEST_ASSERT_EQUAL_INT(BUF_NUMOF - 1, _alloc_all(bufs));
+    _free_all(bufs, BUF_NUMOF - 1);
+    /* let it exit */
+    thread_wakeup(target);
+    TEST_ASSERT_EQUAL_INT(BUF_NUMOF, _alloc_all(bufs));
+    _free_all(bufs, BUF_NUMOF);
+}
+
+static void test_msg_buf_release_all__allocated(void)
+{
+    msg_buf_t *bufs[BUF_NUMOF];
+
+    _allocated = 0;
+    _create(_alloc_and_exit, NULL);
+    TEST_ASSERT_EQUAL_INT(BUF_NUMOF, _allocated);
+    TEST_ASSERT_EQUAL_INT(BUF_NUMOF, _alloc_all(bufs));
+    TEST_ASSERT_NULL(msg_buf_alloc(&_pool));
+    _free_all(bufs, BUF_NUMOF);
+}
+
+static Test *tests_msg_buf(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_msg_buf_send__round_trip),
+        new_TestFixture(test_msg_buf_try_send__not_delivered),
+        new_TestFixture(test_msg_buf_release_all__queued),
+        new_TestFixture(test_msg_buf_release_all__allocated),
+    };
+
+    EMB_UNIT_TESTCALLER(tests, NULL, NULL, fixtures);
+
+    return (Test *)&tests;
+}
+
+int main(void)
+{
+    msg_buf_pool_init(&_pool, _storage, BUF_SIZE, BUF_NUMOF);
+
+    TESTS_START();
+    TESTS_RUN(tests_msg_buf());
+    TESTS_END();
+
+    return 0;
+}
@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Floods a message queue from timer interrupts and threads
+ *
+ * The receiver has a lower priority than all senders, so its queue
+ * overflows regularly. Every message must either be received or be counted
+ * as an overflow of the queue.
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "msg.h"
+#include "ps.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define TEST_DURATION       (1U * US_PER_SEC)
+#define QUEUE_SIZE          (16U)
+
+#define SENDERS_NUMOF       (2U)
+#define SENDER_BURST        (8U)
+#define SENDER_PAUSE        (1000U)
+
+#define TIMERS_NUMOF        (2U)
+#define TIMER_PERIOD        (200U)
+
+/* message types are the index of the source, the stop message is last */
+#define SOURCES_NUMOF       (SENDERS_NUMOF + TIMERS_NUMOF)
+#define TYPE_STOP           (SOURCES_NUMOF)
+
+static char _receiver_stack[THREAD_STACKSIZE_DEFAULT];
+static char _sender_stacks[SENDERS_NUMOF][THREAD_STACKSIZE_DEFAULT];
+static msg_t _queue[QUEUE_SIZE];
+static kernel_pid_t _receiver;
+
+static xtimer_t _timers[TIMERS_NUMOF];
+static volatile unsigned _stop;
+
+static unsigned _sent[SOURCES_NUMOF];
+static unsigned _dropped[SOURCES_NUMOF];
+static unsigned _received[SOURCES_NUMOF];
+
+static void _send(unsigned source)
+{
+    msg_t m = { .type = source };
+
+    if (msg_try_send(&m, _receiver) == 1) {
+        _sent[source]++;
+    }
+    else {
+        _dropped[source]++;
+    }
+}
+
+static void _timer_cb(void *arg)
+{
+    unsigned idx = (uintptr_t)arg;
+
+    _send(SENDERS_NUMOF + idx);
+    if (!_stop) {
+        /* different periods make the timers fire in varying order */
+        xtimer_set(&_timers[idx], TIMER_PERIOD + (idx * 37));
+    }
+}
+
+static void *_sender(void *arg)
+{
+    unsigned source = (uintptr_t)arg;
+
+    while (!_stop) {
+        for (unsigned i = 0; i < SENDER_BURST; i++) {
+            _send(source);
+        }
+        xtimer_usleep(SENDER_PAUSE);
+    }
+
+    return NULL;
+}
+
+static void *_receiver_thread(void *arg)
+{
+    (void)arg;
+    msg_t m;
+
+    msg_init_queue(_queue, QUEUE_SIZE);
+
+    while (1) {
+        msg_receive(&m);
+        if (m.type == TYPE_STOP) {
+            msg_reply(&m, &m);
+        }
+        else {
+            _received[m.type]++;
+        }
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    msg_t m = { .type = TYPE_STOP };
+    unsigned dropped = 0;
+    int res = 1;
+
+    puts("msg queue flood test");
+
+    _receiver = thread_create(_receiver_stack, sizeof(_receiver_stack),
+                              THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                              _receiver_thread, NULL, "receiver");
+    for (unsigned i = 0; i < SENDERS_NUMOF; i++) {
+        thread_create(_sender_stacks[i], sizeof(_sender_stacks[i]),
+                      THREAD_PRIORITY_MAIN - 2, THREAD_CREATE_STACKTEST,
+                      _sender, (void *)(uintptr_t)i, "sender");
+    }
+    for (unsigned i = 0; i < TIMERS_NUMOF; i++) {
+        _timers[i].callback = _timer_cb;
+        _timers[i].arg = (void *)(uintptr_t)i;
+        xtimer_set(&_timers[i], TIMER_PERIOD);
+    }
+
+    xtimer_usleep(TEST_DURATION);
+    _stop = 1;
+    for (unsigned i = 0; i < TIMERS_NUMOF; i++) {
+        xtimer_remove(&_timers[i]);
+    }
+    /* let the senders finish their last burst */
+    xtimer_usleep(2 * SENDER_PAUSE);
+
+    /* the receiver handles the queued messages before replying */
+    msg_send_receive(&m, &m, _receiver);
+
+    for (unsigned i = 0; i < SOURCES_NUMOF; i++) {
+        printf("source %u: sent %u, dropped %u, received %u\n",
+               i, _sent[i], _dropped[i], _received[i]);
+        if (_sent[i] != _received[i]) {
+            res = 0;
+        }
+        dropped += _dropped[i];
+    }
+
+    unsigned overflows = ((thread_t *)thread_get(_receiver))->msg_overflows;
+    printf("queue overflows: %u\n", overflows);
+    if (overflows != dropped) {
+        res = 0;
+    }
+
+    ps();
+
+    puts(res ? "SUCCESS" : "FAILURE");
+
+    return 0;
+}
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for mutex priority inheritance
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "mutex.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define PRIO_LOW        (THREAD_PRIORITY_MAIN - 1)
+#define PRIO_MID        (THREAD_PRIORITY_MAIN - 2)
+#define PRIO_HIGH       (THREAD_PRIORITY_MAIN - 3)
+
+#define HOLD_TIME       (100U * US_PER_MS)
+#define BUSY_TIME       (200U * US_PER_MS)
+/* the high priority thread starts waiting this long after the mutex was
+ * locked, the medium priority thread starts working after twice that time */
+#define START_DELAY     (10U * US_PER_MS)
+
+static char _stack_low[THREAD_STACKSIZE_DEFAULT];
+static char _stack_mid[THREAD_STACKSIZE_DEFAULT];
+static char _stack_high[THREAD_STACKSIZE_DEFAULT];
+
+static mutex_t _mtx1 = MUTEX_INIT;
+static uint32_t _latency;
+
+static void *_inversion_low(void *arg)
+{
+    (void)arg;
+
+    mutex_lock(&_mtx1);
+    xtimer_spin(xtimer_ticks_from_usec(HOLD_TIME));
+    mutex_unlock(&_mtx1);
+
+    return NULL;
+}
+
+static void *_inversion_mid(void *arg)
+{
+    (void)arg;
+
+    xtimer_usleep(2 * START_DELAY);
+    xtimer_spin(xtimer_ticks_from_usec(BUSY_TIME));
+
+    return NULL;
+}
+
+static void *_inversion_high(void *arg)
+{
+    (void)arg;
+
+    xtimer_usleep(START_DELAY);
+
+    uint32_t start = xtimer_now_usec();
+    mutex_lock(&_mtx1);
+    _latency = xtimer_now_usec() - start;
+    mutex_unlock(&_mtx1);
+
+    return NULL;
+}
+
+static int _test_inversion(void)
+{
+    puts("priority inversion:");
+
+    /* the low priority thread starts last, as it does not block */
+    thread_create(_stack_high, sizeof(_stack_high), PRIO_HIGH,
+                  THREAD_CREATE_STACKTEST, _inversion_high, NULL, "high");
+    thread_create(_stack_mid, sizeof(_stack_mid), PRIO_MID,
+                  THREAD_CREATE_STACKTEST, _inversion_mid, NULL, "mid");
+    thread_create(_stack_low, sizeof(_stack_low), PRIO_LOW,
+                  THREAD_CREATE_STACKTEST, _inversion_low, NULL, "low");
+
+    /* main has the lowest priority, so all threads are done by now */
+    printf("high priority thread waited %" PRIu32 " us\n", _latency);
+
+    return _latency < (HOLD_TIME + (BUSY_TIME / 2));
+}
+
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+static mutex_t _mtx2 = MUTEX_INIT;
+
+static void *_chain_low(void *arg)
+{
+    (void)arg;
+
+    mutex_lock(&_mtx2);
+    thread_sleep();
+    mutex_unlock(&_mtx2);
+
+    return NULL;
+}
+
+static void *_chain_mid(void *arg)
+{
+    (void)arg;
+
+    mutex_lock(&_mtx1);
+    mutex_lock(&_mtx2);
+    mutex_unlock(&_mtx2);
+    mutex_unlock(&_mtx1);
+
+    return NULL;
+}
+
+static void *_chain_high(void *arg)
+{
+    (void)arg;
+
+    mutex_lock(&_mtx1);
+    mutex_unlock(&_mtx1);
+
+    return NULL;
+}
+
+static int _test_chain(void)
+{
+    int res = 1;
+
+    puts("priority inheritance chain:");
+
+    /* every thread runs until it blocks, so when main continues the low
+     * priority thread sleeps owning _mtx2, the medium priority thread owns
+     * _mtx1 and waits for _mtx2, and the high priority thread waits for
+     * _mtx1 */
+    kernel_pid_t low = thread_create(_stack_low, sizeof(_stack_low), PRIO_LOW,
+                                     THREAD_CREATE_STACKTEST, _chain_low,
+                                     NULL, "low");
+    kernel_pid_t mid = thread_create(_stack_mid, sizeof(_stack_mid), PRIO_MID,
+                                     THREAD_CREATE_STACKTEST, _chain_mid,
+                                     NULL, "mid");
+    thread_create(_stack_high, sizeof(_stack_high), PRIO_HIGH,
+                  THREAD_CREATE_STACKTEST, _chain_high, NULL, "high");
+
+    unsigned prio_low = thread_get(low)->priority;
+    unsigned prio_mid = thread_get(mid)->priority;
+    printf("low runs with priority %u, mid with priority %u\n",
+           prio_low, prio_mid);
+    if ((prio_low != PRIO_HIGH) || (prio_mid != PRIO_HIGH)) {
+        res = 0;
+    }
+
+    thread_wakeup(low);
+
+    /* all threads are done, so the mutexes must be free again */
+    if (!mutex_trylock(&_mtx1) || !mutex_trylock(&_mtx2)) {
+        res = 0;
+    }
+
+    return res;
+}
+#endif
+
+int main(void)
+{
+    int res;
+
+    puts("mutex priority inheritance test application");
+
+    res = _test_inversion();
+    printf("%s\n", res ? "ok" : "failed");
+
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    int chain = _test_chain();
+    printf("%s\n", chain ? "ok" : "failed");
+    res &= chain;
+#endif
+
+    puts(res ? "SUCCESS" : "FAILURE");
+
+    return 0;
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for deferred interrupt work
+ *
+ * Raises two softirqs from a timer ISR, one of which needs several rounds
+ * to finish its work, checks that the worker pauses after
+ * SOFTIRQ_RUN_ITEMS handler calls, and prints the interrupt-disabled
+ * sections seen, per call site and per thread.
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "assert.h"
+#include "irq_stats.h"
+#include "ps.h"
+#include "sched.h"
+#include "softirq.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define WORK_A          (20U)
+#define WORK_B          (1U)
+#define RUNS_MAX        (8U)
+
+static unsigned _work[2] = { WORK_A, WORK_B };
+static char _runs[RUNS_MAX];
+static unsigned _budgets[RUNS_MAX];
+static uint32_t _times[RUNS_MAX];
+static unsigned _nruns;
+
+static int _handler(softirq_t *sirq, unsigned budget)
+{
+    unsigned idx = (uintptr_t)sirq->arg;
+    unsigned done = (_work[idx] < budget) ? _work[idx] : budget;
+
+    assert(_nruns < RUNS_MAX);
+    _runs[_nruns] = 'a' + idx;
+    _times[_nruns] = xtimer_now_usec();
+    _budgets[_nruns++] = budget;
+    _work[idx] -= done;
+
+    return _work[idx] != 0;
+}
+
+static softirq_t _sirq[2] = {
+    SOFTIRQ_INIT(_handler, (void *)0),
+    SOFTIRQ_INIT(_handler, (void *)1),
+};
+
+static void _isr(void *arg)
+{
+    (void)arg;
+    softirq_raise(&_sirq[0]);
+    softirq_raise(&_sirq[1]);
+    /* already pending, must not queue twice */
+    softirq_raise(&_sirq[0]);
+}
+
+int main(void)
+{
+    xtimer_t timer = { .callback = _isr };
+
+    irq_stats_reset();
+    xtimer_set(&timer, 1000);
+    xtimer_usleep(100 * US_PER_MS);
+
+    printf("order:");
+    for (unsigned i = 0; i < _nruns; i++) {
+        printf(" %c(%u)", _runs[i], _budgets[i]);
+    }
+    puts("");
+    assert((_work[0] == 0) && (_work[1] == 0));
+    /* the first run ended after SOFTIRQ_RUN_ITEMS handlers */
+    assert((_times[SOFTIRQ_RUN_ITEMS] - _times[SOFTIRQ_RUN_ITEMS - 1]) >=
+           SOFTIRQ_RUN_GAP_US);
+    puts("paused after a run");
+
+    irq_stats_print();
+    schedstat_snapshot_t snap;
+    sched_statistics_snapshot(sched_active_pid, &snap);
+    /* the snapshot was taken first */
+    assert(snap.irq_off_us <= irq_stats_thread_us(sched_active_pid));
+    printf("main: %u us with interrupts disabled\n",
+           (unsigned)snap.irq_off_us);
+    ps();
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
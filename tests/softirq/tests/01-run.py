@@ -0,0 +1,23 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 RIOT developers
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("order: a(8) b(8) a(8) a(8)")
+    child.expect_exact("paused after a run")
+    child.expect_exact("site       |      count |   max (us)")
+    child.expect(r"main: \d+ us with interrupts disabled")
+    child.expect_exact("| irq (us)")
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Thread pool test application
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+
+#include "assert.h"
+#include "thread.h"
+#include "tpool.h"
+
+#define WORKERS         (2U)
+#define JOBS            (5U)
+#define ROUNDS          (1000U)
+#define RESUBMITS       (100U)
+
+static tpool_t pool;
+static tpool_job_t jobs[JOBS];
+static uint32_t results[JOBS];
+
+#ifndef MODULE_TPOOL_PTHREAD
+static char stacks[WORKERS][THREAD_STACKSIZE_DEFAULT];
+#endif
+
+/* pure computation, so it is safe to run on host threads as well */
+static void _job(void *arg)
+{
+    uint32_t *res = arg;
+    uint32_t x = (uint32_t)(res - results) + 1;
+
+    for (unsigned i = 0; i < ROUNDS; i++) {
+        x = (x * 1103515245U) + 12345U;
+    }
+    *res = x;
+}
+
+static uint32_t _expected(unsigned idx)
+{
+    uint32_t x = idx + 1;
+
+    for (unsigned i = 0; i < ROUNDS; i++) {
+        x = (x * 1103515245U) + 12345U;
+    }
+    return x;
+}
+
+int main(void)
+{
+    tpool_init(&pool);
+#ifdef MODULE_TPOOL_PTHREAD
+    unsigned started = tpool_start_host(&pool, WORKERS);
+#else
+    /* lower priority than main, so nothing runs before main blocks */
+    unsigned started = tpool_start(&pool, (char *)stacks, sizeof(stacks[0]),
+                                   WORKERS, THREAD_PRIORITY_MAIN + 1);
+#endif
+    assert(started == WORKERS);
+    (void)started;
+
+    for (unsigned i = 0; i < JOBS; i++) {
+        tpool_submit(&pool, &jobs[i], _job, &results[i]);
+    }
+
+#ifndef MODULE_TPOOL_PTHREAD
+    /* no worker got to run yet */
+    assert(tpool_cancel(&pool, &jobs[JOBS - 1]) == 0);
+    assert(tpool_wait(&jobs[JOBS - 1]) == TPOOL_JOB_CANCELLED);
+#else
+    tpool_cancel(&pool, &jobs[JOBS - 1]);
+#endif
+
+    for (unsigned i = 0; i < JOBS - 1; i++) {
+        assert(tpool_wait(&jobs[i]) == TPOOL_JOB_DONE);
+        assert(tpool_done(&jobs[i]));
+        assert(results[i] == _expected(i));
+        assert(tpool_cancel(&pool, &jobs[i]) == -EBUSY);
+        printf("job %u done\n", i);
+    }
+
+    /* a job reported done must be ready to be submitted again right away,
+     * even if the worker that ran it did not get to return yet */
+    for (unsigned i = 0; i < RESUBMITS; i++) {
+        results[0] = 0;
+        tpool_submit(&pool, &jobs[0], _job, &results[0]);
+#ifdef MODULE_TPOOL_PTHREAD
+        while (!tpool_done(&jobs[0])) {}
+#else
+        /* main preempts the worker as soon as it releases the job */
+        tpool_wait(&jobs[0]);
+#endif
+        assert(tpool_done(&jobs[0]));
+        assert(jobs[0].state == TPOOL_JOB_DONE);
+        assert(results[0] == _expected(0));
+    }
+    printf("resubmitted %u times\n", RESUBMITS);
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
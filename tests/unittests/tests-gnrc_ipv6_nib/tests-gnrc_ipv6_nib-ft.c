@@ -16,6 +16,7 @@
 #include <inttypes.h>
 
 #include "bitfield.h"
+#include "kernel_defines.h"
 #include "net/ipv6/addr.h"
 #include "net/gnrc/ipv6/nib.h"
 #include "net/gnrc/ipv6/nib/ft.h"
@@ -178,6 +179,96 @@ static void test_nib_ft_get__success4(void)
     TEST_ASSERT_EQUAL_INT(IFACE, fte.iface);
 }
 
+/*
+ * Adds the default route and routes with overlapping prefixes of length 16, 32,
+ * 48, and 64 (in neither ascending nor descending order) to the forwarding
+ * table, then tries to get addresses that differ from the routes just after
+ * each of those prefix lengths.
+ * Expected result: gnrc_ipv6_nib_ft_get() returns the route with the longest
+ * matching prefix for each address
+ */
+static void test_nib_ft_get__success_longest_prefix(void)
+{
+    static const unsigned dst_lens[] = { 48, 16, 64, 32 };
+    /* routes to expect when toggling the bit after the given prefix length */
+    static const unsigned toggles[] = { 3, 20, 40, 50, 100 };
+    static const unsigned expected[] = { 0, 16, 32, 48, 64 };
+    gnrc_ipv6_nib_ft_t fte;
+    static const ipv6_addr_t dst = { .u64 = { { .u8 = GLOBAL_PREFIX },
+                                              { .u64 = TEST_UINT64 } } };
+    ipv6_addr_t next_hop = { .u64 = { { .u8 = LINK_LOCAL_PREFIX },
+                                      { .u64 = TEST_UINT64 } } };
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_add(NULL, 0, &next_hop, IFACE, 0));
+    for (unsigned i = 0; i < ARRAY_SIZE(dst_lens); i++) {
+        next_hop.u64[1].u64 = TEST_UINT64 + dst_lens[i];
+        TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_add(&dst, dst_lens[i],
+                                                      &next_hop, IFACE, 0));
+    }
+    for (unsigned i = 0; i < ARRAY_SIZE(toggles); i++) {
+        ipv6_addr_t addr = dst;
+
+        bf_toggle(addr.u8, toggles[i]);
+        next_hop.u64[1].u64 = TEST_UINT64 + expected[i];
+        TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_get(&addr, NULL, &fte));
+        TEST_ASSERT_EQUAL_INT(expected[i], fte.dst_len);
+        TEST_ASSERT(ipv6_addr_match_prefix(&addr, &fte.dst) >= expected[i]);
+        TEST_ASSERT(ipv6_addr_equal(&next_hop, &fte.next_hop));
+        TEST_ASSERT_EQUAL_INT(IFACE, fte.iface);
+    }
+}
+
+/*
+ * Adds routes with overlapping prefixes of length 16, 32, 48, and 64 to the
+ * forwarding table, then removes them one after another (the longest, one in
+ * the middle, and the rest) and tries to get an address within all of them
+ * and one only within the shorter two after each removal.
+ * Expected result: gnrc_ipv6_nib_ft_get() returns the longest remaining
+ * matching route, and -ENETUNREACH when no route is left
+ */
+static void test_nib_ft_get__success_longest_prefix_del(void)
+{
+    static const unsigned dst_lens[] = { 16, 32, 48, 64 };
+    gnrc_ipv6_nib_ft_t fte;
+    static const ipv6_addr_t dst = { .u64 = { { .u8 = GLOBAL_PREFIX },
+                                              { .u64 = TEST_UINT64 } } };
+    ipv6_addr_t next_hop = { .u64 = { { .u8 = LINK_LOCAL_PREFIX },
+                                      { .u64 = TEST_UINT64 } } };
+    ipv6_addr_t addr = dst;
+
+    /* only within the /16 and /32 routes */
+    bf_toggle(addr.u8, 40);
+    for (unsigned i = 0; i < ARRAY_SIZE(dst_lens); i++) {
+        next_hop.u64[1].u64 = TEST_UINT64 + dst_lens[i];
+        TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_add(&dst, dst_lens[i],
+                                                      &next_hop, IFACE, 0));
+    }
+    gnrc_ipv6_nib_ft_del(&dst, 64);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_get(&dst, NULL, &fte));
+    TEST_ASSERT_EQUAL_INT(48, fte.dst_len);
+    next_hop.u64[1].u64 = TEST_UINT64 + 48;
+    TEST_ASSERT(ipv6_addr_equal(&next_hop, &fte.next_hop));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_get(&addr, NULL, &fte));
+    TEST_ASSERT_EQUAL_INT(32, fte.dst_len);
+
+    gnrc_ipv6_nib_ft_del(&dst, 32);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_get(&dst, NULL, &fte));
+    TEST_ASSERT_EQUAL_INT(48, fte.dst_len);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_get(&addr, NULL, &fte));
+    TEST_ASSERT_EQUAL_INT(16, fte.dst_len);
+    next_hop.u64[1].u64 = TEST_UINT64 + 16;
+    TEST_ASSERT(ipv6_addr_equal(&next_hop, &fte.next_hop));
+
+    gnrc_ipv6_nib_ft_del(&dst, 48);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_get(&dst, NULL, &fte));
+    TEST_ASSERT_EQUAL_INT(16, fte.dst_len);
+    TEST_ASSERT(ipv6_addr_equal(&next_hop, &fte.next_hop));
+
+    gnrc_ipv6_nib_ft_del(&dst, 16);
+    TEST_ASSERT_EQUAL_INT(-ENETUNREACH, gnrc_ipv6_nib_ft_get(&dst, NULL, &fte));
+    TEST_ASSERT_EQUAL_INT(-ENETUNREACH, gnrc_ipv6_nib_ft_get(&addr, NULL, &fte));
+}
+
 /*
  * Tries to create a forwarding table entry for the default route (::) with
  * NULL as next hop.
@@ -727,6 +818,8 @@ Test *tests_gnrc_ipv6_nib_ft_tests(void)
         new_TestFixture(test_nib_ft_get__success2),
         new_TestFixture(test_nib_ft_get__success3),
         new_TestFixture(test_nib_ft_get__success4),
+        new_TestFixture(test_nib_ft_get__success_longest_prefix),
+        new_TestFixture(test_nib_ft_get__success_longest_prefix_del),
         new_TestFixture(test_nib_ft_add__EINVAL_def_route_next_hop_NULL),
         new_TestFixture(test_nib_ft_add__EINVAL_iface0),
         new_TestFixture(test_nib_ft_add__ENOMEM_diff_def_router),
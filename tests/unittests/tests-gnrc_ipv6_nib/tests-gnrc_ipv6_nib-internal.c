@@ -531,6 +531,43 @@ static void test_nib_nc_add__cache_out_crash(void)
     }
 }
 
+/*
+ * Creates GNRC_IPV6_NIB_NUMOF garbage-collectible neighbor cache entries, looks
+ * up the first one and then adds another one.
+ * Expected result: the second entry, as the least recently used, is replaced
+ * and the lookups and the replacement are counted
+ */
+static void test_nib_nc_add__success_full_lru(void)
+{
+    _nib_onl_entry_t *first, *second, *node;
+    gnrc_ipv6_nib_nc_stats_t stats;
+    ipv6_addr_t addr = { .u64 = { { .u8 = GLOBAL_PREFIX },
+                                  { .u64 = TEST_UINT64 } } };
+    const ipv6_addr_t first_addr = addr;
+
+    TEST_ASSERT_NOT_NULL((first = _nib_nc_add(&addr, IFACE,
+                                              GNRC_IPV6_NIB_NC_INFO_NUD_STATE_STALE)));
+    addr.u64[1].u64++;
+    TEST_ASSERT_NOT_NULL((second = _nib_nc_add(&addr, IFACE,
+                                               GNRC_IPV6_NIB_NC_INFO_NUD_STATE_STALE)));
+    for (int i = 2; i < GNRC_IPV6_NIB_NUMOF; i++) {
+        addr.u64[1].u64++;
+        TEST_ASSERT_NOT_NULL(_nib_nc_add(&addr, IFACE,
+                                         GNRC_IPV6_NIB_NC_INFO_NUD_STATE_STALE));
+    }
+    TEST_ASSERT(first == _nib_onl_get(&first_addr, IFACE));
+    addr.u64[1].u64++;
+    TEST_ASSERT_NULL(_nib_onl_get(&addr, IFACE));
+    TEST_ASSERT_NOT_NULL((node = _nib_nc_add(&addr, IFACE,
+                                             GNRC_IPV6_NIB_NC_INFO_NUD_STATE_STALE)));
+    TEST_ASSERT(second == node);
+    TEST_ASSERT(first == _nib_onl_get(&first_addr, IFACE));
+    gnrc_ipv6_nib_nc_get_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(2, stats.hits);
+    TEST_ASSERT_EQUAL_INT(1, stats.misses);
+    TEST_ASSERT_EQUAL_INT(1, stats.evictions);
+}
+
 /*
  * Creates a neighbor cache entry and sets it reachable
  * Expected result: node->info flags set to NUD_STATE_REACHABLE and NIB's event
@@ -2027,6 +2064,7 @@ Test *tests_gnrc_ipv6_nib_internal_tests(void)
         new_TestFixture(test_nib_nc_add__success),
         new_TestFixture(test_nib_nc_add__success_full_but_garbage_collectible),
         new_TestFixture(test_nib_nc_add__cache_out_crash),
+        new_TestFixture(test_nib_nc_add__success_full_lru),
         new_TestFixture(test_nib_nc_remove__uncleared),
         new_TestFixture(test_nib_nc_remove__cleared),
         new_TestFixture(test_nib_nc_set_reachable__success),
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @author  RIOT developers <devel@riot-os.org>
+ * @file
+ */
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+
+#include "net/gnrc/ipv6/route_cache.h"
+
+#include "tests-gnrc_ipv6_route_cache.h"
+
+#define TEST_DST        { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x01, \
+                          0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02 }
+#define TEST_NEXT_HOP   { 0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, \
+                          0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x01 }
+#define TEST_L2ADDR     { 0x00, 0x00, 0x00, 0x00, 0x00, 0x01 }
+#define TEST_IFACE      (5)
+
+static const ipv6_addr_t _dst = { .u8 = TEST_DST };
+
+/* The cache only keeps a reference to the interface's PID */
+static gnrc_netif_t _dummy_netif = { .pid = TEST_IFACE };
+
+static void _init_nce(gnrc_ipv6_nib_nc_t *nce)
+{
+    static const ipv6_addr_t next_hop = { .u8 = TEST_NEXT_HOP };
+    static const uint8_t l2addr[] = TEST_L2ADDR;
+
+    memset(nce, 0, sizeof(*nce));
+    memcpy(&nce->ipv6, &next_hop, sizeof(nce->ipv6));
+    memcpy(nce->l2addr, l2addr, sizeof(l2addr));
+    nce->l2addr_len = sizeof(l2addr);
+    nce->info = (TEST_IFACE << GNRC_IPV6_NIB_NC_INFO_IFACE_POS);
+}
+
+static void set_up(void)
+{
+    gnrc_ipv6_route_cache_invalidate();
+}
+
+static void test_route_cache_get__empty(void)
+{
+    TEST_ASSERT_NULL(gnrc_ipv6_route_cache_get(&_dst, NULL));
+}
+
+static void test_route_cache_get__after_add(void)
+{
+    gnrc_ipv6_nib_nc_t nce;
+    const gnrc_ipv6_nib_nc_t *res;
+
+    _init_nce(&nce);
+    TEST_ASSERT_NULL(gnrc_ipv6_route_cache_get(&_dst, NULL));
+    gnrc_ipv6_route_cache_add(&_dst, NULL, &nce);
+    TEST_ASSERT_NOT_NULL((res = gnrc_ipv6_route_cache_get(&_dst, NULL)));
+    TEST_ASSERT(memcmp(&nce, res, sizeof(nce)) == 0);
+    /* lookups for a specific interface are cached separately */
+    TEST_ASSERT_NULL(gnrc_ipv6_route_cache_get(&_dst, &_dummy_netif));
+}
+
+static void test_route_cache_get__after_invalidate(void)
+{
+    gnrc_ipv6_nib_nc_t nce;
+
+    _init_nce(&nce);
+    TEST_ASSERT_NULL(gnrc_ipv6_route_cache_get(&_dst, &_dummy_netif));
+    gnrc_ipv6_route_cache_add(&_dst, &_dummy_netif, &nce);
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_route_cache_get(&_dst, &_dummy_netif));
+    gnrc_ipv6_route_cache_invalidate();
+    TEST_ASSERT_NULL(gnrc_ipv6_route_cache_get(&_dst, &_dummy_netif));
+}
+
+static void test_route_cache_add__invalidated_during_resolution(void)
+{
+    gnrc_ipv6_nib_nc_t nce;
+
+    _init_nce(&nce);
+    TEST_ASSERT_NULL(gnrc_ipv6_route_cache_get(&_dst, NULL));
+    /* NIB changes while the next hop is resolved */
+    gnrc_ipv6_route_cache_invalidate();
+    gnrc_ipv6_route_cache_add(&_dst, NULL, &nce);
+    TEST_ASSERT_NULL(gnrc_ipv6_route_cache_get(&_dst, NULL));
+}
+
+static void test_route_cache_get_stats(void)
+{
+    gnrc_ipv6_route_cache_stats_t before, after;
+    gnrc_ipv6_nib_nc_t nce;
+
+    _init_nce(&nce);
+    gnrc_ipv6_route_cache_get_stats(&before);
+    TEST_ASSERT_NULL(gnrc_ipv6_route_cache_get(&_dst, NULL));
+    gnrc_ipv6_route_cache_add(&_dst, NULL, &nce);
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_route_cache_get(&_dst, NULL));
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_route_cache_get(&_dst, NULL));
+    gnrc_ipv6_route_cache_forwarded(42U);
+    gnrc_ipv6_route_cache_get_stats(&after);
+    TEST_ASSERT_EQUAL_INT(2, after.hits - before.hits);
+    TEST_ASSERT_EQUAL_INT(1, after.misses - before.misses);
+    TEST_ASSERT_EQUAL_INT(1, after.forwarded - before.forwarded);
+    TEST_ASSERT_EQUAL_INT(42, after.forward_time - before.forward_time);
+}
+
+static Test *tests_gnrc_ipv6_route_cache_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_route_cache_get__empty),
+        new_TestFixture(test_route_cache_get__after_add),
+        new_TestFixture(test_route_cache_get__after_invalidate),
+        new_TestFixture(test_route_cache_add__invalidated_during_resolution),
+        new_TestFixture(test_route_cache_get_stats),
+    };
+
+    EMB_UNIT_TESTCALLER(route_cache_tests, set_up, NULL, fixtures);
+
+    return (Test *)&route_cache_tests;
+}
+
+void tests_gnrc_ipv6_route_cache(void)
+{
+    TESTS_RUN(tests_gnrc_ipv6_route_cache_tests());
+}
+/** @} */
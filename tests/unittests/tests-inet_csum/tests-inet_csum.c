@@ -13,6 +13,7 @@
  */
 #include <errno.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "embUnit.h"
 
@@ -165,6 +166,84 @@ static void test_inet_csum__empty_app_buffer(void)
     TEST_ASSERT_EQUAL_INT(hdr_expected, pyld_sum);
 }
 
+/* straight-forward implementation to compare the optimized one against */
+static uint16_t _ref_csum(uint16_t sum, const uint8_t *buf, uint16_t len)
+{
+    uint32_t csum = sum;
+
+    for (unsigned i = 0; i < len; i++) {
+        csum += (i & 1) ? buf[i] : (uint16_t)(buf[i] << 8);
+    }
+    while (csum >> 16) {
+        csum = (csum & 0xffff) + (csum >> 16);
+    }
+    return csum;
+}
+
+static void test_inet_csum__long_unaligned(void)
+{
+    uint8_t data[1500 + 3];
+
+    for (unsigned i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)((i * 0x9d) ^ (i >> 3));
+    }
+    /* all offsets and a few lengths around the word sizes of the loops */
+    for (unsigned off = 0; off < 4; off++) {
+        for (unsigned len = 0; len < 40; len++) {
+            TEST_ASSERT_EQUAL_INT(_ref_csum(0x1234, &data[off], len),
+                                  inet_csum(0x1234, &data[off], len));
+        }
+        TEST_ASSERT_EQUAL_INT(_ref_csum(0, &data[off], 1500),
+                              inet_csum(0, &data[off], 1500));
+        TEST_ASSERT_EQUAL_INT(_ref_csum(0, &data[off], 1499),
+                              inet_csum(0, &data[off], 1499));
+    }
+}
+
+static void test_inet_csum__long_all_ones(void)
+{
+    uint8_t data[1024];
+
+    /* sums up to more than 32 bit before folding */
+    memset(data, 0xff, sizeof(data));
+    TEST_ASSERT_EQUAL_INT(0xffff, inet_csum(0, data, sizeof(data)));
+    TEST_ASSERT_EQUAL_INT(0xffff, inet_csum(0xffff, data, sizeof(data)));
+    memset(data, 0, sizeof(data));
+    TEST_ASSERT_EQUAL_INT(0, inet_csum(0, data, sizeof(data)));
+}
+
+static void test_inet_csum__update_rfc_example(void)
+{
+    /* source: https://tools.ietf.org/html/rfc1624#section-4 */
+    TEST_ASSERT_EQUAL_INT(0x0000, inet_csum_update(0xdd2f, 0x5555, 0x3285));
+}
+
+static void test_inet_csum__update_buf(void)
+{
+    /* IPv4 header of https://tools.ietf.org/html/rfc1071#section-3 style
+     * test data, with an address rewritten as done by a NAT */
+    uint8_t data[] = {
+        0x45, 0x00, 0x00, 0x73, 0x00, 0x00, 0x40, 0x00,
+        0x40, 0x11, 0x00, 0x00, 0xc0, 0xa8, 0x00, 0x01,
+        0xc0, 0xa8, 0x00, 0xc7,
+    };
+    static const uint8_t new_addr[] = { 0x0a, 0x00, 0x00, 0x2a };
+    uint8_t old_addr[sizeof(new_addr)];
+    uint16_t csum = ~inet_csum(0, data, sizeof(data));
+
+    TEST_ASSERT_EQUAL_INT(0xb861, csum);
+    memcpy(old_addr, &data[12], sizeof(old_addr));
+    memcpy(&data[12], new_addr, sizeof(new_addr));
+    TEST_ASSERT_EQUAL_INT((uint16_t)~inet_csum(0, data, sizeof(data)),
+                          inet_csum_update_buf(csum, old_addr, new_addr,
+                                               sizeof(new_addr)));
+    /* decrementing the TTL */
+    csum = ~inet_csum(0, data, sizeof(data));
+    data[8]--;
+    TEST_ASSERT_EQUAL_INT((uint16_t)~inet_csum(0, data, sizeof(data)),
+                          inet_csum_update(csum, 0x4011, 0x3f11));
+}
+
 Test *tests_inet_csum_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -176,6 +255,10 @@ Test *tests_inet_csum_tests(void)
         new_TestFixture(test_inet_csum__odd_len),
         new_TestFixture(test_inet_csum__two_app_snips),
         new_TestFixture(test_inet_csum__empty_app_buffer),
+        new_TestFixture(test_inet_csum__long_unaligned),
+        new_TestFixture(test_inet_csum__long_all_ones),
+        new_TestFixture(test_inet_csum__update_rfc_example),
+        new_TestFixture(test_inet_csum__update_buf),
     };
 
     EMB_UNIT_TESTCALLER(inet_csum_tests, NULL, NULL, fixtures);
@@ -42,6 +42,11 @@ static void set_up(void)
     gnrc_pktbuf_init();
 }
 
+static void tear_down(void)
+{
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+}
+
 static void test_pktbuf_init(void)
 {
     TEST_ASSERT(gnrc_pktbuf_is_empty());
@@ -202,11 +207,22 @@ static void test_pktbuf_add__memfull(void)
 }
 #endif
 
+/* the buddy system of gnrc_pktbuf_slab rounds large chunks up to a power of
+ * two multiple of GNRC_PKTBUF_SLAB_UNIT, so less of them fit */
+#ifdef MODULE_GNRC_PKTBUF_SLAB
+#define TEST_PKTBUF_ADD_NUMOF   (4)
+#else
+#define TEST_PKTBUF_ADD_NUMOF   (9)
+#endif
+
 static void test_pktbuf_add__success(void)
 {
-    gnrc_pktsnip_t *pkt, *pkt_prev = NULL;
+    gnrc_pktsnip_t *pkt;
+#ifndef MODULE_GNRC_PKTBUF_SLAB  /* neither does it allocate in address order */
+    gnrc_pktsnip_t *pkt_prev = NULL;
+#endif
 
-    for (int i = 0; i < 9; i++) {
+    for (int i = 0; i < TEST_PKTBUF_ADD_NUMOF; i++) {
         pkt = gnrc_pktbuf_add(NULL, NULL, (GNRC_PKTBUF_SIZE / 10) + 4, GNRC_NETTYPE_TEST);
 
         TEST_ASSERT_NOT_NULL(pkt);
@@ -216,12 +232,14 @@ static void test_pktbuf_add__success(void)
         TEST_ASSERT_EQUAL_INT(GNRC_NETTYPE_TEST, pkt->type);
         TEST_ASSERT_EQUAL_INT(1, pkt->users);
 
+#ifndef MODULE_GNRC_PKTBUF_SLAB
         if (pkt_prev != NULL) {
             TEST_ASSERT(pkt_prev < pkt);
             TEST_ASSERT(pkt_prev->data < pkt->data);
         }
 
         pkt_prev = pkt;
+#endif
     }
     TEST_ASSERT(gnrc_pktbuf_is_sane());
 }
@@ -245,7 +263,9 @@ static void test_pktbuf_add__packed_struct(void)
     TEST_ASSERT_EQUAL_INT(data.s64, data_cpy->s64);
 }
 
-#ifndef MODULE_GNRC_PKTBUF_MALLOC   /* alignment-handling left to malloc, so no certainty here */
+/* alignment-handling left to malloc, so no certainty here; gnrc_pktbuf_slab
+ * rounds up to GNRC_PKTBUF_SLAB_UNIT, so the larger chunk fits into the hole */
+#if !defined(MODULE_GNRC_PKTBUF_MALLOC) && !defined(MODULE_GNRC_PKTBUF_SLAB)
 static void test_pktbuf_add__unaligned_in_aligned_hole(void)
 {
     gnrc_pktsnip_t *pkt1 = gnrc_pktbuf_add(NULL, NULL, 8, GNRC_NETTYPE_TEST);
@@ -813,7 +833,9 @@ static void test_pktbuf_start_write__pkt_users_2(void)
     TEST_ASSERT(gnrc_pktbuf_is_empty());
 }
 
-#ifndef MODULE_GNRC_PKTBUF_MALLOC
+/* the size filling up the packet buffer depends on the layout of
+ * gnrc_pktbuf_static, tests/gnrc_pktbuf_slab has its own variant */
+#if !defined(MODULE_GNRC_PKTBUF_MALLOC) && !defined(MODULE_GNRC_PKTBUF_SLAB)
 static void test_pktbuf_reverse_snips__too_full(void)
 {
     gnrc_pktsnip_t *pkt, *pkt_next, *pkt_huge;
@@ -835,7 +857,7 @@ static void test_pktbuf_reverse_snips__too_full(void)
     gnrc_pktbuf_release(pkt_next);
     TEST_ASSERT(gnrc_pktbuf_is_empty());
 }
-#endif /* MODULE_GNRC_PKTBUF_MALLOC */
+#endif /* !MODULE_GNRC_PKTBUF_MALLOC && !MODULE_GNRC_PKTBUF_SLAB */
 
 static void test_pktbuf_reverse_snips__success(void)
 {
@@ -868,7 +890,7 @@ Test *tests_pktbuf_tests(void)
 #endif
         new_TestFixture(test_pktbuf_add__success),
         new_TestFixture(test_pktbuf_add__packed_struct),
-#ifndef MODULE_GNRC_PKTBUF_MALLOC
+#if !defined(MODULE_GNRC_PKTBUF_MALLOC) && !defined(MODULE_GNRC_PKTBUF_SLAB)
         new_TestFixture(test_pktbuf_add__unaligned_in_aligned_hole),
 #endif
         new_TestFixture(test_pktbuf_add__0_sized_release),
@@ -906,13 +928,13 @@ Test *tests_pktbuf_tests(void)
         new_TestFixture(test_pktbuf_start_write__NULL),
         new_TestFixture(test_pktbuf_start_write__pkt_users_1),
         new_TestFixture(test_pktbuf_start_write__pkt_users_2),
-#ifndef MODULE_GNRC_PKTBUF_MALLOC
+#if !defined(MODULE_GNRC_PKTBUF_MALLOC) && !defined(MODULE_GNRC_PKTBUF_SLAB)
         new_TestFixture(test_pktbuf_reverse_snips__too_full),
-#endif /* MODULE_GNRC_PKTBUF_MALLOC */
+#endif
         new_TestFixture(test_pktbuf_reverse_snips__success),
     };
 
-    EMB_UNIT_TESTCALLER(gnrc_pktbuf_tests, set_up, NULL, fixtures);
+    EMB_UNIT_TESTCALLER(gnrc_pktbuf_tests, set_up, tear_down, fixtures);
 
     return (Test *)&gnrc_pktbuf_tests;
 }
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       xtimer_slack test application
+ *
+ * Sets timers with overlapping slack and checks that none of them fires
+ * early or later than allowed, and that they share timer interrupts.
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "xtimer.h"
+
+#define NUMOF           (8U)
+#define OFFSET          (10U * US_PER_MS)
+#define SPACING         (1U * US_PER_MS)
+#define SLACK           (20U * US_PER_MS)
+/* callbacks are executed a bit after the target even without slack */
+#define TOLERANCE       (1U * US_PER_MS)
+
+static uint32_t _fired[NUMOF];
+
+static void _cb(void *arg)
+{
+    _fired[(uintptr_t)arg] = xtimer_now_usec();
+}
+
+int main(void)
+{
+    xtimer_t timers[NUMOF];
+    uint32_t targets[NUMOF];
+    xtimer_slack_stats_t before, after;
+    unsigned errors = 0;
+
+    puts("xtimer_slack test application.");
+
+    xtimer_slack_get_stats(&before);
+    uint32_t now = xtimer_now_usec();
+    for (unsigned i = 0; i < NUMOF; i++) {
+        timers[i].callback = _cb;
+        timers[i].arg = (void *)(uintptr_t)i;
+        targets[i] = now + OFFSET + (i * SPACING);
+        xtimer_set_slack(&timers[i], OFFSET + (i * SPACING), SLACK);
+    }
+
+    xtimer_usleep(OFFSET + (NUMOF * SPACING) + SLACK + TOLERANCE);
+    xtimer_slack_get_stats(&after);
+
+    for (unsigned i = 0; i < NUMOF; i++) {
+        int32_t late = (int32_t)(_fired[i] - targets[i]);
+
+        printf("timer %u late by %" PRIi32 " us\n", i, late);
+        if ((late < 0) || (late > (int32_t)(SLACK + TOLERANCE))) {
+            errors++;
+        }
+    }
+
+    /* the sleeping thread's own timer is counted as well */
+    uint32_t fired = after.fired - before.fired;
+    uint32_t wakeups = after.wakeups - before.wakeups;
+    printf("%" PRIu32 " timers fired by %" PRIu32 " interrupts\n",
+           fired, wakeups);
+    if (wakeups >= NUMOF) {
+        errors++;
+    }
+
+    if (errors) {
+        puts("TEST FAILED");
+    }
+    else {
+        puts("TEST PASSED");
+    }
+
+    return 0;
+}
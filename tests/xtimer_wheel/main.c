@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2019 RIOT developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the timing wheel backend of xtimer
+ *
+ * The offsets are chosen for a 1 MHz xtimer, so with the configuration in the
+ * Makefile they end up on every level of the wheel and in the overflow list.
+ *
+ * @author      RIOT developers <devel@riot-os.org>
+ *
+ * @}
+ */
+
+#include <stdint.h>
+
+#include "embUnit.h"
+#include "xtimer.h"
+
+#define TIMERS_NUMOF    (8U)
+#define MARGIN          (20U * US_PER_MS)
+#define UNFIRED         (UINT8_MAX)
+
+static xtimer_t _timers[TIMERS_NUMOF];
+static volatile unsigned _fired;
+static volatile uint8_t _order[TIMERS_NUMOF];
+static volatile uint32_t _fired_at[TIMERS_NUMOF];
+
+static void _cb(void *arg)
+{
+    unsigned idx = (unsigned)(uintptr_t)arg;
+
+    _fired_at[idx] = xtimer_now_usec();
+    _order[_fired++] = idx;
+}
+
+static void set_up(void)
+{
+    _fired = 0;
+    for (unsigned i = 0; i < TIMERS_NUMOF; i++) {
+        _timers[i].callback = _cb;
+        _timers[i].arg = (void *)(uintptr_t)i;
+        _order[i] = UNFIRED;
+    }
+}
+
+static void tear_down(void)
+{
+    for (unsigned i = 0; i < TIMERS_NUMOF; i++) {
+        xtimer_remove(&_timers[i]);
+    }
+}
+
+static void test_xtimer_wheel__expiry_order(void)
+{
+    /* sorted, spread over all levels and the overflow list */
+    static const uint32_t offsets[] = { 100, 300, 2000, 9000, 40000, 300000,
+                                        700000, 900000 };
+    /* order to set them in */
+    static const uint8_t perm[] = { 5, 1, 7, 3, 0, 6, 2, 4 };
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < TIMERS_NUMOF; i++) {
+        xtimer_set(&_timers[perm[i]], offsets[perm[i]]);
+    }
+    xtimer_usleep(offsets[TIMERS_NUMOF - 1] + MARGIN);
+    TEST_ASSERT_EQUAL_INT(TIMERS_NUMOF, _fired);
+    for (unsigned i = 0; i < TIMERS_NUMOF; i++) {
+        TEST_ASSERT_EQUAL_INT(i, _order[i]);
+        /* never early */
+        TEST_ASSERT((_fired_at[i] - start) >= offsets[i]);
+    }
+}
+
+static void test_xtimer_wheel__remove(void)
+{
+    /* pairs of timers sharing a slot of level 1, level 2 and the overflow
+     * list, the removed ones are at the head and at the tail of the slot */
+    static const uint32_t offsets[] = { 2000, 2100, 40000, 40500, 700000,
+                                        710000, 9000, 300000 };
+    xtimer_t unset = { 0 };
+
+    for (unsigned i = 0; i < TIMERS_NUMOF; i++) {
+        xtimer_set(&_timers[i], offsets[i]);
+    }
+    xtimer_remove(&_timers[1]);
+    xtimer_remove(&_timers[2]);
+    xtimer_remove(&_timers[5]);
+    /* reschedule from level 1 to level 2 */
+    xtimer_set(&_timers[6], 50000);
+    /* removing a timer that was never set does nothing */
+    xtimer_remove(&unset);
+    xtimer_usleep(offsets[4] + MARGIN);
+    TEST_ASSERT_EQUAL_INT(5, _fired);
+    TEST_ASSERT_EQUAL_INT(0, _order[0]);
+    TEST_ASSERT_EQUAL_INT(3, _order[1]);
+    TEST_ASSERT_EQUAL_INT(6, _order[2]);
+    TEST_ASSERT_EQUAL_INT(7, _order[3]);
+    TEST_ASSERT_EQUAL_INT(4, _order[4]);
+    /* removing a timer that already fired does nothing */
+    xtimer_remove(&_timers[0]);
+    xtimer_usleep(offsets[5] - offsets[4] + MARGIN);
+    TEST_ASSERT_EQUAL_INT(5, _fired);
+}
+
+static void test_xtimer_wheel__cascade(void)
+{
+    /* one slot of level 2, 20us apart, so they are cascaded down together
+     * and end up in different slots of the lower levels */
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = TIMERS_NUMOF; i > 0; i--) {
+        xtimer_set(&_timers[i - 1], 40000 + ((i - 1) * 20));
+    }
+    xtimer_usleep(40000 + MARGIN);
+    TEST_ASSERT_EQUAL_INT(TIMERS_NUMOF, _fired);
+    for (unsigned i = 0; i < TIMERS_NUMOF; i++) {
+        TEST_ASSERT_EQUAL_INT(i, _order[i]);
+        TEST_ASSERT((_fired_at[i] - start) >= (40000 + (i * 20)));
+    }
+}
+
+static void test_xtimer_wheel__cascade_overflow(void)
+{
+    /* 600 ms lie beyond the span of the wheel (524 ms), so these wait in
+     * the overflow list until the top level wraps around */
+    uint32_t start = xtimer_now_usec();
+
+    xtimer_set(&_timers[1], 600000);
+    xtimer_set(&_timers[0], 520000);
+    xtimer_set(&_timers[2], 600020);
+    xtimer_usleep(600020 + MARGIN);
+    TEST_ASSERT_EQUAL_INT(3, _fired);
+    for (unsigned i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_INT(i, _order[i]);
+    }
+    TEST_ASSERT((_fired_at[2] - start) >= 600020);
+}
+
+static Test *tests_xtimer_wheel(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_xtimer_wheel__expiry_order),
+        new_TestFixture(test_xtimer_wheel__remove),
+        new_TestFixture(test_xtimer_wheel__cascade),
+        new_TestFixture(test_xtimer_wheel__cascade_overflow),
+    };
+
+    EMB_UNIT_TESTCALLER(tests, set_up, tear_down, fixtures);
+
+    return (Test *)&tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_xtimer_wheel());
+    TESTS_END();
+
+    return 0;
+}